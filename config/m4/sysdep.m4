@@ -243,6 +243,12 @@ AC_CHECK_HEADERS([sys/eventfd.h])
 AC_CHECK_HEADERS([sys/event.h])
 
 
+#
+# io_uring (TCP transport progress engine)
+#
+AC_CHECK_HEADERS([linux/io_uring.h])
+
+
 #
 # FreeBSD-specific threading functions
 #
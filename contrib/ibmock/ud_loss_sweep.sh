@@ -0,0 +1,39 @@
+#!/bin/bash -eE
+#
+# Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# See file LICENSE for terms.
+#
+# Measure UD transport goodput and tail latency under injected packet loss.
+#
+# Usage: ud_loss_sweep.sh <ucx_perftest> <ibmock build dir> [device]
+#
+
+perftest=${1:-""}
+ibmock=${2:-""}
+device=${3:-"rdmap0:1"}
+
+if [ -z "$perftest" ] || [ -z "$ibmock" ]; then
+    echo "usage: $0 <ucx_perftest> <ibmock build dir> [device]" >&2
+    exit 1
+fi
+
+drop_rates=${DROP_RATES:-"0 0.001 0.005 0.01 0.02 0.05"}
+iters=${ITERS:-20000}
+rank=${PERCENTILE:-99}
+
+run_perftest() {
+    local rate=$1
+    shift
+
+    IBMOCK_UD_DROP_RATE=$rate LD_LIBRARY_PATH=$ibmock:$LD_LIBRARY_PATH \
+        $perftest -x ud_verbs -d $device -l -n $iters "$@" 2>/dev/null | \
+        awk '/^Final:/ {print}'
+}
+
+printf "%-10s %16s %16s\n" "drop_rate" "am_bw[msg/s]" "am_lat_p${rank}[us]"
+for rate in $drop_rates
+do
+    bw=$(run_perftest $rate -t am_bw -D bcopy | awk '{print $9}')
+    lat=$(run_perftest $rate -t am_lat -D bcopy -R $rank | awk '{print $3}')
+    printf "%-10s %16s %16s\n" $rate ${bw:-n/a} ${lat:-n/a}
+done
@@ -33,6 +33,10 @@ void unlock(void)
 
 bool verbs_allow_disassociate_destroy = 0;
 
+/* Packet loss injection for UD QPs, set by IBMOCK_UD_DROP_RATE */
+static double ud_drop_rate   = 0;
+static unsigned ud_drop_seed = 1;
+
 enum be_mode {
     BE_NOTSET,
     BE_LOOPBACK
@@ -420,6 +424,13 @@ static int dev_wr_send_serialize(struct ibv_qp *qp, struct ibv_send_wr *wr,
     wc->src_qp   = qp->qp_num;
     wc->byte_len = total;
 
+    if ((qp->qp_type == IBV_QPT_UD) && (ud_drop_rate > 0) &&
+        (rand_r(&ud_drop_seed) < (ud_drop_rate * RAND_MAX))) {
+        /* Lost on the wire: the sender still gets a successful completion */
+        dev_send_comp(fcqe, 1);
+        return 0;
+    }
+
     /* TODO: Use actual backend for multi process/nodes */
     ret = dev_rx_cb(iov, count);
     if (ret == 0) {
@@ -938,7 +949,19 @@ int dev_qp_wr_complete(struct ibv_qp_ex *qp_ex)
 
 __attribute__((constructor)) void verbs_ctor(void)
 {
+    const char *env;
+
     array_init(&fake_qps, sizeof(struct fake_qp*));
+
+    env = getenv("IBMOCK_UD_DROP_RATE");
+    if (env != NULL) {
+        ud_drop_rate = atof(env);
+    }
+
+    env = getenv("IBMOCK_UD_DROP_SEED");
+    if (env != NULL) {
+        ud_drop_seed = strtoul(env, NULL, 0);
+    }
 }
 
 __attribute__((destructor)) void verbs_dtor(void)
@@ -48,6 +48,10 @@ typedef enum {
                                             ucp_worker_wait_mem() */
     UCX_PERF_TEST_TYPE_STREAM_UNI,       /* Unidirectional stream */
     UCX_PERF_TEST_TYPE_STREAM_BI,        /* Bidirectional stream */
+    UCX_PERF_TEST_TYPE_INCAST,           /* All processes stream to the first
+                                            one */
+    UCX_PERF_TEST_TYPE_ALLTOALL,         /* Every process streams to all the
+                                            other ones */
     UCX_PERF_TEST_TYPE_LAST
 } ucx_perf_test_type_t;
 
@@ -55,6 +59,7 @@ typedef enum {
 typedef enum {
     UCP_PERF_DATATYPE_CONTIG,
     UCP_PERF_DATATYPE_IOV,
+    UCP_PERF_DATATYPE_GENERIC
 } ucp_perf_datatype_t;
 
 
@@ -63,6 +68,7 @@ typedef enum {
     UCT_PERF_DATA_LAYOUT_SHORT_IOV,
     UCT_PERF_DATA_LAYOUT_BCOPY,
     UCT_PERF_DATA_LAYOUT_ZCOPY,
+    UCT_PERF_DATA_LAYOUT_SHORT_BATCH,
     UCT_PERF_DATA_LAYOUT_LAST
 } uct_perf_data_layout_t;
 
@@ -89,12 +95,17 @@ enum ucx_perf_test_flags {
     UCX_PERF_TEST_FLAG_ERR_HANDLING     = UCS_BIT(11), /* Create UCP eps with error handling support */
     UCX_PERF_TEST_FLAG_LOOPBACK         = UCS_BIT(12), /* Use loopback connection */
     UCX_PERF_TEST_FLAG_PREREG           = UCS_BIT(13), /* Pass pre-registered memory handle */
-    UCX_PERF_TEST_FLAG_AM_RECV_COPY     = UCS_BIT(14)  /* Do additional memcopy during AM receive */
+    UCX_PERF_TEST_FLAG_AM_RECV_COPY     = UCS_BIT(14), /* Do additional memcopy during AM receive */
+    UCX_PERF_TEST_FLAG_AM_BATCH         = UCS_BIT(15), /* Send UCP AM in batches of batch_size */
+    UCX_PERF_TEST_FLAG_STREAM_COALESCE  = UCS_BIT(16), /* Coalesce small UCP stream sends */
+    UCX_PERF_TEST_FLAG_RATE_POISSON     = UCS_BIT(17)  /* Poisson arrivals in open-loop mode */
 };
 
 
 enum {
-    UCT_PERF_TEST_MAX_FC_WINDOW   = 127         /* Maximal flow-control window */
+    UCT_PERF_TEST_MAX_FC_WINDOW   = 127,        /* Maximal flow-control window */
+    UCX_PERF_TEST_MAX_BATCH_SIZE  = 64          /* Maximal number of operations
+                                                   posted in one batch */
 };
 
 
@@ -166,6 +177,28 @@ typedef enum {
 typedef uint64_t ucx_perf_counter_t;
 
 
+/*
+ * Latency histogram, with log-linear buckets: values below
+ * 2^UCX_PERF_HIST_SUB_BITS are recorded exactly, and larger values with a
+ * relative error of at most 2^-UCX_PERF_HIST_SUB_BITS. Values of
+ * 2^UCX_PERF_HIST_MAX_BITS and above are counted in the last bucket.
+ */
+#define UCX_PERF_HIST_SUB_BITS    6
+#define UCX_PERF_HIST_MAX_BITS    40
+#define UCX_PERF_HIST_NUM_BUCKETS \
+    ((UCX_PERF_HIST_MAX_BITS - UCX_PERF_HIST_SUB_BITS + 1) << \
+     UCX_PERF_HIST_SUB_BITS)
+
+
+typedef struct ucx_perf_histogram {
+    double                  unit;    /* Seconds per recorded value unit */
+    ucx_perf_counter_t      count;   /* Total number of recorded values */
+    uint64_t                min;     /* Minimal recorded value */
+    uint64_t                max;     /* Maximal recorded value */
+    ucx_perf_counter_t      buckets[UCX_PERF_HIST_NUM_BUCKETS];
+} ucx_perf_histogram_t;
+
+
 /*
  * Performance test result.
  *
@@ -176,12 +209,27 @@ typedef struct ucx_perf_result {
     ucx_perf_counter_t      iters;
     double                  elapsed_time;
     ucx_perf_counter_t      bytes;
+    double                  cpu_time; /* CPU time (user + system) consumed by
+                                         the process during the test */
     struct {
         double              percentile;
         double              moment_average; /* Average since last report */
         double              total_average;  /* Average of the whole test */
     }
     latency, bandwidth, msgrate;
+    const ucx_perf_histogram_t *latency_histogram; /* Valid only inside the
+                                                      report callback */
+    struct {
+        unsigned            flows;          /* Number of sender to receiver
+                                               flows, 0 if not a group test */
+        double              bandwidth;      /* Aggregate receive bandwidth */
+        double              msgrate;        /* Aggregate receive message rate */
+        double              fairness;       /* Jain's index of flow msgrates */
+        double              min_flow_msgrate;
+        double              max_flow_msgrate;
+        double              progress_calls; /* Receiver progress calls and */
+        double              progress_time;  /* time per received message */
+    } group;
 } ucx_perf_result_t;
 
 
@@ -264,10 +312,14 @@ typedef struct ucx_perf_params {
                                                similar to UCT uct_iov_t type stride */
     size_t                 alignment;       /* Message buffer alignment */
     unsigned               max_outstanding; /* Maximal number of outstanding sends */
+    unsigned               batch_size;      /* Number of operations posted
+                                               together in batch modes */
     ucx_perf_counter_t     warmup_iter;     /* Number of warm-up iterations */
     double                 warmup_time;     /* Approximately how long to warm-up */
     ucx_perf_counter_t     max_iter;        /* Iterations limit, 0 - unlimited */
     double                 max_time;        /* Time limit (seconds), 0 - unlimited */
+    double                 rate;            /* Open-loop target rate (operations per
+                                               second), 0 - closed loop */
     double                 report_interval; /* Interval at which to call the report callback */
     double                 percentile_rank; /* The percentile rank of the percentile reported
                                                in latency tests */
@@ -318,6 +370,35 @@ extern const ucx_perf_allocator_t* ucx_perf_mem_type_allocators[];
 const char *ucp_perf_daemon_am_id_name(ucp_perf_daemon_am_id_t id);
 
 
+/**
+ * Reset a histogram which records values of @a unit seconds each.
+ */
+void ucx_perf_histogram_reset(ucx_perf_histogram_t *hist, double unit);
+
+
+/**
+ * Add all values recorded in @a src to @a dst. The histograms may use
+ * different units, for example when they were recorded on different hosts.
+ */
+void ucx_perf_histogram_merge(ucx_perf_histogram_t *dst,
+                              const ucx_perf_histogram_t *src);
+
+
+/**
+ * @return Value of the given percentile rank (0..100), in seconds.
+ */
+double ucx_perf_histogram_percentile(const ucx_perf_histogram_t *hist,
+                                     double rank);
+
+
+/**
+ * Get the range of values covered by a histogram bucket, in seconds.
+ */
+void ucx_perf_histogram_bucket_range(const ucx_perf_histogram_t *hist,
+                                     unsigned index, double *low_p,
+                                     double *high_p);
+
+
 /**
  * Initialize performance testing framework. May be called multiple times.
  */
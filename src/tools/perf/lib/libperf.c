@@ -24,6 +24,7 @@
 #include <uct/api/v2/uct_v2.h>
 
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #if _OPENMP
@@ -189,17 +190,157 @@ static ucs_time_t __find_percentile_quick_select(ucs_time_t arr[], int n, double
     }
 }
 
+static void ucx_perf_histogram_bucket_bounds(unsigned index, uint64_t *low_p,
+                                             uint64_t *high_p)
+{
+    unsigned group = index >> UCX_PERF_HIST_SUB_BITS;
+    uint64_t sub   = index & UCS_MASK(UCX_PERF_HIST_SUB_BITS);
+
+    if (group == 0) {
+        *low_p  = sub;
+        *high_p = sub + 1;
+    } else {
+        *low_p  = (UCS_BIT(UCX_PERF_HIST_SUB_BITS) + sub) << (group - 1);
+        *high_p = *low_p + UCS_BIT(group - 1);
+    }
+}
+
+/* Value which represents a bucket: its middle, within the recorded range */
+static uint64_t ucx_perf_histogram_bucket_value(const ucx_perf_histogram_t *hist,
+                                                unsigned index)
+{
+    uint64_t low, high;
+
+    ucx_perf_histogram_bucket_bounds(index, &low, &high);
+    return ucs_max(ucs_min(low + ((high - 1 - low) / 2), hist->max),
+                   hist->min);
+}
+
+void ucx_perf_histogram_reset(ucx_perf_histogram_t *hist, double unit)
+{
+    memset(hist->buckets, 0, sizeof(hist->buckets));
+    hist->unit  = unit;
+    hist->count = 0;
+    hist->min   = UINT64_MAX;
+    hist->max   = 0;
+}
+
+void ucx_perf_histogram_merge(ucx_perf_histogram_t *dst,
+                              const ucx_perf_histogram_t *src)
+{
+    double scale = src->unit / dst->unit;
+    unsigned i;
+
+    if (src->count == 0) {
+        return;
+    }
+
+    if (scale == 1.0) {
+        for (i = 0; i < UCX_PERF_HIST_NUM_BUCKETS; ++i) {
+            dst->buckets[i] += src->buckets[i];
+        }
+        dst->count += src->count;
+        dst->min    = ucs_min(dst->min, src->min);
+        dst->max    = ucs_max(dst->max, src->max);
+        return;
+    }
+
+    /* different clock rates: move every bucket to its value in dst units */
+    for (i = 0; i < UCX_PERF_HIST_NUM_BUCKETS; ++i) {
+        if (src->buckets[i] != 0) {
+            ucx_perf_histogram_record(
+                    dst, ucx_perf_histogram_bucket_value(src, i) * scale,
+                    src->buckets[i]);
+        }
+    }
+    dst->min = ucs_min(dst->min, (uint64_t)(src->min * scale));
+    dst->max = ucs_max(dst->max, (uint64_t)(src->max * scale));
+}
+
+double ucx_perf_histogram_percentile(const ucx_perf_histogram_t *hist,
+                                     double rank)
+{
+    ucx_perf_counter_t target, sum;
+    unsigned i;
+
+    if (hist->count == 0) {
+        return 0.0;
+    }
+
+    target = ucs_max((ucx_perf_counter_t)(hist->count * (rank / 100.0)), 1);
+    if (target >= hist->count) {
+        return hist->max * hist->unit;
+    }
+
+    sum = 0;
+    for (i = 0; i < UCX_PERF_HIST_NUM_BUCKETS; ++i) {
+        sum += hist->buckets[i];
+        if (sum >= target) {
+            break;
+        }
+    }
+
+    return ucx_perf_histogram_bucket_value(hist, i) * hist->unit;
+}
+
+void ucx_perf_histogram_bucket_range(const ucx_perf_histogram_t *hist,
+                                     unsigned index, double *low_p,
+                                     double *high_p)
+{
+    uint64_t low, high;
+
+    ucx_perf_histogram_bucket_bounds(index, &low, &high);
+    *low_p  = low * hist->unit;
+    *high_p = high * hist->unit;
+}
+
+static double ucx_perf_get_cpu_time()
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
 void ucx_perf_test_start_clock(ucx_perf_context_t *perf)
 {
     ucs_time_t start_time = ucs_get_time();
 
     perf->start_time_acc   = ucs_get_accurate_time();
+    perf->start_cpu_time   = ucx_perf_get_cpu_time();
     perf->end_time         = (perf->params.max_time == 0.0) ? UINT64_MAX :
                               ucs_time_from_sec(perf->params.max_time) + start_time;
     perf->prev_time        = start_time;
     perf->prev.time        = start_time;
     perf->prev.time_acc    = perf->start_time_acc;
     perf->current.time_acc = perf->start_time_acc;
+
+    /* The same arrival times in every run */
+    perf->sched.next       = start_time;
+    perf->sched.interval   = ucx_perf_is_open_loop(&perf->params) ?
+                             ucs_time_from_sec(1.0) / perf->params.rate : 0;
+    perf->sched.seed[0]    = 0x330e;
+    perf->sched.seed[1]    = 0xabcd;
+    perf->sched.seed[2]    = 0x1234;
+}
+
+static double ucx_perf_latency_factor(const ucx_perf_context_t *perf)
+{
+    /* open-loop latency is the whole response time of a request */
+    if (ucx_perf_is_open_loop(&perf->params)) {
+        return 1.0;
+    }
+
+    /* ping-pong iteration is a round trip */
+    if ((perf->params.test_type == UCX_PERF_TEST_TYPE_PINGPONG) ||
+        (perf->params.test_type == UCX_PERF_TEST_TYPE_PINGPONG_WAIT_MEM)) {
+        return 2.0;
+    }
+
+    return 1.0;
 }
 
 /* Initialize/reset all parameters that could be modified by the warm-up run */
@@ -224,30 +365,29 @@ void ucx_perf_test_prepare_new_run(ucx_perf_context_t *perf,
     for (i = 0; i < TIMING_QUEUE_SIZE; ++i) {
         perf->timing_queue[i] = 0;
     }
+    memset(&perf->group, 0, sizeof(perf->group));
+    ucx_perf_histogram_reset(&perf->histogram,
+                             ucs_time_to_sec(1) /
+                             ucx_perf_latency_factor(perf));
     ucx_perf_test_start_clock(perf);
 }
 
 void ucx_perf_calc_result(ucx_perf_context_t *perf, ucx_perf_result_t *result)
 {
+    double factor = ucx_perf_latency_factor(perf);
     ucs_time_t percentile;
-    double factor;
-
-    if ((perf->params.test_type == UCX_PERF_TEST_TYPE_PINGPONG) ||
-        (perf->params.test_type == UCX_PERF_TEST_TYPE_PINGPONG_WAIT_MEM)) {
-        factor = 2.0;
-    } else {
-        factor = 1.0;
-    }
 
     result->iters = perf->current.iters;
     result->bytes = perf->current.bytes;
     result->elapsed_time = perf->current.time_acc - perf->start_time_acc;
+    result->cpu_time     = ucx_perf_get_cpu_time() - perf->start_cpu_time;
 
     /* Latency */
     percentile = __find_percentile_quick_select(perf->timing_queue,
                                                 ucs_min(TIMING_QUEUE_SIZE, perf->current.iters),
                                                 perf->params.percentile_rank);
     result->latency.percentile = ucs_time_to_sec(percentile) / factor;
+    result->latency_histogram  = &perf->histogram;
 
     result->latency.moment_average =
         (perf->current.time_acc - perf->prev.time_acc)
@@ -285,6 +425,29 @@ void ucx_perf_calc_result(ucx_perf_context_t *perf, ucx_perf_result_t *result)
         perf->current.msgs /
         (perf->current.time_acc - perf->start_time_acc) * factor;
 
+
+    /* Group receive statistics */
+
+    if (perf->group.flows == 0) {
+        memset(&result->group, 0, sizeof(result->group));
+        return;
+    }
+
+    result->group.flows            = perf->group.flows;
+    result->group.bandwidth        = perf->group.rx_bytes /
+                                     perf->group.elapsed_time;
+    result->group.msgrate          = perf->group.rx_msgs /
+                                     perf->group.elapsed_time;
+    result->group.fairness         = (perf->group.flow_msgrate_sum *
+                                      perf->group.flow_msgrate_sum) /
+                                     (perf->group.flows *
+                                      perf->group.flow_msgrate_sq);
+    result->group.min_flow_msgrate = perf->group.flow_msgrate_min;
+    result->group.max_flow_msgrate = perf->group.flow_msgrate_max;
+    result->group.progress_calls   = (double)perf->group.progress_calls /
+                                     perf->group.rx_msgs;
+    result->group.progress_time    = perf->group.progress_time /
+                                     perf->group.rx_msgs;
 }
 
 static ucs_status_t ucx_perf_test_check_params(ucx_perf_params_t *params)
@@ -316,6 +479,18 @@ static ucs_status_t ucx_perf_test_check_params(ucx_perf_params_t *params)
         return UCS_ERR_INVALID_PARAM;
     }
 
+    /* the responder does not know the schedule, so a time limit could stop
+     * it before the last request */
+    if (ucx_perf_is_open_loop(params) &&
+        ((params->test_type != UCX_PERF_TEST_TYPE_PINGPONG) ||
+         (params->thread_count > 1) || (params->max_time != 0.0))) {
+        if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+            ucs_error("open-loop rate is supported only by single-thread "
+                      "ping-pong tests without time limit");
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     /* check if particular message size fit into stride size */
     if (params->iov_stride) {
         for (it = 0; it < params->msg_size_cnt; ++it) {
@@ -382,7 +557,8 @@ static inline uint64_t __get_flag(uct_perf_data_layout_t layout, uint64_t short_
                                   uint64_t bcopy_f, uint64_t zcopy_f)
 {
     return ((layout == UCT_PERF_DATA_LAYOUT_SHORT) ||
-            (layout == UCT_PERF_DATA_LAYOUT_SHORT_IOV)) ? short_f :
+            (layout == UCT_PERF_DATA_LAYOUT_SHORT_IOV) ||
+            (layout == UCT_PERF_DATA_LAYOUT_SHORT_BATCH)) ? short_f :
            (layout == UCT_PERF_DATA_LAYOUT_BCOPY) ? bcopy_f :
            (layout == UCT_PERF_DATA_LAYOUT_ZCOPY) ? zcopy_f :
            0;
@@ -405,7 +581,8 @@ static inline size_t __get_max_size(uct_perf_data_layout_t layout, size_t short_
                                     size_t bcopy_m, uint64_t zcopy_m)
 {
     return ((layout == UCT_PERF_DATA_LAYOUT_SHORT) ||
-            (layout == UCT_PERF_DATA_LAYOUT_SHORT_IOV)) ? short_m :
+            (layout == UCT_PERF_DATA_LAYOUT_SHORT_IOV) ||
+            (layout == UCT_PERF_DATA_LAYOUT_SHORT_BATCH)) ? short_m :
            (layout == UCT_PERF_DATA_LAYOUT_BCOPY) ? bcopy_m :
            (layout == UCT_PERF_DATA_LAYOUT_ZCOPY) ? zcopy_m :
            0;
@@ -519,6 +696,17 @@ static ucs_status_t uct_perf_test_check_capabilities(ucx_perf_params_t *params,
         return status;
     }
 
+    /* in-flight open-loop requests must have distinct sequence numbers */
+    if (ucx_perf_is_open_loop(params) &&
+        (params->max_outstanding > UCT_PERF_OPEN_LOOP_MAX_WINDOW)) {
+        if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+            ucs_error("open-loop window (%u) is larger than max supported "
+                      "(%u)", params->max_outstanding,
+                      UCT_PERF_OPEN_LOOP_MAX_WINDOW);
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     /* check atomics first */
     ATOMIC_OP_CHECK(32, attr.cap.atomic32.op_flags, atomic_op32, params, perf_atomic_op);
     ATOMIC_OP_CHECK(64, attr.cap.atomic64.op_flags, atomic_op64, params, perf_atomic_op);
@@ -553,7 +741,8 @@ static ucs_status_t uct_perf_test_check_capabilities(ucx_perf_params_t *params,
     }
 
     if (params->command == UCX_PERF_CMD_AM) {
-        if ((params->uct.data_layout == UCT_PERF_DATA_LAYOUT_SHORT) &&
+        if (((params->uct.data_layout == UCT_PERF_DATA_LAYOUT_SHORT) ||
+             (params->uct.data_layout == UCT_PERF_DATA_LAYOUT_SHORT_BATCH)) &&
             (params->uct.am_hdr_size != sizeof(uint64_t))) {
             if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
                 ucs_error("Short AM header size must be 8 bytes");
@@ -588,6 +777,16 @@ static ucs_status_t uct_perf_test_check_capabilities(ucx_perf_params_t *params,
             return UCS_ERR_INVALID_PARAM;
         }
 
+        if ((params->uct.data_layout == UCT_PERF_DATA_LAYOUT_SHORT_BATCH) &&
+            ((params->batch_size == 0) ||
+             (params->batch_size > UCX_PERF_TEST_MAX_BATCH_SIZE))) {
+            if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+                ucs_error("Batch size (%u) should be between 1 and %d",
+                          params->batch_size, UCX_PERF_TEST_MAX_BATCH_SIZE);
+            }
+            return UCS_ERR_INVALID_PARAM;
+        }
+
         if ((params->flags & UCX_PERF_TEST_FLAG_ONE_SIDED) &&
             (params->flags & UCX_PERF_TEST_FLAG_VERBOSE))
         {
@@ -927,6 +1126,56 @@ static ucs_status_t ucp_perf_test_fill_params(ucx_perf_params_t *params,
         ucp_params->features |= UCP_FEATURE_AM;
     }
 
+    if ((params->flags & UCX_PERF_TEST_FLAG_AM_BATCH) &&
+        ((params->command != UCX_PERF_CMD_AM) ||
+         (params->test_type != UCX_PERF_TEST_TYPE_STREAM_UNI) ||
+         (params->batch_size == 0))) {
+        if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+            ucs_error("AM batch mode requires am stream test and non-zero "
+                      "batch size");
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if ((params->flags & UCX_PERF_TEST_FLAG_STREAM_COALESCE) &&
+        ((params->command != UCX_PERF_CMD_STREAM) ||
+         (params->flags & UCX_PERF_TEST_FLAG_STREAM_RECV_DATA))) {
+        if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+            ucs_error("stream send coalescing requires stream test with recv "
+                      "receive mode");
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (ucx_perf_is_group_test(params) &&
+        (((params->command != UCX_PERF_CMD_TAG) &&
+          (params->command != UCX_PERF_CMD_AM)) ||
+         (params->thread_count > 1) || (params->max_time != 0.0) ||
+         (params->ucp.am_hdr_size != 0) || params->ucp.is_daemon_mode ||
+         (params->flags & (UCX_PERF_TEST_FLAG_LOOPBACK |
+                           UCX_PERF_TEST_FLAG_AM_BATCH |
+                           UCX_PERF_TEST_FLAG_TAG_UNEXP_PROBE)))) {
+        if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+            ucs_error("incast and all-to-all tests support only single-thread"
+                      " tag and AM tests, without time limit, loopback, AM"
+                      " header, AM batch, tag probe or daemon");
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (ucx_perf_is_open_loop(params) &&
+        (((params->command != UCX_PERF_CMD_TAG) &&
+          (params->command != UCX_PERF_CMD_AM)) ||
+         params->ucp.is_daemon_mode ||
+         (params->flags & (UCX_PERF_TEST_FLAG_AM_BATCH |
+                           UCX_PERF_TEST_FLAG_TAG_UNEXP_PROBE)))) {
+        if (params->flags & UCX_PERF_TEST_FLAG_VERBOSE) {
+            ucs_error("open-loop rate supports only tag and AM tests, without"
+                      " AM batch, tag probe or daemon");
+        }
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     status = ucx_perf_test_check_params(params);
     if (status != UCS_OK) {
         return status;
@@ -1002,6 +1251,30 @@ static void ucp_perf_test_destroy_self_eps(ucx_perf_context_t *perf)
     ucp_perf_release_requests_in_progress(perf, reqs, num_in_prog);
 }
 
+static void ucp_perf_test_destroy_peer_eps(ucx_perf_context_t *perf)
+{
+    unsigned group_size    = rte_call(perf, group_size);
+    unsigned num_in_prog   = 0;
+    ucs_status_ptr_t *reqs = ucs_alloca(group_size * sizeof(*reqs));
+    ucs_status_ptr_t req;
+    unsigned i;
+
+    if (perf->ucp.peer_eps == NULL) {
+        return;
+    }
+
+    for (i = 0; i < group_size; ++i) {
+        req = ucp_perf_test_destroy_ep(perf->ucp.peer_eps[i], 0);
+        if (req != NULL) {
+            reqs[num_in_prog++] = req;
+        }
+    }
+
+    ucp_perf_release_requests_in_progress(perf, reqs, num_in_prog);
+    free(perf->ucp.peer_eps);
+    perf->ucp.peer_eps = NULL;
+}
+
 static void ucp_perf_test_destroy_eps(ucx_perf_context_t *perf)
 {
     unsigned thread_count  = perf->params.thread_count;
@@ -1020,6 +1293,7 @@ static void ucp_perf_test_destroy_eps(ucx_perf_context_t *perf)
     }
 
     ucp_perf_release_requests_in_progress(perf, reqs, num_in_prog);
+    ucp_perf_test_destroy_peer_eps(perf);
 }
 
 static ucs_status_t
@@ -1055,6 +1329,15 @@ static void ucp_perf_test_err_handler(void *arg, ucp_ep_h ep,
     exit(EXIT_FAILURE);
 }
 
+static void ucp_perf_test_set_ep_flags(const ucx_perf_params_t *params,
+                                       ucp_ep_params_t *ep_params)
+{
+    if (params->flags & UCX_PERF_TEST_FLAG_STREAM_COALESCE) {
+        ep_params->field_mask |= UCP_EP_PARAM_FIELD_FLAGS;
+        ep_params->flags       = UCP_EP_PARAMS_FLAGS_STREAM_COALESCE;
+    }
+}
+
 static ucs_status_t ucp_perf_test_rkey_pack(ucx_perf_context_t *perf,
                                             uint64_t features,
                                             void **rkey_buffer,
@@ -1180,6 +1463,7 @@ static ucs_status_t ucp_perf_test_receive_remote_data(ucx_perf_context_t *perf,
             ep_params.err_mode        = UCP_ERR_HANDLING_MODE_PEER;
         }
 
+        ucp_perf_test_set_ep_flags(&perf->params, &ep_params);
         status = UCX_PERF_VERBOSE(error, &perf->params, ucp_ep_create,
                                   perf->ucp.tctx[i].perf.ucp.worker, &ep_params,
                                   &perf->ucp.tctx[i].perf.ucp.ep);
@@ -1207,6 +1491,39 @@ err:
     return status;
 }
 
+/* Connect to every other process of the group */
+static ucs_status_t ucp_perf_test_connect_group(ucx_perf_context_t *perf)
+{
+    unsigned group_size  = rte_call(perf, group_size);
+    unsigned group_index = rte_call(perf, group_index);
+    ucs_status_t status;
+    unsigned i;
+
+    perf->ucp.peer_eps = calloc(group_size, sizeof(*perf->ucp.peer_eps));
+    if (perf->ucp.peer_eps == NULL) {
+        ucs_error("failed to allocate group endpoints array");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < group_size; ++i) {
+        if (i == group_index) {
+            continue;
+        }
+
+        status = ucp_perf_test_receive_remote_data(perf, i);
+        if (status != UCS_OK) {
+            ucp_perf_test_destroy_peer_eps(perf);
+            return status;
+        }
+
+        /* Group tests have a single thread and no remote keys */
+        perf->ucp.peer_eps[i]         = perf->ucp.tctx[0].perf.ucp.ep;
+        perf->ucp.tctx[0].perf.ucp.ep = NULL;
+    }
+
+    return UCS_OK;
+}
+
 static ucs_status_t ucp_perf_test_send_local_data(ucx_perf_context_t *perf,
                                                   uint64_t features)
 {
@@ -1547,6 +1864,7 @@ static ucs_status_t ucp_perf_test_setup_self_endpoints(ucx_perf_context_t *perf)
 
         ep_params.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
         ep_params.address    = worker_attr.address;
+        ucp_perf_test_set_ep_flags(&perf->params, &ep_params);
         status = UCX_PERF_VERBOSE(error, &perf->params, ucp_ep_create, worker,
                                   &ep_params, &thread_perf->ucp.self_ep);
         if (status != UCS_OK) {
@@ -1594,15 +1912,19 @@ static ucs_status_t ucp_perf_test_setup_endpoints(ucx_perf_context_t *perf,
     unsigned peer_index  = rte_peer_index(group_size, group_index);
     ucs_status_t status;
 
-    if ((perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
-        (group_size != 1)) {
+    if (ucx_perf_is_group_test(&perf->params)) {
+        if (group_size < 2) {
+            ucs_error("perftest group test requires at least 2 processes "
+                      "(actual group size: %u)", group_size);
+            return UCS_ERR_UNSUPPORTED;
+        }
+    } else if ((perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
+               (group_size != 1)) {
         ucs_error("perftest loopback requires group size to be 1 "
                   "(actual group size: %u)", group_size);
         return UCS_ERR_UNSUPPORTED;
-    }
-
-    if (!(perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
-        (group_size != 2)) {
+    } else if (!(perf->params.flags & UCX_PERF_TEST_FLAG_LOOPBACK) &&
+               (group_size != 2)) {
         ucs_error("perftest p2p requires group size to be exactly 2 "
                   "(actual group size: %u)", group_size);
         return UCS_ERR_UNSUPPORTED;
@@ -1621,7 +1943,11 @@ static ucs_status_t ucp_perf_test_setup_endpoints(ucx_perf_context_t *perf,
         }
 
         /* Receive remote peer's endpoints' data and connect to them */
-        status = ucp_perf_test_receive_remote_data(perf, peer_index);
+        if (ucx_perf_is_group_test(&perf->params)) {
+            status = ucp_perf_test_connect_group(perf);
+        } else {
+            status = ucp_perf_test_receive_remote_data(perf, peer_index);
+        }
         if (status != UCS_OK) {
             goto err;
         }
@@ -2056,8 +2382,9 @@ static ucs_status_t ucp_perf_setup(ucx_perf_context_t *perf)
         goto err;
     }
 
-    thread_count = perf->params.thread_count;
-    message_size = ucx_perf_get_message_size(&perf->params);
+    thread_count       = perf->params.thread_count;
+    message_size       = ucx_perf_get_message_size(&perf->params);
+    perf->ucp.peer_eps = NULL;
 
     status = ucp_perf_test_alloc_mem(perf);
     if (status != UCS_OK) {
@@ -2242,6 +2569,8 @@ ucs_status_t ucx_perf_run(const ucx_perf_params_t *params,
         /* Run test */
         status = ucx_perf_funcs[params->api].run(perf);
         ucx_perf_funcs[params->api].barrier(perf);
+        ucx_perf_histogram_gather(perf);
+        ucx_perf_group_stats_gather(perf);
         if (status == UCS_OK) {
             ucx_perf_calc_result(perf, result);
             perf->params.report_func(perf->params.rte_group, result,
@@ -2282,6 +2611,143 @@ unsigned rte_peer_index(unsigned group_size, unsigned group_index)
     return peer_index;
 }
 
+/* Histogram part which fits in a single RTE message */
+typedef struct {
+    double             unit;
+    ucx_perf_counter_t count;
+    uint64_t           min;
+    uint64_t           max;
+    ucx_perf_counter_t buckets[HIST_CHUNK_SIZE];
+} ucx_perf_histogram_chunk_t;
+
+/* Merge the histograms of all peers into the local one */
+void ucx_perf_histogram_gather(ucx_perf_context_t *perf)
+{
+    unsigned group_size         = rte_call(perf, group_size);
+    unsigned group_index        = rte_call(perf, group_index);
+    ucx_perf_histogram_t *local = &perf->histogram;
+    ucx_perf_histogram_chunk_t chunk;
+    ucx_perf_histogram_t *remote;
+    unsigned i, offset, length;
+    struct iovec vec[2];
+    void *req;
+
+    UCS_STATIC_ASSERT(ucs_offsetof(ucx_perf_histogram_t, buckets) ==
+                      ucs_offsetof(ucx_perf_histogram_chunk_t, buckets));
+
+    if (group_size <= 1) {
+        return;
+    }
+
+    if (ucx_perf_is_open_loop(&perf->params) && (group_index != 0)) {
+        /* Only the requester measures response times */
+        ucx_perf_histogram_reset(local, local->unit);
+    }
+
+    remote = calloc(group_size, sizeof(*remote));
+    if (remote == NULL) {
+        ucs_error("failed to allocate remote latency histograms");
+        return;
+    }
+
+    vec[0].iov_base = local;
+    vec[0].iov_len  = ucs_offsetof(ucx_perf_histogram_chunk_t, buckets);
+
+    /* RTE message size is limited, so send the buckets in parts */
+    for (offset = 0; offset < UCX_PERF_HIST_NUM_BUCKETS;
+         offset += HIST_CHUNK_SIZE) {
+        length          = ucs_min(HIST_CHUNK_SIZE,
+                                  UCX_PERF_HIST_NUM_BUCKETS - offset);
+        vec[1].iov_base = &local->buckets[offset];
+        vec[1].iov_len  = length * sizeof(local->buckets[0]);
+
+        req = NULL;
+        rte_call(perf, post_vec, vec, 2, &req);
+        rte_call(perf, exchange_vec, req);
+
+        for (i = 0; i < group_size; ++i) {
+            if (i == group_index) {
+                continue;
+            }
+
+            chunk.unit = 0;
+            rte_call(perf, recv, i, &chunk, sizeof(chunk), req);
+            if (chunk.unit == 0) {
+                continue; /* not a peer of this process */
+            }
+
+            remote[i].unit  = chunk.unit;
+            remote[i].count = chunk.count;
+            remote[i].min   = chunk.min;
+            remote[i].max   = chunk.max;
+            memcpy(&remote[i].buckets[offset], chunk.buckets,
+                   length * sizeof(chunk.buckets[0]));
+        }
+    }
+
+    for (i = 0; i < group_size; ++i) {
+        if (remote[i].unit != 0) {
+            ucx_perf_histogram_merge(local, &remote[i]);
+        }
+    }
+
+    free(remote);
+}
+
+/* Sum the group test statistics of all processes */
+void ucx_perf_group_stats_gather(ucx_perf_context_t *perf)
+{
+    unsigned group_size           = rte_call(perf, group_size);
+    unsigned group_index          = rte_call(perf, group_index);
+    ucx_perf_group_stats_t *total = &perf->group;
+    ucx_perf_group_stats_t local  = perf->group;
+    ucx_perf_group_stats_t remote;
+    struct iovec vec;
+    void *req = NULL;
+    unsigned i;
+
+    if (!ucx_perf_is_group_test(&perf->params)) {
+        return;
+    }
+
+    vec.iov_base = &local;
+    vec.iov_len  = sizeof(local);
+    rte_call(perf, post_vec, &vec, 1, &req);
+    rte_call(perf, exchange_vec, req);
+
+    for (i = 0; i < group_size; ++i) {
+        if (i == group_index) {
+            continue;
+        }
+
+        /* RTEs which do not connect all processes leave it unchanged */
+        remote.flows = 0;
+        rte_call(perf, recv, i, &remote, sizeof(remote), req);
+        if (remote.flows == 0) {
+            continue;
+        }
+
+        if (total->flows == 0) {
+            *total = remote;
+            continue;
+        }
+
+        total->rx_msgs          += remote.rx_msgs;
+        total->rx_bytes         += remote.rx_bytes;
+        total->progress_calls   += remote.progress_calls;
+        total->progress_time    += remote.progress_time;
+        total->elapsed_time      = ucs_max(total->elapsed_time,
+                                           remote.elapsed_time);
+        total->flows            += remote.flows;
+        total->flow_msgrate_sum += remote.flow_msgrate_sum;
+        total->flow_msgrate_sq  += remote.flow_msgrate_sq;
+        total->flow_msgrate_min  = ucs_min(total->flow_msgrate_min,
+                                           remote.flow_msgrate_min);
+        total->flow_msgrate_max  = ucs_max(total->flow_msgrate_max,
+                                           remote.flow_msgrate_max);
+    }
+}
+
 void ucx_perf_report(ucx_perf_context_t *perf)
 {
     ucx_perf_result_t result;
@@ -15,6 +15,7 @@ BEGIN_C_DECLS
 
 /** @file libperf_int.h */
 
+#include <ucs/arch/bitops.h>
 #include <ucs/async/async.h>
 #include <ucs/time/time.h>
 #include <ucs/sys/math.h>
@@ -24,11 +25,16 @@ BEGIN_C_DECLS
 #include <omp.h>
 #endif
 
+#include <math.h>
+#include <stdlib.h>
+
 
 #define TIMING_QUEUE_SIZE    2048
 #define UCT_PERF_TEST_AM_ID  5
 #define ADDR_BUF_SIZE        4096
 #define EXTRA_INFO_SIZE      256
+#define HIST_CHUNK_SIZE      128 /* histogram buckets per RTE message */
+#define UCT_PERF_OPEN_LOOP_MAX_WINDOW 127 /* in-flight limit by 8-bit psn */
 
 #define UCX_PERF_TEST_FOREACH(perf) \
     while (!ucx_perf_context_done(perf))
@@ -74,6 +80,21 @@ typedef struct {
     size_t length;
 } ucx_perf_exported_mem_t;
 
+/* Receive statistics of incast and all-to-all tests. Every process fills its
+ * own values, and then they are summed over the whole group. */
+typedef struct {
+    ucx_perf_counter_t rx_msgs;          /* Received messages */
+    ucx_perf_counter_t rx_bytes;         /* Received bytes */
+    ucx_perf_counter_t progress_calls;   /* Progress calls by receivers */
+    double             progress_time;    /* Time in progress by receivers */
+    double             elapsed_time;     /* Time to receive all messages */
+    unsigned           flows;            /* Flows with received data */
+    double             flow_msgrate_sum; /* Sum of flow message rates */
+    double             flow_msgrate_sq;  /* Sum of squared flow msgrates */
+    double             flow_msgrate_min;
+    double             flow_msgrate_max;
+} ucx_perf_group_stats_t;
+
 struct ucx_perf_context {
     ucx_perf_params_t            params;
 
@@ -83,6 +104,7 @@ struct ucx_perf_context {
 
     /* Measurements */
     double                       start_time_acc;  /* accurate start time */
+    double                       start_cpu_time;  /* process CPU time at start */
     ucs_time_t                   end_time;        /* inaccurate end time (upper bound) */
     ucs_time_t                   prev_time;       /* time of previous iteration */
     ucs_time_t                   report_interval; /* interval of showing report */
@@ -99,6 +121,15 @@ struct ucx_perf_context {
 
     ucs_time_t                   timing_queue[TIMING_QUEUE_SIZE];
     unsigned                     timing_queue_head;
+    ucx_perf_histogram_t         histogram; /* all iteration times of the run */
+    ucx_perf_group_stats_t       group;     /* incast/all-to-all statistics */
+
+    /* Open-loop schedule, in ucs_time_t units kept as double to avoid drift */
+    struct {
+        double                   interval; /* mean time between operations */
+        double                   next;     /* intended time of next operation */
+        unsigned short           seed[3];  /* state of Poisson arrivals */
+    } sched;
 
     const ucx_perf_allocator_t   *send_allocator;
     const ucx_perf_allocator_t   *recv_allocator;
@@ -136,6 +167,8 @@ struct ucx_perf_context {
             ucp_ep_h                   self_ep;
             ucp_rkey_h                 self_send_rkey;
             ucp_rkey_h                 self_recv_rkey;
+            ucp_ep_h                   *peer_eps; /* Endpoint to every group
+                                                     member in group tests */
         } ucp;
     };
 };
@@ -196,6 +229,10 @@ size_t ucx_perf_get_message_size(const ucx_perf_params_t *params);
 
 void ucx_perf_report(ucx_perf_context_t *perf);
 
+void ucx_perf_histogram_gather(ucx_perf_context_t *perf);
+
+void ucx_perf_group_stats_gather(ucx_perf_context_t *perf);
+
 ucs_status_t ucx_perf_allocators_init_thread(ucx_perf_context_t *perf);
 
 static UCS_F_ALWAYS_INLINE int ucx_perf_context_done(ucx_perf_context_t *perf)
@@ -204,6 +241,43 @@ static UCS_F_ALWAYS_INLINE int ucx_perf_context_done(ucx_perf_context_t *perf)
                         (perf->current.time  > perf->end_time));
 }
 
+/* Whether every process of the group exchanges data with several peers */
+static inline int ucx_perf_is_group_test(const ucx_perf_params_t *params)
+{
+    return (params->test_type == UCX_PERF_TEST_TYPE_INCAST) ||
+           (params->test_type == UCX_PERF_TEST_TYPE_ALLTOALL);
+}
+
+/* Whether operations are issued on a schedule instead of by completions */
+static inline int ucx_perf_is_open_loop(const ucx_perf_params_t *params)
+{
+    return params->rate > 0;
+}
+
+/* Intended time of the next open-loop operation */
+static UCS_F_ALWAYS_INLINE ucs_time_t
+ucx_perf_sched_peek(const ucx_perf_context_t *perf)
+{
+    return (ucs_time_t)perf->sched.next;
+}
+
+/* Take the intended time of the next open-loop operation */
+static UCS_F_ALWAYS_INLINE ucs_time_t
+ucx_perf_sched_next(ucx_perf_context_t *perf)
+{
+    ucs_time_t time = ucx_perf_sched_peek(perf);
+
+    if (perf->params.flags & UCX_PERF_TEST_FLAG_RATE_POISSON) {
+        /* Exponentially distributed time between operations */
+        perf->sched.next -= perf->sched.interval *
+                            log(1.0 - erand48(perf->sched.seed));
+    } else {
+        perf->sched.next += perf->sched.interval;
+    }
+
+    return time;
+}
+
 static inline void ucx_perf_get_time(ucx_perf_context_t *perf)
 {
     perf->current.time_acc = ucs_get_accurate_time();
@@ -218,6 +292,36 @@ static inline void ucx_perf_omp_barrier(ucx_perf_context_t *perf)
 #endif
 }
 
+static UCS_F_ALWAYS_INLINE unsigned ucx_perf_histogram_index(uint64_t value)
+{
+    unsigned msb;
+
+    if (value < UCS_BIT(UCX_PERF_HIST_SUB_BITS)) {
+        return value;
+    }
+
+    msb = ucs_ilog2(value);
+    if (ucs_unlikely(msb >= UCX_PERF_HIST_MAX_BITS)) {
+        return UCX_PERF_HIST_NUM_BUCKETS - 1;
+    }
+
+    /* bucket group by the most significant bit, then the next SUB_BITS bits
+     * select the bucket inside the group */
+    return ((msb - UCX_PERF_HIST_SUB_BITS + 1) << UCX_PERF_HIST_SUB_BITS) +
+           ((value >> (msb - UCX_PERF_HIST_SUB_BITS)) &
+            UCS_MASK(UCX_PERF_HIST_SUB_BITS));
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucx_perf_histogram_record(ucx_perf_histogram_t *hist, uint64_t value,
+                          ucx_perf_counter_t count)
+{
+    hist->buckets[ucx_perf_histogram_index(value)] += count;
+    hist->count                                    += count;
+    hist->min = ucs_min(hist->min, value);
+    hist->max = ucs_max(hist->max, value);
+}
+
 static UCS_F_ALWAYS_INLINE void ucx_perf_update(ucx_perf_context_t *perf,
                                                 ucx_perf_counter_t iters,
                                                 size_t bytes)
@@ -229,6 +333,8 @@ static UCS_F_ALWAYS_INLINE void ucx_perf_update(ucx_perf_context_t *perf,
 
     perf->timing_queue[perf->timing_queue_head] =
                     perf->current.time - perf->prev_time;
+    ucx_perf_histogram_record(&perf->histogram,
+                              perf->timing_queue[perf->timing_queue_head], 1);
     ++perf->timing_queue_head;
     if (perf->timing_queue_head == TIMING_QUEUE_SIZE) {
         perf->timing_queue_head = 0;
@@ -242,6 +348,16 @@ static UCS_F_ALWAYS_INLINE void ucx_perf_update(ucx_perf_context_t *perf,
     }
 }
 
+/* Complete an open-loop operation. Its latency is counted from the time it
+ * was supposed to be sent, so a late send due to a backlog is not hidden. */
+static UCS_F_ALWAYS_INLINE void
+ucx_perf_update_scheduled(ucx_perf_context_t *perf, ucx_perf_counter_t iters,
+                          size_t bytes, ucs_time_t sched_time)
+{
+    perf->prev_time = sched_time;
+    ucx_perf_update(perf, iters, bytes);
+}
+
 END_C_DECLS
 
 #endif
@@ -64,6 +64,7 @@ static void ucx_perf_thread_report_aggregated_results(ucx_perf_context_t *perf)
     agg_result.iters        = tctx[0].result.iters;
     agg_result.bytes        = tctx[0].result.bytes;
     agg_result.elapsed_time = tctx[0].result.elapsed_time;
+    agg_result.cpu_time     = tctx[0].result.cpu_time;
 
     agg_result.bandwidth.total_average  = 0.0;
     agg_result.bandwidth.percentile     = 0.0; /* Undefined since used only for latency calculations */
@@ -77,6 +78,7 @@ static void ucx_perf_thread_report_aggregated_results(ucx_perf_context_t *perf)
     agg_result.bandwidth.moment_average = 0.0;
     agg_result.latency.moment_average   = 0.0;
     agg_result.latency.percentile       = 0.0;
+    memset(&agg_result.group, 0, sizeof(agg_result.group)); /* Not a group test */
 
     /* in case of multiple threads, we have to aggregate the results so that the
      * final output of the result would show the performance numbers that were
@@ -93,6 +95,14 @@ static void ucx_perf_thread_report_aggregated_results(ucx_perf_context_t *perf)
 
     agg_result.latency.total_average = lat_sum_total_avegare / thread_count;
 
+    /* latency distribution of all threads, and of all peers */
+    ucx_perf_histogram_reset(&perf->histogram, tctx[0].perf.histogram.unit);
+    for (i = 0; i < thread_count; i++) {
+        ucx_perf_histogram_merge(&perf->histogram, &tctx[i].perf.histogram);
+    }
+    ucx_perf_histogram_gather(perf);
+    agg_result.latency_histogram = &perf->histogram;
+
     perf->params.report_func(perf->params.rte_group, &agg_result,
                              perf->params.report_arg, "", 1, 1);
 }
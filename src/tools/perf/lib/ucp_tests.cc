@@ -13,6 +13,8 @@
 
 #include "libperf_int.h"
 
+#include <ucp/api/ucpx.h>
+
 #include <ucs/sys/preprocessor.h>
 #include <ucs/sys/string.h>
 #include <limits>
@@ -27,17 +29,35 @@ public:
     static const ucp_tag_t TAG      = 0x1337a880u;
     static const ucp_tag_t TAG_MASK = (FLAGS & UCX_PERF_TEST_FLAG_TAG_WILDCARD) ?
                                       0 : (ucp_tag_t)-1;
+    static const unsigned GROUP_TAG_SHIFT = 32; /* Sender index in the tag */
     static const psn_t INITIAL_SN   = 0;
     static const psn_t LAST_ITER_SN = 1;
     static const psn_t UNKNOWN_SN   = std::numeric_limits<psn_t>::max();
 
+    /* Block size of the generic datatype */
+    static const size_t GENERIC_DT_BLOCK = 64;
+
+    /* Pack/unpack state of the generic datatype */
+    typedef struct {
+        uint8_t *buffer;
+        size_t  length;
+        size_t  stride;
+    } generic_dt_state_t;
+
     ucp_perf_test_runner(ucx_perf_context_t &perf) :
         m_perf(perf),
         m_recvs_outstanding(0),
         m_sends_outstanding(0),
         m_max_outstanding(m_perf.params.max_outstanding),
         m_am_rx_buffer(NULL),
-        m_am_rx_length(0ul)
+        m_am_rx_length(0ul),
+        m_am_batch(NULL),
+        m_generic_dt(0),
+        m_group_index(0),
+        m_peer_rx_msgs(NULL),
+        m_peer_rx_time(NULL),
+        m_progress_calls(0),
+        m_progress_time(0)
     {
         memset(&m_am_rx_params, 0, sizeof(m_am_rx_params));
         memset(&m_send_params, 0, sizeof(m_send_params));
@@ -67,6 +87,12 @@ public:
 
     ~ucp_perf_test_runner()
     {
+        free(m_peer_rx_time);
+        free(m_peer_rx_msgs);
+        free(m_am_batch);
+        if (m_generic_dt != 0) {
+            ucp_dt_destroy(m_generic_dt);
+        }
         set_am_handler(UCP_PERF_DAEMON_AM_ID_RECV_CMPL, NULL, NULL, 0);
         set_am_handler(UCP_PERF_DAEMON_AM_ID_SEND_CMPL, NULL, NULL, 0);
         set_am_handler(AM_ID, NULL, NULL, 0);
@@ -116,6 +142,133 @@ public:
         }
     }
 
+    /* Copy between a packed stream and a buffer which is split to blocks of
+     * GENERIC_DT_BLOCK bytes. Packed block i is buffer block (i * stride) mod
+     * num_blocks, and the remainder after the last full block is copied as
+     * is. */
+    static void generic_dt_copy(const generic_dt_state_t *state, size_t offset,
+                                void *packed, size_t length, bool pack)
+    {
+        size_t num_blocks = state->length / GENERIC_DT_BLOCK;
+        size_t block, block_offset, buffer_offset, chunk;
+
+        while (length > 0) {
+            block = offset / GENERIC_DT_BLOCK;
+            if (block < num_blocks) {
+                block_offset  = offset % GENERIC_DT_BLOCK;
+                buffer_offset = ((block * state->stride) % num_blocks) *
+                                GENERIC_DT_BLOCK + block_offset;
+                chunk         = ucs_min(GENERIC_DT_BLOCK - block_offset,
+                                        length);
+            } else {
+                buffer_offset = offset;
+                chunk         = length;
+            }
+
+            if (pack) {
+                memcpy(packed, state->buffer + buffer_offset, chunk);
+            } else {
+                memcpy(state->buffer + buffer_offset, packed, chunk);
+            }
+
+            packed  = UCS_PTR_BYTE_OFFSET(packed, chunk);
+            offset += chunk;
+            length -= chunk;
+        }
+    }
+
+    static void *generic_dt_start(const void *buffer, size_t count)
+    {
+        size_t num_blocks = count / GENERIC_DT_BLOCK;
+        generic_dt_state_t *state;
+
+        state = (generic_dt_state_t*)malloc(sizeof(*state));
+        ucs_assert_always(state != NULL);
+
+        state->buffer = (uint8_t*)buffer;
+        state->length = count;
+
+        /* Smallest odd stride which visits every block exactly once */
+        state->stride = 3;
+        while ((num_blocks > 1) && (gcd(state->stride, num_blocks) != 1)) {
+            state->stride += 2;
+        }
+
+        return state;
+    }
+
+    static size_t gcd(size_t a, size_t b)
+    {
+        size_t t;
+
+        while (b != 0) {
+            t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    static void *generic_dt_start_pack(void *context, const void *buffer,
+                                       size_t count)
+    {
+        return generic_dt_start(buffer, count);
+    }
+
+    static void *generic_dt_start_unpack(void *context, void *buffer,
+                                         size_t count)
+    {
+        return generic_dt_start(buffer, count);
+    }
+
+    static size_t generic_dt_packed_size(void *state)
+    {
+        return ((generic_dt_state_t*)state)->length;
+    }
+
+    static size_t generic_dt_pack(void *state, size_t offset, void *dest,
+                                  size_t max_length)
+    {
+        const generic_dt_state_t *dt_state = (generic_dt_state_t*)state;
+        size_t length = ucs_min(max_length, dt_state->length - offset);
+
+        generic_dt_copy(dt_state, offset, dest, length, true);
+        return length;
+    }
+
+    static ucs_status_t generic_dt_unpack(void *state, size_t offset,
+                                          const void *src, size_t length)
+    {
+        generic_dt_copy((generic_dt_state_t*)state, offset, (void*)src, length,
+                        false);
+        return UCS_OK;
+    }
+
+    static void generic_dt_finish(void *state)
+    {
+        free(state);
+    }
+
+    ucp_datatype_t get_generic_datatype()
+    {
+        ucp_generic_dt_ops_t ops;
+        ucs_status_t status;
+
+        if (m_generic_dt == 0) {
+            ops.start_pack   = generic_dt_start_pack;
+            ops.start_unpack = generic_dt_start_unpack;
+            ops.packed_size  = generic_dt_packed_size;
+            ops.pack         = generic_dt_pack;
+            ops.unpack       = generic_dt_unpack;
+            ops.finish       = generic_dt_finish;
+
+            status = ucp_dt_create_generic(&ops, NULL, &m_generic_dt);
+            ucs_assert_always(status == UCS_OK);
+        }
+
+        return m_generic_dt;
+    }
+
     ucp_datatype_t ucp_perf_test_get_datatype(ucp_perf_datatype_t datatype, ucp_dt_iov_t *iov,
                                               size_t *length, void **buffer_p)
     {
@@ -127,6 +280,8 @@ public:
             *buffer_p = iov;
             *length   = m_perf.params.msg_size_cnt;
             type      = ucp_dt_make_iov();
+        } else if (UCP_PERF_DATATYPE_GENERIC == datatype) {
+            type      = get_generic_datatype();
         }
         return type;
     }
@@ -190,6 +345,12 @@ public:
         m_recv_params.cb.recv      = tag_recv_cb;
         m_recv_params.user_data    = this;
         fill_common_params(m_recv_params, m_perf.ucp.recv_memh);
+
+        if (is_group_test() || ucx_perf_is_open_loop(&m_perf.params)) {
+            /* The sender is known only from the completion callback, and
+             * open-loop replies are counted by outstanding receives */
+            m_recv_params.op_attr_mask |= UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
+        }
     }
 
     void fill_send_params(ucp_request_param_t &params, void *reply_buffer,
@@ -203,7 +364,7 @@ public:
         params.cb.send      = cb;
         params.user_data    = this;
 
-        if (TYPE == UCX_PERF_TEST_TYPE_STREAM_UNI) {
+        if ((TYPE == UCX_PERF_TEST_TYPE_STREAM_UNI) || is_group_test()) {
             params.op_attr_mask |= UCP_OP_ATTR_FLAG_MULTI_SEND;
         }
 
@@ -223,7 +384,7 @@ public:
             params.memh          = memh;
         }
 
-        if (TYPE == UCX_PERF_TEST_TYPE_STREAM_UNI) {
+        if ((TYPE == UCX_PERF_TEST_TYPE_STREAM_UNI) || is_group_test()) {
             params.op_attr_mask |= UCP_OP_ATTR_FLAG_MULTI_SEND;
         }
     }
@@ -234,7 +395,7 @@ public:
         }
     }
 
-    void UCS_F_ALWAYS_INLINE progress() {
+    void UCS_F_ALWAYS_INLINE worker_progress() {
         if (ucs_unlikely(UCX_PERF_WAIT_MODE_SLEEP == m_perf.params.wait_mode)) {
             blocking_progress();
         } else {
@@ -242,6 +403,20 @@ public:
         }
     }
 
+    void UCS_F_ALWAYS_INLINE progress() {
+        ucs_time_t start;
+
+        if (is_group_test()) {
+            /* Measure the cost of the progress loop with many peers */
+            start = ucs_get_time();
+            worker_progress();
+            m_progress_time += ucs_get_time() - start;
+            ++m_progress_calls;
+        } else {
+            worker_progress();
+        }
+    }
+
     void UCS_F_ALWAYS_INLINE progress_responder() {
         if (!(FLAGS & UCX_PERF_TEST_FLAG_ONE_SIDED) &&
             !(m_perf.params.flags & UCX_PERF_TEST_FLAG_ONE_SIDED))
@@ -305,6 +480,10 @@ public:
                             const ucp_tag_recv_info_t *info, void *user_data)
     {
         ucp_perf_test_runner *test = (ucp_perf_test_runner*)user_data;
+
+        if (is_group_test()) {
+            test->group_recv(info->sender_tag >> GROUP_TAG_SHIFT);
+        }
         test->recv_completed();
         ucp_request_free(request);
     }
@@ -322,6 +501,11 @@ public:
     {
         ucp_perf_test_runner *test = (ucp_perf_test_runner*)arg;
 
+        if (is_group_test()) {
+            ucs_assert(header_length == sizeof(test->m_group_index));
+            test->group_recv(*(const uint32_t*)header);
+        }
+
         if (param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV) {
             return test->am_rndv_recv(data, length, param);
         }
@@ -391,6 +575,13 @@ public:
         --m_recvs_outstanding;
     }
 
+    void UCS_F_ALWAYS_INLINE group_recv(unsigned sender)
+    {
+        ucs_assert(sender < rte_call(&m_perf, group_size));
+        ++m_peer_rx_msgs[sender];
+        m_peer_rx_time[sender] = ucs_get_time();
+    }
+
     void UCS_F_ALWAYS_INLINE wait_send_window(unsigned n)
     {
         ucs_assert(m_sends_outstanding >= 0);
@@ -494,6 +685,51 @@ public:
         return UCS_PTR_STATUS(req);
     }
 
+    unsigned am_batch_size() const
+    {
+        if ((CMD != UCX_PERF_CMD_AM) ||
+            !(m_perf.params.flags & UCX_PERF_TEST_FLAG_AM_BATCH)) {
+            return 1;
+        }
+
+        /* The whole batch has to fit into the send window */
+        return ucs_min(m_perf.params.batch_size, (unsigned)m_max_outstanding);
+    }
+
+    void init_am_batch(ucp_ep_h ep, void *buffer, size_t length,
+                       unsigned batch_size)
+    {
+        unsigned i;
+
+        m_am_batch = (ucp_am_batch_entry_t*)calloc(batch_size,
+                                                   sizeof(*m_am_batch));
+        ucs_assert_always(m_am_batch != NULL);
+
+        for (i = 0; i < batch_size; ++i) {
+            m_am_batch[i].ep            = ep;
+            m_am_batch[i].id            = AM_ID;
+            m_am_batch[i].header        = m_perf.ucp.am_hdr;
+            m_am_batch[i].header_length = m_perf.params.ucp.am_hdr_size;
+            m_am_batch[i].buffer        = buffer;
+            m_am_batch[i].count         = length;
+        }
+    }
+
+    void UCS_F_ALWAYS_INLINE send_am_batch(unsigned count)
+    {
+        unsigned i;
+
+        wait_send_window(count);
+
+        ucp_am_send_nbx_batch(m_perf.ucp.worker, m_am_batch, count,
+                              &m_send_params);
+        for (i = 0; i < count; ++i) {
+            if (UCS_PTR_IS_PTR(m_am_batch[i].request)) {
+                send_started();
+            }
+        }
+    }
+
     ucs_status_t UCS_F_ALWAYS_INLINE
     send(ucp_ep_h ep, void *buffer, size_t length, ucp_datatype_t datatype,
          psn_t sn, uint64_t remote_addr, ucp_rkey_h rkey, bool get_info = false)
@@ -514,7 +750,10 @@ public:
         /* coverity[switch_selector_expr_is_constant] */
         switch (CMD) {
         case UCX_PERF_CMD_TAG:
-            request = ucp_tag_send_nbx(ep, buffer, length, TAG, param);
+            request = ucp_tag_send_nbx(ep, buffer, length,
+                                       TAG | ((ucp_tag_t)m_group_index <<
+                                              GROUP_TAG_SHIFT),
+                                       param);
             break;
         case UCX_PERF_CMD_TAG_SYNC:
             request = ucp_tag_send_sync_nbx(ep, buffer, length, TAG, param);
@@ -523,9 +762,16 @@ public:
             request = ucp_stream_send_nbx(ep, buffer, length, param);
             break;
         case UCX_PERF_CMD_AM:
-            request = ucp_am_send_nbx(ep, AM_ID, m_perf.ucp.am_hdr,
-                                      m_perf.params.ucp.am_hdr_size, buffer,
-                                      length, param);
+            if (is_group_test()) {
+                /* Let the receiver know the sender of the message */
+                request = ucp_am_send_nbx(ep, AM_ID, &m_group_index,
+                                          sizeof(m_group_index), buffer,
+                                          length, param);
+            } else {
+                request = ucp_am_send_nbx(ep, AM_ID, m_perf.ucp.am_hdr,
+                                          m_perf.params.ucp.am_hdr_size,
+                                          buffer, length, param);
+            }
             break;
         case UCX_PERF_CMD_PUT:
             /* coverity[switch_selector_expr_is_constant] */
@@ -591,7 +837,10 @@ public:
                     progress_responder();
                 }
             }
-            request = ucp_tag_recv_nbx(worker, buffer, length, TAG, TAG_MASK,
+            request = ucp_tag_recv_nbx(worker, buffer, length, TAG,
+                                       is_group_test() ?
+                                       (TAG_MASK & UCS_MASK(GROUP_TAG_SHIFT)) :
+                                       TAG_MASK,
                                        &m_recv_params);
             if (ucs_likely(!UCS_PTR_IS_PTR(request))) {
                 return UCS_PTR_STATUS(request);
@@ -766,6 +1015,12 @@ public:
         ucp_worker_fence(m_perf.ucp.worker);
     }
 
+    static inline bool is_group_test()
+    {
+        return (TYPE == UCX_PERF_TEST_TYPE_INCAST) ||
+               (TYPE == UCX_PERF_TEST_TYPE_ALLTOALL);
+    }
+
     inline bool is_atomic() const
     {
         return (CMD == UCX_PERF_CMD_ADD) || (CMD == UCX_PERF_CMD_FADD) ||
@@ -789,6 +1044,49 @@ public:
                  m_perf.ucp.self_recv_rkey);
     }
 
+    /* Send requests on the schedule, without waiting for the replies. The
+     * responder replies to every request in order, as in ping-pong. */
+    void run_open_loop_requester(ucp_worker_h worker, ucp_ep_h ep,
+                                 void *send_buffer, size_t send_length,
+                                 ucp_datatype_t send_datatype,
+                                 void *recv_buffer, size_t recv_length,
+                                 ucp_datatype_t recv_datatype, size_t length)
+    {
+        ucx_perf_counter_t posted    = 0;
+        ucx_perf_counter_t completed = 0;
+        ucs_time_t *sched_times;
+
+        sched_times = (ucs_time_t*)calloc(m_max_outstanding,
+                                          sizeof(*sched_times));
+        ucs_assert_always(sched_times != NULL);
+
+        UCX_PERF_TEST_FOREACH(&m_perf) {
+            /* A late request still counts from its intended time, and the
+             * window only limits the number of requests in flight */
+            if ((posted < m_perf.max_iter) &&
+                (m_recvs_outstanding < m_max_outstanding) &&
+                (ucs_get_time() >= ucx_perf_sched_peek(&m_perf))) {
+                sched_times[posted % m_max_outstanding] =
+                        ucx_perf_sched_next(&m_perf);
+                send(ep, send_buffer, send_length, send_datatype, 0, 0, NULL);
+                recv(worker, ep, recv_buffer, recv_length, recv_datatype, 0);
+                ++posted;
+            } else {
+                static ucs_time_t dbg_t; if (ucs_get_time() - dbg_t > ucs_time_from_sec(1.0)) { dbg_t = ucs_get_time(); fprintf(stderr, "DBG posted %lu completed %lu out %d max %d now %lu peek %lu iters %lu\n", (unsigned long)posted, (unsigned long)completed, m_recvs_outstanding, m_max_outstanding, (unsigned long)ucs_get_time(), (unsigned long)ucx_perf_sched_peek(&m_perf), (unsigned long)m_perf.current.iters); }
+                progress_requestor();
+            }
+
+            while (completed < (posted - m_recvs_outstanding)) {
+                ucx_perf_update_scheduled(&m_perf, 1, length,
+                                          sched_times[completed %
+                                                      m_max_outstanding]);
+                ++completed;
+            }
+        }
+
+        free(sched_times);
+    }
+
     ucs_status_t run_pingpong()
     {
         unsigned my_index;
@@ -823,7 +1121,11 @@ public:
 
         ucx_perf_omp_barrier(&m_perf);
 
-        if (my_index == 0) {
+        if ((my_index == 0) && ucx_perf_is_open_loop(&m_perf.params)) {
+            run_open_loop_requester(worker, ep, send_buffer, send_length,
+                                    send_datatype, recv_buffer, recv_length,
+                                    recv_datatype, length);
+        } else if (my_index == 0) {
             UCX_PERF_TEST_FOREACH(&m_perf) {
                 send(ep, send_buffer, send_length, send_datatype, sn, remote_addr, rkey);
                 recv(worker, ep, recv_buffer, recv_length, recv_datatype, sn);
@@ -856,6 +1158,7 @@ public:
     ucs_status_t run_stream_uni()
     {
         unsigned my_index;
+        unsigned batch_size, count;
         ucp_worker_h worker;
         ucp_ep_h ep;
         void *send_buffer, *recv_buffer;
@@ -911,11 +1214,26 @@ public:
         } else if (my_index == 1) {
             /* Sender may only receive final ack */
             m_am_rx_length = 1;
-            UCX_PERF_TEST_FOREACH(&m_perf) {
-                send(ep, send_buffer, send_length, send_datatype, sn,
-                     remote_addr, rkey, m_perf.current.iters == 0);
-                ucx_perf_update(&m_perf, 1, length);
-                ++sn;
+            batch_size     = am_batch_size();
+            if (batch_size > 1) {
+                init_am_batch(ep, send_buffer, send_length, batch_size);
+                UCX_PERF_TEST_FOREACH(&m_perf) {
+                    count = ucs_min(batch_size, m_perf.max_iter -
+                                                m_perf.current.iters);
+                    send_am_batch(count);
+                    /* Account every message of the batch, so the reported
+                     * message rate is comparable to non-batched sends */
+                    while (count-- > 0) {
+                        ucx_perf_update(&m_perf, 1, length);
+                    }
+                }
+            } else {
+                UCX_PERF_TEST_FOREACH(&m_perf) {
+                    send(ep, send_buffer, send_length, send_datatype, sn,
+                         remote_addr, rkey, m_perf.current.iters == 0);
+                    ucx_perf_update(&m_perf, 1, length);
+                    ++sn;
+                }
             }
 
             send_last_iter(ep, send_buffer, send_length, remote_addr, rkey);
@@ -932,6 +1250,121 @@ public:
         return UCS_OK;
     }
 
+    /* Fill the receive statistics of this process */
+    void group_stats(ucs_time_t start_time, size_t length)
+    {
+        ucx_perf_group_stats_t *stats = &m_perf.group;
+        unsigned group_size           = rte_call(&m_perf, group_size);
+        double flow_time, msgrate;
+        unsigned i;
+
+        memset(stats, 0, sizeof(*stats));
+        for (i = 0; i < group_size; ++i) {
+            if (m_peer_rx_msgs[i] == 0) {
+                continue;
+            }
+
+            /* The flow rate is measured until its last message arrived */
+            flow_time = ucs_time_to_sec(m_peer_rx_time[i] - start_time);
+            msgrate   = m_peer_rx_msgs[i] / flow_time;
+            if (stats->flows == 0) {
+                stats->flow_msgrate_min = msgrate;
+                stats->flow_msgrate_max = msgrate;
+            }
+
+            stats->rx_msgs          += m_peer_rx_msgs[i];
+            stats->elapsed_time      = ucs_max(stats->elapsed_time, flow_time);
+            stats->flow_msgrate_sum += msgrate;
+            stats->flow_msgrate_sq  += msgrate * msgrate;
+            stats->flow_msgrate_min  = ucs_min(stats->flow_msgrate_min,
+                                               msgrate);
+            stats->flow_msgrate_max  = ucs_max(stats->flow_msgrate_max,
+                                               msgrate);
+            ++stats->flows;
+        }
+
+        stats->rx_bytes       = stats->rx_msgs * length;
+        stats->progress_calls = m_progress_calls;
+        stats->progress_time  = ucs_time_to_sec(m_progress_time);
+    }
+
+    ucs_status_t run_group()
+    {
+        unsigned group_size = rte_call(&m_perf, group_size);
+        unsigned my_index   = rte_call(&m_perf, group_index);
+        unsigned num_peers  = group_size - 1;
+        bool is_sender, is_receiver;
+        ucp_worker_h worker;
+        void *send_buffer, *recv_buffer;
+        ucp_datatype_t send_datatype, recv_datatype;
+        size_t length, send_length, recv_length;
+        ucs_time_t start_time;
+        unsigned dest;
+
+        send_buffer = m_perf.send_buffer;
+        recv_buffer = m_perf.recv_buffer;
+        worker      = m_perf.ucp.worker;
+
+        ucp_perf_init_common_params(&length, &send_length, &send_datatype,
+                                    &send_buffer, &recv_length, &recv_datatype,
+                                    &recv_buffer);
+
+        m_group_index  = my_index;
+        m_peer_rx_msgs = (ucx_perf_counter_t*)calloc(group_size,
+                                                     sizeof(*m_peer_rx_msgs));
+        m_peer_rx_time = (ucs_time_t*)calloc(group_size,
+                                             sizeof(*m_peer_rx_time));
+        ucs_assert_always((m_peer_rx_msgs != NULL) &&
+                          (m_peer_rx_time != NULL));
+
+        /* In incast, the first process receives max_iter messages from
+         * every other process. In all-to-all, every process sends max_iter
+         * messages round-robin to the other ones, so it also receives
+         * max_iter messages. */
+        if (TYPE == UCX_PERF_TEST_TYPE_INCAST) {
+            is_sender   = (my_index != 0);
+            is_receiver = (my_index == 0);
+            if (is_receiver && (m_perf.max_iter != UINT64_MAX)) {
+                m_perf.max_iter *= num_peers;
+            }
+        } else {
+            is_sender   = true;
+            is_receiver = true;
+        }
+
+        ucp_perf_barrier(&m_perf);
+
+        ucx_perf_test_start_clock(&m_perf);
+        start_time = m_perf.prev_time;
+
+        UCX_PERF_TEST_FOREACH(&m_perf) {
+            if (is_sender) {
+                dest = (TYPE == UCX_PERF_TEST_TYPE_INCAST) ? 0 :
+                       (my_index + 1 + (m_perf.current.iters % num_peers)) %
+                       group_size;
+                send(m_perf.ucp.peer_eps[dest], send_buffer, send_length,
+                     send_datatype, 0, 0, NULL);
+            }
+
+            if (is_receiver) {
+                recv(worker, NULL, recv_buffer, recv_length, recv_datatype,
+                     0);
+            }
+
+            ucx_perf_update(&m_perf, 1, length);
+        }
+
+        wait_recv_window(m_max_outstanding);
+        wait_send_window(m_max_outstanding);
+        ucp_worker_flush(worker);
+
+        ucx_perf_get_time(&m_perf);
+        group_stats(start_time, length);
+
+        ucp_perf_barrier(&m_perf);
+        return UCS_OK;
+    }
+
     ucs_status_t run()
     {
         /* coverity[switch_selector_expr_is_constant] */
@@ -941,6 +1374,9 @@ public:
             return run_pingpong();
         case UCX_PERF_TEST_TYPE_STREAM_UNI:
             return run_stream_uni();
+        case UCX_PERF_TEST_TYPE_INCAST:
+        case UCX_PERF_TEST_TYPE_ALLTOALL:
+            return run_group();
         case UCX_PERF_TEST_TYPE_STREAM_BI:
         default:
             return UCS_ERR_INVALID_PARAM;
@@ -1029,6 +1465,18 @@ private:
     ucp_request_param_t m_send_get_info_params;
     ucp_request_param_t m_recv_params;
     ucp_atomic_op_t     m_atomic_op;
+    /* Entries of batched Active Message sends */
+    ucp_am_batch_entry_t *m_am_batch;
+    /* Generic datatype handle, or 0 if not created yet */
+    ucp_datatype_t       m_generic_dt;
+    /* Group tests: own index, which is sent with every message */
+    uint32_t             m_group_index;
+    /* Group tests: messages and last arrival time from every sender */
+    ucx_perf_counter_t   *m_peer_rx_msgs;
+    ucs_time_t           *m_peer_rx_time;
+    /* Group tests: number of progress calls and total time in them */
+    ucx_perf_counter_t   m_progress_calls;
+    ucs_time_t           m_progress_time;
 };
 
 
@@ -1063,6 +1511,13 @@ private:
               UCX_PERF_TEST_FLAG_TAG_WILDCARD|UCX_PERF_TEST_FLAG_TAG_UNEXP_PROBE, \
               UCX_PERF_TEST_FLAG_TAG_WILDCARD|UCX_PERF_TEST_FLAG_TAG_UNEXP_PROBE)
 
+/* Unexpected probe is not supported by group tests */
+#define TEST_CASE_ALL_GROUP_TAG(_perf, _case) \
+    TEST_CASE(_perf, UCS_PP_TUPLE_0 _case, UCS_PP_TUPLE_1 _case, \
+              0, UCX_PERF_TEST_FLAG_TAG_WILDCARD) \
+    TEST_CASE(_perf, UCS_PP_TUPLE_0 _case, UCS_PP_TUPLE_1 _case, \
+              UCX_PERF_TEST_FLAG_TAG_WILDCARD, UCX_PERF_TEST_FLAG_TAG_WILDCARD)
+
 #define TEST_CASE_ALL_OSD(_perf, _case) \
     TEST_CASE(_perf, UCS_PP_TUPLE_0 _case, UCS_PP_TUPLE_1 _case, \
               0, UCX_PERF_TEST_FLAG_ONE_SIDED) \
@@ -1116,13 +1571,27 @@ static ucs_status_t ucp_perf_dispatch_am(ucx_perf_context_t *perf)
     return UCS_ERR_INVALID_PARAM;
 }
 
+static ucs_status_t ucp_perf_dispatch_group(ucx_perf_context_t *perf)
+{
+    UCS_PP_FOREACH(TEST_CASE_ALL_GROUP_TAG, perf,
+                   (UCX_PERF_CMD_TAG, UCX_PERF_TEST_TYPE_INCAST),
+                   (UCX_PERF_CMD_TAG, UCX_PERF_TEST_TYPE_ALLTOALL)
+                   );
+    UCS_PP_FOREACH(TEST_CASE_ALL_AM, perf,
+                   (UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_INCAST),
+                   (UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_ALLTOALL)
+                   );
+    return UCS_ERR_INVALID_PARAM;
+}
+
 typedef ucs_status_t (*ucp_dispatch_func_t)(ucx_perf_context_t *perf);
 
 static ucp_dispatch_func_t dispatchers[] = {
     ucp_perf_dispatch_osd,
     ucp_perf_dispatch_tag,
     ucp_perf_dispatch_stream,
-    ucp_perf_dispatch_am
+    ucp_perf_dispatch_am,
+    ucp_perf_dispatch_group
 };
 
 ucs_status_t ucp_perf_test_dispatch(ucx_perf_context_t *perf)
@@ -18,6 +18,10 @@
 
 #include "libperf_int.h"
 
+extern "C" {
+#include <uct/api/v2/uct_v2.h>
+}
+
 #include <limits>
 
 
@@ -30,7 +34,8 @@ public:
     uct_perf_test_runner(ucx_perf_context_t &perf) :
         m_perf(perf),
         m_max_outstanding(m_perf.params.max_outstanding),
-        m_send_b_count(0)
+        m_send_b_count(0),
+        m_batch_count(0)
 
     {
         ucs_assert_always(m_max_outstanding > 0);
@@ -40,6 +45,14 @@ public:
         m_completion.func   = NULL;
         m_last_recvd_sn     = 0;
 
+        if (DATA == UCT_PERF_DATA_LAYOUT_SHORT_BATCH) {
+            m_batch = (uct_am_short_batch_entry_t*)
+                    calloc(m_perf.params.batch_size, sizeof(*m_batch));
+            ucs_assert_always(m_batch != NULL);
+        } else {
+            m_batch = NULL;
+        }
+
         ucs_status_t status;
         uct_iface_attr_t attr;
         status = uct_iface_query(m_perf.uct.iface, &attr);
@@ -55,6 +68,7 @@ public:
     }
 
     ~uct_perf_test_runner() {
+        free(m_batch);
         uct_iface_set_am_handler(m_perf.uct.iface, UCT_PERF_TEST_AM_ID, NULL,
                                  NULL, 0);
     }
@@ -350,11 +364,58 @@ public:
         }
     }
 
+    void flush_batch(uct_ep_h ep)
+    {
+        size_t posted = 0;
+        ssize_t ret;
+
+        while (posted < m_batch_count) {
+            ret = uct_ep_am_short_batch(ep, UCT_PERF_TEST_AM_ID,
+                                        &m_batch[posted],
+                                        m_batch_count - posted);
+            if (ucs_likely(ret > 0)) {
+                posted += ret;
+            } else if (ret == UCS_ERR_NO_RESOURCE) {
+                progress_requestor();
+            } else {
+                ucs_error("Failed to send batch: %s",
+                          ucs_status_string((ucs_status_t)ret));
+                break;
+            }
+        }
+
+        if (m_batch_count > 0) {
+            m_batch_count = 0;
+            progress_requestor();
+        }
+    }
+
+    void UCS_F_ALWAYS_INLINE
+    send_batch_b(uct_ep_h ep, psn_t sn, void *buffer, size_t length)
+    {
+        uct_am_short_batch_entry_t *entry = &m_batch[m_batch_count++];
+
+        entry->header  = sn;
+        entry->payload = (char*)buffer + sizeof(entry->header);
+        entry->length  = length - sizeof(entry->header);
+
+        if (m_batch_count == m_perf.params.batch_size) {
+            flush_batch(ep);
+        }
+    }
+
     void UCS_F_ALWAYS_INLINE
     send_b(uct_ep_h ep, psn_t sn, psn_t prev_sn, void *buffer, size_t length,
            uint64_t remote_addr, uct_rkey_t rkey, uct_completion_t *comp)
     {
         ucs_status_t status;
+
+        if ((CMD == UCX_PERF_CMD_AM) &&
+            (DATA == UCT_PERF_DATA_LAYOUT_SHORT_BATCH)) {
+            send_batch_b(ep, sn, buffer, length);
+            return;
+        }
+
         for (;;) {
             status = send(ep, sn, prev_sn, buffer, length, remote_addr, rkey, comp);
             if (ucs_likely(status == UCS_OK)) {
@@ -395,6 +456,73 @@ public:
         }
     }
 
+    /* The requester sends on the schedule, without waiting for the replies.
+     * The responder replies with the last sequence number it received, which
+     * acknowledges all requests up to it. */
+    void run_open_loop(unsigned my_index, uct_ep_h ep, psn_t *recv_sn,
+                       void *buffer, size_t length, uint64_t remote_addr,
+                       uct_rkey_t rkey)
+    {
+        ucs_memory_type_t recv_mem_type = m_perf.uct.recv_mem.mem_type;
+        psn_t acked_sn                  = std::numeric_limits<psn_t>::max();
+        psn_t send_sn                   = 0;
+        ucx_perf_counter_t posted       = 0;
+        ucx_perf_counter_t completed    = 0;
+        ucs_time_t *sched_times;
+        psn_t sn;
+
+        if (my_index != 0) {
+            UCX_PERF_TEST_FOREACH(&m_perf) {
+                do {
+                    progress_responder();
+                    sn = get_recv_sn(recv_sn, recv_mem_type,
+                                     m_perf.recv_allocator);
+                } while (sn == acked_sn);
+
+                send_b(ep, sn, acked_sn, buffer, length, remote_addr, rkey,
+                       NULL);
+                flush_batch(ep);
+                ucx_perf_update(&m_perf, (psn_t)(sn - acked_sn),
+                                (psn_t)(sn - acked_sn) * length);
+                acked_sn = sn;
+            }
+            return;
+        }
+
+        sched_times = (ucs_time_t*)calloc(m_max_outstanding,
+                                          sizeof(*sched_times));
+        ucs_assert_always(sched_times != NULL);
+
+        UCX_PERF_TEST_FOREACH(&m_perf) {
+            /* A late request still counts from its intended time, and the
+             * window only limits the number of requests in flight */
+            if ((posted < m_perf.max_iter) &&
+                ((posted - completed) < m_max_outstanding) &&
+                (ucs_get_time() >= ucx_perf_sched_peek(&m_perf))) {
+                sched_times[posted % m_max_outstanding] =
+                        ucx_perf_sched_next(&m_perf);
+                send_b(ep, send_sn, send_sn - 1, buffer, length, remote_addr,
+                       rkey, NULL);
+                flush_batch(ep);
+                ++send_sn;
+                ++posted;
+            } else {
+                progress_responder();
+            }
+
+            sn = get_recv_sn(recv_sn, recv_mem_type, m_perf.recv_allocator);
+            while (acked_sn != sn) {
+                ucx_perf_update_scheduled(&m_perf, 1, length,
+                                          sched_times[completed %
+                                                      m_max_outstanding]);
+                ++acked_sn;
+                ++completed;
+            }
+        }
+
+        free(sched_times);
+    }
+
     ucs_status_t run_pingpong()
     {
         psn_t send_sn, *recv_sn, sn;
@@ -447,10 +575,14 @@ public:
         ep          = m_perf.uct.peers[peer_index].ep;
 
         send_sn = 0;
-        if (my_index == 0) {
+        if (ucx_perf_is_open_loop(&m_perf.params)) {
+            run_open_loop(my_index, ep, recv_sn, buffer, length, remote_addr,
+                          rkey);
+        } else if (my_index == 0) {
             UCX_PERF_TEST_FOREACH(&m_perf) {
                 send_b(ep, send_sn, send_sn - 1, buffer, length, remote_addr,
                        rkey, NULL);
+                flush_batch(ep);
                 ucx_perf_update(&m_perf, 1, length);
 
                 do {
@@ -471,6 +603,7 @@ public:
 
                 send_b(ep, send_sn, send_sn - 1, buffer, length, remote_addr,
                        rkey, NULL);
+                flush_batch(ep);
                 ucx_perf_update(&m_perf, 1, length);
                 ++send_sn;
             }
@@ -520,6 +653,8 @@ public:
                             m_perf.current.iters);
 
                 while (UCS_CIRCULAR_COMPARE8(send_sn, >, sn + fc_window)) {
+                    /* Messages held in the batch must go out to get an ACK */
+                    flush_batch(ep);
                     progress_responder();
                     sn = get_recv_sn(recv_sn, recv_mem_type, recv_allocator);
                 }
@@ -558,6 +693,7 @@ public:
         } else {
             /* Wait for last ACK, to make sure no more messages will arrive. */
             ucs_assert(direction_to_responder);
+            flush_batch(ep);
 
             do {
                 progress_responder();
@@ -602,6 +738,7 @@ public:
                     wait_for_window(send_window);
                     send_b(ep, sn, send_sn, buffer, length, remote_addr, rkey,
                            &m_completion);
+                    flush_batch(ep);
                     send_sn = sn;
                 }
 
@@ -617,6 +754,7 @@ public:
                 sn = get_recv_sn(recv_sn, recv_mem_type, recv_allocator);
                 send_b(ep, sn, send_sn, buffer, length, remote_addr, rkey,
                        &m_completion);
+                flush_batch(ep);
             }
         } else {
             /* Wait for "sentinel" value */
@@ -759,6 +897,9 @@ private:
     const unsigned     m_max_outstanding;
     uct_completion_t   m_completion;
     int                m_send_b_count;
+    /* messages accumulated for the short batch layout */
+    uct_am_short_batch_entry_t *m_batch;
+    unsigned           m_batch_count;
     /* this is only valid for UCT AM tests */
     psn_t              m_last_recvd_sn;
     const static int   N_SEND_B_PER_PROGRESS = 16;
@@ -781,7 +922,8 @@ private:
    TEST_CASE_ALL_OSD(_perf, _case, UCT_PERF_DATA_LAYOUT_SHORT) \
    TEST_CASE_ALL_OSD(_perf, _case, UCT_PERF_DATA_LAYOUT_SHORT_IOV) \
    TEST_CASE_ALL_OSD(_perf, _case, UCT_PERF_DATA_LAYOUT_BCOPY) \
-   TEST_CASE_ALL_OSD(_perf, _case, UCT_PERF_DATA_LAYOUT_ZCOPY)
+   TEST_CASE_ALL_OSD(_perf, _case, UCT_PERF_DATA_LAYOUT_ZCOPY) \
+   TEST_CASE_ALL_OSD(_perf, _case, UCT_PERF_DATA_LAYOUT_SHORT_BATCH)
 
 #define DEFINE_DISPATCH_FUNC(_case, _cmd, _type) \
     static ucs_status_t uct_perf_dispatch_##_case(ucx_perf_context_t *perf) { \
@@ -14,6 +14,7 @@
 
 #include "perftest.h"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/sys/sock.h>
@@ -25,7 +26,31 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <netdb.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
 #include <sys/poll.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+
+
+#define LOCAL_RTE_SLOT_SIZE     (ADDR_BUF_SIZE * 16)
+#define LOCAL_RTE_CHECK_MSEC    100
+
+
+/* Data posted by one process of the local RTE */
+typedef struct local_rte_slot {
+    size_t                       length;
+    char                         data[LOCAL_RTE_SLOT_SIZE];
+} local_rte_slot_t;
+
+
+/* Shared memory of the local RTE */
+typedef struct local_rte_shm {
+    volatile uint32_t            barrier_count;
+    volatile uint32_t            barrier_sense;
+    local_rte_slot_t             slots[];
+} local_rte_shm_t;
 
 
 test_type_t tests[] = {
@@ -107,6 +132,18 @@ test_type_t tests[] = {
     {"ucp_am_bw", UCX_PERF_API_UCP, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_STREAM_UNI,
      "am bandwidth / message rate", "overhead", 32},
 
+    {"tag_incast", UCX_PERF_API_UCP, UCX_PERF_CMD_TAG, UCX_PERF_TEST_TYPE_INCAST,
+     "tag match incast bandwidth / fairness", "overhead", 32},
+
+    {"tag_a2a", UCX_PERF_API_UCP, UCX_PERF_CMD_TAG, UCX_PERF_TEST_TYPE_ALLTOALL,
+     "tag match all-to-all bandwidth / fairness", "overhead", 32},
+
+    {"ucp_am_incast", UCX_PERF_API_UCP, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_INCAST,
+     "am incast bandwidth / fairness", "overhead", 32},
+
+    {"ucp_am_a2a", UCX_PERF_API_UCP, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_ALLTOALL,
+     "am all-to-all bandwidth / fairness", "overhead", 32},
+
     {NULL}
 };
 
@@ -180,6 +217,7 @@ ucs_status_t init_test_params(perftest_params_t *params)
     params->super.async_mode        = UCS_ASYNC_THREAD_LOCK_TYPE;
     params->super.wait_mode         = UCX_PERF_WAIT_MODE_LAST;
     params->super.max_outstanding   = 0;
+    params->super.batch_size        = 16;
     params->super.warmup_iter       = 10000;
     params->super.warmup_time       = 100e-3;
     params->super.alignment         = ucs_get_page_size();
@@ -538,6 +576,244 @@ static void sock_rte_cleanup(void *arg)
     }
 }
 
+static unsigned local_rte_group_size(void *rte_group)
+{
+    local_rte_group_t *group = rte_group;
+    return group->size;
+}
+
+static unsigned local_rte_group_index(void *rte_group)
+{
+    local_rte_group_t *group = rte_group;
+    return group->index;
+}
+
+static void local_rte_check_children(local_rte_group_t *group)
+{
+    unsigned i;
+    int status;
+
+    for (i = 1; i < group->size; ++i) {
+        if ((group->pids[i] == 0) ||
+            (waitpid(group->pids[i], &status, WNOHANG) <= 0)) {
+            continue;
+        }
+
+        if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+            ucs_error("local: rte process %u (pid %d) failed", i,
+                      group->pids[i]);
+            exit(EXIT_FAILURE);
+        }
+
+        group->pids[i] = 0;
+    }
+}
+
+/* Sense-reversing barrier over the shared memory */
+static void local_rte_wait(local_rte_group_t *group,
+                           void (*progress)(void *arg), void *arg)
+{
+    local_rte_shm_t *shm  = group->shm;
+    ucs_time_t check_time = ucs_get_time() +
+                            ucs_time_from_msec(LOCAL_RTE_CHECK_MSEC);
+
+    group->sense = !group->sense;
+    ucs_memory_cpu_fence();
+
+    if (ucs_atomic_fadd32(&shm->barrier_count, 1) == (group->size - 1)) {
+        shm->barrier_count = 0;
+        ucs_memory_cpu_store_fence();
+        shm->barrier_sense = group->sense;
+        return;
+    }
+
+    while (shm->barrier_sense != group->sense) {
+        if (progress != NULL) {
+            progress(arg);
+        }
+
+        /* Other processes may share the same CPUs */
+        sched_yield();
+
+        /* Child processes are killed when the first process exits */
+        if ((group->index == 0) && (ucs_get_time() > check_time)) {
+            local_rte_check_children(group);
+            check_time = ucs_get_time() +
+                         ucs_time_from_msec(LOCAL_RTE_CHECK_MSEC);
+        }
+    }
+
+    ucs_memory_cpu_load_fence();
+}
+
+static void local_rte_barrier(void *rte_group, void (*progress)(void *arg),
+                              void *arg)
+{
+#if _OPENMP
+#  pragma omp barrier
+#  pragma omp master
+#endif
+    local_rte_wait(rte_group, progress, arg);
+#if _OPENMP
+#  pragma omp barrier
+#endif
+}
+
+static void local_rte_post_vec(void *rte_group, const struct iovec *iovec,
+                               int iovcnt, void **req)
+{
+    local_rte_group_t *group = rte_group;
+    local_rte_slot_t *slot   = &group->shm->slots[group->index];
+    size_t size              = ucs_iovec_total_length(iovec, iovcnt);
+
+    ucs_assertv_always(size <= LOCAL_RTE_SLOT_SIZE, "size=%zu", size);
+
+    /* Wait until all processes read the previously posted data */
+    local_rte_wait(group, NULL, NULL);
+
+    slot->length = ucs_iov_copy(iovec, iovcnt, 0, slot->data, size,
+                                UCS_IOV_COPY_TO_BUF);
+}
+
+static void local_rte_exchange_vec(void *rte_group, void *req)
+{
+    local_rte_wait(rte_group, NULL, NULL);
+}
+
+static void local_rte_recv(void *rte_group, unsigned src, void *buffer,
+                           size_t max, void *req)
+{
+    local_rte_group_t *group = rte_group;
+    local_rte_slot_t *slot   = &group->shm->slots[src];
+
+    ucs_assert_always(src < group->size);
+    ucs_assertv_always(slot->length <= max, "length=%zu max=%zu",
+                       slot->length, max);
+    memcpy(buffer, slot->data, slot->length);
+}
+
+static ucs_status_t local_rte_setup(void *arg);
+static void local_rte_cleanup(void *arg);
+
+static ucx_perf_rte_t local_rte = {
+    .setup        = local_rte_setup,
+    .cleanup      = local_rte_cleanup,
+    .group_size   = local_rte_group_size,
+    .group_index  = local_rte_group_index,
+    .barrier      = local_rte_barrier,
+    .post_vec     = local_rte_post_vec,
+    .recv         = local_rte_recv,
+    .exchange_vec = local_rte_exchange_vec,
+};
+
+static void local_rte_kill_children(local_rte_group_t *group, unsigned count)
+{
+    unsigned i;
+
+    for (i = 1; i < count; ++i) {
+        kill(group->pids[i], SIGKILL);
+        waitpid(group->pids[i], NULL, 0);
+    }
+}
+
+static ucs_status_t local_rte_setup(void *arg)
+{
+    struct perftest_context *ctx = arg;
+    local_rte_group_t *group     = &ctx->local_rte_group;
+    pid_t parent                 = getpid();
+    ucs_status_t status;
+    unsigned i;
+    pid_t pid;
+
+    if (ctx->num_procs == 0) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    group->size     = ctx->num_procs;
+    group->index    = 0;
+    group->sense    = 0;
+    group->shm_size = sizeof(*group->shm) +
+                      (group->size * sizeof(local_rte_slot_t));
+    group->shm      = mmap(NULL, group->shm_size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (group->shm == MAP_FAILED) {
+        ucs_error("local: mmap(size=%zu) failed: %m", group->shm_size);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    group->pids = calloc(group->size, sizeof(*group->pids));
+    if (group->pids == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_unmap;
+    }
+
+    /* Do not let the children print buffered output again */
+    fflush(stdout);
+    fflush(stderr);
+
+    for (i = 1; i < group->size; ++i) {
+        pid = fork();
+        if (pid < 0) {
+            ucs_error("local: fork() failed: %m");
+            local_rte_kill_children(group, i);
+            status = UCS_ERR_IO_ERROR;
+            goto err_free_pids;
+        }
+
+        if (pid == 0) {
+            /* Do not outlive the first process */
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            if (getppid() != parent) {
+                exit(EXIT_FAILURE);
+            }
+
+            group->index = i;
+            free(group->pids);
+            group->pids = NULL;
+            break;
+        }
+
+        group->pids[i] = pid;
+    }
+
+    /* The first process is the incast receiver, let it print the results */
+    if (group->index == 0) {
+        ctx->flags |= TEST_FLAG_PRINT_TEST | TEST_FLAG_PRINT_RESULTS;
+    }
+
+    ctx->params.super.rte_group = group;
+    ctx->params.super.rte       = &local_rte;
+    return UCS_OK;
+
+err_free_pids:
+    free(group->pids);
+err_unmap:
+    munmap(group->shm, group->shm_size);
+    return status;
+}
+
+static void local_rte_cleanup(void *arg)
+{
+    struct perftest_context *ctx = arg;
+    local_rte_group_t *group     = &ctx->local_rte_group;
+    unsigned i;
+    int status;
+
+    if (group->index == 0) {
+        for (i = 1; i < group->size; ++i) {
+            if ((group->pids[i] != 0) &&
+                (waitpid(group->pids[i], &status, 0) == group->pids[i]) &&
+                (!WIFEXITED(status) || (WEXITSTATUS(status) != 0))) {
+                ucs_error("local: rte process %u (pid %d) failed", i,
+                          group->pids[i]);
+            }
+        }
+        free(group->pids);
+    }
+
+    munmap(group->shm, group->shm_size);
+}
+
 #if defined (HAVE_MPI)
 
 #define MPI_RTE_BSEND_BUFFER_SIZE 4096
@@ -817,6 +1093,7 @@ static void initialize_plugins(void)
 #if defined (HAVE_MPI)
     ucs_list_add_tail(&rte_list, &mpi_rte.list);
 #endif
+    ucs_list_add_tail(&rte_list, &local_rte.list);
     ucs_list_add_tail(&rte_list, &sock_rte.list);
 }
 
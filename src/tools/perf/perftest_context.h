@@ -14,6 +14,8 @@
 
 #define MAX_BATCH_FILES         32
 #define MAX_CPUS                1024
+#define MAX_RATES               32
+#define OPEN_LOOP_WINDOW_SIZE   64
 
 
 enum {
@@ -23,7 +25,9 @@ enum {
     TEST_FLAG_NUMERIC_FMT      = UCS_BIT(9),
     TEST_FLAG_PRINT_FINAL      = UCS_BIT(10),
     TEST_FLAG_PRINT_CSV        = UCS_BIT(11),
-    TEST_FLAG_PRINT_EXTRA_INFO = UCS_BIT(12)
+    TEST_FLAG_PRINT_EXTRA_INFO = UCS_BIT(12),
+    TEST_FLAG_PRINT_CPU        = UCS_BIT(13),
+    TEST_FLAG_PRINT_PERCENTILE = UCS_BIT(14)
 };
 
 
@@ -36,12 +40,32 @@ typedef struct sock_rte_group {
 } sock_rte_group_t;
 
 
+typedef struct local_rte_group {
+    struct local_rte_shm         *shm;      /* Shared by all the processes */
+    size_t                       shm_size;
+    unsigned                     size;
+    unsigned                     index;
+    uint32_t                     sense;     /* Phase of the current barrier */
+    pid_t                        *pids;     /* Child processes, on index 0 */
+} local_rte_group_t;
+
+
 typedef struct perftest_params {
     ucx_perf_params_t            super;
     int                          test_id;
+    unsigned                     num_rates;
+    double                       rates[MAX_RATES]; /* Open-loop rates to sweep */
 } perftest_params_t;
 
 
+/* Point of the throughput-latency curve of an open-loop rate sweep */
+typedef struct perftest_rate_point {
+    double                       offered_rate;
+    double                       msgrate;
+    double                       latency[4]; /* 50%, 99%, 99.9% and max */
+} perftest_rate_point_t;
+
+
 struct perftest_context {
     perftest_params_t            params;
     const char                   *server_addr;
@@ -56,8 +80,12 @@ struct perftest_context {
     char                         *batch_files[MAX_BATCH_FILES];
     char                         *test_names[MAX_BATCH_FILES];
     const char                   *mad_port;
+    const char                   *histogram_file;
+    unsigned                     num_procs;
+    perftest_rate_point_t        *rate_point; /* Filled by the running test */
 
     sock_rte_group_t             sock_rte_group;
+    local_rte_group_t            local_rte_group;
 };
 
 
@@ -81,6 +81,15 @@ static void usage(const struct perftest_context *ctx, const char *program)
                                 ctx->params.super.max_outstanding);
     printf("     -i <offset>    distance between consecutive scatter-gather entries (%zu)\n",
                                 ctx->params.super.iov_stride);
+    printf("     -a <count>     number of operations posted together in batch modes (%u)\n",
+                                ctx->params.super.batch_size);
+    printf("     -j <rate>[,<rate>...]\n");
+    printf("                    run ping-pong tests in open loop, sending requests at the\n");
+    printf("                    given rates (operations per second) regardless of replies,\n");
+    printf("                    and print response times, measured from the intended send\n");
+    printf("                    time, for every rate. The window (-O) limits the number of\n");
+    printf("                    requests in flight (%d)\n", OPEN_LOOP_WINDOW_SIZE);
+    printf("     -Y             use Poisson arrivals instead of a fixed rate with -j\n");
     printf("     -l             use loopback connection\n");
     printf("                    in this case, the process will communicate with itself,\n");
     printf("                    so passing server hostname is not allowed\n");
@@ -100,6 +109,8 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("     -P <0|1>       disable/enable MPI mode (%d)\n", ctx->mpi);
 #endif
     printf("     -K <ca:port>   use MAD for test setup and synchronization\n");
+    printf("     -F <nprocs>    run <nprocs> local processes, for incast and all-to-all\n");
+    printf("                    tests (tag_incast, tag_a2a, ucp_am_incast, ucp_am_a2a)\n");
     printf("     -h             show this help message\n");
     printf("\n");
     printf("  Output format:\n");
@@ -107,6 +118,10 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("     -f             print only final numbers\n");
     printf("     -v             print CSV-formatted output\n");
     printf("     -I             print extra information about the operation\n");
+    printf("     -u             print CPU cycles consumed by the process per byte\n");
+    printf("     -Q             print a table of latency percentiles after the test\n");
+    printf("     -X <file>      save the latency histogram to a file, in JSON format\n");
+    printf("                    if the file name ends with \".json\", otherwise in CSV\n");
     printf("     -q             do not print error messages\n");
     printf("\n");
     printf("  UCT only:\n");
@@ -117,6 +132,7 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("                        shortiov - short io-vector messages (only for active messages)\n");
     printf("                        bcopy    - copy-out (cannot be used for atomics)\n");
     printf("                        zcopy    - zero-copy (cannot be used for atomics)\n");
+    printf("                        shortbatch - batches of short messages (only for active messages)\n");
     printf("     -W <count>     flow control window size, for active messages (%u)\n",
                                 ctx->params.super.uct.fc_window);
     printf("     -H <size>      active message header size (%zu), included in message size\n",
@@ -137,11 +153,14 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("                    data layout for sender and receiver side (contig)\n");
     printf("                        contig - Continuous datatype\n");
     printf("                        iov    - Scatter-gather list\n");
+    printf("                        generic - Generic datatype which packs 64-byte\n");
+    printf("                                  blocks in a strided order\n");
     printf("     -C             use wild-card tag for tag tests\n");
     printf("     -U             force unexpected flow by using tag probe\n");
     printf("     -r <mode>      receive mode for stream tests (recv)\n");
     printf("                        recv       : Use ucp_stream_recv_nb\n");
     printf("                        recv_data  : Use ucp_stream_recv_data_nb\n");
+    printf("     -J             coalesce small stream sends on the sender endpoint\n");
     printf("     -I             create context with wakeup feature enabled\n");
     printf("     -e             create endpoints with error handling support\n");
     printf("     -E <mode>      wait mode for tests\n");
@@ -149,6 +168,7 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("                        sleep      : go to sleep after posting requests\n");
     printf("     -H <size>      active message header size (%zu), not included in message size\n",
                                 ctx->params.super.ucp.am_hdr_size);
+    printf("     -L             send active messages in batches of -a messages with ucp_am_send_nbx_batch\n");
     printf("     -y             do additional memcopy to the user memory in active message receive handler\n");
     printf("     -z             pass pre-registered memory handle\n");
     printf("     -g <IP>[:<port>], --daemon-local <IP>[:<port>]\n");
@@ -256,13 +276,17 @@ static ucs_status_t parse_ucp_datatype_params(const char *opt_arg,
 {
     const char  *iov_type         = "iov";
     const size_t iov_type_size    = strlen("iov");
-    const char  *contig_type      = "contig";
-    const size_t contig_type_size = strlen("contig");
+    const char  *contig_type       = "contig";
+    const size_t contig_type_size  = strlen("contig");
+    const char  *generic_type      = "generic";
+    const size_t generic_type_size = strlen("generic");
 
     if (0 == strncmp(opt_arg, iov_type, iov_type_size)) {
         *datatype = UCP_PERF_DATATYPE_IOV;
     } else if (0 == strncmp(opt_arg, contig_type, contig_type_size)) {
         *datatype = UCP_PERF_DATATYPE_CONTIG;
+    } else if (0 == strncmp(opt_arg, generic_type, generic_type_size)) {
+        *datatype = UCP_PERF_DATATYPE_GENERIC;
     } else {
         return UCS_ERR_INVALID_PARAM;
     }
@@ -304,6 +328,12 @@ static ucs_status_t check_daemon_params(const ucx_perf_params_t *params)
         return UCS_ERR_UNSUPPORTED;
     }
 
+    if (params->flags & UCX_PERF_TEST_FLAG_AM_BATCH) {
+        ucs_error("sending UCP AM in batches is not supported in offloaded"
+                  " mode");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
     if (params->thread_count > 1) {
         ucs_error("only 1 thread is supported in offloaded mode");
         return UCS_ERR_UNSUPPORTED;
@@ -337,6 +367,33 @@ static ucs_status_t init_daemon_params(ucx_perf_params_t *params)
     return UCS_OK;
 }
 
+static ucs_status_t parse_rates(const char *opt_arg, perftest_params_t *params)
+{
+    const char *str = opt_arg;
+    double rate;
+    char *end;
+
+    params->num_rates = 0;
+    do {
+        rate = strtod(str, &end);
+        if ((end == str) || ((*end != ',') && (*end != '\0')) ||
+            !(rate > 0)) {
+            ucs_error("invalid rate list: '%s'", opt_arg);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        if (params->num_rates == MAX_RATES) {
+            ucs_error("too many rates: '%s' (max: %d)", opt_arg, MAX_RATES);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        params->rates[params->num_rates++] = rate;
+        str                                = end + 1;
+    } while (*end != '\0');
+
+    return UCS_OK;
+}
+
 ucs_status_t parse_test_params(perftest_params_t *params, char opt,
                                const char *opt_arg)
 {
@@ -378,6 +435,8 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
             params->super.uct.data_layout   = UCT_PERF_DATA_LAYOUT_BCOPY;
         } else if (!strcmp(opt_arg, "zcopy")) {
             params->super.uct.data_layout   = UCT_PERF_DATA_LAYOUT_ZCOPY;
+        } else if (!strcmp(opt_arg, "shortbatch")) {
+            params->super.uct.data_layout   = UCT_PERF_DATA_LAYOUT_SHORT_BATCH;
         } else if (UCS_OK == parse_ucp_datatype_params(opt_arg,
                                                        &params->super.ucp.send_datatype)) {
             optarg2 = strchr(opt_arg, ',');
@@ -413,6 +472,11 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
     case 'n':
         params->super.max_iter = atol(opt_arg);
         return UCS_OK;
+    case 'j':
+        return parse_rates(opt_arg, params);
+    case 'Y':
+        params->super.flags |= UCX_PERF_TEST_FLAG_RATE_POISSON;
+        return UCS_OK;
     case 's':
         return parse_message_sizes_params(opt_arg, &params->super);
     case 'H':
@@ -425,6 +489,9 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
     case 'O':
         params->super.max_outstanding = atoi(opt_arg);
         return UCS_OK;
+    case 'a':
+        params->super.batch_size = atoi(opt_arg);
+        return UCS_OK;
     case 'w':
         params->super.warmup_iter = atol(opt_arg);
         return UCS_OK;
@@ -504,6 +571,12 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
             return UCS_ERR_INVALID_PARAM;
         }
         return UCS_OK;
+    case 'L':
+        params->super.flags |= UCX_PERF_TEST_FLAG_AM_BATCH;
+        return UCS_OK;
+    case 'J':
+        params->super.flags |= UCX_PERF_TEST_FLAG_STREAM_COALESCE;
+        return UCS_OK;
     case 'y':
         params->super.flags |= UCX_PERF_TEST_FLAG_AM_RECV_COPY;
         return UCS_OK;
@@ -528,7 +601,9 @@ ucs_status_t adjust_test_params(perftest_params_t *params,
     test = &tests[params->test_id];
 
     if (params->super.max_outstanding == 0) {
-        params->super.max_outstanding = test->window_size;
+        params->super.max_outstanding = (params->num_rates > 0) ?
+                                        OPEN_LOOP_WINDOW_SIZE :
+                                        test->window_size;
     }
 
     return UCS_OK;
@@ -646,10 +721,13 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
     ctx->flags           = 0;
     ctx->mpi             = mpi_initialized;
     ctx->mad_port        = NULL;
+    ctx->histogram_file  = NULL;
+    ctx->num_procs       = 0;
+    ctx->rate_point      = NULL;
 
     optind = 1;
     while ((c = getopt_long(argc, argv,
-                            "p:b:6NfvIc:P:hK:g:G:k" TEST_PARAMS_ARGS,
+                            "p:b:6NfvIuQX:c:P:hK:F:g:G:k" TEST_PARAMS_ARGS,
                             TEST_PARAMS_ARGS_LONG, NULL)) != -1) {
         switch (c) {
         case 'p':
@@ -678,6 +756,15 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
         case 'I':
             ctx->flags |= TEST_FLAG_PRINT_EXTRA_INFO;
             break;
+        case 'u':
+            ctx->flags |= TEST_FLAG_PRINT_CPU;
+            break;
+        case 'Q':
+            ctx->flags |= TEST_FLAG_PRINT_PERCENTILE;
+            break;
+        case 'X':
+            ctx->histogram_file = optarg;
+            break;
         case 'c':
             ctx->flags |= TEST_FLAG_SET_AFFINITY;
             status = parse_cpus(optarg, ctx);
@@ -688,6 +775,15 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
         case 'K':
             ctx->mad_port = optarg;
             break;
+        case 'F':
+            ctx->num_procs = atoi(optarg);
+            if (ctx->num_procs < 2) {
+                ucs_error("invalid number of local processes: '%s' (must be "
+                          "at least 2)", optarg);
+                status = UCS_ERR_INVALID_PARAM;
+                goto err;
+            }
+            break;
         case 'P':
 #ifdef HAVE_MPI
             ctx->mpi = atoi(optarg) && mpi_initialized;
@@ -730,9 +826,31 @@ ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized,
         goto err;
     }
 
+    if ((ctx->num_procs != 0) && ((ctx->mpi != 0) || (ctx->mad_port != NULL))) {
+        ucs_error("conflicting arguments: cannot use local processes with MPI "
+                  "or IB RTE (-F and mpirun or -K), use -P 0 to disable MPI");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
+    if ((ctx->num_procs != 0) &&
+        (ctx->params.super.flags & UCX_PERF_TEST_FLAG_LOOPBACK)) {
+        ucs_error("conflicting arguments: local processes (-F) are not "
+                  "allowed in loopback (-l) mode");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     if (optind < argc) {
         ctx->server_addr = argv[optind];
 
+        if (ctx->num_procs != 0) {
+            ucs_error("conflicting arguments: server hostname argument is not "
+                      "allowed with local processes (-F)");
+            status = UCS_ERR_INVALID_PARAM;
+            goto err;
+        }
+
         if (ctx->params.super.flags & UCX_PERF_TEST_FLAG_LOOPBACK) {
             ucs_error("conflicting arguments: server hostname argument is not "
                       "allowed in loopback (-l) mode");
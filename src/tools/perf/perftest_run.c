@@ -20,6 +20,186 @@
 #include <locale.h>
 
 
+static const double latency_percentile_ranks[] = {
+    50.0, 90.0, 99.0, 99.9, 99.99, 100.0
+};
+
+static void print_latency_percentiles(const struct perftest_context *ctx,
+                                      const ucx_perf_histogram_t *hist)
+{
+    unsigned i;
+
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        printf("percentile,latency_usec\n");
+        for (i = 0; i < ucs_static_array_size(latency_percentile_ranks); ++i) {
+            printf("%.2f,%.3f\n", latency_percentile_ranks[i],
+                   ucx_perf_histogram_percentile(
+                           hist, latency_percentile_ranks[i]) * 1000000.0);
+        }
+        return;
+    }
+
+    printf("+--------------+--------------+\n");
+    printf("|  percentile  | latency usec |\n");
+    printf("+--------------+--------------+\n");
+    for (i = 0; i < ucs_static_array_size(latency_percentile_ranks); ++i) {
+        printf("| %11.2f%% | %12.3f |\n", latency_percentile_ranks[i],
+               ucx_perf_histogram_percentile(hist,
+                                             latency_percentile_ranks[i]) *
+               1000000.0);
+    }
+    printf("+--------------+--------------+\n");
+}
+
+static const double rate_curve_percentile_ranks[] = {
+    50.0, 99.0, 99.9, 100.0
+};
+
+static void print_rate_curve(const struct perftest_context *ctx,
+                             const perftest_rate_point_t *points,
+                             unsigned num_points)
+{
+    unsigned i, j;
+
+    UCS_STATIC_ASSERT(ucs_static_array_size(rate_curve_percentile_ranks) ==
+                      ucs_static_array_size(points->latency));
+
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        printf("offered_rate,achieved_rate,p50_usec,p99_usec,p99.9_usec,"
+               "max_usec\n");
+        for (i = 0; i < num_points; ++i) {
+            printf("%.0f,%.0f", points[i].offered_rate, points[i].msgrate);
+            for (j = 0; j < ucs_static_array_size(points[i].latency); ++j) {
+                printf(",%.3f", points[i].latency[j] * 1000000.0);
+            }
+            printf("\n");
+        }
+        return;
+    }
+
+    printf("+--------------+--------------+---------------------------------------------------+\n");
+    printf("|   offered    |   achieved   |               response time (usec)                |\n");
+    printf("| rate (op/s)  | rate (op/s)  |    50.0%%   |    99.0%%   |    99.9%%   |     max    |\n");
+    printf("+--------------+--------------+------------+------------+------------+------------+\n");
+    for (i = 0; i < num_points; ++i) {
+        printf("| %12.0f | %12.0f |", points[i].offered_rate,
+               points[i].msgrate);
+        for (j = 0; j < ucs_static_array_size(points[i].latency); ++j) {
+            printf(" %10.3f |", points[i].latency[j] * 1000000.0);
+        }
+        printf("\n");
+    }
+    printf("+--------------+--------------+------------+------------+------------+------------+\n");
+}
+
+static void fill_rate_point(perftest_rate_point_t *point,
+                            const ucx_perf_result_t *result)
+{
+    unsigned i;
+
+    point->msgrate = result->msgrate.total_average;
+    for (i = 0; i < ucs_static_array_size(point->latency); ++i) {
+        point->latency[i] = ucx_perf_histogram_percentile(
+                result->latency_histogram, rate_curve_percentile_ranks[i]);
+    }
+}
+
+static void print_group_stats(const struct perftest_context *ctx,
+                              const ucx_perf_result_t *result)
+{
+    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+        printf("flows,bw_MBs,msgrate,fairness,min_flow_msgrate,"
+               "max_flow_msgrate,progress_calls_per_msg,progress_nsec_per_msg\n");
+        printf("%u,%.2f,%.0f,%.4f,%.0f,%.0f,%.2f,%.1f\n", result->group.flows,
+               result->group.bandwidth / UCS_MBYTE, result->group.msgrate,
+               result->group.fairness, result->group.min_flow_msgrate,
+               result->group.max_flow_msgrate, result->group.progress_calls,
+               result->group.progress_time * 1e9);
+        return;
+    }
+
+    printf("+--------------------------------+----------------+\n");
+    printf("| %-30s | %14u |\n", "flows", result->group.flows);
+    printf("| %-30s | %14.2f |\n", "aggregate bandwidth (MB/s)",
+           result->group.bandwidth / UCS_MBYTE);
+    printf("| %-30s | %14.0f |\n", "aggregate message rate (msg/s)",
+           result->group.msgrate);
+    printf("| %-30s | %14.4f |\n", "flow fairness (Jain index)",
+           result->group.fairness);
+    printf("| %-30s | %14.0f |\n", "min flow message rate (msg/s)",
+           result->group.min_flow_msgrate);
+    printf("| %-30s | %14.0f |\n", "max flow message rate (msg/s)",
+           result->group.max_flow_msgrate);
+    printf("| %-30s | %14.2f |\n", "progress calls per message",
+           result->group.progress_calls);
+    printf("| %-30s | %14.1f |\n", "progress nsec per message",
+           result->group.progress_time * 1e9);
+    printf("+--------------------------------+----------------+\n");
+}
+
+static void save_latency_histogram(const struct perftest_context *ctx,
+                                   const ucx_perf_histogram_t *hist)
+{
+    const char *suffix = strrchr(ctx->histogram_file, '.');
+    int is_json        = (suffix != NULL) && !strcmp(suffix, ".json");
+    const char *sep    = "";
+    ucx_perf_counter_t sum;
+    double low, high;
+    unsigned i;
+    FILE *file;
+
+    file = fopen(ctx->histogram_file, "w");
+    if (file == NULL) {
+        ucs_error("failed to open '%s' for writing: %m", ctx->histogram_file);
+        return;
+    }
+
+    if (is_json) {
+        fprintf(file, "{\n  \"count\": %" PRIu64 ",\n", hist->count);
+        fprintf(file, "  \"min_usec\": %.3f,\n  \"max_usec\": %.3f,\n",
+                (hist->count == 0) ? 0.0 : hist->min * hist->unit * 1000000.0,
+                hist->max * hist->unit * 1000000.0);
+        fprintf(file, "  \"percentiles\": {");
+        for (i = 0; i < ucs_static_array_size(latency_percentile_ranks); ++i) {
+            fprintf(file, "%s\"%.2f\": %.3f", sep, latency_percentile_ranks[i],
+                    ucx_perf_histogram_percentile(
+                            hist, latency_percentile_ranks[i]) * 1000000.0);
+            sep = ", ";
+        }
+        fprintf(file, "},\n  \"buckets\": [");
+        sep = "\n";
+    } else {
+        fprintf(file, "low_usec,high_usec,count,cumulative_percent\n");
+    }
+
+    sum = 0;
+    for (i = 0; i < UCX_PERF_HIST_NUM_BUCKETS; ++i) {
+        if (hist->buckets[i] == 0) {
+            continue;
+        }
+
+        sum += hist->buckets[i];
+        ucx_perf_histogram_bucket_range(hist, i, &low, &high);
+        if (is_json) {
+            fprintf(file,
+                    "%s    {\"low_usec\": %.3f, \"high_usec\": %.3f, "
+                    "\"count\": %" PRIu64 "}",
+                    sep, low * 1000000.0, high * 1000000.0, hist->buckets[i]);
+            sep = ",\n";
+        } else {
+            fprintf(file, "%.3f,%.3f,%" PRIu64 ",%.4f\n", low * 1000000.0,
+                    high * 1000000.0, hist->buckets[i],
+                    sum * 100.0 / hist->count);
+        }
+    }
+
+    if (is_json) {
+        fprintf(file, "\n  ]\n}\n");
+    }
+
+    fclose(file);
+}
+
 void print_progress(void *UCS_V_UNUSED rte_group,
                     const ucx_perf_result_t *result, void *arg,
                     const char *extra_info, int final, int is_multi_thread)
@@ -95,12 +275,43 @@ void print_progress(void *UCS_V_UNUSED rte_group,
                 result->msgrate.moment_average, result->msgrate.total_average);
     }
 
+    if ((ctx->flags & TEST_FLAG_PRINT_CPU) && !is_multi_thread) {
+        /* Total CPU time of the process is converted to cycles, so it
+         * includes the overhead of progress threads and the kernel */
+        ucs_string_buffer_appendf(&strb,
+                                  (ctx->flags & TEST_FLAG_PRINT_CSV) ?
+                                  ",%.3f" : "  %.3f cycles/B",
+                                  (result->bytes == 0) ? 0.0 :
+                                  result->cpu_time *
+                                  ucs_get_cpu_clocks_per_sec() /
+                                  result->bytes);
+    }
+
     if ((ctx->flags & TEST_FLAG_PRINT_EXTRA_INFO) &&
         !(ctx->flags & TEST_FLAG_PRINT_CSV)) {
         ucs_string_buffer_appendf(&strb, "  %s", extra_info);
     }
 
     fprintf(stdout, "%s\n", ucs_string_buffer_cstr(&strb));
+
+    if (final && (result->latency_histogram != NULL)) {
+        if (ctx->rate_point != NULL) {
+            fill_rate_point(ctx->rate_point, result);
+        }
+
+        if (ctx->flags & TEST_FLAG_PRINT_PERCENTILE) {
+            print_latency_percentiles(ctx, result->latency_histogram);
+        }
+
+        if (ctx->histogram_file != NULL) {
+            save_latency_histogram(ctx, result->latency_histogram);
+        }
+    }
+
+    if (final && (result->group.flows > 0)) {
+        print_group_stats(ctx, result);
+    }
+
     fflush(stdout);
 }
 
@@ -131,6 +342,9 @@ static void print_header(struct perftest_context *ctx)
             case UCT_PERF_DATA_LAYOUT_ZCOPY:
                 test_data_str = "zcopy";
                 break;
+            case UCT_PERF_DATA_LAYOUT_SHORT_BATCH:
+                test_data_str = "short batch";
+                break;
             default:
                 test_data_str = "(undefined)";
                 break;
@@ -155,6 +369,10 @@ static void print_header(struct perftest_context *ctx)
             (test->command == UCX_PERF_CMD_AM)) {
             printf("| AM header size: %-60zu                             |\n",
                    ctx->params.super.ucp.am_hdr_size);
+            if (ctx->params.super.flags & UCX_PERF_TEST_FLAG_AM_BATCH) {
+                printf("| AM batch size:  %-60u                             |\n",
+                       ctx->params.super.batch_size);
+            }
         }
     }
 
@@ -163,7 +381,9 @@ static void print_header(struct perftest_context *ctx)
             for (i = 0; i < ctx->num_batch_files; ++i) {
                 printf("%s,", ucs_basename(ctx->batch_files[i]));
             }
-            printf("iterations,%.1f_percentile_lat,avg_lat,overall_lat,avg_bw,overall_bw,avg_mr,overall_mr\n", ctx->params.super.percentile_rank);
+            printf("iterations,%.1f_percentile_lat,avg_lat,overall_lat,avg_bw,overall_bw,avg_mr,overall_mr%s\n",
+                   ctx->params.super.percentile_rank,
+                   (ctx->flags & TEST_FLAG_PRINT_CPU) ? ",cpu_cycles_per_byte" : "");
         }
     } else {
         if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
@@ -259,6 +479,41 @@ static ucs_status_t read_batch_file(FILE *batch_file, const char *file_name,
     return UCS_OK;
 }
 
+/* Run the test at every open-loop rate, to get a throughput-latency curve */
+static ucs_status_t run_rate_sweep(struct perftest_context *ctx,
+                                   const perftest_params_t *params)
+{
+    perftest_rate_point_t points[MAX_RATES];
+    ucx_perf_params_t run_params;
+    ucx_perf_result_t result;
+    ucs_status_t status;
+    unsigned i;
+
+    memset(points, 0, sizeof(points));
+    run_params = params->super;
+    status     = UCS_OK;
+
+    for (i = 0; i < params->num_rates; ++i) {
+        run_params.rate        = params->rates[i];
+        points[i].offered_rate = params->rates[i];
+        ctx->rate_point        = &points[i];
+
+        status = ucx_perf_run(&run_params, &result);
+        if (status != UCS_OK) {
+            break;
+        }
+    }
+
+    ctx->rate_point = NULL;
+
+    if ((ctx->flags & TEST_FLAG_PRINT_RESULTS) && (i > 0)) {
+        print_rate_curve(ctx, points, i);
+        fflush(stdout);
+    }
+
+    return status;
+}
+
 static ucs_status_t run_test_recurs(struct perftest_context *ctx,
                                     const perftest_params_t *parent_params,
                                     unsigned depth)
@@ -278,6 +533,10 @@ static ucs_status_t run_test_recurs(struct perftest_context *ctx,
             return status;
         }
 
+        if (parent_params->num_rates > 0) {
+            return run_rate_sweep(ctx, parent_params);
+        }
+
         return ucx_perf_run(&parent_params->super, &result);
     }
 
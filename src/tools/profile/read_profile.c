@@ -49,6 +49,10 @@
 #define REQ_COLOR          (opts->raw ? "" : TERM_COLOR_YELLOW)
 #define CLEAR_COLOR        (opts->raw ? "" : TERM_COLOR_CLEAR)
 
+/* Modes which save the sequence of records */
+#define RECORD_MODES       (UCS_BIT(UCS_PROFILE_MODE_LOG) | \
+                            UCS_BIT(UCS_PROFILE_MODE_RING))
+
 #define print_error(_fmt, ...) \
     fprintf(stderr, "Error: " _fmt "\n", ## __VA_ARGS__)
 
@@ -65,6 +69,7 @@ typedef enum {
 typedef struct options {
     const char                   *filename;
     int                          raw;
+    int                          chrome_trace;
     time_units_t                 time_units;
     int                          thread_list[MAX_THREADS + 1];
 } options_t;
@@ -629,6 +634,135 @@ static void show_profile_data_log(profile_data_t *data, options_t *opts,
     free(scope_ends);
 }
 
+static void print_json_string(const char *str)
+{
+    const char *p;
+
+    putchar('"');
+    for (p = str; *p != '\0'; ++p) {
+        if ((*p == '"') || (*p == '\\')) {
+            printf("\\%c", *p);
+        } else if ((unsigned char)*p < 0x20) {
+            printf("\\u%04x", (unsigned char)*p);
+        } else {
+            putchar(*p);
+        }
+    }
+    putchar('"');
+}
+
+static void show_chrome_trace_event(const profile_data_t *data,
+                                    const ucs_profile_thread_header_t *thread,
+                                    const ucs_profile_record_t *rec,
+                                    uint64_t base_time, int *first)
+{
+    const ucs_profile_location_t *loc = &data->locations[rec->location];
+    const char *phase;
+
+    switch (loc->type) {
+    case UCS_PROFILE_TYPE_SCOPE_BEGIN:
+        phase = "B";
+        break;
+    case UCS_PROFILE_TYPE_SCOPE_END:
+        phase = "E";
+        break;
+    case UCS_PROFILE_TYPE_SAMPLE:
+        phase = "i";
+        break;
+    case UCS_PROFILE_TYPE_REQUEST_NEW:
+        phase = "b";
+        break;
+    case UCS_PROFILE_TYPE_REQUEST_EVENT:
+        phase = "n";
+        break;
+    case UCS_PROFILE_TYPE_REQUEST_FREE:
+        phase = "e";
+        break;
+    default:
+        return;
+    }
+
+    printf("%s\n    {\"ph\":\"%s\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,",
+           *first ? "" : ",", phase, data->header->pid, thread->tid,
+           (rec->timestamp - base_time) * 1e6 / data->header->one_second);
+    *first = 0;
+
+    switch (loc->type) {
+    case UCS_PROFILE_TYPE_SCOPE_END:
+        /* the name of the scope is taken from the matching begin event */
+        printf("\"args\":{\"param32\":%u,\"param64\":%lu}}",
+               rec->param32, (unsigned long)rec->param64);
+        break;
+    case UCS_PROFILE_TYPE_REQUEST_NEW:
+    case UCS_PROFILE_TYPE_REQUEST_EVENT:
+    case UCS_PROFILE_TYPE_REQUEST_FREE:
+        /* async events with the same id are shown on the same track */
+        printf("\"cat\":\"request\",\"name\":\"request\","
+               "\"id\":\"0x%lx\",\"args\":{\"name\":",
+               (unsigned long)rec->param64);
+        print_json_string(loc->name);
+        printf(",\"param32\":%u}}", rec->param32);
+        break;
+    default:
+        if (loc->type == UCS_PROFILE_TYPE_SAMPLE) {
+            printf("\"s\":\"t\",");
+        }
+        printf("\"cat\":\"ucx\",\"name\":");
+        print_json_string((loc->name[0] != '\0') ? loc->name : loc->function);
+        printf(",\"args\":{\"location\":\"%s:%d\",\"function\":",
+               ucs_basename(loc->file), loc->line);
+        print_json_string(loc->function);
+        printf(",\"param32\":%u,\"param64\":%lu}}", rec->param32,
+               (unsigned long)rec->param64);
+        break;
+    }
+}
+
+/* Print the records in Chrome trace event format, which can be loaded by
+ * chrome://tracing or https://ui.perfetto.dev */
+static void show_chrome_trace(const profile_data_t *data, options_t *opts)
+{
+    uint64_t base_time = UINT64_MAX;
+    const profile_thread_data_t *thread;
+    const ucs_profile_record_t *rec;
+    int first = 1;
+    int *t;
+
+    for (t = opts->thread_list; *t != -1; ++t) {
+        base_time = ucs_min(base_time,
+                            data->threads[*t - 1].header->start_time);
+    }
+
+    printf("{\n  \"traceEvents\": [");
+    for (t = opts->thread_list; *t != -1; ++t) {
+        thread = &data->threads[*t - 1];
+
+        printf("%s\n    {\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+               "\"name\":\"thread_name\",\"args\":{\"name\":\"thread %d "
+               "(tid %u)\"}}",
+               first ? "" : ",", data->header->pid, thread->header->tid, *t,
+               thread->header->tid);
+        first = 0;
+
+        if (!(data->header->mode & RECORD_MODES)) {
+            continue;
+        }
+
+        for (rec = thread->records;
+             rec < thread->records + thread->header->num_records; ++rec) {
+            show_chrome_trace_event(data, thread->header, rec, base_time,
+                                    &first);
+        }
+    }
+
+    printf("\n  ],\n  \"displayTimeUnit\": \"ns\",\n");
+    printf("  \"otherData\": {\"host\":");
+    print_json_string(data->header->hostname);
+    printf(",\"command\":");
+    print_json_string(data->header->cmdline);
+    printf(",\"pid\":%d}\n}\n", data->header->pid);
+}
+
 static void close_pipes()
 {
     close(output_pipefds[0]);
@@ -660,7 +794,7 @@ static int redirect_output(const profile_data_t *data, options_t *opts)
                      1; /* locations footer */
     }
 
-    if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) {
+    if (data->header->mode & RECORD_MODES) {
         for (t = opts->thread_list; *t != -1; ++t) {
             num_lines += 3; /* thread header */
             /* Suppressing a false positive for null value dereference */
@@ -798,6 +932,11 @@ static int show_profile_data(profile_data_t *data, options_t *opts)
         }
     }
 
+    if (opts->chrome_trace) {
+        show_chrome_trace(data, opts);
+        return 0;
+    }
+
     /* redirect output if needed */
     if (!opts->raw) {
         ret = redirect_output(data, opts);
@@ -813,7 +952,7 @@ static int show_profile_data(profile_data_t *data, options_t *opts)
         printf("\n");
     }
 
-    if (data->header->mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) {
+    if (data->header->mode & RECORD_MODES) {
         for (t = opts->thread_list; *t != -1; ++t) {
             show_profile_data_log(data, opts, *t - 1);
         }
@@ -828,6 +967,10 @@ static void usage()
     printf("Usage: ucx_read_profile [options] [profile-file]\n");
     printf("Options are:\n");
     printf("  -r              Show raw output\n");
+    printf("  -c              Print the records in Chrome trace JSON format, "
+           "which can be\n"
+           "                  loaded by chrome://tracing or "
+           "https://ui.perfetto.dev\n");
     printf("  -T <threads>    Comma-separated list of threads to show, "
            "e.g. \"1,2,3\", or \"all\" to show all threads\n");
     printf("  -t <units>      Select time units to use:\n");
@@ -842,18 +985,22 @@ static int parse_args(int argc, char **argv, options_t *opts)
 {
     int ret, c;
 
-    opts->raw         = !isatty(fileno(stdout));
-    opts->time_units  = TIME_UNITS_USEC;
+    opts->raw          = !isatty(fileno(stdout));
+    opts->chrome_trace = 0;
+    opts->time_units   = TIME_UNITS_USEC;
     ret = parse_thread_list(opts->thread_list, "all");
     if (ret < 0) {
         return ret;
     }
 
-    while ( (c = getopt(argc, argv, "rT:t:h")) != -1 ) {
+    while ( (c = getopt(argc, argv, "rcT:t:h")) != -1 ) {
         switch (c) {
         case 'r':
             opts->raw = 1;
             break;
+        case 'c':
+            opts->chrome_trace = 1;
+            break;
         case 'T':
             ret = parse_thread_list(opts->thread_list, optarg);
             if (ret < 0) {
@@ -293,7 +293,7 @@ enum ucp_ep_params_flags_field {
                                                            send to a particular
                                                            remote endpoint, for
                                                            example stream */
-    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2)   /**< Send client id
+    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2),  /**< Send client id
                                                            when connecting to remote
                                                            socket address as part of the
                                                            connection request payload.
@@ -301,6 +301,17 @@ enum ucp_ep_params_flags_field {
                                                            can be obtained from
                                                            @ref ucp_conn_request_h using
                                                            @ref ucp_conn_request_query */
+    UCP_EP_PARAMS_FLAGS_STREAM_COALESCE = UCS_BIT(3)  /**< Coalesce small stream
+                                                           sends on the endpoint.
+                                                           Such sends are copied to
+                                                           a staging buffer and
+                                                           complete immediately,
+                                                           and the buffer is sent
+                                                           as one message when it
+                                                           is full, after
+                                                           UCX_STREAM_COALESCE_TIMEOUT,
+                                                           or when the endpoint is
+                                                           flushed. */
 };
 
 
@@ -7,7 +7,7 @@
 #ifndef UCPX_H_
 #define UCPX_H_
 
-#include <ucp/api/ucp_def.h>
+#include <ucp/api/ucp.h>
 #include <ucs/sys/compiler_def.h>
 
 /*
@@ -20,6 +20,257 @@
 BEGIN_C_DECLS
 
 
+/**
+ * @ingroup UCP_COMM
+ * @brief Active Message batch entry.
+ *
+ * Describes a single Active Message of a batch which is sent by
+ * @ref ucp_am_send_nbx_batch. The input fields have the same meaning as the
+ * corresponding arguments of @ref ucp_am_send_nbx.
+ */
+typedef struct ucp_am_batch_entry {
+    ucp_ep_h         ep;            /**< Endpoint to send the message on */
+    unsigned         id;            /**< Active Message id */
+    const void       *header;       /**< User defined Active Message header */
+    size_t           header_length; /**< Active Message header length */
+    const void       *buffer;       /**< Data to send */
+    size_t           count;         /**< Number of elements to send */
+
+    /**
+     * Output: the result of sending this entry, with the same semantics as
+     * the return value of @ref ucp_am_send_nbx.
+     */
+    ucs_status_ptr_t request;
+} ucp_am_batch_entry_t;
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Send a batch of Active Messages.
+ *
+ * This routine sends an array of Active Messages, possibly to different
+ * endpoints of the same worker, as if @ref ucp_am_send_nbx was called for each
+ * entry in order. The worker lock is taken once for the whole batch, and
+ * consecutive entries whose endpoints share a configuration reuse its
+ * protocol selection.
+ *
+ * @note The same operation parameters are used for all entries, and
+ *       @ref UCP_OP_ATTR_FIELD_REQUEST is not allowed. If a send callback is
+ *       requested, it is invoked separately for every entry which returned a
+ *       request handle.
+ *
+ * @param [in]    worker       Worker which all batch endpoints belong to.
+ * @param [inout] entries      Array of messages to send. The @a request field
+ *                             of every entry is set by this routine.
+ * @param [in]    num_entries  Number of entries in @a entries.
+ * @param [in]    param        Operation parameters, see
+ *                             @ref ucp_request_param_t.
+ *
+ * @return UCS_OK           - All messages were sent immediately.
+ * @return UCS_INPROGRESS   - All messages were sent or scheduled, and some of
+ *                            the entries hold request handles which must be
+ *                            released by the application.
+ * @return Error code       - At least one of the messages could not be sent,
+ *                            and the @a request field of every entry must be
+ *                            checked. If @a param is invalid, no entry is
+ *                            sent or updated.
+ */
+ucs_status_t ucp_am_send_nbx_batch(ucp_worker_h worker,
+                                   ucp_am_batch_entry_t *entries,
+                                   size_t num_entries,
+                                   const ucp_request_param_t *param);
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Callback to notify about an Active Message received to a ring buffer.
+ *
+ * The data of the message was placed in the ring buffer number @a index, and
+ * the application owns this buffer until it is posted back to the ring by
+ * @ref ucp_worker_am_recv_ring_post.
+ *
+ * @param [in] arg            User-defined argument.
+ * @param [in] header         User defined active message header, which is
+ *                            valid only inside the callback.
+ * @param [in] header_length  Active message header length in bytes.
+ * @param [in] index          Index of the ring buffer holding the data.
+ * @param [in] length         Length of the data in bytes.
+ * @param [in] status         UCS_OK if the data was received, otherwise an
+ *                            error code. The buffer is returned to the
+ *                            application in both cases.
+ * @param [in] param          Data receive parameters, see
+ *                            @ref ucp_am_recv_param_t.
+ */
+typedef void (*ucp_am_recv_ring_callback_t)(void *arg, const void *header,
+                                            size_t header_length,
+                                            unsigned index, size_t length,
+                                            ucs_status_t status,
+                                            const ucp_am_recv_param_t *param);
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Active Message receive ring parameters.
+ *
+ * The ring consists of @a num_buffers buffers of @a buffer_size bytes each,
+ * placed one after the other starting at @a buffer. Buffer number i starts at
+ * @a buffer + i * @a buffer_size.
+ */
+typedef struct ucp_am_recv_ring_param {
+    unsigned                    id;          /**< Active Message id */
+    void                        *buffer;     /**< Start of the ring memory, or
+                                                  NULL to remove the ring */
+    size_t                      buffer_size; /**< Size of every buffer */
+    unsigned                    num_buffers; /**< Number of buffers */
+    ucp_am_recv_ring_callback_t cb;          /**< Receive notification
+                                                  callback */
+    void                        *arg;        /**< Argument of @a cb */
+} ucp_am_recv_ring_param_t;
+
+
+/**
+ * @ingroup UCP_WORKER
+ * @brief Set a receive ring for an Active Message id.
+ *
+ * The ring lets UCP place the data of multi-fragment eager and rendezvous
+ * Active Messages directly into application buffers, instead of assembling it
+ * in a temporary buffer which the application would copy out. Such messages
+ * consume the posted buffers in the order they were posted, and @a cb is
+ * invoked when the data is placed. A message is passed to the regular
+ * handler set by @ref ucp_worker_set_am_recv_handler if it is larger than
+ * @a buffer_size, if it fits in a single fragment, or if no buffer is posted.
+ *
+ * All buffers are posted when the ring is set. Setting a ring with NULL
+ * @a buffer removes the ring of the Active Message id.
+ *
+ * @note The ring memory must be in host memory.
+ *
+ * @param [in] worker  UCP worker on which to set the ring.
+ * @param [in] param   Ring parameters, see @ref ucp_am_recv_ring_param_t.
+ *
+ * @return UCS_OK           - The ring was set.
+ * @return UCS_ERR_BUSY     - Messages are being received to the current ring
+ *                            of this Active Message id.
+ * @return Error code       - The parameters are invalid, or there is no
+ *                            handler registered for the Active Message id.
+ */
+ucs_status_t ucp_worker_set_am_recv_ring(ucp_worker_h worker,
+                                         const ucp_am_recv_ring_param_t *param);
+
+
+/**
+ * @ingroup UCP_WORKER
+ * @brief Post a buffer back to an Active Message receive ring.
+ *
+ * @param [in] worker  UCP worker which the ring was set on.
+ * @param [in] id      Active Message id of the ring.
+ * @param [in] index   Index of the buffer to post, as passed to
+ *                     @ref ucp_am_recv_ring_callback_t.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t ucp_worker_am_recv_ring_post(ucp_worker_h worker, unsigned id,
+                                          unsigned index);
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Maximal number of dimensions of a strided datatype.
+ */
+#define UCP_DT_STRIDED_MAX_DIMS 4
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Dimension of a strided datatype.
+ */
+typedef struct ucp_dt_strided_dim {
+    size_t  count;  /**< Number of items in the dimension */
+    ssize_t stride; /**< Distance in bytes between the beginnings of
+                         consecutive items */
+} ucp_dt_strided_dim_t;
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Strided datatype description.
+ *
+ * A strided datatype element consists of contiguous blocks of @a elem_size
+ * bytes, arranged in up to @ref UCP_DT_STRIDED_MAX_DIMS nested dimensions.
+ * Block number (i0, i1, ...) starts at the byte offset
+ * i0 * dims[0].stride + i1 * dims[1].stride + ... from the element address,
+ * and blocks are packed in the order of increasing i0, then i1, and so on.
+ *
+ * When the datatype is used with count > 1, element number k starts at the
+ * byte offset k * @a extent from the buffer address.
+ *
+   @verbatim
+    buffer
+    |
+    +-----------+-------+-----------+-------+-----------+
+    | elem_size | empty | elem_size | empty | elem_size |
+    +-----------+-------+-----------+-------+-----------+
+    |<--- dims[0].stride -->|
+   @endverbatim
+ */
+typedef struct ucp_dt_strided_param {
+    size_t               elem_size; /**< Size of a contiguous block in bytes */
+    unsigned             num_dims;  /**< Number of dimensions in @a dims */
+
+    /**
+     * Dimensions of the datatype, dims[0] is the innermost one
+     */
+    ucp_dt_strided_dim_t dims[UCP_DT_STRIDED_MAX_DIMS];
+
+    /**
+     * Distance in bytes between consecutive datatype elements. If 0, the
+     * elements follow each other with the extent of the outermost dimension.
+     */
+    ssize_t              extent;
+} ucp_dt_strided_param_t;
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Create a strided datatype.
+ *
+ * This routine creates a datatype of blocks with fixed size and strides, such
+ * as a column of a matrix or a face of a 3D halo. The data is gathered and
+ * scattered by UCP without per-block callbacks or scatter-gather lists.
+ * The datatype must be released by @ref ucp_dt_destroy.
+ *
+ * @note The buffer of a strided datatype must be in host memory.
+ *
+ * @param [in]  param       Strided datatype description.
+ * @param [out] datatype_p  Filled with the datatype handle.
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ */
+ucs_status_t ucp_dt_create_strided(const ucp_dt_strided_param_t *param,
+                                   ucp_datatype_t *datatype_p);
+
+
+/**
+ * @ingroup UCP_MEM
+ * @brief Invalidate cached remote keys of an endpoint.
+ *
+ * When UCX_RKEY_CACHE_SIZE is set, @ref ucp_ep_rkey_unpack returns the same
+ * remote key handle for repeated unpacks of an identical packed buffer on the
+ * endpoint. Since the remote side may unmap the memory and reuse its packed
+ * key for a new mapping, the application must invalidate the cached entry when
+ * it learns that the remote memory was unmapped. Remote key handles which were
+ * already returned to the application remain valid until they are destroyed
+ * with @ref ucp_rkey_destroy.
+ *
+ * @param [in] ep           Endpoint whose cache should be updated.
+ * @param [in] rkey_buffer  Packed remote key buffer to invalidate, or NULL to
+ *                          invalidate all remote keys cached on @a ep.
+ *
+ * @return UCS_OK           - The remote key was removed from the cache.
+ * @return UCS_ERR_NO_ELEM  - @a rkey_buffer was not found in the cache.
+ */
+ucs_status_t ucp_ep_rkey_cache_invalidate(ucp_ep_h ep, const void *rkey_buffer);
+
 
 END_C_DECLS
 
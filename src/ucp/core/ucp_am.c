@@ -17,6 +17,7 @@
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_context.h>
+#include <ucp/api/ucpx.h>
 #include <ucp/rndv/rndv.inl>
 #include <ucp/proto/proto_am.inl>
 #include <ucp/proto/proto_common.inl>
@@ -36,10 +37,16 @@ ucs_status_t ucp_am_init(ucp_worker_h worker)
 
 void ucp_am_cleanup(ucp_worker_h worker)
 {
+    ucp_am_entry_t *am_cb;
+
     if (!(worker->context->config.features & UCP_FEATURE_AM)) {
         return;
     }
 
+    ucs_array_for_each(am_cb, &worker->am.cbs) {
+        ucs_free(am_cb->ring);
+    }
+
     ucs_array_cleanup_dynamic(&worker->am.cbs);
 }
 
@@ -53,6 +60,94 @@ void ucp_am_ep_init(ucp_ep_h ep)
     }
 }
 
+static UCS_F_ALWAYS_INLINE ucp_am_recv_ring_t *
+ucp_am_recv_ring_get(ucp_worker_h worker, uint16_t am_id, size_t length)
+{
+    ucp_am_recv_ring_t *ring;
+
+    if (am_id >= ucs_array_length(&worker->am.cbs)) {
+        return NULL;
+    }
+
+    ring = ucs_array_elem(&worker->am.cbs, am_id).ring;
+    if ((ring == NULL) || (ring->count == 0) ||
+        (length > ring->buffer_size)) {
+        return NULL;
+    }
+
+    return ring;
+}
+
+static unsigned
+ucp_am_recv_ring_index(const ucp_am_recv_ring_t *ring, const void *buffer)
+{
+    return UCS_PTR_BYTE_DIFF(ring->buffer, buffer) / ring->buffer_size;
+}
+
+static void ucp_am_recv_ring_push(ucp_am_recv_ring_t *ring, unsigned index)
+{
+    ucs_assert(ring->count < ring->num_buffers);
+    ring->posted[(ring->head + ring->count) % ring->num_buffers] = index;
+    ++ring->count;
+}
+
+/* Take the next posted buffer for a message which is about to be received */
+static void *ucp_am_recv_ring_pop(ucp_am_recv_ring_t *ring)
+{
+    unsigned index;
+
+    ucs_assert(ring->count > 0);
+    index      = ring->posted[ring->head];
+    ring->head = (ring->head + 1) % ring->num_buffers;
+    --ring->count;
+    ++ring->inflight;
+
+    return UCS_PTR_BYTE_OFFSET(ring->buffer, index * ring->buffer_size);
+}
+
+/* Return a buffer to the ring without notifying the user */
+static void ucp_am_recv_ring_cancel(ucp_am_recv_ring_t *ring, void *buffer)
+{
+    ucs_assert(ring->inflight > 0);
+    --ring->inflight;
+    ucp_am_recv_ring_push(ring, ucp_am_recv_ring_index(ring, buffer));
+}
+
+static void
+ucp_am_recv_ring_complete(ucp_am_recv_ring_t *ring, void *buffer,
+                          const void *user_hdr, size_t user_hdr_length,
+                          size_t length, ucs_status_t status,
+                          ucp_ep_h reply_ep, uint64_t recv_flags)
+{
+    ucp_am_recv_param_t param;
+
+    ucs_assert(ring->inflight > 0);
+    --ring->inflight;
+
+    param.recv_attr = recv_flags;
+    param.reply_ep  = reply_ep;
+    ring->cb(ring->arg, user_hdr, user_hdr_length,
+             ucp_am_recv_ring_index(ring, buffer), length, status, &param);
+}
+
+/* Release the first fragment descriptor of an unfinished message */
+static void
+ucp_am_release_first_rdesc(ucp_worker_h worker, ucp_recv_desc_t *first_rdesc)
+{
+    ucp_am_first_ftr_t *first_ftr;
+    ucp_am_hdr_t *hdr;
+
+    if (first_rdesc->flags & UCP_RECV_DESC_FLAG_AM_RING) {
+        first_ftr = (ucp_am_first_ftr_t*)(first_rdesc + 1);
+        hdr       = (ucp_am_hdr_t*)(first_ftr + 1);
+        ucp_am_recv_ring_cancel(ucs_array_elem(&worker->am.cbs,
+                                               hdr->am_id).ring,
+                                first_rdesc->am_first.payload);
+    }
+
+    ucs_free(first_rdesc);
+}
+
 void ucp_am_ep_cleanup(ucp_ep_h ep)
 {
     ucp_ep_ext_t *ep_ext = ep->ext;
@@ -68,7 +163,7 @@ void ucp_am_ep_cleanup(ucp_ep_h ep)
     ucs_list_for_each_safe(rdesc, tmp_rdesc, &ep_ext->am.started_ams,
                            am_first.list) {
         ucs_list_del(&rdesc->am_first.list);
-        ucs_free(rdesc);
+        ucp_am_release_first_rdesc(ep->worker, rdesc);
         ++count;
     }
     ucs_trace_data("worker %p: %zu unhandled first AM fragments have been"
@@ -189,7 +284,8 @@ static ucs_status_t ucp_worker_set_am_handler_common(ucp_worker_h worker,
     static const ucp_am_entry_t empty_am_handler = {
         .cb      = NULL,
         .context = NULL,
-        .flags   = 0
+        .flags   = 0,
+        .ring    = NULL
     };
 
     UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_AM,
@@ -359,6 +455,108 @@ out:
     return status;
 }
 
+ucs_status_t ucp_worker_set_am_recv_ring(ucp_worker_h worker,
+                                         const ucp_am_recv_ring_param_t *param)
+{
+    ucp_am_recv_ring_t *ring = NULL;
+    ucp_am_entry_t *am_cb;
+    ucs_status_t status;
+    unsigned i;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_AM,
+                                    return UCS_ERR_INVALID_PARAM);
+
+    status = ucp_am_check_id(param->id);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if ((param->buffer != NULL) &&
+        ((param->buffer_size == 0) || (param->num_buffers == 0) ||
+         (param->cb == NULL))) {
+        ucs_error("invalid AM receive ring: buffer_size %zu num_buffers %u "
+                  "cb %p", param->buffer_size, param->num_buffers, param->cb);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    if ((param->id >= ucs_array_length(&worker->am.cbs)) ||
+        !(ucs_array_elem(&worker->am.cbs, param->id).flags &
+          UCP_AM_CB_PRIV_FLAG_NBX)) {
+        ucs_error("AM receive ring requires a handler set by "
+                  "ucp_worker_set_am_recv_handler() for id %u", param->id);
+        status = UCS_ERR_INVALID_PARAM;
+        goto out;
+    }
+
+    am_cb = &ucs_array_elem(&worker->am.cbs, param->id);
+    if ((am_cb->ring != NULL) && (am_cb->ring->inflight > 0)) {
+        status = UCS_ERR_BUSY;
+        goto out;
+    }
+
+    if (param->buffer != NULL) {
+        ring = ucs_malloc(sizeof(*ring) +
+                                  (param->num_buffers * sizeof(*ring->posted)),
+                          "ucp_am_recv_ring");
+        if (ring == NULL) {
+            status = UCS_ERR_NO_MEMORY;
+            goto out;
+        }
+
+        ring->buffer      = param->buffer;
+        ring->buffer_size = param->buffer_size;
+        ring->num_buffers = param->num_buffers;
+        ring->cb          = param->cb;
+        ring->arg         = param->arg;
+        ring->inflight    = 0;
+        ring->head        = 0;
+        ring->count       = 0;
+        for (i = 0; i < ring->num_buffers; ++i) {
+            ucp_am_recv_ring_push(ring, i);
+        }
+    }
+
+    ucs_free(am_cb->ring);
+    am_cb->ring = ring;
+
+    ucs_debug("worker %p: AM id %u receive ring %p buffer %p size %zu count %u",
+              worker, param->id, ring, param->buffer, param->buffer_size,
+              param->num_buffers);
+
+out:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+    return status;
+}
+
+ucs_status_t ucp_worker_am_recv_ring_post(ucp_worker_h worker, unsigned id,
+                                          unsigned index)
+{
+    ucp_am_recv_ring_t *ring;
+    ucs_status_t status;
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    ring = (id < ucs_array_length(&worker->am.cbs)) ?
+           ucs_array_elem(&worker->am.cbs, id).ring : NULL;
+    if (ENABLE_PARAMS_CHECK &&
+        ((ring == NULL) || (index >= ring->num_buffers) ||
+         (ring->count == ring->num_buffers))) {
+        ucs_error("invalid post of buffer %u to AM id %u receive ring %p",
+                  index, id, ring);
+        status = UCS_ERR_INVALID_PARAM;
+        goto out;
+    }
+
+    ucp_am_recv_ring_push(ring, index);
+    status = UCS_OK;
+
+out:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+    return status;
+}
+
 static UCS_F_ALWAYS_INLINE ssize_t
 ucp_am_bcopy_pack_data(void *buffer, ucp_request_t *req, size_t length)
 {
@@ -936,11 +1134,22 @@ ucp_am_send_nbx_check_header_length(ucp_worker_h worker, size_t header_length)
     return UCS_OK;
 }
 
-UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
-                 (ep, id, header, header_length, buffer, count, param),
-                 ucp_ep_h ep, unsigned id, const void *header,
-                 size_t header_length, const void *buffer, size_t count,
-                 const ucp_request_param_t *param)
+static UCS_F_ALWAYS_INLINE ucs_status_ptr_t
+ucp_am_send_nbx_check_param(ucp_worker_h worker,
+                            const ucp_request_param_t *param)
+{
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_AM,
+                                    return UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM));
+    UCP_REQUEST_CHECK_PARAM(param);
+    return UCS_STATUS_PTR(UCS_OK);
+}
+
+/* Must be called with the worker thread lock held */
+static UCS_F_ALWAYS_INLINE ucs_status_ptr_t
+ucp_am_send_nbx_common(ucp_ep_h ep, ucp_ep_config_t *ep_config, unsigned id,
+                       const void *header, size_t header_length,
+                       const void *buffer, size_t count,
+                       const ucp_request_param_t *param)
 {
     ucp_worker_h worker = ep->worker;
     ucs_status_t status;
@@ -954,21 +1163,14 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
     size_t contig_length;
     ucp_operation_id_t op_id;
 
-    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_AM,
-                                    return UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM));
-    UCP_REQUEST_CHECK_PARAM(param);
-
     status = ucp_am_check_id(id);
     if (status != UCS_OK) {
         return UCS_STATUS_PTR(status);
     }
 
-    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
-
     status = ucp_am_send_nbx_check_header_length(worker, header_length);
     if (status != UCS_OK) {
-        ret = UCS_STATUS_PTR(status);
-        goto out;
+        return UCS_STATUS_PTR(status);
     }
 
     flags     = ucp_request_param_flags(param);
@@ -976,25 +1178,24 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
                 (UCP_OP_ATTR_FIELD_DATATYPE | UCP_OP_ATTR_FLAG_NO_IMM_CMPL);
 
     if (flags & UCP_AM_SEND_FLAG_REPLY) {
-        max_short = &ucp_ep_config(ep)->am_u.max_reply_eager_short;
-        proto     = ucp_ep_config(ep)->am_u.reply_proto;
+        max_short = &ep_config->am_u.max_reply_eager_short;
+        proto     = ep_config->am_u.reply_proto;
         op_id     = UCP_OP_ID_AM_SEND_REPLY;
     } else {
-        max_short = &ucp_ep_config(ep)->am_u.max_eager_short;
-        proto     = ucp_ep_config(ep)->am_u.proto;
+        max_short = &ep_config->am_u.max_eager_short;
+        proto     = ep_config->am_u.proto;
         op_id     = UCP_OP_ID_AM_SEND;
     }
 
     status = ucp_am_params_check_memh(param, &flags);
     if (ucs_unlikely(status != UCS_OK)) {
-        ret = UCS_STATUS_PTR(status);
-        goto out;
+        return UCS_STATUS_PTR(status);
     }
 
     if (ucs_likely(attr_mask == 0)) {
         status = ucp_am_try_send_short(ep, id, flags, header, header_length,
                                        buffer, count, max_short, param);
-        ucp_request_send_check_status(status, ret, goto out);
+        ucp_request_send_check_status(status, ret, return ret);
         datatype      = ucp_dt_make_contig(1);
         contig_length = count;
     } else if (attr_mask == UCP_OP_ATTR_FIELD_DATATYPE) {
@@ -1004,7 +1205,7 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
             status = ucp_am_try_send_short(ep, id, flags, header, header_length,
                                            buffer, contig_length, max_short,
                                            param);
-            ucp_request_send_check_status(status, ret, goto out);
+            ucp_request_send_check_status(status, ret, return ret);
         } else {
             contig_length = 0ul;
         }
@@ -1014,21 +1215,18 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
     }
 
     if (ucs_unlikely(param->op_attr_mask & UCP_OP_ATTR_FLAG_FORCE_IMM_CMPL)) {
-        ret = UCS_STATUS_PTR(UCS_ERR_NO_RESOURCE);
-        goto out;
+        return UCS_STATUS_PTR(UCS_ERR_NO_RESOURCE);
     }
 
     /* TODO: move from common code to specific protocols (REPLY_EP, multi-Eager
      * Bcopy/Zcopy,RNDV) which use remote ID */
     status = ucp_ep_resolve_remote_id(ep, ep->am_lane);
     if (ucs_unlikely(status != UCS_OK)) {
-        ret = UCS_STATUS_PTR(status);
-        goto out;
+        return UCS_STATUS_PTR(status);
     }
 
     req = ucp_request_get_param(worker, param,
-                                {ret = UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
-                                 goto out;});
+                                return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY));
 
     if (worker->context->config.ext.proto_enable) {
         req->send.msg_proto.am.am_id           = id;
@@ -1037,27 +1235,105 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
         req->send.msg_proto.am.header.ptr      = (void*)header;
         req->send.msg_proto.am.header.reg_desc = NULL;
         req->send.msg_proto.am.header.length   = header_length;
-        ret = ucp_proto_request_send_op(ep, &ucp_ep_config(ep)->proto_select,
-                                        UCP_WORKER_CFG_INDEX_NULL, req, 0,
-                                        op_id, buffer, count, datatype,
-                                        contig_length, param, header_length,
-                                        ucp_am_send_nbx_get_op_flag(flags));
-    } else {
-        ucp_am_send_req_init(req, ep, header, header_length, buffer, datatype,
-                             count, flags, id, param);
+        return ucp_proto_request_send_op(ep, &ep_config->proto_select,
+                                         UCP_WORKER_CFG_INDEX_NULL, req, 0,
+                                         op_id, buffer, count, datatype,
+                                         contig_length, param, header_length,
+                                         ucp_am_send_nbx_get_op_flag(flags));
+    }
 
-        /* Note that max_eager_short.memtype_on is always initialized to real
-         * max_short value
-         */
-        ret = ucp_am_send_req(req, count, &ucp_ep_config(ep)->am, param, proto,
-                              max_short->memtype_on, flags);
+    ucp_am_send_req_init(req, ep, header, header_length, buffer, datatype,
+                         count, flags, id, param);
+
+    /* Note that max_eager_short.memtype_on is always initialized to real
+     * max_short value
+     */
+    return ucp_am_send_req(req, count, &ep_config->am, param, proto,
+                           max_short->memtype_on, flags);
+}
+
+UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
+                 (ep, id, header, header_length, buffer, count, param),
+                 ucp_ep_h ep, unsigned id, const void *header,
+                 size_t header_length, const void *buffer, size_t count,
+                 const ucp_request_param_t *param)
+{
+    ucp_worker_h worker = ep->worker;
+    ucs_status_ptr_t ret;
+
+    ret = ucp_am_send_nbx_check_param(worker, param);
+    if (ucs_unlikely(UCS_PTR_IS_ERR(ret))) {
+        return ret;
     }
 
-out:
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+    ret = ucp_am_send_nbx_common(ep, ucp_ep_config(ep), id, header,
+                                 header_length, buffer, count, param);
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+
     return ret;
 }
 
+UCS_PROFILE_FUNC(ucs_status_t, ucp_am_send_nbx_batch,
+                 (worker, entries, num_entries, param), ucp_worker_h worker,
+                 ucp_am_batch_entry_t *entries, size_t num_entries,
+                 const ucp_request_param_t *param)
+{
+    ucp_worker_cfg_index_t cfg_index = UCP_WORKER_CFG_INDEX_NULL;
+    ucp_ep_config_t *ep_config       = NULL;
+    ucs_status_t ret_status          = UCS_OK;
+    ucp_am_batch_entry_t *entry;
+    ucs_status_ptr_t ret;
+
+    ret = ucp_am_send_nbx_check_param(worker, param);
+    if (ucs_unlikely(UCS_PTR_IS_ERR(ret))) {
+        return UCS_PTR_STATUS(ret);
+    }
+
+    if (ENABLE_PARAMS_CHECK &&
+        ucs_unlikely(param->op_attr_mask & UCP_OP_ATTR_FIELD_REQUEST)) {
+        ucs_error("user-allocated request can not be used for a batch send");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    ucs_carray_for_each(entry, entries, num_entries) {
+        if (ENABLE_PARAMS_CHECK && ucs_unlikely(entry->ep->worker != worker)) {
+            ucs_error("batch entry %zu: endpoint %p does not belong to worker "
+                      "%p", entry - entries, entry->ep, worker);
+            entry->request = UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM);
+        } else {
+            /* Entries to endpoints which share a configuration reuse its
+             * thresholds and protocol selection, which also keeps the
+             * selection lookup cache of that configuration warm */
+            if (entry->ep->cfg_index != cfg_index) {
+                cfg_index = entry->ep->cfg_index;
+                ep_config = ucp_ep_config(entry->ep);
+            }
+
+            entry->request = ucp_am_send_nbx_common(entry->ep, ep_config,
+                                                    entry->id, entry->header,
+                                                    entry->header_length,
+                                                    entry->buffer, entry->count,
+                                                    param);
+        }
+
+        if (UCS_PTR_IS_PTR(entry->request)) {
+            if (ret_status == UCS_OK) {
+                ret_status = UCS_INPROGRESS;
+            }
+        } else if (UCS_PTR_IS_ERR(entry->request) &&
+                   !UCS_STATUS_IS_ERR(ret_status)) {
+            ret_status = UCS_PTR_STATUS(entry->request);
+        }
+    }
+
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+
+    return ret_status;
+}
+
 ucs_status_ptr_t ucp_am_send_nb(ucp_ep_h ep, uint16_t id, const void *payload,
                                 size_t count, ucp_datatype_t datatype,
                                 ucp_send_callback_t cb, unsigned flags)
@@ -1365,7 +1641,8 @@ ucp_am_copy_data_fragment(ucp_recv_desc_t *first_rdesc, void *data,
                           size_t length, size_t offset)
 {
     UCS_PROFILE_NAMED_CALL("am_memcpy_recv", ucs_memcpy_relaxed,
-                           UCS_PTR_BYTE_OFFSET(first_rdesc + 1, offset),
+                           UCS_PTR_BYTE_OFFSET(first_rdesc->am_first.payload,
+                                               offset),
                            data, length, UCS_ARCH_MEMCPY_NT_SOURCE, length);
     first_rdesc->am_first.remaining -= length;
 }
@@ -1411,14 +1688,24 @@ ucp_am_handle_unfinished(ucp_worker_h worker, ucp_recv_desc_t *first_rdesc,
     first_ftr       = (ucp_am_first_ftr_t*)(first_rdesc + 1);
     hdr             = (ucp_am_hdr_t*)(first_ftr + 1);
     recv_flags      = ucp_am_hdr_reply_ep(worker, hdr->flags, reply_ep,
-                                          &reply_ep) |
-                      UCP_AM_RECV_ATTR_FLAG_DATA;
-    payload         = UCS_PTR_BYTE_OFFSET(first_rdesc + 1,
-                                          first_rdesc->payload_offset);
+                                          &reply_ep);
+    payload         = first_rdesc->am_first.payload;
     am_id           = hdr->am_id;
     user_hdr_length = hdr->header_length;
     total_size      = first_ftr->total_size;
-    user_hdr        = UCS_PTR_BYTE_OFFSET(payload, total_size);
+
+    if (first_rdesc->flags & UCP_RECV_DESC_FLAG_AM_RING) {
+        /* Data is already in the ring buffer, and the user header follows the
+         * base header in the descriptor */
+        ucp_am_recv_ring_complete(ucs_array_elem(&worker->am.cbs, am_id).ring,
+                                  payload, hdr + 1, user_hdr_length,
+                                  total_size, UCS_OK, reply_ep, recv_flags);
+        ucs_free(first_rdesc);
+        return;
+    }
+
+    recv_flags |= UCP_AM_RECV_ATTR_FLAG_DATA;
+    user_hdr    = UCS_PTR_BYTE_OFFSET(payload, total_size);
 
     /* Need to reinit descriptor, because we have two headers between rdesc and
      * the data. In ucp_am_data_release() and ucp_am_recv_data_nbx() functions,
@@ -1462,12 +1749,13 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_first_handler,
     ucp_am_mid_hdr_t *mid_hdr;
     ucp_am_mid_ftr_t *mid_ftr;
     ucp_am_first_ftr_t *first_ftr;
+    ucp_am_recv_ring_t *ring;
     ucs_queue_iter_t iter;
     ucp_ep_h ep;
     ucp_ep_ext_t *ep_ext;
     size_t total_length, padding;
     uint64_t recv_flags;
-    void *user_hdr;
+    void *user_hdr, *user_hdr_dst;
 
     first_ftr = UCS_PTR_BYTE_OFFSET(am_data, am_length - sizeof(*first_ftr));
 
@@ -1493,31 +1781,64 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_first_handler,
     ucs_assert(NULL == ucp_am_find_first_rdesc(worker, ep_ext,
                                                first_ftr->super.msg_id));
 
-    /* Alloc buffer for the data and its desc, as we know total_size.
-     * Need to allocate a separate rdesc which would be in one contiguous chunk
-     * with data buffer. The layout of assembled message is below:
-     *
-     * +-------+-----------+--------+---------+---------+----------+
-     * | rdesc | first_ftr | am_hdr | padding | payload | user hdr |
-     * +-------+-----------+--------+---------+---------+----------+
-     *
-     * Note: footer is added right after rdesc (unlike wire format) for easier
-     * access to it while processing incoming fragments.
-     */
-    first_rdesc = ucs_malloc(total_length + sizeof(ucp_recv_desc_t) +
-                                     worker->am.alignment,
-                             "ucp recv desc for long AM");
-    if (ucs_unlikely(first_rdesc == NULL)) {
-        ucs_error("failed to allocate buffer for assembling UCP AM (id %u)",
-                  hdr->am_id);
-        return UCS_OK; /* release UCT desc */
-    }
+    ring = ucp_am_recv_ring_get(worker, hdr->am_id, first_ftr->total_size);
+    if (ring != NULL) {
+        /* The data is assembled in the next posted ring buffer, so the desc
+         * holds only the headers:
+         *
+         * +-------+-----------+--------+----------+
+         * | rdesc | first_ftr | am_hdr | user hdr |
+         * +-------+-----------+--------+----------+
+         */
+        first_rdesc = ucs_malloc(sizeof(ucp_recv_desc_t) +
+                                         UCP_AM_FIRST_FRAG_META_LEN +
+                                         user_hdr_length,
+                                 "ucp recv desc for ring AM");
+        if (ucs_unlikely(first_rdesc == NULL)) {
+            ucs_error("failed to allocate descriptor for UCP AM (id %u)",
+                      hdr->am_id);
+            return UCS_OK; /* release UCT desc */
+        }
 
-    padding = ucs_padding((uintptr_t)UCS_PTR_BYTE_OFFSET(
-                                  first_rdesc + 1, UCP_AM_FIRST_FRAG_META_LEN),
-                          worker->am.alignment);
+        first_rdesc->flags            = UCP_RECV_DESC_FLAG_AM_RING;
+        first_rdesc->payload_offset   = UCP_AM_FIRST_FRAG_META_LEN;
+        first_rdesc->am_first.payload = ucp_am_recv_ring_pop(ring);
+        user_hdr_dst                  = UCS_PTR_BYTE_OFFSET(
+                first_rdesc + 1, first_rdesc->payload_offset);
+    } else {
+        /* Alloc buffer for the data and its desc, as we know total_size.
+         * Need to allocate a separate rdesc which would be in one contiguous
+         * chunk with data buffer. The layout of assembled message is below:
+         *
+         * +-------+-----------+--------+---------+---------+----------+
+         * | rdesc | first_ftr | am_hdr | padding | payload | user hdr |
+         * +-------+-----------+--------+---------+---------+----------+
+         *
+         * Note: footer is added right after rdesc (unlike wire format) for
+         * easier access to it while processing incoming fragments.
+         */
+        first_rdesc = ucs_malloc(total_length + sizeof(ucp_recv_desc_t) +
+                                         worker->am.alignment,
+                                 "ucp recv desc for long AM");
+        if (ucs_unlikely(first_rdesc == NULL)) {
+            ucs_error("failed to allocate buffer for assembling UCP AM "
+                      "(id %u)", hdr->am_id);
+            return UCS_OK; /* release UCT desc */
+        }
+
+        padding = ucs_padding((uintptr_t)UCS_PTR_BYTE_OFFSET(
+                                      first_rdesc + 1,
+                                      UCP_AM_FIRST_FRAG_META_LEN),
+                              worker->am.alignment);
+
+        first_rdesc->flags            = 0;
+        first_rdesc->payload_offset   = UCP_AM_FIRST_FRAG_META_LEN + padding;
+        first_rdesc->am_first.payload = UCS_PTR_BYTE_OFFSET(
+                first_rdesc + 1, first_rdesc->payload_offset);
+        user_hdr_dst                  = UCS_PTR_BYTE_OFFSET(
+                first_rdesc->am_first.payload, first_ftr->total_size);
+    }
 
-    first_rdesc->payload_offset     = UCP_AM_FIRST_FRAG_META_LEN + padding;
     first_rdesc->am_first.remaining = first_ftr->total_size;
 
     /* Copy first fragment and base headers before the data, it will be needed
@@ -1533,10 +1854,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_first_handler,
 
     /* Copy user header to the end of message */
     user_hdr = UCS_PTR_BYTE_OFFSET(first_ftr, -user_hdr_length);
-    UCS_PROFILE_NAMED_CALL("am_memcpy_recv", ucs_memcpy_relaxed,
-                           UCS_PTR_BYTE_OFFSET(first_rdesc + 1,
-                                               first_rdesc->payload_offset +
-                                                       first_ftr->total_size),
+    UCS_PROFILE_NAMED_CALL("am_memcpy_recv", ucs_memcpy_relaxed, user_hdr_dst,
                            user_hdr, user_hdr_length,
                            UCS_ARCH_MEMCPY_NT_SOURCE, user_hdr_length);
 
@@ -1553,8 +1871,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_first_handler,
         ucs_queue_del_iter(&ep_ext->am.mid_rdesc_q, iter);
         ucp_am_copy_data_fragment(first_rdesc, mid_hdr + 1,
                                   mid_rdesc->length - UCP_AM_MID_FRAG_META_LEN,
-                                  mid_hdr->offset +
-                                          first_rdesc->payload_offset);
+                                  mid_hdr->offset);
         ucp_recv_desc_release(mid_rdesc);
     }
 
@@ -1565,7 +1882,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_first_handler,
     ucp_am_handle_unfinished(worker, first_rdesc, hdr + 1,
                              am_length - (user_hdr_length +
                                           UCP_AM_FIRST_FRAG_META_LEN),
-                             first_rdesc->payload_offset, ep);
+                             0, ep);
 
     return UCS_OK; /* release UCT desc */
 }
@@ -1597,8 +1914,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_middle_handler,
         /* First fragment already arrived, just copy the data */
         ucp_am_handle_unfinished(worker, first_rdesc, mid_hdr + 1,
                                  am_length - UCP_AM_MID_FRAG_META_LEN,
-                                 mid_hdr->offset + first_rdesc->payload_offset,
-                                 ep);
+                                 mid_hdr->offset, ep);
         return UCS_OK; /* data is copied, release UCT desc */
     }
 
@@ -1620,6 +1936,92 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_long_middle_handler,
     return status;
 }
 
+static void ucp_am_recv_ring_rndv_completed(void *request, ucs_status_t status,
+                                            size_t length, void *user_data)
+{
+    ucp_am_recv_ring_rndv_t *ring_rndv = user_data;
+    uint64_t recv_flags                = 0;
+    ucp_ep_h reply_ep                  = NULL;
+
+    if (status == UCS_OK) {
+        recv_flags = ring_rndv->recv_flags;
+        reply_ep   = ring_rndv->reply_ep;
+    }
+
+    ucp_am_recv_ring_complete(ring_rndv->ring, ring_rndv->buffer,
+                              ring_rndv + 1, ring_rndv->header_length, length,
+                              status, reply_ep, recv_flags);
+    ucs_free(ring_rndv);
+}
+
+/* Start receiving rendezvous data to the next posted ring buffer */
+static ucs_status_t
+ucp_am_recv_ring_rndv_start(ucp_worker_h worker, ucp_am_recv_ring_t *ring,
+                            ucp_recv_desc_t *desc, const void *user_hdr,
+                            ucp_ep_h reply_ep, uint64_t recv_flags)
+{
+    ucp_rndv_rts_hdr_t *rts = (ucp_rndv_rts_hdr_t*)(desc + 1);
+    uint32_t user_hdr_length = ucp_am_hdr_from_rts(rts)->header_length;
+    ucp_am_recv_ring_rndv_t *ring_rndv;
+    ucp_request_t *req;
+    ucs_status_t status;
+
+    ring_rndv = ucs_malloc(sizeof(*ring_rndv) + user_hdr_length,
+                           "ucp_am_recv_ring_rndv");
+    if (ring_rndv == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    req = ucp_request_get(worker);
+    if (req == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_free;
+    }
+
+    ring_rndv->ring          = ring;
+    ring_rndv->buffer        = ucp_am_recv_ring_pop(ring);
+    ring_rndv->reply_ep      = reply_ep;
+    ring_rndv->recv_flags    = recv_flags;
+    ring_rndv->header_length = user_hdr_length;
+    memcpy(ring_rndv + 1, user_hdr, user_hdr_length);
+
+    /* Internal request, released when the data is received */
+    req->status       = UCS_OK;
+    req->recv.worker  = worker;
+    req->flags        = UCP_REQUEST_FLAG_RECV_AM | UCP_REQUEST_FLAG_CALLBACK |
+                        UCP_REQUEST_FLAG_RELEASED;
+    req->recv.op_attr = 0;
+    req->recv.am.desc = desc;
+    req->recv.am.cb   = ucp_am_recv_ring_rndv_completed;
+    req->user_data    = ring_rndv;
+
+    status = ucp_datatype_iter_init_unpack(worker->context, ring_rndv->buffer,
+                                           rts->size, &req->recv.dt_iter,
+                                           &ucp_request_null_param);
+    if (status != UCS_OK) {
+        goto err_put_req;
+    }
+
+#if ENABLE_DEBUG_DATA
+    req->recv.proto_rndv_config = NULL;
+#endif
+
+    ucs_trace("worker %p: AM rndv receive %p to ring buffer %p", worker, req,
+              ring_rndv->buffer);
+
+    desc->flags |= UCP_RECV_DESC_FLAG_RECV_STARTED;
+    ucp_rndv_receive_start(worker, req, rts, rts + 1,
+                           desc->length - sizeof(*rts) - user_hdr_length);
+    return UCS_OK;
+
+err_put_req:
+    ucp_request_put(req);
+    ucp_am_recv_ring_cancel(ring, ring_rndv->buffer);
+err_free:
+    ucs_free(ring_rndv);
+    return status;
+}
+
 ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
                                      unsigned tl_flags)
 {
@@ -1629,6 +2031,7 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
     uint16_t am_id          = am->am_id;
     ucp_recv_desc_t *desc   = NULL;
     ucp_am_entry_t *am_cb   = &ucs_array_elem(&worker->am.cbs, am_id);
+    ucp_am_recv_ring_t *ring;
     ucp_ep_h ep;
     ucp_am_recv_param_t param;
     ucs_status_t status, desc_status;
@@ -1670,11 +2073,26 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
         goto out_send_ats;
     }
 
-    param.recv_attr = UCP_AM_RECV_ATTR_FLAG_RNDV |
-                      ucp_am_hdr_reply_ep(worker, am->flags, ep,
+    param.recv_attr = ucp_am_hdr_reply_ep(worker, am->flags, ep,
                                           &param.reply_ep);
-    status          = am_cb->cb(am_cb->context, hdr, am->header_length,
-                                desc + 1, rts->size, &param);
+
+    ring = ucp_am_recv_ring_get(worker, am_id, rts->size);
+    if ((ring != NULL) && (rts->size > 0) &&
+        (ucp_am_recv_ring_rndv_start(worker, ring, desc, hdr, param.reply_ep,
+                                     param.recv_attr) == UCS_OK)) {
+        if (desc->flags & UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS) {
+            /* Keep the descriptor until the data is received */
+            desc->flags &= ~UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS;
+            return desc_status;
+        }
+
+        /* Data was already received */
+        goto out;
+    }
+
+    param.recv_attr |= UCP_AM_RECV_ATTR_FLAG_RNDV;
+    status           = am_cb->cb(am_cb->context, hdr, am->header_length,
+                                 desc + 1, rts->size, &param);
     if (ucp_am_rdesc_in_progress(desc, status)) {
         /* User either wants to save descriptor for later use or initiated
          * rendezvous receive (by ucp_am_recv_data_nbx) in the callback. */
@@ -10,6 +10,7 @@
 
 
 #include <ucs/datastruct/array.h>
+#include <ucp/api/ucpx.h>
 #include <ucp/rndv/rndv.h>
 
 
@@ -33,6 +34,35 @@ enum {
 };
 
 
+/**
+ * Ring of application buffers which receive AM data of a specific id
+ */
+typedef struct ucp_am_recv_ring {
+    void                        *buffer;      /* Start of the ring memory */
+    size_t                      buffer_size;  /* Size of every buffer */
+    unsigned                    num_buffers;  /* Number of buffers */
+    ucp_am_recv_ring_callback_t cb;           /* Receive notification callback */
+    void                        *arg;         /* User argument of cb */
+    unsigned                    inflight;     /* Messages being received */
+    unsigned                    head;         /* First element of posted[] */
+    unsigned                    count;        /* Number of posted buffers */
+    unsigned                    posted[0];    /* Circular queue of posted
+                                                 buffer indices */
+} ucp_am_recv_ring_t;
+
+
+/**
+ * Rendezvous receive to a ring buffer, followed by the user header
+ */
+typedef struct {
+    ucp_am_recv_ring_t *ring;          /* Ring the buffer belongs to */
+    void               *buffer;        /* Ring buffer receiving the data */
+    ucp_ep_h           reply_ep;       /* Reply endpoint, or NULL */
+    uint64_t           recv_flags;     /* Receive attributes */
+    uint32_t           header_length;  /* User header length */
+} ucp_am_recv_ring_rndv_t;
+
+
 /**
  * Data that is stored about each callback registered with a worker
  */
@@ -44,6 +74,7 @@ typedef struct ucp_am_entry {
     void                       *context;   /* user defined callback argument */
     unsigned                   flags;      /* flags affecting callback behavior
                                               (set by the user) */
+    ucp_am_recv_ring_t         *ring;      /* receive ring, or NULL */
 } ucp_am_entry_t;
 
 
@@ -118,6 +149,7 @@ typedef struct {
 typedef struct {
     ucs_list_link_t          list;        /* entry into list of unfinished AM's */
     size_t                   remaining;   /* how many bytes left to receive */
+    void                     *payload;    /* buffer the data is assembled in */
 } ucp_am_first_desc_t;
 
 
@@ -300,6 +300,13 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "y      - Use mutex for multithreading support in UCP.",
    ucs_offsetof(ucp_context_config_t, use_mt_mutex), UCS_CONFIG_TYPE_BOOL},
 
+  {"MT_PROGRESS_SKIP_BUSY", "n",
+   "When a worker is used by multiple threads, let ucp_worker_progress() return\n"
+   "immediately if another thread holds the worker lock, instead of waiting for\n"
+   "it. The lock holder progresses the whole worker, so threads which only poll\n"
+   "for completions do not serialize behind each other.",
+   ucs_offsetof(ucp_context_config_t, mt_progress_skip_busy), UCS_CONFIG_TYPE_BOOL},
+
   {"ADAPTIVE_PROGRESS", "y",
    "Enable adaptive progress mechanism, which turns on polling only on active\n"
    "transport interfaces.",
@@ -377,6 +384,13 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "even if invalidation workflow isn't supported",
    ucs_offsetof(ucp_context_config_t, rndv_errh_ppln_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"RNDV_PIPELINE_RAMP_START", "64k",
+   "Size of the first fragment of the rendezvous pipeline protocol. Following\n"
+   "fragments double in size until they reach the pipeline fragment size, to\n"
+   "reduce the time to first byte without adding overhead to large messages.\n"
+   "\"inf\" disables the ramp and uses fragments of fixed size.",
+   ucs_offsetof(ucp_context_config_t, rndv_ppln_ramp_start), UCS_CONFIG_TYPE_MEMUNITS},
+
   {"FLUSH_WORKER_EPS", "y",
    "Enable flushing the worker by flushing its endpoints. Allows completing\n"
    "the flush operation in a bounded time even if there are new requests on\n"
@@ -474,6 +488,14 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "dynamically allocated memory.",
    ucs_offsetof(ucp_context_config_t, rkey_mpool_max_md), UCS_CONFIG_TYPE_INT},
 
+  {"RKEY_CACHE_SIZE", "0",
+   "Maximal number of unpacked remote keys cached on every endpoint. When\n"
+   "enabled, unpacking the same packed remote key buffer again on an endpoint\n"
+   "returns the cached remote key instead of parsing the buffer. Cached keys\n"
+   "must be invalidated by ucp_ep_rkey_cache_invalidate() when the remote\n"
+   "memory is unmapped. 0 disables the cache.",
+   ucs_offsetof(ucp_context_config_t, rkey_cache_size), UCS_CONFIG_TYPE_UINT},
+
   {"ADDRESS_VERSION", "v1",
    "Defines UCP worker address format obtained with ucp_worker_get_address() or\n"
    "ucp_worker_query() routines.",
@@ -498,6 +520,72 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "directory.",
    ucs_offsetof(ucp_context_config_t, proto_info_dir), UCS_CONFIG_TYPE_STRING},
 
+  {"PROTO_CACHE_DIR", "",
+   "If non-empty, protocol selection results are saved to a file in this\n"
+   "directory when a worker is destroyed, and loaded when a worker with the same\n"
+   "transports configuration is created. This reduces the latency of the first\n"
+   "operations after a restart. The directory should be local to the node, or\n"
+   "shared only by nodes with identical hardware.",
+   ucs_offsetof(ucp_context_config_t, proto_cache_dir), UCS_CONFIG_TYPE_STRING},
+
+  {"PROTO_TUNE", "n",
+   "Enable online tuning of protocol thresholds. When enabled, the completion\n"
+   "time of send operations is measured, and the performance estimation of each\n"
+   "protocol is corrected by the ratio between the measured and the estimated\n"
+   "completion times. The thresholds are rebuilt periodically using the\n"
+   "corrected estimations.",
+   ucs_offsetof(ucp_context_config_t, proto_tune), UCS_CONFIG_TYPE_BOOL},
+
+  {"PROTO_TUNE_INTERVAL", "100ms",
+   "Minimal time between protocol thresholds updates when PROTO_TUNE is enabled.",
+   ucs_offsetof(ucp_context_config_t, proto_tune_interval),
+   UCS_CONFIG_TYPE_TIME},
+
+  {"PROTO_TUNE_MIN_SAMPLES", "64",
+   "Minimal number of completion time samples of a protocol which are required\n"
+   "to update its performance estimation.",
+   ucs_offsetof(ucp_context_config_t, proto_tune_min_samples),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"PROTO_TUNE_HYSTERESIS", "0.2",
+   "Relative change of a protocol performance correction which is required to\n"
+   "rebuild the thresholds. Higher values prevent switching back and forth\n"
+   "between protocols due to measurement noise.",
+   ucs_offsetof(ucp_context_config_t, proto_tune_hysteresis),
+   UCS_CONFIG_TYPE_DOUBLE},
+
+  {"GENERIC_DT_OFFLOAD_THREADS", "0",
+   "Number of threads which pack generic datatypes of rendezvous sends in the\n"
+   "background, so that packing the next fragment overlaps the transfer of the\n"
+   "current one. 0 disables the offload.",
+   ucs_offsetof(ucp_context_config_t, generic_dt_offload_threads),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"GENERIC_DT_OFFLOAD_THRESH", "256k",
+   "Minimal rendezvous message size to pack a generic datatype in the\n"
+   "background, when GENERIC_DT_OFFLOAD_THREADS is nonzero.",
+   ucs_offsetof(ucp_context_config_t, generic_dt_offload_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"STREAM_COALESCE_THRESH", "256",
+   "Maximal size of a stream send which is coalesced with other sends, on\n"
+   "endpoints created with UCP_EP_PARAMS_FLAGS_STREAM_COALESCE.",
+   ucs_offsetof(ucp_context_config_t, stream_coalesce_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"STREAM_COALESCE_SIZE", "8k",
+   "Size of the staging buffer of coalesced stream sends. The buffer is sent\n"
+   "when it is full, and it is also limited by the maximal bcopy size of the\n"
+   "active message transport.",
+   ucs_offsetof(ucp_context_config_t, stream_coalesce_size),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"STREAM_COALESCE_TIMEOUT", "10us",
+   "Maximal time coalesced stream sends wait in the staging buffer before it\n"
+   "is sent. The timeout is checked by ucp_worker_progress().",
+   ucs_offsetof(ucp_context_config_t, stream_coalesce_timeout),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
   {"REG_NONBLOCK_MEM_TYPES", "",
    "Perform only non-blocking memory registration for these memory types.\n"
    "Non-blocking registration means that the page registration may be\n"
@@ -2384,6 +2472,13 @@ ucs_status_t ucp_init_version(unsigned api_major_version, unsigned api_minor_ver
         memset(&context->cache_md_map, 0, sizeof(context->cache_md_map));
     }
 
+    status = ucp_dt_offload_init(&context->dt_offload,
+                                 context->config.ext.generic_dt_offload_threads,
+                                 "ucp");
+    if (status != UCS_OK) {
+        goto err_rcache_cleanup;
+    }
+
     if (dfl_config != NULL) {
         ucp_config_release(dfl_config);
     }
@@ -2398,6 +2493,8 @@ ucs_status_t ucp_init_version(unsigned api_major_version, unsigned api_minor_ver
     *context_p = context;
     return UCS_OK;
 
+err_rcache_cleanup:
+    ucp_mem_rcache_cleanup(context);
 err_free_res:
     ucp_free_resources(context);
 err_thread_lock_finalize:
@@ -2416,6 +2513,7 @@ err:
 void ucp_cleanup(ucp_context_h context)
 {
     ucs_vfs_obj_remove(context);
+    ucp_dt_offload_cleanup(&context->dt_offload);
     ucp_mem_rcache_cleanup(context);
     ucp_free_resources(context);
     ucp_free_config(context);
@@ -15,6 +15,7 @@
 
 #include <ucp/api/ucp.h>
 #include <ucp/dt/dt.h>
+#include <ucp/dt/dt_offload.h>
 #include <ucp/proto/proto.h>
 #include <uct/api/uct.h>
 #include <uct/api/v2/uct_v2.h>
@@ -98,6 +99,8 @@ typedef struct ucp_context_config {
     int                                    rndv_shm_ppln_enable;
     /** Enable error handling for rndv pipeline protocol */
     int                                    rndv_errh_ppln_enable;
+    /** Size of the first fragment of the rndv pipeline protocol */
+    size_t                                 rndv_ppln_ramp_start;
     /** Threshold for using tag matching offload capabilities. Smaller buffers
      *  will not be posted to the transport. */
     size_t                                 tm_thresh;
@@ -116,6 +119,8 @@ typedef struct ucp_context_config {
     ucp_atomic_mode_t                      atomic_mode;
     /** If use mutex for MT support or not */
     int                                    use_mt_mutex;
+    /** Skip progress if the multi-threaded worker is locked by another thread */
+    int                                    mt_progress_skip_busy;
     /** On-demand progress */
     int                                    adaptive_progress;
     /** Eager-am multi-lane support */
@@ -171,6 +176,8 @@ typedef struct ucp_context_config {
     /** Remote keys with that many remote MDs or less would be allocated from a
       * memory pool.*/
     int                                    rkey_mpool_max_md;
+    /** Maximal number of cached unpacked remote keys per endpoint */
+    unsigned                               rkey_cache_size;
     /** Worker address format version */
     ucp_object_version_t                   worker_addr_version;
     /** Threshold for enabling RNDV data split alignment */
@@ -181,6 +188,26 @@ typedef struct ucp_context_config {
     char                                   *select_distance_md;
     /** Directory to write protocol selection information */
     char                                   *proto_info_dir;
+    /** Directory to save and load protocol selection results */
+    char                                   *proto_cache_dir;
+    /** Enable online tuning of protocol thresholds */
+    int                                    proto_tune;
+    /** Minimal time between protocol thresholds updates */
+    double                                 proto_tune_interval;
+    /** Minimal number of samples to update a protocol performance estimation */
+    unsigned                               proto_tune_min_samples;
+    /** Relative performance change which triggers thresholds update */
+    double                                 proto_tune_hysteresis;
+    /** Number of threads which pack generic datatypes for rendezvous */
+    unsigned                               generic_dt_offload_threads;
+    /** Minimal message size to offload generic datatype packing */
+    size_t                                 generic_dt_offload_thresh;
+    /** Maximal size of a coalesced stream send */
+    size_t                                 stream_coalesce_thresh;
+    /** Size of the staging buffer of coalesced stream sends */
+    size_t                                 stream_coalesce_size;
+    /** Maximal time coalesced stream sends are staged */
+    ucs_time_t                             stream_coalesce_timeout;
     /** Memory types that perform non-blocking registration by default */
     uint64_t                               reg_nb_mem_types;
     /** Prefer native RMA transports for RMA/AMO protocols */
@@ -392,6 +419,9 @@ typedef struct ucp_context {
     /* Hash of rcaches which contain imported memory handles got from peers */
     ucp_context_imported_mem_hash_t *imported_mem_hash;
 
+    /* Threads which pack generic datatypes in the background */
+    ucp_dt_offload_t              dt_offload;
+
     struct {
 
         /* Bitmap of features supported by the context */
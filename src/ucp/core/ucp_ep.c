@@ -29,6 +29,7 @@
 #include <ucp/core/ucp_listener.h>
 #include <ucp/rma/rma.inl>
 #include <ucp/rma/rma.h>
+#include <ucp/core/ucp_rkey_cache.h>
 
 #include <ucs/datastruct/queue.h>
 #include <ucs/debug/memtrack_int.h>
@@ -88,9 +89,11 @@ static ucs_stats_class_t ucp_ep_stats_class = {
     .num_counters   = UCP_EP_STAT_LAST,
     .class_id       = UCS_STATS_CLASS_ID_INVALID,
     .counter_names  = {
-        [UCP_EP_STAT_TAG_TX_EAGER]      = "tx_eager",
-        [UCP_EP_STAT_TAG_TX_EAGER_SYNC] = "tx_eager_sync",
-        [UCP_EP_STAT_TAG_TX_RNDV]       = "tx_rndv"
+        [UCP_EP_STAT_TAG_TX_EAGER]            = "tx_eager",
+        [UCP_EP_STAT_TAG_TX_EAGER_SYNC]       = "tx_eager_sync",
+        [UCP_EP_STAT_TAG_TX_RNDV]             = "tx_rndv",
+        [UCP_EP_STAT_STREAM_TX_COALESCED]     = "tx_stream_coalesced",
+        [UCP_EP_STAT_STREAM_TX_COALESCED_MSG] = "tx_stream_coalesced_msg"
     }
 };
 #endif
@@ -226,6 +229,8 @@ static ucp_ep_h ucp_ep_allocate(ucp_worker_h worker, const char *peer_name)
     ep->ext->ka_last_round                = 0;
 #endif
     ep->ext->peer_mem                     = NULL;
+    ep->ext->rkey_cache                   = NULL;
+    ep->ext->stream.coalesce              = NULL;
     ep->ext->unflushed_lanes              = 0;
     ep->ext->fence_seq                    = 0;
     ep->ext->uct_eps                      = NULL;
@@ -518,6 +523,14 @@ void ucp_ep_destroy_base(ucp_ep_h ep)
 
         kh_destroy(ucp_ep_peer_mem_hash, ep->ext->peer_mem);
     }
+
+    if (ep->ext->rkey_cache != NULL) {
+        ucp_rkey_cache_destroy(ep->ext->rkey_cache);
+    }
+
+    if (ep->ext->stream.coalesce != NULL) {
+        ucp_stream_coalesce_destroy(ep);
+    }
     ucp_ep_deallocate(ep);
 }
 
@@ -623,6 +636,12 @@ ucp_ep_adjust_params(ucp_ep_h ep, const ucp_ep_params_t *params)
         ep->flags |= UCP_EP_FLAG_USER_DATA_PARAM;
     }
 
+    if ((UCP_PARAM_VALUE(EP, params, flags, FLAGS, 0) &
+         UCP_EP_PARAMS_FLAGS_STREAM_COALESCE) &&
+        (ep->worker->context->config.features & UCP_FEATURE_STREAM)) {
+        ep->flags |= UCP_EP_FLAG_STREAM_COALESCE;
+    }
+
     return UCS_OK;
 }
 
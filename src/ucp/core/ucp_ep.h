@@ -104,7 +104,7 @@ enum {
                                                         while merging pending queues */
     UCP_EP_FLAG_CONNECT_PRE_REQ_QUEUED = UCS_BIT(9), /* Pre-Connection request was queued */
     UCP_EP_FLAG_CLOSED                 = UCS_BIT(10),/* EP was closed */
-    /* 11 bit is vacant for a flag */
+    UCP_EP_FLAG_STREAM_COALESCE        = UCS_BIT(11),/* Coalesce small stream sends */
     UCP_EP_FLAG_ERR_HANDLER_INVOKED    = UCS_BIT(12),/* error handler was called */
     UCP_EP_FLAG_INTERNAL               = UCS_BIT(13),/* the internal EP which holds
                                                         temporary wireup configuration or
@@ -139,6 +139,8 @@ enum {
     UCP_EP_STAT_TAG_TX_EAGER,
     UCP_EP_STAT_TAG_TX_EAGER_SYNC,
     UCP_EP_STAT_TAG_TX_RNDV,
+    UCP_EP_STAT_STREAM_TX_COALESCED,
+    UCP_EP_STAT_STREAM_TX_COALESCED_MSG,
     UCP_EP_STAT_LAST
 };
 
@@ -517,6 +519,7 @@ typedef struct ucp_ep_ext {
     ucp_request_t                 *close_req;    /* Close protocol request */
     khash_t(ucp_ep_peer_mem_hash) *peer_mem;     /* Hash of remote memory segments
                                                     used by 2-stage ppln rndv proto */
+    ucp_rkey_cache_t              *rkey_cache;   /* Cache of unpacked remote keys */
     /* List of requests which are waiting for remote completion */
     ucs_hlist_head_t              proto_reqs;
 #if UCS_ENABLE_ASSERT
@@ -536,6 +539,8 @@ typedef struct ucp_ep_ext {
         ucs_list_link_t           ready_list;     /* List entry in worker's EP list */
         ucs_queue_head_t          match_q;        /* Queue of receive data or requests,
                                                      depends on UCP_EP_FLAG_STREAM_HAS_DATA */
+        ucp_stream_coalesce_t     *coalesce;      /* Staging buffer of coalesced sends,
+                                                     allocated on first use */
     } stream;
 
     struct {
@@ -37,6 +37,7 @@ enum {
     UCP_REQUEST_FLAG_COMPLETED             = UCS_BIT(0),
     UCP_REQUEST_FLAG_RELEASED              = UCS_BIT(1),
     UCP_REQUEST_FLAG_PROTO_SEND            = UCS_BIT(2),
+    UCP_REQUEST_FLAG_PROTO_TUNE            = UCS_BIT(3),
     UCP_REQUEST_FLAG_SYNC_LOCAL_COMPLETED  = UCS_BIT(4),
     UCP_REQUEST_FLAG_SYNC_REMOTE_COMPLETED = UCS_BIT(5),
     UCP_REQUEST_FLAG_CALLBACK              = UCS_BIT(6),
@@ -107,8 +108,10 @@ enum {
                                                          because UCT AM callback is still in
                                                          the call stack and descriptor is not
                                                          initialized yet. */
-    UCP_RECV_DESC_FLAG_RELEASED         = UCS_BIT(10) /* Indicates that the descriptor was
-                                                         released and cannot be used. */
+    UCP_RECV_DESC_FLAG_RELEASED         = UCS_BIT(10), /* Indicates that the descriptor was
+                                                          released and cannot be used. */
+    UCP_RECV_DESC_FLAG_AM_RING          = UCS_BIT(11)  /* Multi-fragment AM is assembled
+                                                          in a receive ring buffer */
 };
 
 
@@ -155,6 +158,8 @@ struct ucp_request {
                                              flush/proto requests */
 
             const ucp_proto_config_t *proto_config; /* Selected protocol for the request */
+            ucs_time_t               proto_start_time; /* Protocol start time, used
+                                                          by online tuning */
 
             /* This structure holds all mutable fields, and everything else
              * except common send/recv fields 'status' and 'flags' is immutable
@@ -308,6 +313,13 @@ struct ucp_request {
                                     /* Element in queue for segmented RKEY ptr */
                                     ucs_queue_elem_t  queue_elem;
                                 } rkey_ptr;
+
+                                /* Used by rndv/am/bcopy */
+                                struct {
+                                    /* Background packing of a generic
+                                       datatype, or NULL if not offloaded */
+                                    ucp_dt_offload_pack_t *offload;
+                                } am;
                             };
                         };
                     };
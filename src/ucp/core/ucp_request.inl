@@ -248,6 +248,9 @@ ucp_request_complete_send(ucp_request_t *req, ucs_status_t status)
                   req, req + 1, UCP_REQUEST_FLAGS_ARG(req->flags),
                   ucs_status_string(status));
     UCS_PROFILE_REQUEST_EVENT(req, "complete_send", status);
+    if (ucs_unlikely(req->flags & UCP_REQUEST_FLAG_PROTO_TUNE)) {
+        ucp_proto_tune_request_sample(req, status);
+    }
     /* Coverity wrongly resolves completion callback function to
      * 'ucp_cm_client_connect_progress'/'ucp_cm_server_conn_request_progress'
      */
@@ -365,6 +368,8 @@ ucp_request_send_state_init(ucp_request_t *req, ucp_datatype_t datatype,
         req->send.state.dt.dt.iov.iovcnt        = dt_count;
         req->send.state.dt.dt.iov.memhs         = NULL;
         return;
+    case UCP_DATATYPE_STRIDED:
+        return;
     case UCP_DATATYPE_GENERIC:
         dt_gen    = ucp_dt_to_generic(datatype);
         state_gen = dt_gen->ops.start_pack(dt_gen->context, req->send.buffer,
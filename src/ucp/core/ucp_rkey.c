@@ -11,10 +11,12 @@
 #include "ucp_rkey.inl"
 #include "ucp_request.h"
 #include "ucp_ep.inl"
+#include "ucp_rkey_cache.h"
 
 #include <ucp/core/ucp_mm.inl>
 #include <ucp/rma/rma.h>
 #include <ucp/proto/proto_debug.h>
+#include <ucs/arch/atomic.h>
 #include <ucs/datastruct/mpool.inl>
 #include <ucs/profile/profile.h>
 #include <ucs/type/float8.h>
@@ -932,7 +934,11 @@ ucs_status_t ucp_ep_rkey_unpack(ucp_ep_h ep, const void *rkey_buffer,
     ucs_status_t status;
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
-    status = ucp_ep_rkey_unpack_reachable(ep, rkey_buffer, 0, rkey_p);
+    if (ep->worker->context->config.ext.rkey_cache_size > 0) {
+        status = ucp_rkey_cache_unpack(ep, rkey_buffer, rkey_p);
+    } else {
+        status = ucp_ep_rkey_unpack_reachable(ep, rkey_buffer, 0, rkey_p);
+    }
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
 
     return status;
@@ -1006,6 +1012,12 @@ void ucp_rkey_destroy(ucp_rkey_h rkey)
     unsigned remote_md_index, rkey_index;
     ucp_worker_h UCS_V_UNUSED worker;
 
+    /* A cached rkey may be shared by several users and the cache itself */
+    if (ucs_unlikely(rkey->flags & UCP_RKEY_DESC_FLAG_CACHED) &&
+        (ucs_atomic_fsub32(&rkey->refcount, 1) > 1)) {
+        return;
+    }
+
     rkey_index = 0;
     ucs_for_each_bit(remote_md_index, rkey->md_map) {
         if (rkey->tl_rkey[rkey_index].rkey.rkey != UCT_INVALID_RKEY) {
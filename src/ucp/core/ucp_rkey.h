@@ -39,8 +39,11 @@ typedef struct ucp_tl_rkey {
  * Rkey flags
  */
 enum {
-    UCP_RKEY_DESC_FLAG_POOL       = UCS_BIT(0)  /* Descriptor was allocated from pool
+    UCP_RKEY_DESC_FLAG_POOL       = UCS_BIT(0), /* Descriptor was allocated from pool
                                                    and must be returned to pool, not free */
+    UCP_RKEY_DESC_FLAG_CACHED     = UCS_BIT(1)  /* Descriptor is shared through the
+                                                   endpoint rkey cache and released
+                                                   by reference count */
 };
 
 
@@ -113,6 +116,8 @@ typedef struct ucp_rkey {
             ucp_worker_cfg_index_t    cfg_index;       /* Rkey configuration index */
         };
     };
+    uint32_t                          refcount;        /* Reference count, valid if
+                                                          UCP_RKEY_DESC_FLAG_CACHED */
 #if ENABLE_PARAMS_CHECK
     ucp_ep_h                          ep;
 #endif
@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ucp_rkey_cache.h"
+#include "ucp_rkey.inl"
+#include "ucp_ep.inl"
+
+#include <ucp/api/ucpx.h>
+#include <ucs/arch/atomic.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/lru.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/type/serialize.h>
+#include <string.h>
+
+
+/* 64-bit FNV prime, used to hash the packed buffer one word at a time */
+#define UCP_RKEY_CACHE_HASH_PRIME 0x100000001b3ul
+
+
+typedef struct {
+    ucp_rkey_h             rkey;         /* Cached remote key */
+    ucp_worker_cfg_index_t ep_cfg_index; /* Endpoint configuration the remote
+                                            key was unpacked with */
+    size_t                 length;       /* Length of the packed buffer */
+    uint8_t                packed[0];    /* Copy of the packed buffer */
+} ucp_rkey_cache_entry_t;
+
+
+KHASH_INIT(ucp_rkey_cache_hash, uint64_t, ucp_rkey_cache_entry_t*, 1,
+           kh_int64_hash_func, kh_int64_hash_equal);
+
+
+struct ucp_rkey_cache {
+    khash_t(ucp_rkey_cache_hash) hash;     /* Packed buffer hash to entry */
+    ucs_lru_h                    lru;      /* Usage order of hash keys */
+    unsigned                     capacity; /* Maximal number of entries */
+};
+
+
+/* Length of the packed rkey part used by ucp_ep_rkey_unpack() */
+static size_t ucp_rkey_cache_packed_length(const void *buffer)
+{
+    const void *p = buffer;
+    ucp_md_map_t md_map;
+    unsigned md_index;
+    uint8_t tl_rkey_size;
+
+    md_map = *ucs_serialize_next(&p, const ucp_md_map_t);
+    ucs_serialize_next(&p, const uint8_t); /* Memory type */
+    ucs_for_each_bit(md_index, md_map) {
+        tl_rkey_size = *ucs_serialize_next(&p, const uint8_t);
+        ucs_serialize_next_raw(&p, const void, tl_rkey_size);
+    }
+
+    return UCS_PTR_BYTE_DIFF(buffer, p);
+}
+
+static uint64_t ucp_rkey_cache_hash_buffer(const void *buffer, size_t length)
+{
+    uint64_t hash = length;
+    uint64_t word;
+
+    for (; length >= sizeof(word); length -= sizeof(word)) {
+        memcpy(&word, buffer, sizeof(word));
+        hash   = (hash ^ word) * UCP_RKEY_CACHE_HASH_PRIME;
+        buffer = UCS_PTR_BYTE_OFFSET(buffer, sizeof(word));
+    }
+
+    if (length > 0) {
+        word = 0;
+        memcpy(&word, buffer, length);
+        hash = (hash ^ word) * UCP_RKEY_CACHE_HASH_PRIME;
+    }
+
+    return hash ^ (hash >> 32);
+}
+
+static ucs_status_t
+ucp_rkey_cache_create(unsigned capacity, ucp_rkey_cache_t **rkey_cache_p)
+{
+    ucp_rkey_cache_t *rkey_cache;
+    ucs_status_t status;
+
+    rkey_cache = ucs_malloc(sizeof(*rkey_cache), "ucp_rkey_cache");
+    if (rkey_cache == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucs_lru_create(capacity, &rkey_cache->lru);
+    if (status != UCS_OK) {
+        ucs_free(rkey_cache);
+        return status;
+    }
+
+    kh_init_inplace(ucp_rkey_cache_hash, &rkey_cache->hash);
+    rkey_cache->capacity = capacity;
+    *rkey_cache_p        = rkey_cache;
+    return UCS_OK;
+}
+
+static void ucp_rkey_cache_entry_release(ucp_rkey_cache_entry_t *entry)
+{
+    /* Drop the reference held by the cache */
+    ucp_rkey_destroy(entry->rkey);
+    ucs_free(entry);
+}
+
+static void ucp_rkey_cache_remove(ucp_rkey_cache_t *rkey_cache, khiter_t iter)
+{
+    uint64_t hash                 = kh_key(&rkey_cache->hash, iter);
+    ucp_rkey_cache_entry_t *entry = kh_val(&rkey_cache->hash, iter);
+
+    ucs_trace("rkey_cache %p: remove rkey %p hash 0x%" PRIx64, rkey_cache,
+              entry->rkey, hash);
+
+    kh_del(ucp_rkey_cache_hash, &rkey_cache->hash, iter);
+    ucs_lru_remove(rkey_cache->lru, (void*)hash);
+    ucp_rkey_cache_entry_release(entry);
+}
+
+static void ucp_rkey_cache_evict(ucp_rkey_cache_t *rkey_cache)
+{
+    ucs_lru_element_t *elem;
+    khiter_t iter;
+
+    elem = ucs_lru_pop(rkey_cache->lru);
+    iter = kh_get(ucp_rkey_cache_hash, &rkey_cache->hash,
+                  (uint64_t)elem->key);
+    ucs_assert(iter != kh_end(&rkey_cache->hash));
+    ucs_free(elem);
+
+    ucs_trace("rkey_cache %p: evict rkey %p", rkey_cache,
+              kh_val(&rkey_cache->hash, iter)->rkey);
+    ucp_rkey_cache_entry_release(kh_val(&rkey_cache->hash, iter));
+    kh_del(ucp_rkey_cache_hash, &rkey_cache->hash, iter);
+}
+
+static void ucp_rkey_cache_purge(ucp_rkey_cache_t *rkey_cache)
+{
+    ucp_rkey_cache_entry_t *entry;
+
+    kh_foreach_value(&rkey_cache->hash, entry, {
+        ucp_rkey_cache_entry_release(entry);
+    });
+
+    kh_clear(ucp_rkey_cache_hash, &rkey_cache->hash);
+    ucs_lru_reset(rkey_cache->lru);
+}
+
+void ucp_rkey_cache_destroy(ucp_rkey_cache_t *rkey_cache)
+{
+    ucp_rkey_cache_purge(rkey_cache);
+    kh_destroy_inplace(ucp_rkey_cache_hash, &rkey_cache->hash);
+    ucs_lru_destroy(rkey_cache->lru);
+    ucs_free(rkey_cache);
+}
+
+static ucs_status_t
+ucp_rkey_cache_get(ucp_ep_h ep, ucp_rkey_cache_t **rkey_cache_p)
+{
+    ucs_status_t status;
+
+    if (ucs_likely(ep->ext->rkey_cache != NULL)) {
+        *rkey_cache_p = ep->ext->rkey_cache;
+        return UCS_OK;
+    }
+
+    status = ucp_rkey_cache_create(
+            ep->worker->context->config.ext.rkey_cache_size,
+            &ep->ext->rkey_cache);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    *rkey_cache_p = ep->ext->rkey_cache;
+    return UCS_OK;
+}
+
+ucs_status_t
+ucp_rkey_cache_unpack(ucp_ep_h ep, const void *buffer, ucp_rkey_h *rkey_p)
+{
+    ucp_rkey_cache_t *rkey_cache;
+    ucp_rkey_cache_entry_t *entry;
+    ucs_status_t status;
+    ucp_rkey_h rkey;
+    uint64_t hash;
+    size_t length;
+    khiter_t iter;
+    int ret;
+
+    status = ucp_rkey_cache_get(ep, &rkey_cache);
+    if (status != UCS_OK) {
+        return ucp_ep_rkey_unpack_reachable(ep, buffer, 0, rkey_p);
+    }
+
+    length = ucp_rkey_cache_packed_length(buffer);
+    hash   = ucp_rkey_cache_hash_buffer(buffer, length);
+    iter   = kh_get(ucp_rkey_cache_hash, &rkey_cache->hash, hash);
+    if (iter != kh_end(&rkey_cache->hash)) {
+        entry = kh_val(&rkey_cache->hash, iter);
+        if (ucs_likely((entry->length == length) &&
+                       (entry->ep_cfg_index == ep->cfg_index) &&
+                       (memcmp(entry->packed, buffer, length) == 0))) {
+            ucs_atomic_add32(&entry->rkey->refcount, 1);
+            ucs_lru_push(rkey_cache->lru, (void*)hash);
+            ucs_trace("ep %p: found rkey %p in cache", ep, entry->rkey);
+            *rkey_p = entry->rkey;
+            return UCS_OK;
+        }
+
+        /* Hash collision, or the endpoint was reconfigured */
+        ucp_rkey_cache_remove(rkey_cache, iter);
+    }
+
+    status = ucp_ep_rkey_unpack_reachable(ep, buffer, 0, &rkey);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    entry = ucs_malloc(sizeof(*entry) + length, "ucp_rkey_cache_entry");
+    if (entry == NULL) {
+        /* Return the rkey without caching it */
+        *rkey_p = rkey;
+        return UCS_OK;
+    }
+
+    if (kh_size(&rkey_cache->hash) >= rkey_cache->capacity) {
+        ucp_rkey_cache_evict(rkey_cache);
+    }
+
+    iter = kh_put(ucp_rkey_cache_hash, &rkey_cache->hash, hash, &ret);
+    ucs_assert_always(ret != UCS_KH_PUT_FAILED);
+    ucs_assert(ret != UCS_KH_PUT_KEY_PRESENT);
+
+    /* One reference for the cache and one for the caller */
+    rkey->flags        |= UCP_RKEY_DESC_FLAG_CACHED;
+    rkey->refcount      = 2;
+    entry->rkey         = rkey;
+    entry->ep_cfg_index = ep->cfg_index;
+    entry->length       = length;
+    memcpy(entry->packed, buffer, length);
+    kh_val(&rkey_cache->hash, iter) = entry;
+    ucs_lru_push(rkey_cache->lru, (void*)hash);
+
+    ucs_trace("ep %p: added rkey %p to cache, hash 0x%" PRIx64, ep, rkey,
+              hash);
+    *rkey_p = rkey;
+    return UCS_OK;
+}
+
+ucs_status_t ucp_ep_rkey_cache_invalidate(ucp_ep_h ep, const void *rkey_buffer)
+{
+    ucp_rkey_cache_t *rkey_cache;
+    ucp_rkey_cache_entry_t *entry;
+    ucs_status_t status;
+    size_t length;
+    khiter_t iter;
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
+
+    rkey_cache = ep->ext->rkey_cache;
+    if (rkey_cache == NULL) {
+        status = (rkey_buffer == NULL) ? UCS_OK : UCS_ERR_NO_ELEM;
+        goto out;
+    }
+
+    if (rkey_buffer == NULL) {
+        ucs_trace("ep %p: purge rkey cache", ep);
+        ucp_rkey_cache_purge(rkey_cache);
+        status = UCS_OK;
+        goto out;
+    }
+
+    length = ucp_rkey_cache_packed_length(rkey_buffer);
+    iter   = kh_get(ucp_rkey_cache_hash, &rkey_cache->hash,
+                    ucp_rkey_cache_hash_buffer(rkey_buffer, length));
+    if (iter == kh_end(&rkey_cache->hash)) {
+        status = UCS_ERR_NO_ELEM;
+        goto out;
+    }
+
+    entry = kh_val(&rkey_cache->hash, iter);
+    if ((entry->length != length) ||
+        (memcmp(entry->packed, rkey_buffer, length) != 0)) {
+        status = UCS_ERR_NO_ELEM;
+        goto out;
+    }
+
+    ucp_rkey_cache_remove(rkey_cache, iter);
+    status = UCS_OK;
+
+out:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
+    return status;
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_RKEY_CACHE_H_
+#define UCP_RKEY_CACHE_H_
+
+#include "ucp_types.h"
+
+#include <ucp/api/ucp_def.h>
+#include <ucs/type/status.h>
+
+
+/**
+ * @brief Unpack a remote key through the endpoint rkey cache.
+ *
+ * If the same packed buffer was already unpacked on the endpoint, return the
+ * cached remote key with an additional reference. Otherwise, unpack the buffer
+ * and insert the result to the cache, evicting the least recently used entry
+ * if the cache is full. Must be called with the worker lock held.
+ *
+ * @param [in]  ep          Endpoint to unpack the remote key on.
+ * @param [in]  buffer      Packed remote key buffer.
+ * @param [out] rkey_p      Filled with the remote key handle, which must be
+ *                          released by @ref ucp_rkey_destroy.
+ *
+ * @return Error code as defined by @ref ucs_status_t.
+ */
+ucs_status_t
+ucp_rkey_cache_unpack(ucp_ep_h ep, const void *buffer, ucp_rkey_h *rkey_p);
+
+
+/**
+ * @brief Release all cached remote keys and destroy the cache.
+ *
+ * @param [in]  rkey_cache  Cache to destroy.
+ */
+void ucp_rkey_cache_destroy(ucp_rkey_cache_t *rkey_cache);
+
+#endif
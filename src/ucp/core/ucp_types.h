@@ -76,6 +76,8 @@ typedef struct ucp_amo_proto          ucp_amo_proto_t;
 typedef struct ucp_ep_config          ucp_ep_config_t;
 typedef struct ucp_ep_config_key      ucp_ep_config_key_t;
 typedef struct ucp_rkey_config_key    ucp_rkey_config_key_t;
+typedef struct ucp_rkey_cache         ucp_rkey_cache_t;
+typedef struct ucp_stream_coalesce    ucp_stream_coalesce_t;
 typedef struct ucp_proto              ucp_proto_t;
 typedef struct ucp_mem_desc           ucp_mem_desc_t;
 
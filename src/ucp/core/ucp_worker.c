@@ -1931,6 +1931,11 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     mp_params.elems_per_chunk = 128;
     mp_params.ops             = &ucp_request_mpool_ops;
     mp_params.name            = "ucp_requests";
+    if (worker->flags & UCP_WORKER_FLAG_THREAD_MULTI) {
+        /* Let user threads allocate and release requests without contending
+         * on the same free list */
+        mp_params.flags      |= UCS_MPOOL_FLAG_THREAD_CACHE;
+    }
     /* Create memory pool for requests */
     status = ucs_mpool_init(&mp_params, &worker->req_mp);
     if (status != UCS_OK) {
@@ -2311,6 +2316,17 @@ static void ucp_warn_unused_uct_config(ucp_context_h context)
     ucs_string_buffer_cleanup(&unused_cached_uct_cfg);
 }
 
+static void
+ucp_worker_vfs_show_proto_thresholds(void *obj, ucs_string_buffer_t *strb,
+                                     void *arg_ptr, uint64_t arg_u64)
+{
+    ucp_worker_h worker = obj;
+
+    UCS_ASYNC_BLOCK(&worker->async);
+    ucp_proto_tune_dump(worker, strb);
+    UCS_ASYNC_UNBLOCK(&worker->async);
+}
+
 static void
 ucp_worker_vfs_show_primitive(void *obj, ucs_string_buffer_t *strb,
                               void *arg_ptr, uint64_t arg_u64)
@@ -2360,6 +2376,14 @@ void ucp_worker_create_vfs(ucp_context_h context, ucp_worker_h worker)
     ucs_vfs_obj_add_ro_file(worker, ucp_worker_vfs_show_primitive,
                             &worker->counters.ep_failures, UCS_VFS_TYPE_ULONG,
                             "counters/ep_failures");
+
+    if (context->config.ext.proto_tune) {
+        ucs_vfs_obj_add_ro_file(worker, ucp_worker_vfs_show_primitive,
+                                &worker->proto_tune.num_updates,
+                                UCS_VFS_TYPE_U32, "proto_tune/num_updates");
+        ucs_vfs_obj_add_ro_file(worker, ucp_worker_vfs_show_proto_thresholds,
+                                NULL, 0, "proto_tune/thresholds");
+    }
 }
 
 static void ucp_worker_set_max_am_header(ucp_worker_h worker)
@@ -2495,11 +2519,13 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->num_ifaces           = 0;
     worker->am_message_id        = ucs_generate_uuid(0);
     worker->rkey_ptr_cb_id       = UCS_CALLBACKQ_ID_NULL;
+    worker->stream_coalesce_cb_id = UCS_CALLBACKQ_ID_NULL;
     worker->num_all_eps          = 0;
     ucp_worker_keepalive_reset(worker);
     ucs_queue_head_init(&worker->rkey_ptr_reqs);
     ucs_list_head_init(&worker->arm_ifaces);
     ucs_list_head_init(&worker->stream_ready_eps);
+    ucs_list_head_init(&worker->stream_coalesce_eps);
     ucs_list_head_init(&worker->all_eps);
     ucs_list_head_init(&worker->internal_eps);
     kh_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
@@ -2531,6 +2557,9 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         uct_thread_mode = UCS_THREAD_MODE_SERIALIZED;
 #if ENABLE_MT
         worker->flags |= UCP_WORKER_FLAG_THREAD_MULTI;
+        if (context->config.ext.mt_progress_skip_busy) {
+            worker->flags |= UCP_WORKER_FLAG_PROGRESS_SKIP_BUSY;
+        }
 #else
         ucs_diag("multi-threaded worker is requested, but library is built "
                  "without multi-thread support");
@@ -2635,10 +2664,14 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         goto err_close_ifaces;
     }
 
+    /* Load cached protocol selections before any endpoint is created */
+    ucp_proto_cache_init(worker);
+    ucp_proto_tune_init(worker);
+
     /* Create loopback endpoints to copy across memory types */
     status = ucp_worker_mem_type_eps_create(worker);
     if (status != UCS_OK) {
-        goto err_close_cms;
+        goto err_proto_cache_cleanup;
     }
 
     /* Initialize memory pools, should be done after resources are added */
@@ -2690,6 +2723,8 @@ err_destroy_mpools:
     ucp_worker_destroy_mpools(worker);
 err_destroy_memtype_eps:
     ucp_worker_mem_type_eps_destroy(worker);
+err_proto_cache_cleanup:
+    ucp_proto_cache_cleanup(worker);
 err_close_cms:
     ucp_worker_close_cms(worker);
 err_close_ifaces:
@@ -2946,6 +2981,7 @@ void ucp_worker_destroy(ucp_worker_h worker)
 
     ucs_callbackq_remove_oneshot(&worker->uct->progress_q, worker,
                                  ucp_worker_ep_config_filter, NULL);
+    ucp_proto_tune_cleanup(worker);
 
     ucs_vfs_obj_remove(worker);
     ucp_tag_match_cleanup(&worker->tm);
@@ -2964,6 +3000,7 @@ void ucp_worker_destroy(ucp_worker_h worker)
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucp_proto_cache_cleanup(worker);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
 }
@@ -3049,11 +3086,18 @@ unsigned ucp_worker_progress(ucp_worker_h worker)
 {
     unsigned count;
 
+    if (worker->flags & UCP_WORKER_FLAG_PROGRESS_SKIP_BUSY) {
+        if (!UCP_WORKER_THREAD_CS_TRY_ENTER_CONDITIONAL(worker)) {
+            /* Another thread holds the lock and will progress the worker */
+            return 0;
+        }
+    } else {
+        UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+    }
+
     /* worker->inprogress is used only for assertion check.
      * coverity[assert_side_effect]
      */
-    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
-
     /* check that ucp_worker_progress is not called from within ucp_worker_progress */
     ucs_assert(worker->inprogress++ == 0);
     count = uct_worker_progress(worker->uct);
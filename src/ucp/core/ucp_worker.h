@@ -14,6 +14,8 @@
 #include "ucp_rkey.h"
 
 #include <ucp/core/ucp_am.h>
+#include <ucp/proto/proto_cache.h>
+#include <ucp/proto/proto_tune.h>
 #include <ucp/tag/tag_match.h>
 #include <ucs/datastruct/mpool.h>
 #include <ucs/datastruct/mpool_set.h>
@@ -61,6 +63,12 @@
     } while (0)
 
 
+/* Evaluates to nonzero if the critical section was entered */
+#define UCP_WORKER_THREAD_CS_TRY_ENTER_CONDITIONAL(_worker) \
+    (!((_worker)->flags & UCP_WORKER_FLAG_THREAD_MULTI) || \
+     ucs_async_try_block(&(_worker)->async))
+
+
 #define UCP_WORKER_THREAD_CS_CHECK_IS_BLOCKED_CONDITIONAL(_worker) \
     do { \
         if ((_worker)->flags & UCP_WORKER_FLAG_THREAD_MULTI) { \
@@ -72,6 +80,7 @@
 
 #define UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(_worker)
 #define UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(_worker)
+#define UCP_WORKER_THREAD_CS_TRY_ENTER_CONDITIONAL(_worker) 1
 #define UCP_WORKER_THREAD_CS_CHECK_IS_BLOCKED_CONDITIONAL(_worker)
 
 #endif
@@ -110,7 +119,11 @@ enum {
 
     /** Indicates that UCT EP discarding was disabled on this worker */
     UCP_WORKER_FLAG_DISCARD_DISABLED =
-            UCS_BIT(UCP_WORKER_INTERNAL_FLAGS_SHIFT + 5)
+            UCS_BIT(UCP_WORKER_INTERNAL_FLAGS_SHIFT + 5),
+
+    /** Progress returns immediately if another thread holds the worker lock */
+    UCP_WORKER_FLAG_PROGRESS_SKIP_BUSY =
+            UCS_BIT(UCP_WORKER_INTERNAL_FLAGS_SHIFT + 6)
 };
 
 
@@ -304,6 +317,9 @@ typedef struct ucp_worker {
     void                             *user_data;          /* User-defined data */
     ucs_strided_alloc_t              ep_alloc;            /* Endpoint allocator */
     ucs_list_link_t                  stream_ready_eps;    /* List of EPs with received stream data */
+    ucs_list_link_t                  stream_coalesce_eps; /* List of EPs with staged stream sends,
+                                                           * in the order of their send deadline */
+    uct_worker_cb_id_t               stream_coalesce_cb_id; /* Staged stream sends progress ID */
     unsigned                         num_all_eps;         /* Number of all endpoints (except internal
                                                            * endpoints) */
     ucs_list_link_t                  all_eps;             /* List of all endpoints (except internal
@@ -345,6 +361,11 @@ typedef struct ucp_worker {
 
     ucp_ep_config_arr_t              ep_config; /* EP configurations storage */
 
+    ucp_proto_cache_t                proto_cache;         /* Persistent protocol
+                                                             selection cache */
+    ucp_proto_tune_t                 proto_tune;          /* Online protocol
+                                                             thresholds tuning */
+
     unsigned                         rkey_config_count;   /* Current number of rkey configurations */
     ucp_rkey_config_t                rkey_config[UCP_WORKER_MAX_RKEY_CONFIG];
 
@@ -9,6 +9,7 @@
 
 #include "dt.h"
 #include "dt_generic.h"
+#include "dt_strided.h"
 
 #include <ucp/api/ucp.h>
 #include <ucp/core/ucp_mm.h>
@@ -49,6 +50,10 @@ typedef struct {
             ucp_dt_generic_t      *dt_gen;    /* Generic datatype handle */
             void                  *state;     /* User-defined state */
         } generic;
+        struct {
+            void                  *buffer;    /* Base address of the data */
+            const ucp_dt_strided_t *dt;       /* Strided datatype handle */
+        } strided;
         struct {
             const ucp_dt_iov_t    *iov;       /* IOV list */
 #if UCS_ENABLE_ASSERT
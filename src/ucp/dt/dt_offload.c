@@ -0,0 +1,289 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "dt_offload.h"
+
+#include <ucp/core/ucp_request.inl>
+#include <ucp/core/ucp_worker.h>
+#include <uct/base/uct_worker.h>
+#include <ucs/arch/atomic.h>
+#include <ucs/datastruct/queue.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/sys.h>
+
+
+static void *ucp_dt_offload_thread_func(void *arg)
+{
+    ucp_dt_offload_t *pool = arg;
+    ucp_dt_offload_job_t *job;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (ucs_queue_is_empty(&pool->queue) && !pool->stop) {
+            pthread_cond_wait(&pool->cond, &pool->lock);
+        }
+
+        if (pool->stop) {
+            break;
+        }
+
+        job        = ucs_queue_pull_elem_non_empty(&pool->queue,
+                                                   ucp_dt_offload_job_t, queue);
+        job->state = UCP_DT_OFFLOAD_JOB_RUNNING;
+        pthread_mutex_unlock(&pool->lock);
+
+        job->func(job);
+
+        pthread_mutex_lock(&pool->lock);
+        job->state = UCP_DT_OFFLOAD_JOB_DONE;
+        pthread_cond_broadcast(&pool->done_cond);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+static void ucp_dt_offload_stop_threads(ucp_dt_offload_t *pool,
+                                        unsigned num_threads)
+{
+    unsigned i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < num_threads; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+}
+
+ucs_status_t ucp_dt_offload_init(ucp_dt_offload_t *pool, unsigned num_threads,
+                                 const char *name)
+{
+    ucs_status_t status;
+    unsigned i;
+
+    pool->stop        = 0;
+    pool->num_threads = 0;
+    pool->threads     = NULL;
+    ucs_queue_head_init(&pool->queue);
+
+    if (num_threads == 0) {
+        return UCS_OK;
+    }
+
+    pool->threads = ucs_calloc(num_threads, sizeof(*pool->threads),
+                               "dt_offload_threads");
+    if (pool->threads == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    for (i = 0; i < num_threads; ++i) {
+        status = ucs_pthread_create(&pool->threads[i],
+                                    ucp_dt_offload_thread_func, pool,
+                                    "%s-dt%u", name, i);
+        if (status != UCS_OK) {
+            goto err_stop;
+        }
+    }
+
+    pool->num_threads = num_threads;
+    ucs_debug("started %u generic datatype offload threads", num_threads);
+    return UCS_OK;
+
+err_stop:
+    ucp_dt_offload_stop_threads(pool, i);
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+    ucs_free(pool->threads);
+    pool->threads = NULL;
+    return status;
+}
+
+void ucp_dt_offload_cleanup(ucp_dt_offload_t *pool)
+{
+    if (pool->num_threads == 0) {
+        return;
+    }
+
+    ucs_assert(ucs_queue_is_empty(&pool->queue));
+    ucp_dt_offload_stop_threads(pool, pool->num_threads);
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+    ucs_free(pool->threads);
+    pool->num_threads = 0;
+}
+
+static void
+ucp_dt_offload_submit(ucp_dt_offload_t *pool, ucp_dt_offload_job_t *job,
+                      ucp_dt_offload_func_t func)
+{
+    job->func   = func;
+    job->state  = UCP_DT_OFFLOAD_JOB_QUEUED;
+    job->cancel = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    ucs_queue_push(&pool->queue, &job->queue);
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/* Wait until a job is not used by the pool anymore */
+static void
+ucp_dt_offload_cancel(ucp_dt_offload_t *pool, ucp_dt_offload_job_t *job)
+{
+    pthread_mutex_lock(&pool->lock);
+    if (job->state == UCP_DT_OFFLOAD_JOB_QUEUED) {
+        ucs_queue_remove(&pool->queue, &job->queue);
+        job->state = UCP_DT_OFFLOAD_JOB_DONE;
+    } else {
+        job->cancel = 1;
+        while (job->state != UCP_DT_OFFLOAD_JOB_DONE) {
+            pthread_cond_wait(&pool->done_cond, &pool->lock);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static unsigned ucp_dt_offload_pack_resume_progress(void *arg)
+{
+    ucp_dt_offload_pack_t *pack = arg;
+
+    ucp_request_send(pack->req);
+    return 1;
+}
+
+static int
+ucp_dt_offload_pack_resume_filter(const ucs_callbackq_elem_t *elem, void *arg)
+{
+    return elem->cb == ucp_dt_offload_pack_resume_progress;
+}
+
+/* Called by a pool thread when more data was packed */
+static void ucp_dt_offload_pack_notify(ucp_dt_offload_pack_t *pack)
+{
+    /* The atomic operation also orders the update of packed_length before
+     * reading the flag */
+    if (ucs_atomic_bool_cswap32(&pack->wait_resume, 1, 0)) {
+        ucs_callbackq_add_oneshot(&pack->worker->uct->progress_q, pack,
+                                  ucp_dt_offload_pack_resume_progress, pack);
+        ucp_worker_signal_internal(pack->worker);
+    }
+}
+
+static void ucp_dt_offload_pack_job(ucp_dt_offload_job_t *job)
+{
+    ucp_dt_offload_pack_t *pack = ucs_derived_of(job, ucp_dt_offload_pack_t);
+    size_t offset               = 0;
+    size_t length;
+
+    while ((offset < pack->length) && !job->cancel) {
+        length = pack->dt_gen->ops.pack(
+                pack->dt_state, offset, UCS_PTR_BYTE_OFFSET(pack->buffer, offset),
+                ucs_min(pack->chunk_size, pack->length - offset));
+        if (length == 0) {
+            ucs_error("generic datatype pack returned 0 at offset %zu/%zu",
+                      offset, pack->length);
+            offset = pack->length;
+        } else {
+            offset += length;
+        }
+
+        ucs_memory_cpu_store_fence();
+        pack->packed_length = offset;
+        ucp_dt_offload_pack_notify(pack);
+    }
+}
+
+ucs_status_t ucp_dt_offload_pack_start(ucp_dt_offload_t *pool,
+                                       ucp_request_t *req, size_t chunk_size,
+                                       ucp_dt_offload_pack_t **pack_p)
+{
+    const ucp_datatype_iter_t *dt_iter = &req->send.state.dt_iter;
+    ucp_dt_offload_pack_t *pack;
+
+    ucs_assert(dt_iter->dt_class == UCP_DATATYPE_GENERIC);
+    ucs_assert(pool->num_threads > 0);
+
+    pack = ucs_malloc(sizeof(*pack), "dt_offload_pack");
+    if (pack == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    pack->buffer = ucs_malloc(dt_iter->length, "dt_offload_pack_buffer");
+    if (pack->buffer == NULL) {
+        ucs_free(pack);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    pack->req           = req;
+    pack->worker        = req->send.ep->worker;
+    pack->dt_gen        = dt_iter->type.generic.dt_gen;
+    pack->dt_state      = dt_iter->type.generic.state;
+    pack->length        = dt_iter->length;
+    pack->chunk_size    = ucs_max(chunk_size, 1);
+    pack->packed_length = 0;
+    pack->wait_resume   = 0;
+
+    ucs_trace_req("req %p: offloading generic datatype packing of %zu bytes",
+                  req, pack->length);
+    ucp_dt_offload_submit(pool, &pack->super, ucp_dt_offload_pack_job);
+
+    *pack_p = pack;
+    return UCS_OK;
+}
+
+int ucp_dt_offload_pack_is_ready(ucp_dt_offload_pack_t *pack,
+                                 size_t end_offset)
+{
+    if (pack->packed_length >= end_offset) {
+        ucs_memory_cpu_load_fence();
+        return 1;
+    }
+
+    /* Ask the pool to resume the request, and check again in case the data was
+     * packed before the flag was set */
+    ucs_atomic_swap32(&pack->wait_resume, 1);
+    if (pack->packed_length < end_offset) {
+        return 0;
+    }
+
+    if (!ucs_atomic_bool_cswap32(&pack->wait_resume, 1, 0)) {
+        /* The pool thread has already scheduled the resume */
+        return 0;
+    }
+
+    ucs_memory_cpu_load_fence();
+    return 1;
+}
+
+void ucp_dt_offload_pack_copy(const ucp_dt_offload_pack_t *pack, void *dest,
+                              size_t offset, size_t length)
+{
+    ucs_assert(offset + length <= pack->packed_length);
+    memcpy(dest, UCS_PTR_BYTE_OFFSET(pack->buffer, offset), length);
+}
+
+void ucp_dt_offload_pack_finish(ucp_dt_offload_t *pool,
+                                ucp_dt_offload_pack_t *pack)
+{
+    ucp_dt_offload_cancel(pool, &pack->super);
+    ucs_callbackq_remove_oneshot(&pack->worker->uct->progress_q, pack,
+                                 ucp_dt_offload_pack_resume_filter, NULL);
+    ucs_free(pack->buffer);
+    ucs_free(pack);
+}
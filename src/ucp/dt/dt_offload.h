@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_DT_OFFLOAD_H_
+#define UCP_DT_OFFLOAD_H_
+
+#include "dt_generic.h"
+
+#include <ucp/core/ucp_types.h>
+#include <ucs/datastruct/queue_types.h>
+#include <pthread.h>
+
+
+typedef struct ucp_dt_offload_job ucp_dt_offload_job_t;
+
+
+/**
+ * Function which is executed by a thread of the offload pool.
+ */
+typedef void (*ucp_dt_offload_func_t)(ucp_dt_offload_job_t *job);
+
+
+/**
+ * State of an offload job
+ */
+typedef enum {
+    UCP_DT_OFFLOAD_JOB_QUEUED,  /* Waiting in the queue */
+    UCP_DT_OFFLOAD_JOB_RUNNING, /* Executed by a pool thread */
+    UCP_DT_OFFLOAD_JOB_DONE     /* Completed, or removed from the queue */
+} ucp_dt_offload_job_state_t;
+
+
+/**
+ * Job which is executed by the offload pool
+ */
+struct ucp_dt_offload_job {
+    ucs_queue_elem_t           queue; /* Element in the pool queue */
+    ucp_dt_offload_func_t      func;  /* Function to execute */
+    ucp_dt_offload_job_state_t state; /* Protected by the pool lock */
+    volatile int               cancel; /* Set to stop a running job early */
+};
+
+
+/**
+ * Pool of threads which runs generic datatype pack and unpack on behalf of the
+ * progress thread.
+ */
+typedef struct {
+    pthread_mutex_t  lock;        /* Protects the queue and the jobs state */
+    pthread_cond_t   cond;        /* Signaled when a job is queued */
+    pthread_cond_t   done_cond;   /* Signaled when a job is done */
+    ucs_queue_head_t queue;       /* Jobs waiting to be executed */
+    int              stop;        /* Whether the threads should exit */
+    unsigned         num_threads; /* Number of threads, 0 - offload disabled */
+    pthread_t        *threads;    /* Thread handles */
+} ucp_dt_offload_t;
+
+
+/**
+ * Packing of a generic datatype send request into a staging buffer, which is
+ * done by the offload pool ahead of sending the fragments.
+ */
+typedef struct {
+    ucp_dt_offload_job_t super;
+    ucp_request_t        *req;           /* Request which is being packed */
+    ucp_worker_h         worker;         /* Worker to resume the request on */
+    ucp_dt_generic_t     *dt_gen;        /* Generic datatype of the request */
+    void                 *dt_state;      /* Generic datatype pack state */
+    void                 *buffer;        /* Staging buffer */
+    size_t               length;         /* Total length to pack */
+    size_t               chunk_size;     /* Length to pack between updates */
+    volatile size_t      packed_length;  /* Length packed so far */
+    volatile uint32_t    wait_resume;    /* Request waits for packed data */
+} ucp_dt_offload_pack_t;
+
+
+/**
+ * Start the threads of the offload pool.
+ *
+ * @param [out] pool         Offload pool to initialize.
+ * @param [in]  num_threads  Number of threads, 0 to disable offload.
+ * @param [in]  name         Name used for the threads.
+ */
+ucs_status_t ucp_dt_offload_init(ucp_dt_offload_t *pool, unsigned num_threads,
+                                 const char *name);
+
+
+/**
+ * Stop the threads of the offload pool. All jobs must be completed.
+ */
+void ucp_dt_offload_cleanup(ucp_dt_offload_t *pool);
+
+
+/**
+ * Start packing a generic datatype send request into a staging buffer in the
+ * background. When the progress of the request is blocked by
+ * @ref ucp_dt_offload_pack_is_ready, it is resumed by the progress thread of
+ * its worker after more data is packed.
+ *
+ * @param [in]  pool        Offload pool to use.
+ * @param [in]  req         Send request with a generic datatype iterator.
+ * @param [in]  chunk_size  Length to pack between progress notifications.
+ * @param [out] pack_p      Filled with the pack context.
+ */
+ucs_status_t ucp_dt_offload_pack_start(ucp_dt_offload_t *pool,
+                                       ucp_request_t *req, size_t chunk_size,
+                                       ucp_dt_offload_pack_t **pack_p);
+
+
+/**
+ * Check whether the data up to a given offset was packed. If not, the request
+ * is resumed by the worker progress when it is.
+ *
+ * @return Nonzero if the data is ready. Otherwise, the caller must stop
+ *         progressing the request.
+ */
+int ucp_dt_offload_pack_is_ready(ucp_dt_offload_pack_t *pack,
+                                 size_t end_offset);
+
+
+/**
+ * Copy packed data from the staging buffer.
+ */
+void ucp_dt_offload_pack_copy(const ucp_dt_offload_pack_t *pack, void *dest,
+                              size_t offset, size_t length);
+
+
+/**
+ * Stop the background packing, if still running, and release the pack
+ * context. After this call the pool does not use the request anymore.
+ */
+void ucp_dt_offload_pack_finish(ucp_dt_offload_t *pool,
+                                ucp_dt_offload_pack_t *pack);
+
+#endif
@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "dt_strided.h"
+
+#include <ucs/debug/assert.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/math.h>
+#include <ucs/sys/sys.h>
+
+#include <string.h>
+
+
+/* Position of a block in strided data */
+typedef struct {
+    size_t idx[UCP_DT_STRIDED_MAX_DIMS]; /* Index in each dimension */
+    void   *ptr;                         /* Block address */
+} ucp_dt_strided_pos_t;
+
+
+ucs_status_t ucp_dt_create_strided(const ucp_dt_strided_param_t *param,
+                                   ucp_datatype_t *datatype_p)
+{
+    const ucp_dt_strided_dim_t *dim;
+    ucp_dt_strided_t *dt_strided;
+    unsigned i;
+    int ret;
+
+    if ((param->elem_size == 0) || (param->num_dims == 0) ||
+        (param->num_dims > UCP_DT_STRIDED_MAX_DIMS)) {
+        ucs_error("invalid strided datatype: elem_size %zu num_dims %u",
+                  param->elem_size, param->num_dims);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    ret = ucs_posix_memalign((void**)&dt_strided,
+                             ucs_max(sizeof(void*), UCS_BIT(UCP_DATATYPE_SHIFT)),
+                             sizeof(*dt_strided), "strided_dt");
+    if (ret != 0) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    dt_strided->elem_size = param->elem_size;
+    dt_strided->length    = param->elem_size;
+    dt_strided->num_dims  = 0;
+
+    for (i = 0; i < param->num_dims; ++i) {
+        dim = &param->dims[i];
+        if (dim->count == 0) {
+            ucs_error("invalid strided datatype: dimension %u has zero count",
+                      i);
+            ucs_free(dt_strided);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        dt_strided->length *= dim->count;
+
+        /* Merge a dimension which is contiguous with the blocks or with the
+         * previous dimension, to copy larger blocks and iterate less */
+        if ((dt_strided->num_dims == 0) &&
+            ((dim->count == 1) ||
+             (dim->stride == (ssize_t)dt_strided->elem_size))) {
+            dt_strided->elem_size *= dim->count;
+        } else if ((dt_strided->num_dims > 0) &&
+                   (dim->stride ==
+                    (dt_strided->dims[dt_strided->num_dims - 1].stride *
+                     (ssize_t)dt_strided->dims[dt_strided->num_dims - 1]
+                             .count))) {
+            dt_strided->dims[dt_strided->num_dims - 1].count *= dim->count;
+        } else if (dim->count > 1) {
+            dt_strided->dims[dt_strided->num_dims++] = *dim;
+        }
+    }
+
+    if (dt_strided->num_dims == 0) {
+        /* Fully contiguous */
+        dt_strided->dims[0].count  = 1;
+        dt_strided->dims[0].stride = dt_strided->elem_size;
+        dt_strided->num_dims       = 1;
+    }
+
+    if (param->extent != 0) {
+        dt_strided->extent = param->extent;
+    } else {
+        dim                = &param->dims[param->num_dims - 1];
+        dt_strided->extent = dim->stride * (ssize_t)dim->count;
+    }
+
+    ucs_debug("created strided datatype %p: elem_size %zu num_dims %u "
+              "length %zu extent %zd", dt_strided, dt_strided->elem_size,
+              dt_strided->num_dims, dt_strided->length, dt_strided->extent);
+
+    *datatype_p = ucp_dt_from_strided(dt_strided);
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_pos_init(const ucp_dt_strided_t *dt_strided, void *buffer,
+                        size_t block, ucp_dt_strided_pos_t *pos)
+{
+    ssize_t ptr_offset = 0;
+    unsigned i;
+
+    for (i = 0; i < dt_strided->num_dims; ++i) {
+        pos->idx[i] = block % dt_strided->dims[i].count;
+        block      /= dt_strided->dims[i].count;
+        ptr_offset += (ssize_t)pos->idx[i] * dt_strided->dims[i].stride;
+    }
+
+    /* The remaining block number is the index of the datatype element */
+    ptr_offset += (ssize_t)block * dt_strided->extent;
+    pos->ptr    = UCS_PTR_BYTE_OFFSET(buffer, ptr_offset);
+}
+
+/* Move the position by 'num_blocks', which must not cross the innermost row */
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_pos_advance(const ucp_dt_strided_t *dt_strided,
+                           ucp_dt_strided_pos_t *pos, size_t num_blocks)
+{
+    const ucp_dt_strided_dim_t *dims = dt_strided->dims;
+    unsigned i;
+
+    pos->idx[0] += num_blocks;
+    pos->ptr     = UCS_PTR_BYTE_OFFSET(pos->ptr,
+                                       (ssize_t)num_blocks * dims[0].stride);
+
+    for (i = 0; pos->idx[i] == dims[i].count; ++i) {
+        pos->idx[i] = 0;
+        pos->ptr    = UCS_PTR_BYTE_OFFSET(pos->ptr,
+                                          -(ssize_t)dims[i].count *
+                                          dims[i].stride);
+        if ((i + 1) == dt_strided->num_dims) {
+            pos->ptr = UCS_PTR_BYTE_OFFSET(pos->ptr, dt_strided->extent);
+            break;
+        }
+
+        ++pos->idx[i + 1];
+        pos->ptr = UCS_PTR_BYTE_OFFSET(pos->ptr, dims[i + 1].stride);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_copy_bytes(void *packed, void *ptr, size_t length, int is_pack)
+{
+    if (is_pack) {
+        memcpy(packed, ptr, length);
+    } else {
+        memcpy(ptr, packed, length);
+    }
+}
+
+/*
+ * Copy 'count' blocks of a row. The block size is a compile-time constant for
+ * common sizes, so the compiler can replace the copy by vector loads and
+ * stores instead of calling memcpy for every block.
+ */
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_copy_row(void *packed, void *ptr, ssize_t stride,
+                        size_t elem_size, size_t count, int is_pack)
+{
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        ucp_dt_strided_copy_bytes(packed, ptr, elem_size, is_pack);
+        packed = UCS_PTR_BYTE_OFFSET(packed, elem_size);
+        ptr    = UCS_PTR_BYTE_OFFSET(ptr, stride);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_copy_row_dispatch(void *packed, void *ptr, ssize_t stride,
+                                 size_t elem_size, size_t count, int is_pack)
+{
+    switch (elem_size) {
+    case 4:
+        ucp_dt_strided_copy_row(packed, ptr, stride, 4, count, is_pack);
+        break;
+    case 8:
+        ucp_dt_strided_copy_row(packed, ptr, stride, 8, count, is_pack);
+        break;
+    case 16:
+        ucp_dt_strided_copy_row(packed, ptr, stride, 16, count, is_pack);
+        break;
+    case 32:
+        ucp_dt_strided_copy_row(packed, ptr, stride, 32, count, is_pack);
+        break;
+    case 64:
+        ucp_dt_strided_copy_row(packed, ptr, stride, 64, count, is_pack);
+        break;
+    default:
+        ucp_dt_strided_copy_row(packed, ptr, stride, elem_size, count,
+                                is_pack);
+        break;
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_copy(const ucp_dt_strided_t *dt_strided, void *buffer,
+                    size_t offset, void *packed, size_t length, int is_pack)
+{
+    size_t elem_size    = dt_strided->elem_size;
+    size_t block_offset = offset % elem_size;
+    ucp_dt_strided_pos_t pos;
+    size_t num_blocks, chunk;
+
+    ucp_dt_strided_pos_init(dt_strided, buffer, offset / elem_size, &pos);
+
+    /* Partial first block */
+    if (block_offset != 0) {
+        chunk = ucs_min(elem_size - block_offset, length);
+        ucp_dt_strided_copy_bytes(packed,
+                                  UCS_PTR_BYTE_OFFSET(pos.ptr, block_offset),
+                                  chunk, is_pack);
+        packed  = UCS_PTR_BYTE_OFFSET(packed, chunk);
+        length -= chunk;
+        if (length == 0) {
+            return;
+        }
+
+        ucp_dt_strided_pos_advance(dt_strided, &pos, 1);
+    }
+
+    /* Full blocks, up to the end of the innermost row at a time */
+    while (length >= elem_size) {
+        num_blocks = ucs_min(dt_strided->dims[0].count - pos.idx[0],
+                             length / elem_size);
+        ucp_dt_strided_copy_row_dispatch(packed, pos.ptr,
+                                         dt_strided->dims[0].stride, elem_size,
+                                         num_blocks, is_pack);
+        packed  = UCS_PTR_BYTE_OFFSET(packed, num_blocks * elem_size);
+        length -= num_blocks * elem_size;
+        ucp_dt_strided_pos_advance(dt_strided, &pos, num_blocks);
+    }
+
+    /* Partial last block */
+    if (length > 0) {
+        ucp_dt_strided_copy_bytes(packed, pos.ptr, length, is_pack);
+    }
+}
+
+void ucp_dt_strided_gather(void *dest, const void *buffer,
+                           const ucp_dt_strided_t *dt_strided, size_t offset,
+                           size_t length)
+{
+    ucp_dt_strided_copy(dt_strided, (void*)buffer, offset, dest, length, 1);
+}
+
+void ucp_dt_strided_scatter(void *buffer, const ucp_dt_strided_t *dt_strided,
+                            size_t offset, const void *src, size_t length)
+{
+    ucp_dt_strided_copy(dt_strided, buffer, offset, (void*)src, length, 0);
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_DT_STRIDED_H_
+#define UCP_DT_STRIDED_H_
+
+#include <ucp/api/ucpx.h>
+
+
+/**
+ * Strided datatype structure.
+ *
+ * Dimensions which are contiguous in memory are merged when the datatype is
+ * created, so @a elem_size is the largest contiguous block, and @a dims[0] is
+ * the innermost dimension which is not contiguous.
+ */
+typedef struct ucp_dt_strided {
+    size_t               elem_size; /* Size of a contiguous block */
+    size_t               length;    /* Packed length of one datatype element */
+    ssize_t              extent;    /* Distance between datatype elements */
+    unsigned             num_dims;  /* Number of dimensions, at least 1 */
+    ucp_dt_strided_dim_t dims[UCP_DT_STRIDED_MAX_DIMS];
+} ucp_dt_strided_t;
+
+
+#define UCP_DT_IS_STRIDED(_datatype) \
+    (((_datatype) & UCP_DATATYPE_CLASS_MASK) == UCP_DATATYPE_STRIDED)
+
+
+static UCS_F_ALWAYS_INLINE
+ucp_dt_strided_t* ucp_dt_to_strided(ucp_datatype_t datatype)
+{
+    return (ucp_dt_strided_t*)(void*)(datatype & ~UCP_DATATYPE_CLASS_MASK);
+}
+
+
+static UCS_F_ALWAYS_INLINE
+ucp_datatype_t ucp_dt_from_strided(ucp_dt_strided_t *dt_strided)
+{
+    return ((uintptr_t)dt_strided) | UCP_DATATYPE_STRIDED;
+}
+
+
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_length(const ucp_dt_strided_t *dt_strided, size_t count)
+{
+    return dt_strided->length * count;
+}
+
+
+/**
+ * Gather strided data into a contiguous buffer.
+ *
+ * @param [in]  dest        Destination contiguous buffer.
+ * @param [in]  buffer      Base address of the strided data.
+ * @param [in]  dt_strided  Strided datatype.
+ * @param [in]  offset      Packed offset to start from.
+ * @param [in]  length      Number of bytes to gather.
+ */
+void ucp_dt_strided_gather(void *dest, const void *buffer,
+                           const ucp_dt_strided_t *dt_strided, size_t offset,
+                           size_t length);
+
+
+/**
+ * Scatter a contiguous buffer into strided data.
+ *
+ * @param [in]  buffer      Base address of the strided data.
+ * @param [in]  dt_strided  Strided datatype.
+ * @param [in]  offset      Packed offset to start from.
+ * @param [in]  src         Source contiguous buffer.
+ * @param [in]  length      Number of bytes to scatter.
+ */
+void ucp_dt_strided_scatter(void *buffer, const ucp_dt_strided_t *dt_strided,
+                            size_t offset, const void *src, size_t length);
+
+#endif
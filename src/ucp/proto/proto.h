@@ -141,6 +141,10 @@ typedef struct {
 
     /* Map of used lanes */
     ucp_lane_map_t lane_map;
+
+    /* Ratio of measured to estimated completion time learned by online
+       tuning, or 1.0 if the estimation was not corrected */
+    double         tune_factor;
 } ucp_proto_query_attr_t;
 
 
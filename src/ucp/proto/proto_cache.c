@@ -0,0 +1,400 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "proto_cache.h"
+#include "proto_select.inl"
+
+#include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_worker.h>
+#include <ucs/algorithm/crc.h>
+#include <ucs/config/parser.h>
+#include <ucs/sys/string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdio.h>
+
+
+/* First line of the cache file, changed when the file format changes */
+#define UCP_PROTO_CACHE_FILE_HEADER "ucx-proto-cache 1"
+
+
+KHASH_IMPL(ucp_proto_cache_hash, kh_cstr_t, char*, 1, kh_str_hash_func,
+           kh_str_hash_equal);
+
+
+static uint32_t ucp_proto_cache_crc_str(uint32_t crc, const char *str)
+{
+    return ucs_crc32(crc, str, strlen(str) + 1);
+}
+
+/*
+ * Hash everything which can affect protocol selection in this process: the
+ * library version, the configuration, and the resources and their attributes.
+ */
+static uint32_t ucp_proto_cache_config_hash(ucp_worker_h worker)
+{
+    ucp_context_h context = worker->context;
+    ucs_string_buffer_t env_strb;
+    ucp_rsc_index_t rsc_index;
+    ucp_md_index_t md_index;
+    unsigned iface_id;
+    uint32_t crc;
+
+    crc = ucp_proto_cache_crc_str(0, ucp_get_version_string());
+
+    ucs_string_buffer_init(&env_strb);
+    ucs_config_parser_get_env_vars(&env_strb, " ");
+    crc = ucp_proto_cache_crc_str(crc, ucs_string_buffer_cstr(&env_strb));
+    ucs_string_buffer_cleanup(&env_strb);
+
+    for (md_index = 0; md_index < context->num_mds; ++md_index) {
+        crc = ucp_proto_cache_crc_str(crc,
+                                      context->tl_mds[md_index].rsc.md_name);
+    }
+
+    for (rsc_index = 0; rsc_index < context->num_tls; ++rsc_index) {
+        crc = ucp_proto_cache_crc_str(
+                crc, context->tl_rscs[rsc_index].tl_rsc.tl_name);
+        crc = ucp_proto_cache_crc_str(
+                crc, context->tl_rscs[rsc_index].tl_rsc.dev_name);
+    }
+
+    /* Performance estimations are based on the interface attributes */
+    for (iface_id = 0; iface_id < worker->num_ifaces; ++iface_id) {
+        crc = ucs_crc32(crc, &worker->ifaces[iface_id]->attr,
+                        sizeof(worker->ifaces[iface_id]->attr));
+    }
+
+    return crc;
+}
+
+static void ucp_proto_cache_load(ucp_proto_cache_t *cache)
+{
+    char *line        = NULL;
+    size_t line_size  = 0;
+    unsigned num_keys = 0;
+    char *key, *ranges, *saveptr;
+    khiter_t khiter;
+    ssize_t length;
+    FILE *stream;
+    int khret;
+
+    stream = fopen(cache->file_path, "r");
+    if (stream == NULL) {
+        ucs_debug("protocol cache file '%s' is not found", cache->file_path);
+        return;
+    }
+
+    length = getline(&line, &line_size, stream);
+    if ((length < 0) ||
+        strncmp(line, UCP_PROTO_CACHE_FILE_HEADER,
+                strlen(UCP_PROTO_CACHE_FILE_HEADER))) {
+        ucs_debug("protocol cache file '%s' has unsupported format",
+                  cache->file_path);
+        goto out;
+    }
+
+    while (getline(&line, &line_size, stream) >= 0) {
+        key    = strtok_r(line, " \n", &saveptr);
+        ranges = strtok_r(NULL, "\n", &saveptr);
+        if ((key == NULL) || (ranges == NULL)) {
+            continue;
+        }
+
+        key = ucs_strdup(key, "proto_cache_key");
+        if (key == NULL) {
+            break;
+        }
+
+        khiter = kh_put(ucp_proto_cache_hash, &cache->hash, key, &khret);
+        if ((khret == UCS_KH_PUT_FAILED) ||
+            (khret == UCS_KH_PUT_KEY_PRESENT)) {
+            ucs_free(key);
+            continue;
+        }
+
+        kh_value(&cache->hash, khiter) = ucs_strdup(ranges,
+                                                    "proto_cache_ranges");
+        ++num_keys;
+    }
+
+    ucs_debug("loaded %u protocol selections from '%s'", num_keys,
+              cache->file_path);
+
+out:
+    free(line);
+    fclose(stream);
+}
+
+static void ucp_proto_cache_save(ucp_proto_cache_t *cache)
+{
+    char tmp_path[PATH_MAX];
+    const char *key;
+    char *ranges;
+    FILE *stream;
+
+    /* Write to a temporary file and rename it, so processes which share the
+     * cache directory never see a partially written file */
+    ucs_snprintf_safe(tmp_path, sizeof(tmp_path), "%s.%d.tmp",
+                      cache->file_path, getpid());
+    stream = fopen(tmp_path, "w");
+    if (stream == NULL) {
+        ucs_debug("failed to create protocol cache file '%s': %m", tmp_path);
+        return;
+    }
+
+    fprintf(stream, "%s\n", UCP_PROTO_CACHE_FILE_HEADER);
+    kh_foreach(&cache->hash, key, ranges,
+               fprintf(stream, "%s %s\n", key, ranges));
+
+    if ((fclose(stream) != 0) || (rename(tmp_path, cache->file_path) != 0)) {
+        ucs_debug("failed to write protocol cache file '%s': %m",
+                  cache->file_path);
+        unlink(tmp_path);
+        return;
+    }
+
+    ucs_debug("saved %u protocol selections to '%s'",
+              kh_size(&cache->hash), cache->file_path);
+}
+
+void ucp_proto_cache_init(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    char dir_path[PATH_MAX];
+    int ret;
+
+    kh_init_inplace(ucp_proto_cache_hash, &cache->hash);
+    cache->file_path  = NULL;
+    cache->dirty      = 0;
+    cache->num_hits   = 0;
+    cache->num_misses = 0;
+
+    if (ucs_string_is_empty(worker->context->config.ext.proto_cache_dir)) {
+        return;
+    }
+
+    ucs_fill_filename_template(worker->context->config.ext.proto_cache_dir,
+                               dir_path, sizeof(dir_path));
+    ret = mkdir(dir_path, S_IRWXU | S_IRGRP | S_IXGRP);
+    if ((ret != 0) && (errno != EEXIST)) {
+        ucs_diag("failed to create protocol cache directory %s: %m",
+                 dir_path);
+        return;
+    }
+
+    cache->file_path = ucs_malloc(PATH_MAX, "proto_cache_path");
+    if (cache->file_path == NULL) {
+        return;
+    }
+
+    ucs_snprintf_safe(cache->file_path, PATH_MAX, "%s/ucx_proto_%08x.cache",
+                      dir_path, ucp_proto_cache_config_hash(worker));
+    ucp_proto_cache_load(cache);
+}
+
+void ucp_proto_cache_cleanup(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    const char *key;
+    char *ranges;
+
+    if (cache->file_path != NULL) {
+        ucs_debug("worker %p: protocol cache hits %u misses %u", worker,
+                  cache->num_hits, cache->num_misses);
+        if (cache->dirty) {
+            ucp_proto_cache_save(cache);
+        }
+    }
+
+    kh_foreach(&cache->hash, key, ranges,
+               ucs_free((char*)key);
+               ucs_free(ranges));
+    kh_destroy_inplace(ucp_proto_cache_hash, &cache->hash);
+    ucs_free(cache->file_path);
+}
+
+static void ucp_proto_cache_key_lanes(ucs_string_buffer_t *strb,
+                                      const ucp_lane_index_t *lanes)
+{
+    ucp_lane_index_t i;
+
+    for (i = 0; (i < UCP_MAX_LANES) && (lanes[i] != UCP_NULL_LANE); ++i) {
+        ucs_string_buffer_appendf(strb, "%x", lanes[i]);
+    }
+    ucs_string_buffer_appendf(strb, ".");
+}
+
+void ucp_proto_cache_key_str(ucp_worker_h worker,
+                             ucp_worker_cfg_index_t ep_cfg_index,
+                             ucp_worker_cfg_index_t rkey_cfg_index,
+                             const ucp_proto_select_param_t *select_param,
+                             ucs_string_buffer_t *strb)
+{
+    const ucp_ep_config_key_t *key = &ucs_array_elem(&worker->ep_config,
+                                                     ep_cfg_index).key;
+    const ucp_ep_config_key_lane_t *lane;
+    const ucp_rkey_config_t *rkey_config;
+    ucp_proto_select_key_t select_key;
+    ucp_lane_index_t lane_index;
+    int i;
+
+    select_key.param = *select_param;
+    ucs_string_buffer_appendf(strb, "%" PRIx64 "/", select_key.u64);
+
+    for (lane_index = 0; lane_index < key->num_lanes; ++lane_index) {
+        lane = &key->lanes[lane_index];
+        ucs_string_buffer_appendf(strb, "%x.%x.%x.%x.%" PRIx64 ".%zx.",
+                                  lane->rsc_index, lane->dst_md_index,
+                                  lane->dst_sys_dev, lane->path_index,
+                                  (uint64_t)lane->lane_types, lane->seg_size);
+    }
+
+    ucs_string_buffer_appendf(strb, "/%x.%x.%x.%x.%x.%x.", key->am_lane,
+                              key->tag_lane, key->wireup_msg_lane, key->cm_lane,
+                              key->keepalive_lane, key->rkey_ptr_lane);
+    ucp_proto_cache_key_lanes(strb, key->rma_lanes);
+    ucp_proto_cache_key_lanes(strb, key->rma_bw_lanes);
+    ucp_proto_cache_key_lanes(strb, key->amo_lanes);
+    ucp_proto_cache_key_lanes(strb, key->am_bw_lanes);
+    ucs_string_buffer_appendf(strb, "%" PRIx64 ".%" PRIx64 ".%" PRIx64 ".",
+                              key->rma_bw_md_map, key->rma_md_map,
+                              key->reachable_md_map);
+    for (i = 0; i < ucs_popcount(key->reachable_md_map); ++i) {
+        ucs_string_buffer_appendf(strb, "%x", key->dst_md_cmpts[i]);
+    }
+    ucs_string_buffer_appendf(strb, ".%x.%x.%x", key->err_mode, key->flags,
+                              key->dst_version);
+
+    if (rkey_cfg_index == UCP_WORKER_CFG_INDEX_NULL) {
+        return;
+    }
+
+    /* The endpoint configuration index of the remote key is omitted, since
+     * the endpoint configuration is already a part of the key */
+    rkey_config = &worker->rkey_config[rkey_cfg_index];
+    ucs_string_buffer_appendf(strb, "/%" PRIx64 ".%x.%x.%" PRIx64,
+                              rkey_config->key.md_map,
+                              rkey_config->key.sys_dev,
+                              rkey_config->key.mem_type,
+                              rkey_config->key.unreachable_md_map);
+    for (lane_index = 0; lane_index < key->num_lanes; ++lane_index) {
+        ucs_string_buffer_appendf(
+                strb, ".%a.%a", rkey_config->lanes_distance[lane_index].latency,
+                rkey_config->lanes_distance[lane_index].bandwidth);
+    }
+}
+
+static ucp_proto_id_t ucp_proto_cache_find_proto(const char *name)
+{
+    ucp_proto_id_t proto_id;
+
+    for (proto_id = 0; proto_id < ucp_protocols_count(); ++proto_id) {
+        if (!strcmp(ucp_proto_id_field(proto_id, name), name)) {
+            return proto_id;
+        }
+    }
+
+    return UCP_PROTO_ID_INVALID;
+}
+
+ucs_status_t ucp_proto_cache_lookup(ucp_worker_h worker, const char *key,
+                                    ucp_proto_cache_range_t *ranges,
+                                    unsigned *num_ranges_p)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    unsigned num_ranges      = 0;
+    char name[64];
+    const char *p;
+    khiter_t khiter;
+    int consumed;
+
+    khiter = kh_get(ucp_proto_cache_hash, &cache->hash, key);
+    if (khiter == kh_end(&cache->hash)) {
+        goto not_found;
+    }
+
+    /* Ranges are stored as "<protocol>#<variant>:<max_msg_length> ..." */
+    p = kh_value(&cache->hash, khiter);
+    while ((num_ranges < UCP_PROTO_CACHE_MAX_RANGES) &&
+           (sscanf(p, " %63[^#]#%u:%zu%n", name, &ranges[num_ranges].variant,
+                   &ranges[num_ranges].max_msg_length, &consumed) == 3)) {
+        ranges[num_ranges].proto_id = ucp_proto_cache_find_proto(name);
+        if ((ranges[num_ranges].proto_id == UCP_PROTO_ID_INVALID) ||
+            !(worker->context->proto_bitmap &
+              UCS_BIT(ranges[num_ranges].proto_id))) {
+            ucs_debug("cached protocol '%s' is not available", name);
+            goto not_found;
+        }
+
+        p += consumed;
+        ++num_ranges;
+    }
+
+    if ((num_ranges == 0) ||
+        (ranges[num_ranges - 1].max_msg_length != SIZE_MAX)) {
+        ucs_debug("invalid protocol cache entry '%s'",
+                  kh_value(&cache->hash, khiter));
+        goto not_found;
+    }
+
+    ++cache->num_hits;
+    *num_ranges_p = num_ranges;
+    return UCS_OK;
+
+not_found:
+    ++cache->num_misses;
+    return UCS_ERR_NO_ELEM;
+}
+
+void ucp_proto_cache_add(ucp_worker_h worker, const char *key,
+                         const ucp_proto_cache_range_t *ranges,
+                         unsigned num_ranges)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    ucs_string_buffer_t strb = UCS_STRING_BUFFER_INITIALIZER;
+    const ucp_proto_cache_range_t *range;
+    khiter_t khiter;
+    char *key_copy;
+    int khret;
+
+    if (num_ranges > UCP_PROTO_CACHE_MAX_RANGES) {
+        return;
+    }
+
+    for (range = ranges; range < ranges + num_ranges; ++range) {
+        ucs_string_buffer_appendf(&strb, "%s#%u:%zu ",
+                                  ucp_proto_id_field(range->proto_id, name),
+                                  range->variant, range->max_msg_length);
+    }
+    ucs_string_buffer_rtrim(&strb, NULL);
+
+    key_copy = ucs_strdup(key, "proto_cache_key");
+    if (key_copy == NULL) {
+        goto out;
+    }
+
+    khiter = kh_put(ucp_proto_cache_hash, &cache->hash, key_copy, &khret);
+    if (khret == UCS_KH_PUT_FAILED) {
+        ucs_free(key_copy);
+        goto out;
+    } else if (khret == UCS_KH_PUT_KEY_PRESENT) {
+        /* Replace an entry which could not be used */
+        ucs_free(key_copy);
+        ucs_free(kh_value(&cache->hash, khiter));
+    }
+
+    kh_value(&cache->hash, khiter) = ucs_string_buffer_extract_mem(&strb);
+    cache->dirty                   = 1;
+    return;
+
+out:
+    ucs_string_buffer_cleanup(&strb);
+}
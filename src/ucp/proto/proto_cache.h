@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROTO_CACHE_H_
+#define UCP_PROTO_CACHE_H_
+
+#include "proto.h"
+
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/string_buffer.h>
+
+
+/* Maximal number of message size ranges in a cached protocol selection */
+#define UCP_PROTO_CACHE_MAX_RANGES 64
+
+
+/**
+ * Cached protocol selection for a message size range
+ */
+typedef struct {
+    /* Protocol selected for the range */
+    ucp_proto_id_t proto_id;
+
+    /* Index of the protocol element among the elements which were added by
+     * the same protocol during probe (for example, rendezvous variants) */
+    unsigned       variant;
+
+    /* Max message length, inclusive */
+    size_t         max_msg_length;
+} ucp_proto_cache_range_t;
+
+
+/* Hash of selection key string (key) to its serialized ranges (value) */
+KHASH_TYPE(ucp_proto_cache_hash, kh_cstr_t, char*)
+
+
+/**
+ * Persistent cache of protocol selection results. The results are saved to a
+ * file when the worker is destroyed, and loaded when a new worker with the
+ * same transport configuration is created.
+ */
+typedef struct {
+    /* Loaded and newly added selections */
+    khash_t(ucp_proto_cache_hash) hash;
+
+    /* Cache file path, or NULL if the cache is disabled */
+    char                          *file_path;
+
+    /* Whether new selections were added since the file was loaded */
+    int                           dirty;
+
+    /* Number of protocol selections found in the cache */
+    unsigned                      num_hits;
+
+    /* Number of protocol selections which were not found in the cache */
+    unsigned                      num_misses;
+} ucp_proto_cache_t;
+
+
+/**
+ * Load the protocol selection cache file of the worker, if the cache is
+ * enabled by configuration. Must be called after the worker interfaces are
+ * opened, since the cache file name depends on their attributes.
+ */
+void ucp_proto_cache_init(ucp_worker_h worker);
+
+
+/**
+ * Save the new protocol selections to the cache file and release the cache.
+ */
+void ucp_proto_cache_cleanup(ucp_worker_h worker);
+
+
+/**
+ * Build the cache key of a protocol selection. The key does not depend on
+ * configuration indexes, so it remains valid across processes.
+ */
+void ucp_proto_cache_key_str(ucp_worker_h worker,
+                             ucp_worker_cfg_index_t ep_cfg_index,
+                             ucp_worker_cfg_index_t rkey_cfg_index,
+                             const ucp_proto_select_param_t *select_param,
+                             ucs_string_buffer_t *strb);
+
+
+/**
+ * Find a cached protocol selection.
+ *
+ * @return UCS_OK if found, UCS_ERR_NO_ELEM if not found or the cached entry is
+ *         not valid for the current set of protocols.
+ */
+ucs_status_t ucp_proto_cache_lookup(ucp_worker_h worker, const char *key,
+                                    ucp_proto_cache_range_t *ranges,
+                                    unsigned *num_ranges_p);
+
+
+/**
+ * Add a protocol selection to the cache.
+ */
+void ucp_proto_cache_add(ucp_worker_h worker, const char *key,
+                         const ucp_proto_cache_range_t *ranges,
+                         unsigned num_ranges);
+
+#endif
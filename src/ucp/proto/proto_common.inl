@@ -220,6 +220,13 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_proto_request_lookup_proto(
     ucs_assert(thresh_elem->proto_config.ep_cfg_index == ep->cfg_index);
     ucs_assert(thresh_elem->proto_config.rkey_cfg_index == rkey_cfg_index);
     ucp_proto_request_set_proto(req, &thresh_elem->proto_config, msg_length);
+
+    /* Measure the completion time from the first protocol selection */
+    if (ucs_unlikely(worker->context->config.ext.proto_tune) &&
+        !(req->flags & UCP_REQUEST_FLAG_PROTO_TUNE)) {
+        req->flags                |= UCP_REQUEST_FLAG_PROTO_TUNE;
+        req->send.proto_start_time = ucs_get_time();
+    }
     return UCS_OK;
 }
 
@@ -548,7 +548,8 @@ ucs_status_t ucp_proto_init_perf(const ucp_proto_common_init_params_t *params,
         /* Add range that represents sending many fragments */
         if ((range_end < params->max_length) &&
             !(params->flags & UCP_PROTO_COMMON_INIT_FLAG_SINGLE_FRAG)) {
-            frag_seg = ucp_proto_perf_add_ppln(perf, perf, params->max_length);
+            frag_seg = ucp_proto_perf_add_ppln(perf, perf, params->max_length,
+                                               0);
             if (frag_seg == NULL) {
                 goto err_cleanup_perf;
             }
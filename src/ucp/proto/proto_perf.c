@@ -480,9 +480,30 @@ void ucp_proto_perf_apply_func(ucp_proto_perf_t *perf, ucs_linear_func_t func,
  * distinguish which parts of the factors are part of pipeline and which aren't
  * at that moment.
  */
+unsigned ucp_proto_perf_ppln_ramp_frags(size_t first_frag_size,
+                                        size_t frag_size)
+{
+    unsigned num_frags = 0;
+    size_t size;
+
+    if (first_frag_size == 0) {
+        return 0;
+    }
+
+    for (size = first_frag_size; size < frag_size; size *= 2) {
+        ++num_frags;
+        if (size > (SIZE_MAX / 2)) {
+            break;
+        }
+    }
+
+    return num_frags;
+}
+
 const ucp_proto_perf_segment_t *
 ucp_proto_perf_add_ppln(const ucp_proto_perf_t *perf,
-                        ucp_proto_perf_t *ppln_perf, size_t max_length)
+                        ucp_proto_perf_t *ppln_perf, size_t max_length,
+                        size_t first_frag_size)
 {
     ucp_proto_perf_factors_t factors   = UCP_PROTO_PERF_FACTORS_INITIALIZER;
     ucp_proto_perf_segment_t *frag_seg = ucs_list_tail(&perf->segments,
@@ -491,15 +512,20 @@ ucp_proto_perf_add_ppln(const ucp_proto_perf_t *perf,
     size_t frag_size                   = ucp_proto_perf_segment_end(frag_seg);
     ucp_proto_perf_factor_id_t factor_id, max_factor_id;
     ucs_linear_func_t factor_func;
+    unsigned num_ramp_frags;
+    size_t fill_size;
     ucs_status_t status;
-    char frag_str[64];
+    char frag_str[64], first_frag_str[64];
     ucp_proto_perf_node_t *perf_node;
 
     if (frag_size >= max_length) {
         return NULL;
     }
 
-    /* Turn all factors overheads to constant and choose longest one */
+    num_ramp_frags = ucp_proto_perf_ppln_ramp_frags(first_frag_size, frag_size);
+    fill_size      = (num_ramp_frags > 0) ? first_frag_size : frag_size;
+
+    /* Choose the longest factor of a full fragment */
     max_factor_id = 0;
     ucs_assert(max_factor_id != UCP_PROTO_PERF_FACTOR_LATENCY);
     for (factor_id = 0; factor_id < UCP_PROTO_PERF_FACTOR_LAST; factor_id++) {
@@ -511,16 +537,39 @@ ucp_proto_perf_add_ppln(const ucp_proto_perf_t *perf,
         }
     }
 
+    /* Turn all other factors overheads to constant, which is paid for the
+     * first fragment filling the pipeline */
+    if (fill_size != frag_size) {
+        for (factor_id = 0; factor_id < UCP_PROTO_PERF_FACTOR_LAST;
+             factor_id++) {
+            factor_func          = ucp_proto_perf_segment_func(frag_seg,
+                                                               factor_id);
+            factors[factor_id].c = ucs_linear_func_apply(factor_func,
+                                                         fill_size);
+        }
+    }
+
     /* Longest factor still has linear part */
-    factors[max_factor_id]    = ucp_proto_perf_segment_func(frag_seg,
+    factor_func               = ucp_proto_perf_segment_func(frag_seg,
                                                             max_factor_id);
+    factors[max_factor_id]    = factor_func;
     /* Apply the fragment overhead to the performance function linear part
      * since this overhead exists for each fragment */
-    factors[max_factor_id].m += factors[max_factor_id].c / frag_size;
+    factors[max_factor_id].m += factor_func.c / frag_size;
+    /* Fragments of the ramp add their constant overhead */
+    factors[max_factor_id].c += factor_func.c * num_ramp_frags;
 
     ucs_memunits_to_str(frag_size, frag_str, sizeof(frag_str));
-    perf_node = ucp_proto_perf_node_new_data("pipeline", "frag size: %s",
-                                             frag_str);
+    if (num_ramp_frags > 0) {
+        ucs_memunits_to_str(first_frag_size, first_frag_str,
+                            sizeof(first_frag_str));
+        perf_node = ucp_proto_perf_node_new_data("pipeline",
+                                                 "frag size: %s ramp from %s",
+                                                 frag_str, first_frag_str);
+    } else {
+        perf_node = ucp_proto_perf_node_new_data("pipeline", "frag size: %s",
+                                                 frag_str);
+    }
     status    = ucp_proto_perf_add_funcs(ppln_perf, frag_size + 1, max_length,
                                          factors, perf_node,
                                          ucp_proto_perf_segment_node(frag_seg));
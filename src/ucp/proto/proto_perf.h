@@ -198,18 +198,34 @@ void ucp_proto_perf_apply_func(ucp_proto_perf_t *perf, ucs_linear_func_t func,
  * LATENCY factor cannot be chosen as longest one since it overlaps with
  * other simultaneous LATENCY factor operations.
  *
+ * If @a first_frag_size is smaller than the fragment size, fragments start
+ * from @a first_frag_size and double up to the fragment size. The pipeline is
+ * then filled by the first small fragment, and each additional fragment of
+ * the ramp adds the constant overhead of the longest factor.
+ *
  * @param [in] perf       Performance data structure which includes fragment
  *                        performance.
  * @param [in] ppln_perf  Performance data structure which will be extended
  *                        by pipeline performance.
  * @param [in] max_length Message size until what @a perf would be updated.
+ * @param [in] first_frag_size Size of the first fragment, or 0 if all
+ *                        fragments have the same size.
  * 
  * @return NULL in case of error, last segment of `perf` which was used as
  *         performance estimation for sending one fragment.
  */
 const ucp_proto_perf_segment_t *
 ucp_proto_perf_add_ppln(const ucp_proto_perf_t *perf,
-                        ucp_proto_perf_t *ppln_perf, size_t max_length);
+                        ucp_proto_perf_t *ppln_perf, size_t max_length,
+                        size_t first_frag_size);
+
+
+/**
+ * Number of fragments smaller than @a frag_size when the fragment size starts
+ * from @a first_frag_size and doubles with every fragment.
+ */
+unsigned ucp_proto_perf_ppln_ramp_frags(size_t first_frag_size,
+                                        size_t frag_size);
 
 
 /**
@@ -9,6 +9,7 @@
 #endif
 
 #include "proto_init.h"
+#include "proto_cache.h"
 #include "proto_debug.h"
 #include "proto_single.h"
 #include "proto_select.inl"
@@ -57,6 +58,7 @@ static ucs_status_t ucp_proto_thresholds_next_range(
     const ucp_proto_init_elem_t *proto;
     const char *max_prio_proto_name;
     unsigned max_cfg_priority;
+    ucs_linear_func_t *perf;
     ucs_status_t status;
     unsigned proto_idx;
     size_t max_length;
@@ -159,11 +161,12 @@ static ucs_status_t ucp_proto_thresholds_next_range(
         proto = &ucs_array_elem(&proto_init->protocols, proto_idx);
         range = ucp_proto_flat_perf_find_lb(proto->flat_perf, msg_length);
 
-        *ucs_array_append(perf_list, status = UCS_ERR_NO_MEMORY;
-                          goto out_unindent) = range->value;
+        perf  = ucs_array_append(perf_list, status = UCS_ERR_NO_MEMORY;
+                                 goto out_unindent);
+        *perf = ucp_proto_tune_perf(&proto->tune, range->value);
 
-        ucp_proto_select_perf_str(&range->value, time_str, sizeof(time_str),
-                                  bw_str, sizeof(bw_str));
+        ucp_proto_select_perf_str(perf, time_str, sizeof(time_str), bw_str,
+                                  sizeof(bw_str));
         ucs_trace("  %-20s %-20s %-18s",
                   ucp_proto_id_field(proto->proto_id, name), time_str, bw_str);
     }
@@ -183,6 +186,7 @@ ucp_proto_select_init_protocols(ucp_worker_h worker,
                                 ucp_worker_cfg_index_t ep_cfg_index,
                                 ucp_worker_cfg_index_t rkey_cfg_index,
                                 const ucp_proto_select_param_t *select_param,
+                                ucp_proto_id_mask_t proto_bitmap,
                                 ucp_proto_select_init_protocols_t *proto_init)
 {
     UCS_STRING_BUFFER_ONSTACK(strb, UCP_PROTO_CONFIG_STR_MAX);
@@ -213,7 +217,7 @@ ucp_proto_select_init_protocols(ucp_worker_h worker,
     ucs_array_init_dynamic(&proto_init->protocols);
     ucs_array_init_dynamic(&proto_init->priv_buf);
 
-    ucs_for_each_bit(init_params.proto_id, worker->context->proto_bitmap) {
+    ucs_for_each_bit(init_params.proto_id, proto_bitmap) {
         ucs_assert(init_params.proto_id < ucp_protocols_count()); /* Coverity */
         ucs_trace("probing %s", ucp_proto_id_field(init_params.proto_id, name));
         ucs_log_indent(1);
@@ -246,6 +250,27 @@ ucp_proto_select_cleanup_protocols(ucp_proto_select_init_protocols_t *proto_init
     ucs_array_cleanup_dynamic(&proto_init->protocols);
 }
 
+static void ucp_proto_select_thresh_elem_init(
+        ucp_proto_threshold_elem_t *thresh_elem,
+        const ucp_proto_select_init_protocols_t *proto_init, unsigned proto_idx,
+        ucp_worker_cfg_index_t ep_cfg_index,
+        ucp_worker_cfg_index_t rkey_cfg_index,
+        const ucp_proto_select_param_t *select_param, size_t max_msg_length)
+{
+    const ucp_proto_init_elem_t *proto = &ucs_array_elem(&proto_init->protocols,
+                                                         proto_idx);
+    ucp_proto_config_t *proto_config   = &thresh_elem->proto_config;
+
+    thresh_elem->max_msg_length  = max_msg_length;
+    proto_config->proto          = ucp_protocols[proto->proto_id];
+    proto_config->priv           = ucp_proto_select_init_priv_buf(proto_init,
+                                                                  proto_idx);
+    proto_config->ep_cfg_index   = ep_cfg_index;
+    proto_config->rkey_cfg_index = rkey_cfg_index;
+    proto_config->select_param   = *select_param;
+    proto_config->init_elem      = proto;
+}
+
 static ucs_status_t ucp_proto_select_elem_add_envelope(
         const ucp_proto_select_init_protocols_t *proto_init,
         ucp_worker_h worker, ucp_worker_cfg_index_t ep_cfg_index,
@@ -259,7 +284,6 @@ static ucs_status_t ucp_proto_select_elem_add_envelope(
     ucp_proto_perf_envelope_elem_t *envelope_elem;
     ucp_proto_threshold_elem_t *thresh_elem;
     const ucp_proto_init_elem_t *proto;
-    ucp_proto_config_t *proto_config;
     const void *proto_priv;
     unsigned proto_idx;
     size_t UCS_V_UNUSED range_start;
@@ -290,15 +314,11 @@ static ucs_status_t ucp_proto_select_elem_add_envelope(
                                            return UCS_ERR_NO_MEMORY);
 
             ucs_assert(proto_idx < UINT16_MAX);
-            thresh_elem->max_msg_length  = envelope_elem->max_length;
-            proto_config                 = &thresh_elem->proto_config;
-            proto_config->proto          = ucp_protocols[proto->proto_id];
-            proto_config->priv           = proto_priv;
-            proto_config->ep_cfg_index   = ep_cfg_index;
-            proto_config->rkey_cfg_index = rkey_cfg_index;
-            proto_config->select_param   = *select_param;
-            proto_config->init_elem      = proto;
-            *last_proto_idx              = proto_idx;
+            ucp_proto_select_thresh_elem_init(thresh_elem, proto_init,
+                                              proto_idx, ep_cfg_index,
+                                              rkey_cfg_index, select_param,
+                                              envelope_elem->max_length);
+            *last_proto_idx = proto_idx;
         }
 
         /* Print detailed protocol selection data to a user-configured path */
@@ -317,14 +337,13 @@ static ucs_status_t ucp_proto_select_elem_add_envelope(
     return UCS_OK;
 }
 
-static ucs_status_t
-ucp_proto_select_elem_init_thresh(ucp_worker_h worker,
-                                  ucp_proto_select_elem_t *select_elem,
-                                  ucp_proto_select_init_protocols_t *proto_init,
-                                  ucp_worker_cfg_index_t ep_cfg_index,
-                                  ucp_worker_cfg_index_t rkey_cfg_index,
-                                  const ucp_proto_select_param_t *select_param,
-                                  int internal)
+static ucs_status_t ucp_proto_select_elem_init_thresh(
+        ucp_worker_h worker,
+        const ucp_proto_select_init_protocols_t *proto_init,
+        ucp_worker_cfg_index_t ep_cfg_index,
+        ucp_worker_cfg_index_t rkey_cfg_index,
+        const ucp_proto_select_param_t *select_param, int internal,
+        const ucp_proto_threshold_elem_t **thresholds_p)
 {
     ucp_proto_thresh_t thresholds  = UCS_ARRAY_DYNAMIC_INITIALIZER;
     unsigned last_proto_idx        = UINT_MAX;
@@ -386,12 +405,7 @@ ucp_proto_select_elem_init_thresh(ucp_worker_h worker,
 
     ucs_assert_always(!ucs_array_is_empty(&thresholds));
 
-    /* Set pointer to priv buffer (to release it during cleanup) */
-    select_elem->thresholds  = ucs_array_extract_buffer(&thresholds);
-    select_elem->proto_init  = *proto_init;
-    ucs_array_init_dynamic(&proto_init->priv_buf);
-    ucs_array_init_dynamic(&proto_init->protocols);
-
+    *thresholds_p = ucs_array_extract_buffer(&thresholds);
     return UCS_OK;
 
 err_cleanup_envelope:
@@ -450,6 +464,119 @@ ucp_proto_select_wiface_activate(ucp_worker_h worker,
     ep_config->proto_lane_map |= lane_map;
 }
 
+/*
+ * Initialize the thresholds from a cached selection. Only the protocols which
+ * were selected are probed, and the performance of the candidates is not
+ * compared again.
+ */
+static ucs_status_t ucp_proto_select_elem_init_cached(
+        ucp_worker_h worker, ucp_proto_select_elem_t *select_elem,
+        ucp_worker_cfg_index_t ep_cfg_index,
+        ucp_worker_cfg_index_t rkey_cfg_index,
+        const ucp_proto_select_param_t *select_param, const char *cache_key)
+{
+    ucp_proto_thresh_t thresholds      = UCS_ARRAY_DYNAMIC_INITIALIZER;
+    ucp_proto_id_mask_t proto_bitmap   = 0;
+    ucp_proto_cache_range_t ranges[UCP_PROTO_CACHE_MAX_RANGES];
+    ucp_proto_select_init_protocols_t proto_init;
+    ucp_proto_threshold_elem_t *thresh_elem;
+    const ucp_proto_init_elem_t *proto;
+    unsigned i, num_ranges, proto_idx;
+    unsigned variant;
+    ucs_status_t status;
+
+    status = ucp_proto_cache_lookup(worker, cache_key, ranges, &num_ranges);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    for (i = 0; i < num_ranges; ++i) {
+        proto_bitmap |= UCS_BIT(ranges[i].proto_id);
+    }
+
+    status = ucp_proto_select_init_protocols(worker, ep_cfg_index,
+                                             rkey_cfg_index, select_param,
+                                             proto_bitmap, &proto_init);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    for (i = 0; i < num_ranges; ++i) {
+        /* Find the element which was added by the protocol probe */
+        variant = 0;
+        for (proto_idx = 0;
+             proto_idx < ucs_array_length(&proto_init.protocols);
+             ++proto_idx) {
+            proto = &ucs_array_elem(&proto_init.protocols, proto_idx);
+            if ((proto->proto_id == ranges[i].proto_id) &&
+                (variant++ == ranges[i].variant)) {
+                break;
+            }
+        }
+
+        if (proto_idx == ucs_array_length(&proto_init.protocols)) {
+            ucs_debug("cached protocol %s variant %u was not initialized",
+                      ucp_proto_id_field(ranges[i].proto_id, name),
+                      ranges[i].variant);
+            status = UCS_ERR_NO_ELEM;
+            goto err;
+        }
+
+        thresh_elem = ucs_array_append(&thresholds,
+                                       status = UCS_ERR_NO_MEMORY;
+                                       goto err);
+        ucp_proto_select_thresh_elem_init(thresh_elem, &proto_init, proto_idx,
+                                          ep_cfg_index, rkey_cfg_index,
+                                          select_param,
+                                          ranges[i].max_msg_length);
+    }
+
+    select_elem->thresholds = ucs_array_extract_buffer(&thresholds);
+    select_elem->proto_init = proto_init;
+    return UCS_OK;
+
+err:
+    ucs_array_cleanup_dynamic(&thresholds);
+    ucp_proto_select_cleanup_protocols(&proto_init);
+    return status;
+}
+
+/* Save the selected protocols of every message size range */
+static void
+ucp_proto_select_elem_cache_add(ucp_worker_h worker,
+                                const ucp_proto_select_elem_t *select_elem,
+                                const char *cache_key)
+{
+    const ucp_proto_init_elem_t *protocols =
+            ucs_array_begin(&select_elem->proto_init.protocols);
+    ucp_proto_cache_range_t ranges[UCP_PROTO_CACHE_MAX_RANGES];
+    const ucp_proto_threshold_elem_t *thresh_elem;
+    const ucp_proto_init_elem_t *proto, *selected_proto;
+    ucp_proto_cache_range_t *range;
+    unsigned num_ranges;
+
+    num_ranges  = 0;
+    thresh_elem = select_elem->thresholds;
+    do {
+        if (num_ranges == UCP_PROTO_CACHE_MAX_RANGES) {
+            return;
+        }
+
+        selected_proto        = thresh_elem->proto_config.init_elem;
+        range                 = &ranges[num_ranges++];
+        range->proto_id       = selected_proto->proto_id;
+        range->variant        = 0;
+        range->max_msg_length = thresh_elem->max_msg_length;
+        for (proto = protocols; proto < selected_proto; ++proto) {
+            if (proto->proto_id == range->proto_id) {
+                ++range->variant;
+            }
+        }
+    } while ((thresh_elem++)->max_msg_length != SIZE_MAX);
+
+    ucp_proto_cache_add(worker, cache_key, ranges, num_ranges);
+}
+
 static ucs_status_t
 ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
                            ucp_worker_cfg_index_t ep_cfg_index,
@@ -460,6 +587,8 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
     ucp_proto_select_param_t select_param_copy = *select_param;
     UCS_STRING_BUFFER_ONSTACK(sel_param_strb, UCP_PROTO_SELECT_PARAM_STR_MAX);
     UCS_STRING_BUFFER_ONSTACK(config_name_strb, UCP_PROTO_SELECT_PARAM_STR_MAX);
+    ucs_string_buffer_t cache_key_strb = UCS_STRING_BUFFER_INITIALIZER;
+    int use_cache = (worker->proto_cache.file_path != NULL);
     ucp_proto_select_init_protocols_t proto_init;
     ucs_status_t status;
 
@@ -475,20 +604,46 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
 
     ucs_log_indent(1);
 
+    ucs_array_init_dynamic(&select_elem->prev_thresholds);
+
+    if (use_cache) {
+        ucp_proto_cache_key_str(worker, ep_cfg_index, rkey_cfg_index,
+                                &select_param_copy, &cache_key_strb);
+        status = ucp_proto_select_elem_init_cached(
+                worker, select_elem, ep_cfg_index, rkey_cfg_index,
+                &select_param_copy, ucs_string_buffer_cstr(&cache_key_strb));
+        if (status == UCS_OK) {
+            ucs_trace("using cached protocol selection");
+            goto out_activate;
+        }
+    }
+
     status = ucp_proto_select_init_protocols(worker, ep_cfg_index,
                                              rkey_cfg_index, &select_param_copy,
+                                             worker->context->proto_bitmap,
                                              &proto_init);
     if (status != UCS_OK) {
         goto out;
     }
 
-    status = ucp_proto_select_elem_init_thresh(worker, select_elem, &proto_init,
+    status = ucp_proto_select_elem_init_thresh(worker, &proto_init,
                                                ep_cfg_index, rkey_cfg_index,
-                                               &select_param_copy, internal);
+                                               &select_param_copy, internal,
+                                               &select_elem->thresholds);
     if (status != UCS_OK) {
-        goto out_cleanup_proto_init;
+        ucp_proto_select_cleanup_protocols(&proto_init);
+        goto out;
+    }
+
+    /* Keep the initialized protocols (and their priv buffers) */
+    select_elem->proto_init = proto_init;
+
+    if (use_cache) {
+        ucp_proto_select_elem_cache_add(worker, select_elem,
+                                        ucs_string_buffer_cstr(&cache_key_strb));
     }
 
+out_activate:
     ucp_proto_select_wiface_activate(worker, select_elem, ep_cfg_index);
 
     if (!internal) {
@@ -498,9 +653,8 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
 
     status = UCS_OK;
 
-out_cleanup_proto_init:
-    ucp_proto_select_cleanup_protocols(&proto_init);
 out:
+    ucs_string_buffer_cleanup(&cache_key_strb);
     ucs_log_indent(-1);
     return status;
 }
@@ -508,6 +662,12 @@ out:
 static void
 ucp_proto_select_elem_cleanup(ucp_proto_select_elem_t *select_elem)
 {
+    const ucp_proto_threshold_elem_t **thresholds;
+
+    ucs_array_for_each(thresholds, &select_elem->prev_thresholds) {
+        ucs_free((void*)*thresholds);
+    }
+    ucs_array_cleanup_dynamic(&select_elem->prev_thresholds);
     ucs_free((void*)select_elem->thresholds);
     ucp_proto_select_cleanup_protocols(&select_elem->proto_init);
 }
@@ -646,6 +806,7 @@ void ucp_proto_select_add_proto(const ucp_proto_init_params_t *init_params,
     init_elem->cfg_thresh   = cfg_thresh;
     init_elem->cfg_priority = cfg_priority;
     init_elem->perf         = perf;
+    ucp_proto_tune_stats_init(&init_elem->tune);
 
     if (op_attr_flags & UCP_OP_ATTR_FLAG_MULTI_SEND) {
         status = ucp_proto_perf_envelope(init_elem->perf, 0,
@@ -847,6 +1008,7 @@ void ucp_proto_config_query(ucp_worker_h worker,
     };
 
     proto_config->proto->query(&params, proto_attr);
+    proto_attr->tune_factor = proto_config->init_elem->tune.factor;
 }
 
 int ucp_proto_select_elem_query(ucp_worker_h worker,
@@ -867,3 +1029,84 @@ int ucp_proto_select_elem_query(ucp_worker_h worker,
 
     return !(thresh_elem->proto_config.proto->flags & UCP_PROTO_FLAG_INVALID);
 }
+
+/*
+ * Rebuild the thresholds of a protocol selection if the performance correction
+ * of any of its protocols has changed. The previous thresholds array is kept
+ * until the selection is destroyed, since in-flight requests may still point
+ * to it.
+ */
+static void ucp_proto_select_elem_tune(ucp_worker_h worker,
+                                       ucp_proto_select_elem_t *select_elem)
+{
+    const ucp_proto_config_t *proto_config =
+            &select_elem->thresholds->proto_config;
+    const ucp_proto_threshold_elem_t *thresholds, *thresh_elem, **prev;
+    char range_str[64];
+    ucp_proto_init_elem_t *proto;
+    size_t range_start;
+    ucs_status_t status;
+    int changed;
+
+    changed = 0;
+    ucs_array_for_each(proto, &select_elem->proto_init.protocols) {
+        changed |= ucp_proto_tune_stats_update(
+                worker, &proto->tune, ucp_proto_id_field(proto->proto_id, name));
+    }
+
+    if (!changed) {
+        return;
+    }
+
+    status = ucp_proto_select_elem_init_thresh(worker,
+                                               &select_elem->proto_init,
+                                               proto_config->ep_cfg_index,
+                                               proto_config->rkey_cfg_index,
+                                               &proto_config->select_param, 1,
+                                               &thresholds);
+    if (status != UCS_OK) {
+        ucs_debug("worker %p: failed to rebuild protocol thresholds: %s",
+                  worker, ucs_status_string(status));
+        return;
+    }
+
+    prev = ucs_array_append(&select_elem->prev_thresholds,
+                            ucs_free((void*)thresholds);
+                            return);
+    *prev = select_elem->thresholds;
+
+    select_elem->thresholds = thresholds;
+    ucp_proto_select_wiface_activate(worker, select_elem,
+                                     proto_config->ep_cfg_index);
+    ++worker->proto_tune.num_updates;
+
+    ucs_debug("worker %p: tuned protocol thresholds for %s", worker,
+              ucp_operation_names[ucp_proto_select_op_id(
+                      &proto_config->select_param)]);
+    range_start = 0;
+    thresh_elem = thresholds;
+    do {
+        ucs_debug("  %-20s %s x%.2f",
+                  ucs_memunits_range_str(range_start,
+                                         thresh_elem->max_msg_length,
+                                         range_str, sizeof(range_str)),
+                  thresh_elem->proto_config.proto->name,
+                  thresh_elem->proto_config.init_elem->tune.factor);
+        range_start = thresh_elem->max_msg_length + 1;
+    } while ((thresh_elem++)->max_msg_length != SIZE_MAX);
+}
+
+void ucp_proto_select_tune(ucp_worker_h worker,
+                           ucp_proto_select_t *proto_select)
+{
+    khiter_t iter;
+
+    for (iter = kh_begin(proto_select->hash);
+         iter != kh_end(proto_select->hash); ++iter) {
+        if (!kh_exist(proto_select->hash, iter)) {
+            continue;
+        }
+
+        ucp_proto_select_elem_tune(worker, &kh_val(proto_select->hash, iter));
+    }
+}
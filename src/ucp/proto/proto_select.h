@@ -9,6 +9,7 @@
 
 #include "proto.h"
 #include "proto_perf.h"
+#include "proto_tune.h"
 
 #include <ucs/datastruct/khash.h>
 #include <ucs/datastruct/array.h>
@@ -55,6 +56,7 @@ typedef struct {
     unsigned              cfg_priority; /* Priority of configuration */
     ucp_proto_perf_t      *perf;
     ucp_proto_flat_perf_t *flat_perf; /* Flat performance considering all parts */
+    ucp_proto_tune_stats_t tune; /* Online tuning of the performance estimation */
 } ucp_proto_init_elem_t;
 
 
@@ -142,6 +144,10 @@ typedef struct {
 
     /* All the initialized protocols that can be chosen */
     ucp_proto_select_init_protocols_t proto_init;
+
+    /* Thresholds replaced by online tuning, which may still be referenced by
+     * in-flight requests */
+    ucs_array_s(unsigned, const ucp_proto_threshold_elem_t*) prev_thresholds;
 } ucp_proto_select_elem_t;
 
 
@@ -236,4 +242,9 @@ int ucp_proto_select_elem_query(ucp_worker_h worker,
                                 size_t msg_length,
                                 ucp_proto_query_attr_t *proto_attr);
 
+
+/* Rebuild the thresholds whose protocols performance corrections have changed */
+void ucp_proto_select_tune(ucp_worker_h worker,
+                           ucp_proto_select_t *proto_select);
+
 #endif
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "proto_tune.h"
+#include "proto_debug.h"
+#include "proto_select.inl"
+
+#include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_ep.h>
+#include <ucp/core/ucp_request.h>
+#include <ucp/core/ucp_worker.h>
+#include <uct/base/uct_worker.h>
+#include <ucs/async/async.h>
+#include <ucs/time/time.h>
+#include <math.h>
+
+
+/* Limits of the performance correction factor, to avoid a single outlier
+ * (for example, a request which waited for a connection) disabling a protocol
+ * altogether */
+#define UCP_PROTO_TUNE_MIN_FACTOR 1e-3
+#define UCP_PROTO_TUNE_MAX_FACTOR 1e3
+
+
+static unsigned ucp_proto_tune_progress(void *arg)
+{
+    ucp_worker_h worker = arg;
+
+    UCS_ASYNC_BLOCK(&worker->async);
+    ucp_proto_tune_update(worker);
+    UCS_ASYNC_UNBLOCK(&worker->async);
+    return 1;
+}
+
+static int
+ucp_proto_tune_progress_filter(const ucs_callbackq_elem_t *elem, void *arg)
+{
+    return elem->cb == ucp_proto_tune_progress;
+}
+
+void ucp_proto_tune_init(ucp_worker_h worker)
+{
+    const ucp_context_config_t *config = &worker->context->config.ext;
+
+    worker->proto_tune.last_update      = ucs_get_time();
+    worker->proto_tune.interval         =
+            ucs_time_from_sec(config->proto_tune_interval);
+    worker->proto_tune.update_scheduled = 0;
+    worker->proto_tune.num_updates      = 0;
+}
+
+void ucp_proto_tune_cleanup(ucp_worker_h worker)
+{
+    if (worker->proto_tune.update_scheduled) {
+        ucs_callbackq_remove_oneshot(&worker->uct->progress_q, worker,
+                                     ucp_proto_tune_progress_filter, NULL);
+        worker->proto_tune.update_scheduled = 0;
+    }
+}
+
+void ucp_proto_tune_stats_init(ucp_proto_tune_stats_t *stats)
+{
+    stats->measured    = 0;
+    stats->estimated   = 0;
+    stats->num_samples = 0;
+    stats->factor      = 1.0;
+}
+
+void ucp_proto_tune_request_sample(ucp_request_t *req, ucs_status_t status)
+{
+    ucp_worker_h worker = req->send.ep->worker;
+    size_t msg_length   = req->send.state.dt_iter.length;
+    ucs_time_t now      = ucs_get_time();
+    const ucp_proto_flat_perf_range_t *range;
+    ucp_proto_init_elem_t *proto;
+
+    if (status != UCS_OK) {
+        return;
+    }
+
+    /* The statistics are updated in place: the protocol element is owned by
+     * the selection which the request's protocol configuration came from */
+    proto = (ucp_proto_init_elem_t*)req->send.proto_config->init_elem;
+    range = ucp_proto_flat_perf_find_lb(proto->flat_perf, msg_length);
+    if ((range == NULL) || (range->start > msg_length)) {
+        return;
+    }
+
+    proto->tune.measured  += ucs_time_to_sec(now - req->send.proto_start_time);
+    proto->tune.estimated += ucs_linear_func_apply(range->value, msg_length);
+    ++proto->tune.num_samples;
+
+    if (!worker->proto_tune.update_scheduled &&
+        ((now - worker->proto_tune.last_update) >=
+         worker->proto_tune.interval)) {
+        worker->proto_tune.update_scheduled = 1;
+        ucs_callbackq_add_oneshot(&worker->uct->progress_q, worker,
+                                  ucp_proto_tune_progress, worker);
+    }
+}
+
+int ucp_proto_tune_stats_update(ucp_worker_h worker,
+                                ucp_proto_tune_stats_t *stats,
+                                const char *proto_name)
+{
+    const ucp_context_config_t *config = &worker->context->config.ext;
+    double factor;
+
+    if (stats->num_samples < config->proto_tune_min_samples) {
+        return 0;
+    }
+
+    factor = (stats->estimated > 0) ? (stats->measured / stats->estimated) :
+                                      stats->factor;
+    factor = ucs_min(ucs_max(factor, UCP_PROTO_TUNE_MIN_FACTOR),
+                     UCP_PROTO_TUNE_MAX_FACTOR);
+    ucs_trace("%s: %u samples measured %.3f us estimated %.3f us factor %.2f",
+              proto_name, stats->num_samples,
+              stats->measured * UCS_USEC_PER_SEC / stats->num_samples,
+              stats->estimated * UCS_USEC_PER_SEC / stats->num_samples,
+              factor);
+
+    stats->measured    = 0;
+    stats->estimated   = 0;
+    stats->num_samples = 0;
+
+    if (fabs(factor - stats->factor) <=
+        (config->proto_tune_hysteresis * stats->factor)) {
+        return 0;
+    }
+
+    ucs_debug("%s: performance correction factor %.2f -> %.2f", proto_name,
+              stats->factor, factor);
+    stats->factor = factor;
+    return 1;
+}
+
+void ucp_proto_tune_update(ucp_worker_h worker)
+{
+    ucp_rkey_config_t *rkey_config;
+    ucp_ep_config_t *ep_config;
+
+    worker->proto_tune.update_scheduled = 0;
+    worker->proto_tune.last_update      = ucs_get_time();
+
+    ucs_array_for_each(ep_config, &worker->ep_config) {
+        ucp_proto_select_tune(worker, &ep_config->proto_select);
+    }
+
+    ucs_carray_for_each(rkey_config, worker->rkey_config,
+                        worker->rkey_config_count) {
+        ucp_proto_select_tune(worker, &rkey_config->proto_select);
+    }
+}
+
+static int
+ucp_proto_tune_is_selected(const ucp_proto_threshold_elem_t *thresh_elem,
+                           const ucp_proto_init_elem_t *proto)
+{
+    do {
+        if (thresh_elem->proto_config.init_elem == proto) {
+            return 1;
+        }
+    } while ((thresh_elem++)->max_msg_length != SIZE_MAX);
+
+    return 0;
+}
+
+static void ucp_proto_tune_dump_select(ucp_worker_h worker,
+                                       ucp_proto_select_t *proto_select,
+                                       ucp_worker_cfg_index_t ep_cfg_index,
+                                       ucp_worker_cfg_index_t rkey_cfg_index,
+                                       ucs_string_buffer_t *strb)
+{
+    const ucp_proto_threshold_elem_t *thresh_elem;
+    const ucp_proto_init_elem_t *proto;
+    ucp_proto_select_elem_t select_elem;
+    ucp_proto_select_key_t key;
+    char range_str[64];
+    size_t range_start;
+
+    kh_foreach(proto_select->hash, key.u64, select_elem,
+        ucp_ep_config_name(worker, ep_cfg_index, strb);
+        ucs_string_buffer_appendf(strb, " ");
+        ucp_proto_select_info_str(worker, rkey_cfg_index, &key.param,
+                                  ucp_operation_names, strb);
+        ucs_string_buffer_appendf(strb, "\n");
+
+        range_start = 0;
+        thresh_elem = select_elem.thresholds;
+        do {
+            ucs_string_buffer_appendf(
+                    strb, "  %-20s %-24s x%.2f\n",
+                    ucs_memunits_range_str(range_start,
+                                           thresh_elem->max_msg_length,
+                                           range_str, sizeof(range_str)),
+                    thresh_elem->proto_config.proto->name,
+                    thresh_elem->proto_config.init_elem->tune.factor);
+            range_start = thresh_elem->max_msg_length + 1;
+        } while ((thresh_elem++)->max_msg_length != SIZE_MAX);
+
+        /* Show corrections of protocols which are not selected anymore */
+        ucs_array_for_each(proto, &select_elem.proto_init.protocols) {
+            if ((proto->tune.factor != 1.0) &&
+                !ucp_proto_tune_is_selected(select_elem.thresholds, proto)) {
+                ucs_string_buffer_appendf(
+                        strb, "  %-20s %-24s x%.2f\n", "-",
+                        ucp_proto_id_field(proto->proto_id, name),
+                        proto->tune.factor);
+            }
+        }
+    )
+}
+
+void ucp_proto_tune_dump(ucp_worker_h worker, ucs_string_buffer_t *strb)
+{
+    ucp_worker_cfg_index_t cfg_index;
+    ucp_rkey_config_t *rkey_config;
+
+    for (cfg_index = 0; cfg_index < ucs_array_length(&worker->ep_config);
+         ++cfg_index) {
+        ucp_proto_tune_dump_select(
+                worker, &ucs_array_elem(&worker->ep_config, cfg_index)
+                                 .proto_select,
+                cfg_index, UCP_WORKER_CFG_INDEX_NULL, strb);
+    }
+
+    for (cfg_index = 0; cfg_index < worker->rkey_config_count; ++cfg_index) {
+        rkey_config = &worker->rkey_config[cfg_index];
+        ucp_proto_tune_dump_select(worker, &rkey_config->proto_select,
+                                   rkey_config->key.ep_cfg_index, cfg_index,
+                                   strb);
+    }
+}
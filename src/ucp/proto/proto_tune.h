@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROTO_TUNE_H_
+#define UCP_PROTO_TUNE_H_
+
+#include <ucp/api/ucp_def.h>
+#include <ucp/core/ucp_types.h>
+#include <ucs/datastruct/linear_func.h>
+#include <ucs/datastruct/string_buffer.h>
+#include <ucs/time/time_def.h>
+
+
+/**
+ * Completion time samples of a protocol, and the correction learned from them
+ */
+typedef struct {
+    /* Sum of measured completion times since the last update, in seconds */
+    double   measured;
+
+    /* Sum of estimated completion times since the last update, in seconds */
+    double   estimated;
+
+    /* Number of samples since the last update */
+    unsigned num_samples;
+
+    /* Ratio of measured to estimated completion time which is applied to the
+     * protocol performance estimation during selection */
+    double   factor;
+} ucp_proto_tune_stats_t;
+
+
+/**
+ * Per-worker state of online protocol threshold tuning
+ */
+typedef struct {
+    /* Time of the last thresholds update */
+    ucs_time_t last_update;
+
+    /* Minimal time between thresholds updates */
+    ucs_time_t interval;
+
+    /* Whether a thresholds update is scheduled on the progress queue */
+    int        update_scheduled;
+
+    /* Number of protocol selections whose thresholds were rebuilt */
+    unsigned   num_updates;
+} ucp_proto_tune_t;
+
+
+/**
+ * Initialize online tuning state of the worker.
+ */
+void ucp_proto_tune_init(ucp_worker_h worker);
+
+
+/**
+ * Cancel a pending thresholds update of the worker.
+ */
+void ucp_proto_tune_cleanup(ucp_worker_h worker);
+
+
+/**
+ * Initialize the tuning statistics of a newly added protocol.
+ */
+void ucp_proto_tune_stats_init(ucp_proto_tune_stats_t *stats);
+
+
+/**
+ * Record the completion time of a send request which was started with online
+ * tuning enabled, and schedule a thresholds update if it is due.
+ */
+void ucp_proto_tune_request_sample(ucp_request_t *req, ucs_status_t status);
+
+
+/**
+ * Fold the samples collected since the last update into the correction factor
+ * of a protocol.
+ *
+ * @return Nonzero if the correction factor has changed by more than the
+ *         configured hysteresis, and the thresholds should be rebuilt.
+ */
+int ucp_proto_tune_stats_update(ucp_worker_h worker,
+                                ucp_proto_tune_stats_t *stats,
+                                const char *proto_name);
+
+
+/**
+ * Rebuild the thresholds of all protocol selections of the worker whose
+ * protocols performance corrections have changed.
+ */
+void ucp_proto_tune_update(ucp_worker_h worker);
+
+
+/**
+ * Apply the learned correction factor to a performance estimation.
+ */
+static UCS_F_ALWAYS_INLINE ucs_linear_func_t
+ucp_proto_tune_perf(const ucp_proto_tune_stats_t *stats, ucs_linear_func_t perf)
+{
+    return ucs_linear_func_make(perf.c * stats->factor, perf.m * stats->factor);
+}
+
+
+/**
+ * Dump the tuned thresholds of all protocol selections of the worker.
+ */
+void ucp_proto_tune_dump(ucp_worker_h worker, ucs_string_buffer_t *strb);
+
+#endif
@@ -11,6 +11,7 @@
 #include <ucp/core/ucp_ep.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_request.inl>
+#include <ucp/stream/stream.h>
 
 #include "rma.inl"
 
@@ -386,6 +387,14 @@ ucs_status_ptr_t ucp_ep_flush_internal(ucp_ep_h ep, unsigned req_flags,
 
     ucs_debug("%s ep %p", debug_name, ep);
 
+    if (ep->flags & UCP_EP_FLAG_STREAM_COALESCE) {
+        /* Send the staged stream data before the flush */
+        status = ucp_stream_coalesce_flush(ep);
+        if (status != UCS_OK) {
+            return UCS_STATUS_PTR(status);
+        }
+    }
+
     req = ucp_request_get_param(ep->worker, param,
                                 {return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);});
 
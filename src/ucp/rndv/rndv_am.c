@@ -51,14 +51,36 @@ static UCS_F_ALWAYS_INLINE void ucp_rndv_am_destroy_rkey(ucp_request_t *req)
     }
 }
 
+static UCS_F_ALWAYS_INLINE void
+ucp_proto_rndv_am_bcopy_offload_finish(ucp_request_t *req)
+{
+    if (req->send.rndv.am.offload != NULL) {
+        ucp_dt_offload_pack_finish(&req->send.ep->worker->context->dt_offload,
+                                   req->send.rndv.am.offload);
+        req->send.rndv.am.offload = NULL;
+    }
+}
+
 static size_t ucp_proto_rndv_am_bcopy_pack(void *dest, void *arg)
 {
     ucp_request_data_hdr_t *hdr          = dest;
     ucp_proto_multi_pack_ctx_t *pack_ctx = arg;
+    ucp_request_t *req                   = pack_ctx->req;
+    ucp_datatype_iter_t *dt_iter         = &req->send.state.dt_iter;
+    size_t length;
+
+    ucp_rndv_am_fill_header(hdr, req);
 
-    ucp_rndv_am_fill_header(hdr, pack_ctx->req);
+    if (req->send.rndv.am.offload == NULL) {
+        return sizeof(*hdr) + ucp_proto_multi_data_pack(pack_ctx, hdr + 1);
+    }
 
-    return sizeof(*hdr) + ucp_proto_multi_data_pack(pack_ctx, hdr + 1);
+    /* The data was already packed by the offload thread */
+    length = ucs_min(dt_iter->length - dt_iter->offset, pack_ctx->max_payload);
+    ucp_dt_offload_pack_copy(req->send.rndv.am.offload, hdr + 1,
+                             dt_iter->offset, length);
+    pack_ctx->next_iter->offset = dt_iter->offset + length;
+    return sizeof(*hdr) + length;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t ucp_proto_rndv_am_bcopy_send_func(
@@ -85,20 +107,67 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_proto_rndv_am_bcopy_send_func(
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_proto_rndv_am_bcopy_complete(ucp_request_t *req)
 {
+    ucp_proto_rndv_am_bcopy_offload_finish(req);
     ucp_rndv_am_destroy_rkey(req);
     ucp_datatype_iter_mem_dereg(&req->send.state.dt_iter, UCP_DT_MASK_ALL);
     return ucp_proto_request_bcopy_complete_success(req);
 }
 
+static void ucp_proto_rndv_am_bcopy_request_init(ucp_request_t *req,
+                                                 const ucp_proto_multi_priv_t *mpriv)
+{
+    ucp_context_h context              = req->send.ep->worker->context;
+    const ucp_datatype_iter_t *dt_iter = &req->send.state.dt_iter;
+    ucs_status_t status;
+
+    ucp_proto_multi_request_init(req);
+    req->send.rndv.am.offload = NULL;
+
+    if ((dt_iter->dt_class != UCP_DATATYPE_GENERIC) ||
+        (context->dt_offload.num_threads == 0) ||
+        (dt_iter->length < context->config.ext.generic_dt_offload_thresh)) {
+        return;
+    }
+
+    /* Pack in chunks of the data sent by a round over all lanes */
+    status = ucp_dt_offload_pack_start(&context->dt_offload, req,
+                                       mpriv->max_frag_sum,
+                                       &req->send.rndv.am.offload);
+    if (status != UCS_OK) {
+        ucs_diag("req %p: failed to offload generic datatype packing: %s",
+                 req, ucs_status_string(status));
+    }
+}
+
 static ucs_status_t ucp_proto_rndv_am_bcopy_progress(uct_pending_req_t *uct_req)
 {
     ucp_request_t *req = ucs_container_of(uct_req, ucp_request_t, send.uct);
-
     /* coverity[tainted_data_downcast] */
-    return ucp_proto_multi_bcopy_progress(req, req->send.proto_config->priv,
-                                          NULL,
-                                          ucp_proto_rndv_am_bcopy_send_func,
-                                          ucp_proto_rndv_am_bcopy_complete);
+    const ucp_proto_multi_priv_t *mpriv = req->send.proto_config->priv;
+    const ucp_proto_multi_lane_priv_t *lpriv;
+    size_t max_payload, end_offset;
+
+    if (!(req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED)) {
+        ucp_proto_rndv_am_bcopy_request_init(req, mpriv);
+        req->flags |= UCP_REQUEST_FLAG_PROTO_INITIALIZED;
+    }
+
+    if (req->send.rndv.am.offload != NULL) {
+        lpriv       = &mpriv->lanes[req->send.multi_lane_idx];
+        max_payload = ucp_proto_multi_max_payload(
+                req, lpriv, sizeof(ucp_request_data_hdr_t));
+        end_offset  = ucs_min(req->send.state.dt_iter.offset + max_payload,
+                              req->send.state.dt_iter.length);
+        if (!ucp_dt_offload_pack_is_ready(req->send.rndv.am.offload,
+                                          end_offset)) {
+            /* The offload thread resumes the request when the data is ready */
+            return UCS_OK;
+        }
+    }
+
+    return ucp_proto_multi_progress(req, mpriv,
+                                    ucp_proto_rndv_am_bcopy_send_func,
+                                    ucp_proto_rndv_am_bcopy_complete, UINT_MAX);
 }
 
 static void ucp_rndv_am_bcopy_probe(const ucp_proto_init_params_t *init_params)
@@ -126,11 +195,24 @@ static void ucp_rndv_am_bcopy_probe(const ucp_proto_init_params_t *init_params)
 static void
 ucp_proto_rndv_am_bcopy_abort(ucp_request_t *req, ucs_status_t status)
 {
+    if (req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED) {
+        ucp_proto_rndv_am_bcopy_offload_finish(req);
+    }
+
     ucp_rndv_am_destroy_rkey(req);
     ucp_datatype_iter_mem_dereg(&req->send.state.dt_iter, UCP_DT_MASK_ALL);
     ucp_proto_request_bcopy_abort(req,status);
 }
 
+static ucs_status_t ucp_proto_rndv_am_bcopy_reset(ucp_request_t *req)
+{
+    if (req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED) {
+        ucp_proto_rndv_am_bcopy_offload_finish(req);
+    }
+
+    return ucp_proto_request_bcopy_reset(req);
+}
+
 ucp_proto_t ucp_rndv_am_bcopy_proto = {
     .name     = "rndv/am/bcopy",
     .desc     = "fragmented " UCP_PROTO_COPY_IN_DESC " " UCP_PROTO_COPY_OUT_DESC,
@@ -139,7 +221,7 @@ ucp_proto_t ucp_rndv_am_bcopy_proto = {
     .query    = ucp_proto_multi_query,
     .progress = {ucp_proto_rndv_am_bcopy_progress},
     .abort    = ucp_proto_rndv_am_bcopy_abort,
-    .reset    = ucp_proto_request_bcopy_reset
+    .reset    = ucp_proto_rndv_am_bcopy_reset
 };
 
 static UCS_F_ALWAYS_INLINE ucs_status_t ucp_rndv_am_zcopy_send_func(
@@ -28,21 +28,29 @@ enum {
 typedef struct {
     ucp_proto_rndv_ack_priv_t ack;                   /* Ack configuration */
     size_t                    frag_size;             /* Fragment size */
+    size_t                    first_frag_size;       /* Size of the first
+                                                        fragment */
     ucp_proto_config_t        frag_proto_cfg;        /* Frag proto config */
     size_t                    frag_proto_min_length; /* Frag proto min length */
 } ucp_proto_rndv_ppln_priv_t;
 
 static ucs_status_t
-ucp_proto_rndv_ppln_add_overhead(ucp_proto_perf_t *ppln_perf, size_t frag_size)
+ucp_proto_rndv_ppln_add_overhead(ucp_proto_perf_t *ppln_perf, size_t frag_size,
+                                 size_t first_frag_size)
 {
     static const double frag_overhead = 30e-9;
     ucp_proto_perf_factors_t factors  = UCP_PROTO_PERF_FACTORS_INITIALIZER;
+    unsigned num_ramp_frags;
     char frag_str[64];
     ucp_proto_perf_node_t *node;
 
+    /* Every fragment of the ramp is an additional fragment */
+    num_ramp_frags = ucp_proto_perf_ppln_ramp_frags(first_frag_size,
+                                                    frag_size);
     ucs_memunits_to_str(frag_size, frag_str, sizeof(frag_str));
     factors[UCP_PROTO_PERF_FACTOR_LOCAL_CPU] =
-            ucs_linear_func_make(frag_overhead, frag_overhead / frag_size);
+            ucs_linear_func_make(frag_overhead * (1 + num_ramp_frags),
+                                 frag_overhead / frag_size);
     node = ucp_proto_perf_node_new_data("fragment overhead", "frag size: %s",
                                         frag_str);
     return ucp_proto_perf_add_funcs(ppln_perf, frag_size + 1, SIZE_MAX, factors,
@@ -65,6 +73,7 @@ ucp_proto_rndv_ppln_probe(const ucp_proto_init_params_t *init_params)
     ucp_proto_select_t *proto_select;
     ucp_proto_init_elem_t *proto;
     char frag_size_str[32];
+    size_t first_frag_size;
     void *frag_proto_priv;
     ucs_status_t status;
     uint8_t proto_flags;
@@ -120,15 +129,23 @@ ucp_proto_rndv_ppln_probe(const ucp_proto_init_params_t *init_params)
             continue;
         }
 
-        frag_seg = ucp_proto_perf_add_ppln(proto->perf, ppln_perf, SIZE_MAX);
+        /* Fragment size grows from the first fragment size, which must be
+         * supported by the fragment protocol */
+        first_seg       = ucp_proto_perf_find_segment_lb(proto->perf, 0);
+        rpriv.frag_proto_min_length = ucp_proto_perf_segment_start(first_seg);
+        first_frag_size = ucs_max(rpriv.frag_proto_min_length, 1);
+        first_frag_size = ucs_max(first_frag_size,
+                                  worker->context->config.ext.rndv_ppln_ramp_start);
+
+        frag_seg = ucp_proto_perf_add_ppln(proto->perf, ppln_perf, SIZE_MAX,
+                                           first_frag_size);
         if (frag_seg == NULL) {
             goto out_destroy_ppln_perf;
         }
 
         /* Initialize private data */
-        rpriv.frag_size = ucp_proto_perf_segment_end(frag_seg);
-        first_seg       = ucp_proto_perf_find_segment_lb(proto->perf, 0);
-        rpriv.frag_proto_min_length = ucp_proto_perf_segment_start(first_seg);
+        rpriv.frag_size       = ucp_proto_perf_segment_end(frag_seg);
+        rpriv.first_frag_size = ucs_min(first_frag_size, rpriv.frag_size);
         ucs_assertv(rpriv.frag_size >= rpriv.frag_proto_min_length,
                     "rpriv.frag_size=%zu rpriv.frag_proto_min_length=%zu",
                     rpriv.frag_size, rpriv.frag_proto_min_length);
@@ -147,7 +164,8 @@ ucp_proto_rndv_ppln_probe(const ucp_proto_init_params_t *init_params)
                   ucs_string_buffer_cstr(&seg_strb));
 
         /* Add fragment overhead */
-        status = ucp_proto_rndv_ppln_add_overhead(ppln_perf, rpriv.frag_size);
+        status = ucp_proto_rndv_ppln_add_overhead(ppln_perf, rpriv.frag_size,
+                                                  rpriv.first_frag_size);
         if (status != UCS_OK) {
             goto out_destroy_ppln_perf;
         }
@@ -258,7 +276,7 @@ static ucs_status_t ucp_proto_rndv_ppln_progress(uct_pending_req_t *uct_req)
     ucp_datatype_iter_t next_iter;
     ucs_status_t status;
     ucp_request_t *freq;
-    size_t overlap;
+    size_t overlap, frag_size;
 
     /* Nested pipeline is prevented during protocol selection */
     ucs_assert(!(req->flags & UCP_REQUEST_FLAG_RNDV_FRAG));
@@ -269,6 +287,7 @@ static ucs_status_t ucp_proto_rndv_ppln_progress(uct_pending_req_t *uct_req)
     req->send.state.completed_size    = 0;
     req->send.rndv.ppln.ack_data_size = 0;
     rpriv                             = req->send.proto_config->priv;
+    frag_size                         = rpriv->first_frag_size;
 
     while (!ucp_datatype_iter_is_end(&req->send.state.dt_iter)) {
         status = ucp_proto_rndv_frag_request_alloc(worker, req, &freq);
@@ -279,7 +298,7 @@ static ucs_status_t ucp_proto_rndv_ppln_progress(uct_pending_req_t *uct_req)
 
         /* Initialize datatype for the fragment */
         overlap = ucp_datatype_iter_next_slice_overlap(
-                &req->send.state.dt_iter, rpriv->frag_size,
+                &req->send.state.dt_iter, frag_size,
                 rpriv->frag_proto_min_length, &freq->send.state.dt_iter,
                 &next_iter);
         req->send.rndv.ppln.ack_data_size -= overlap;
@@ -305,6 +324,9 @@ static ucs_status_t ucp_proto_rndv_ppln_progress(uct_pending_req_t *uct_req)
 
         ucp_datatype_iter_copy_position(&req->send.state.dt_iter, &next_iter,
                                         UCS_BIT(UCP_DATATYPE_CONTIG));
+
+        /* Grow the fragments geometrically up to the pipeline fragment size */
+        frag_size = ucs_min(frag_size * 2, rpriv->frag_size);
     }
 
     return UCS_OK;
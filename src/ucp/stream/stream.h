@@ -25,12 +25,31 @@ typedef struct {
 } ucp_stream_am_data_t;
 
 
+/**
+ * Staging buffer of small stream sends, which are sent as one message
+ */
+struct ucp_stream_coalesce {
+    ucs_list_link_t          list;      /* Entry in worker's stream_coalesce_eps */
+    ucp_ep_h                 ep;        /* Endpoint which owns the buffer */
+    void                     *buffer;   /* Staged data, or NULL if the buffer
+                                           was passed to a send request */
+    size_t                   length;    /* Length of the staged data */
+    ucs_time_t               deadline;  /* Time to send the staged data */
+    uint64_t                 num_sends; /* Number of coalesced sends */
+    uint64_t                 num_msgs;  /* Number of staged data sends */
+};
+
+
 void ucp_stream_ep_init(ucp_ep_h ep);
 
 void ucp_stream_ep_cleanup(ucp_ep_h ep, ucs_status_t status);
 
 void ucp_stream_ep_activate(ucp_ep_h ep);
 
+ucs_status_t ucp_stream_coalesce_flush(ucp_ep_h ep);
+
+void ucp_stream_coalesce_destroy(ucp_ep_h ep);
+
 
 static UCS_F_ALWAYS_INLINE int ucp_stream_ep_is_queued(ucp_ep_ext_t *ep_ext)
 {
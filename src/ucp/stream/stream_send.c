@@ -118,10 +118,9 @@ ucp_stream_send_nbx_am_short(ucp_ep_t *ep, const void *buffer, size_t length)
     return UCS_ERR_NO_RESOURCE;
 }
 
-UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
-                 (ep, buffer, count, param),
-                 ucp_ep_h ep, const void *buffer, size_t count,
-                 const ucp_request_param_t *param)
+static ucs_status_ptr_t
+ucp_stream_send_nbx_internal(ucp_ep_h ep, const void *buffer, size_t count,
+                             const ucp_request_param_t *param)
 {
     ucp_worker_h worker     = ep->worker;
     size_t contig_length    = 0;
@@ -132,26 +131,6 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
     uint32_t attr_mask;
     size_t length;
 
-    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_STREAM,
-                                    return UCS_STATUS_PTR(
-                                            UCS_ERR_INVALID_PARAM));
-    UCP_REQUEST_CHECK_PARAM(param);
-    if (ENABLE_PARAMS_CHECK && (ucp_request_param_flags(param) != 0)) {
-        return UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM);
-    }
-
-    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
-
-    ucs_trace_req("stream_send_nbx buffer %p count %zu to %s cb %p", buffer,
-                  count, ucp_ep_peer_name(ep),
-                  ucp_request_param_send_callback(param));
-
-    status = ucp_ep_resolve_remote_id(ep, ep->am_lane);
-    if (status != UCS_OK) {
-        ret = UCS_STATUS_PTR(status);
-        goto out;
-    }
-
     attr_mask = param->op_attr_mask &
                 (UCP_OP_ATTR_FIELD_DATATYPE | UCP_OP_ATTR_FLAG_NO_IMM_CMPL);
 
@@ -208,6 +187,252 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
                                   ucp_ep_config(ep)->stream.proto);
     }
 
+out:
+    return ret;
+}
+
+static size_t ucp_stream_coalesce_capacity(ucp_ep_h ep)
+{
+    return ucs_min(ep->worker->context->config.ext.stream_coalesce_size,
+                   ucp_ep_config(ep)->am.max_bcopy -
+                           sizeof(ucp_stream_am_hdr_t));
+}
+
+static void ucp_stream_coalesce_send_cb(void *request, ucs_status_t status,
+                                        void *user_data)
+{
+    ucs_free(user_data);
+}
+
+static void ucp_stream_coalesce_dequeue(ucp_worker_h worker,
+                                        ucp_stream_coalesce_t *coalesce)
+{
+    ucs_list_del(&coalesce->list);
+    if (ucs_list_is_empty(&worker->stream_coalesce_eps)) {
+        uct_worker_progress_unregister_safe(worker->uct,
+                                            &worker->stream_coalesce_cb_id);
+    }
+}
+
+static unsigned ucp_stream_coalesce_progress(void *arg)
+{
+    ucp_worker_h worker = arg;
+    ucs_time_t now      = ucs_get_time();
+    unsigned count      = 0;
+    ucp_stream_coalesce_t *coalesce;
+    ucs_status_t status;
+
+    while (!ucs_list_is_empty(&worker->stream_coalesce_eps)) {
+        coalesce = ucs_list_head(&worker->stream_coalesce_eps,
+                                 ucp_stream_coalesce_t, list);
+        if (coalesce->deadline > now) {
+            break;
+        }
+
+        status = ucp_stream_coalesce_flush(coalesce->ep);
+        if (status != UCS_OK) {
+            ucs_diag("ep %p: failed to send coalesced stream data: %s",
+                     coalesce->ep, ucs_status_string(status));
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+static ucs_status_t
+ucp_stream_coalesce_get(ucp_ep_h ep, ucp_stream_coalesce_t **coalesce_p)
+{
+    size_t size                     = ep->worker->context->config.ext.
+                                              stream_coalesce_size;
+    ucp_stream_coalesce_t *coalesce = ep->ext->stream.coalesce;
+
+    if (coalesce == NULL) {
+        coalesce = ucs_calloc(1, sizeof(*coalesce), "ucp_stream_coalesce");
+        if (coalesce == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        coalesce->ep             = ep;
+        ep->ext->stream.coalesce = coalesce;
+    }
+
+    if (coalesce->buffer == NULL) {
+        ucs_assert(coalesce->length == 0);
+        coalesce->buffer = ucs_malloc(size, "ucp_stream_coalesce_buffer");
+        if (coalesce->buffer == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+    }
+
+    *coalesce_p = coalesce;
+    return UCS_OK;
+}
+
+/*
+ * Copy a small send to the staging buffer of the endpoint. Returns
+ * UCS_ERR_NO_RESOURCE if the send should be started as a regular send.
+ */
+static ucs_status_t
+ucp_stream_coalesce_send(ucp_ep_h ep, const void *buffer, size_t count,
+                         const ucp_request_param_t *param)
+{
+    ucp_worker_h worker     = ep->worker;
+    ucp_context_h context   = worker->context;
+    ucp_datatype_t datatype = ucp_request_param_datatype(param);
+    ucs_time_t timeout      = context->config.ext.stream_coalesce_timeout;
+    ucp_stream_coalesce_t *coalesce;
+    ucs_status_t status;
+    size_t capacity;
+    size_t length;
+
+    if (!UCP_DT_IS_CONTIG(datatype) ||
+        (param->op_attr_mask & UCP_OP_ATTR_FLAG_NO_IMM_CMPL)) {
+        goto out_no_coalesce;
+    }
+
+    length   = ucp_contig_dt_length(datatype, count);
+    capacity = ucp_stream_coalesce_capacity(ep);
+    if ((length == 0) || (length > context->config.ext.stream_coalesce_thresh) ||
+        (length > capacity) ||
+        (ucp_request_get_memory_type(context, buffer, count, datatype, length,
+                                     param) != UCS_MEMORY_TYPE_HOST)) {
+        goto out_no_coalesce;
+    }
+
+    coalesce = ep->ext->stream.coalesce;
+    if ((coalesce != NULL) && ((coalesce->length + length) > capacity)) {
+        status = ucp_stream_coalesce_flush(ep);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    status = ucp_stream_coalesce_get(ep, &coalesce);
+    if (status != UCS_OK) {
+        /* Nothing is staged, so the send can go directly */
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    if (coalesce->length == 0) {
+        coalesce->deadline = (timeout == UCS_TIME_INFINITY) ?
+                             UCS_TIME_INFINITY : (ucs_get_time() + timeout);
+        ucs_list_add_tail(&worker->stream_coalesce_eps, &coalesce->list);
+        uct_worker_progress_register_safe(worker->uct,
+                                          ucp_stream_coalesce_progress, worker,
+                                          0, &worker->stream_coalesce_cb_id);
+    }
+
+    memcpy(UCS_PTR_BYTE_OFFSET(coalesce->buffer, coalesce->length), buffer,
+           length);
+    coalesce->length += length;
+    ++coalesce->num_sends;
+    UCS_STATS_UPDATE_COUNTER(ep->stats, UCP_EP_STAT_STREAM_TX_COALESCED, 1);
+
+    if (coalesce->length >= capacity) {
+        return ucp_stream_coalesce_flush(ep);
+    }
+
+    return UCS_OK;
+
+out_no_coalesce:
+    /* Keep the order of the staged data and this send */
+    status = ucp_stream_coalesce_flush(ep);
+    return (status == UCS_OK) ? UCS_ERR_NO_RESOURCE : status;
+}
+
+ucs_status_t ucp_stream_coalesce_flush(ucp_ep_h ep)
+{
+    ucp_stream_coalesce_t *coalesce = ep->ext->stream.coalesce;
+    ucp_request_param_t param;
+    ucs_status_ptr_t ret;
+
+    if ((coalesce == NULL) || (coalesce->length == 0)) {
+        return UCS_OK;
+    }
+
+    ucs_trace_req("ep %p: send %zu bytes of coalesced stream data", ep,
+                  coalesce->length);
+
+    ucp_stream_coalesce_dequeue(ep->worker, coalesce);
+
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK |
+                         UCP_OP_ATTR_FIELD_USER_DATA;
+    param.cb.send      = ucp_stream_coalesce_send_cb;
+    param.user_data    = coalesce->buffer;
+
+    ret = ucp_stream_send_nbx_internal(ep, coalesce->buffer, coalesce->length,
+                                       &param);
+    coalesce->length = 0;
+    ++coalesce->num_msgs;
+    UCS_STATS_UPDATE_COUNTER(ep->stats, UCP_EP_STAT_STREAM_TX_COALESCED_MSG,
+                             1);
+
+    if (UCS_PTR_IS_PTR(ret)) {
+        /* The request owns the buffer until it is completed */
+        coalesce->buffer = NULL;
+        ucp_request_release(ret);
+        return UCS_OK;
+    }
+
+    return UCS_PTR_STATUS(ret);
+}
+
+void ucp_stream_coalesce_destroy(ucp_ep_h ep)
+{
+    ucp_stream_coalesce_t *coalesce = ep->ext->stream.coalesce;
+
+    ucs_debug("ep %p: coalesced %" PRIu64 " stream sends to %" PRIu64
+              " messages", ep, coalesce->num_sends, coalesce->num_msgs);
+
+    if (coalesce->length > 0) {
+        ucs_debug("ep %p: dropping %zu bytes of coalesced stream data", ep,
+                  coalesce->length);
+        ucp_stream_coalesce_dequeue(ep->worker, coalesce);
+    }
+
+    ucs_free(coalesce->buffer);
+    ucs_free(coalesce);
+    ep->ext->stream.coalesce = NULL;
+}
+
+UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
+                 (ep, buffer, count, param),
+                 ucp_ep_h ep, const void *buffer, size_t count,
+                 const ucp_request_param_t *param)
+{
+    ucp_worker_h worker = ep->worker;
+    ucs_status_t status;
+    ucs_status_ptr_t ret;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_STREAM,
+                                    return UCS_STATUS_PTR(
+                                            UCS_ERR_INVALID_PARAM));
+    UCP_REQUEST_CHECK_PARAM(param);
+    if (ENABLE_PARAMS_CHECK && (ucp_request_param_flags(param) != 0)) {
+        return UCS_STATUS_PTR(UCS_ERR_INVALID_PARAM);
+    }
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    ucs_trace_req("stream_send_nbx buffer %p count %zu to %s cb %p", buffer,
+                  count, ucp_ep_peer_name(ep),
+                  ucp_request_param_send_callback(param));
+
+    status = ucp_ep_resolve_remote_id(ep, ep->am_lane);
+    if (status != UCS_OK) {
+        ret = UCS_STATUS_PTR(status);
+        goto out;
+    }
+
+    if (ep->flags & UCP_EP_FLAG_STREAM_COALESCE) {
+        status = ucp_stream_coalesce_send(ep, buffer, count, param);
+        UCP_STREAM_SEND_CHECK_STATUS(ep, status, ret, goto out);
+    }
+
+    ret = ucp_stream_send_nbx_internal(ep, buffer, count, param);
+
 out:
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
     return ret;
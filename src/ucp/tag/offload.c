@@ -80,11 +80,13 @@ ucp_tag_offload_release_buf(ucp_request_t *req)
 UCS_PROFILE_FUNC_VOID(ucp_tag_offload_tag_consumed, (self),
                       uct_tag_context_t *self)
 {
-    ucp_request_t *req = ucs_container_of(self, ucp_request_t, recv.uct_ctx);
-    ucs_queue_head_t *queue;
+    ucp_request_t *req             = ucs_container_of(self, ucp_request_t,
+                                                      recv.uct_ctx);
+    ucp_tag_match_t *tm            = &req->recv.worker->tm;
+    ucp_request_queue_t *req_queue = ucp_tag_exp_get_req_queue(tm, req);
 
-    queue = &ucp_tag_exp_get_req_queue(&req->recv.worker->tm, req)->queue;
-    ucs_queue_remove(queue, &req->recv.queue);
+    ucp_tag_exp_delete(req, tm, req_queue,
+                       ucp_tag_exp_queue_find(req_queue, req));
 }
 
 /* Message is scattered to user buffer by the transport, complete the request */
@@ -386,6 +388,7 @@ ucp_tag_offload_post_sw_reqs(ucp_request_t *req, ucp_request_queue_t *req_queue)
     ucp_request_t *req_exp;
     ucp_worker_iface_t *wiface;
     size_t max_post;
+    unsigned index;
 
     /* If large enough buffer is being posted to the transport,
      * try to post all unposted requests from the same TM queue before.
@@ -413,7 +416,8 @@ ucp_tag_offload_post_sw_reqs(ucp_request_t *req, ucp_request_queue_t *req_queue)
         return 0;
     }
 
-    ucs_queue_for_each(req_exp, &req_queue->queue, recv.queue) {
+    for (index = req_queue->start; index < req_queue->end; ++index) {
+        req_exp = req_queue->reqs[index];
         if (req_exp->flags & UCP_REQUEST_FLAG_OFFLOADED) {
             continue;
         }
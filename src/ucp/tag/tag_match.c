@@ -12,6 +12,82 @@
 #include <ucp/tag/offload.h>
 
 
+/* Initial length of an expected queue */
+#define UCP_TAG_EXP_QUEUE_MIN_SIZE  8
+
+
+static void ucp_tag_exp_queue_init(ucp_request_queue_t *req_queue)
+{
+    req_queue->tags        = NULL;
+    req_queue->tag_masks   = NULL;
+    req_queue->reqs        = NULL;
+    req_queue->start       = 0;
+    req_queue->end         = 0;
+    req_queue->size        = 0;
+    req_queue->sw_count    = 0;
+    req_queue->block_count = 0;
+}
+
+static void ucp_tag_exp_queue_cleanup(ucp_request_queue_t *req_queue)
+{
+    ucs_free(req_queue->tags);
+    ucs_free(req_queue->tag_masks);
+    ucs_free(req_queue->reqs);
+}
+
+ucs_status_t ucp_tag_exp_queue_grow(ucp_request_queue_t *req_queue)
+{
+    unsigned count = req_queue->end - req_queue->start;
+    unsigned size;
+    void *ptr;
+
+    if (req_queue->start > (req_queue->size / 2)) {
+        /* Reuse the space of the requests which were removed from the head */
+        memmove(req_queue->tags, &req_queue->tags[req_queue->start],
+                count * sizeof(*req_queue->tags));
+        memmove(req_queue->tag_masks, &req_queue->tag_masks[req_queue->start],
+                count * sizeof(*req_queue->tag_masks));
+        memmove(req_queue->reqs, &req_queue->reqs[req_queue->start],
+                count * sizeof(*req_queue->reqs));
+        req_queue->start = 0;
+        req_queue->end   = count;
+        return UCS_OK;
+    }
+
+    size = ucs_max(req_queue->size * 2, UCP_TAG_EXP_QUEUE_MIN_SIZE);
+
+    /* The queue remains valid with its current size if any of the
+     * allocations fails */
+    ptr = ucs_realloc(req_queue->tags, sizeof(*req_queue->tags) * size,
+                      "ucp_tm_exp_tags");
+    if (ptr == NULL) {
+        goto err;
+    }
+    req_queue->tags = ptr;
+
+    ptr = ucs_realloc(req_queue->tag_masks,
+                      sizeof(*req_queue->tag_masks) * size,
+                      "ucp_tm_exp_tag_masks");
+    if (ptr == NULL) {
+        goto err;
+    }
+    req_queue->tag_masks = ptr;
+
+    ptr = ucs_realloc(req_queue->reqs, sizeof(*req_queue->reqs) * size,
+                      "ucp_tm_exp_reqs");
+    if (ptr == NULL) {
+        goto err;
+    }
+    req_queue->reqs = ptr;
+
+    req_queue->size = size;
+    return UCS_OK;
+
+err:
+    ucs_error("failed to grow expected queue to %u requests", size);
+    return UCS_ERR_NO_MEMORY;
+}
+
 ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
 {
     size_t hash_size, bucket;
@@ -20,7 +96,7 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
 
     tm->expected.sn           = 0;
     tm->expected.sw_all_count = 0;
-    ucs_queue_head_init(&tm->expected.wildcard.queue);
+    ucp_tag_exp_queue_init(&tm->expected.wildcard);
     ucs_list_head_init(&tm->unexpected.all);
 
     tm->expected.hash = ucs_malloc(sizeof(*tm->expected.hash) * hash_size,
@@ -37,9 +113,7 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
     }
 
     for (bucket = 0; bucket < hash_size; ++bucket) {
-        tm->expected.hash[bucket].sw_count    = 0;
-        tm->expected.hash[bucket].block_count = 0;
-        ucs_queue_head_init(&tm->expected.hash[bucket].queue);
+        ucp_tag_exp_queue_init(&tm->expected.hash[bucket]);
         ucs_list_head_init(&tm->unexpected.hash[bucket]);
     }
 
@@ -56,6 +130,7 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
 void ucp_tag_match_cleanup(ucp_tag_match_t *tm)
 {
     ucp_recv_desc_t *rdesc, *tmp_rdesc;
+    size_t hash_size, bucket;
 
     ucs_list_for_each_safe(rdesc, tmp_rdesc, &tm->unexpected.all,
                            tag_list[UCP_RDESC_ALL_LIST]) {
@@ -64,6 +139,12 @@ void ucp_tag_match_cleanup(ucp_tag_match_t *tm)
         ucp_recv_desc_release(rdesc);
     }
 
+    hash_size = ucs_roundup_pow2(UCP_TAG_MATCH_HASH_SIZE);
+    for (bucket = 0; bucket < hash_size; ++bucket) {
+        ucp_tag_exp_queue_cleanup(&tm->expected.hash[bucket]);
+    }
+    ucp_tag_exp_queue_cleanup(&tm->expected.wildcard);
+
     kh_destroy_inplace(ucp_tag_offload_hash, &tm->offload.tag_hash);
     kh_destroy_inplace(ucp_tag_frag_hash, &tm->frag_hash);
     ucs_free(tm->unexpected.hash);
@@ -78,15 +159,12 @@ int ucp_tag_unexp_is_empty(ucp_tag_match_t *tm)
 int ucp_tag_exp_remove(ucp_tag_match_t *tm, ucp_request_t *req)
 {
     ucp_request_queue_t *req_queue = ucp_tag_exp_get_req_queue(tm, req);
-    ucs_queue_iter_t iter;
-    ucp_request_t *qreq;
-
-    ucs_queue_for_each_safe(qreq, iter, &req_queue->queue, recv.queue) {
-        if (qreq == req) {
-            ucp_tag_offload_try_cancel(req->recv.worker, req, 0);
-            ucp_tag_exp_delete(req, tm, req_queue, iter);
-            return 1;
-        }
+    unsigned index                 = ucp_tag_exp_queue_find(req_queue, req);
+
+    if (index != req_queue->end) {
+        ucp_tag_offload_try_cancel(req->recv.worker, req, 0);
+        ucp_tag_exp_delete(req, tm, req_queue, index);
+        return 1;
     }
 
     ucs_assert(!(req->flags & UCP_REQUEST_FLAG_COMPLETED));
@@ -95,58 +173,39 @@ int ucp_tag_exp_remove(ucp_tag_match_t *tm, ucp_request_t *req)
     return 0;
 }
 
-static inline uint64_t ucp_tag_exp_req_seq(ucs_queue_iter_t iter)
-{
-    return (*iter == NULL) ? ULONG_MAX :
-           ucs_container_of(*iter, ucp_request_t, recv.queue)->recv.tag.sn;
-}
-
 ucp_request_t*
 ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                        ucp_tag_t tag)
 {
-    ucs_queue_head_t *hash_queue = &req_queue->queue;
-    ucp_request_queue_t *queue;
-    ucs_queue_iter_t hash_iter, wild_iter, *iter;
-    uint64_t hash_sn, wild_sn, *sn_p;
-    ucp_request_t *req;
-
-    *hash_queue->ptail                 = NULL;
-    *tm->expected.wildcard.queue.ptail = NULL;
-
-    hash_iter = ucs_queue_iter_begin(hash_queue);
-    wild_iter = ucs_queue_iter_begin(&tm->expected.wildcard.queue);
-
-    hash_sn = ucp_tag_exp_req_seq(hash_iter);
-    wild_sn = ucp_tag_exp_req_seq(wild_iter);
-
-    while (hash_sn != wild_sn) {
-        if (hash_sn < wild_sn) {
-            iter  = &hash_iter;
-            sn_p  = &hash_sn;
-            queue = req_queue;
-        } else {
-            iter  = &wild_iter;
-            sn_p  = &wild_sn;
-            queue = &tm->expected.wildcard;
+    ucp_request_queue_t *wild_queue = &tm->expected.wildcard;
+    unsigned hash_index, wild_index;
+    ucp_request_t *hash_req, *wild_req;
+
+    /* Both queues are ordered by posting sequence, so the first matching
+     * request which was posted earlier is the one to match */
+    hash_index = ucp_tag_exp_queue_match(req_queue, tag);
+    wild_index = ucp_tag_exp_queue_match(wild_queue, tag);
+
+    if (wild_index == wild_queue->end) {
+        if (hash_index == req_queue->end) {
+            return NULL;
         }
-
-        req = ucs_container_of(**iter, ucp_request_t, recv.queue);
-        if (ucp_tag_is_match(tag, req->recv.tag.tag, req->recv.tag.tag_mask)) {
-            ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
-            ucp_tag_exp_delete(req, tm, queue, *iter);
-            return req;
+    } else {
+        wild_req = wild_queue->reqs[wild_index];
+        if ((hash_index == req_queue->end) ||
+            (wild_req->recv.tag.sn <
+             req_queue->reqs[hash_index]->recv.tag.sn)) {
+            ucs_trace_req("matched received tag %"PRIx64" to req %p", tag,
+                          wild_req);
+            ucp_tag_exp_delete(wild_req, tm, wild_queue, wild_index);
+            return wild_req;
         }
-
-        *iter = ucs_queue_iter_next(*iter);
-        *sn_p = ucp_tag_exp_req_seq(*iter);
     }
 
-    ucs_assertv((hash_sn == ULONG_MAX) && (wild_sn == ULONG_MAX),
-                "hash_seq=%"PRIu64" wild_seq=%"PRIu64, hash_sn, wild_sn);
-    ucs_assert(ucs_queue_iter_end(hash_queue, hash_iter));
-    ucs_assert(ucs_queue_iter_end(&tm->expected.wildcard.queue, wild_iter));
-    return NULL;
+    hash_req = req_queue->reqs[hash_index];
+    ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, hash_req);
+    ucp_tag_exp_delete(hash_req, tm, req_queue, hash_index);
+    return hash_req;
 }
 
 /* Used in SW tag flow only, because fragments hash is not relevant for tag
@@ -31,10 +31,17 @@ typedef struct {
 
 
 /**
- * Queue of expected requests
+ * Queue of expected requests. The tags and masks are kept in packed arrays, in
+ * posting order, so the queue can be searched without dereferencing the
+ * requests, and with vector instructions when available.
  */
 typedef struct {
-    ucs_queue_head_t      queue;       /* Requests queue */
+    ucp_tag_t             *tags;       /* Expected tags */
+    ucp_tag_t             *tag_masks;  /* Expected tag masks */
+    ucp_request_t         **reqs;      /* Requests */
+    unsigned              start;       /* Index of the first request */
+    unsigned              end;         /* Index after the last request */
+    unsigned              size;        /* Allocated length of the arrays */
     unsigned              sw_count;    /* Number of requests in this queue which
                                           are not posted to offload */
     unsigned              block_count; /* Number of requests which can't be
@@ -109,6 +116,8 @@ int ucp_tag_exp_remove(ucp_tag_match_t *tm, ucp_request_t *req);
 
 int ucp_tag_unexp_is_empty(ucp_tag_match_t *tm);
 
+ucs_status_t ucp_tag_exp_queue_grow(ucp_request_queue_t *req_queue);
+
 ucp_request_t*
 ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                        ucp_tag_t tag);
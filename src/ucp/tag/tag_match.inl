@@ -15,6 +15,8 @@
 #include <ucp/core/ucp_request.h>
 #include <ucp/core/ucp_request.inl>
 #include <ucp/dt/dt.h>
+#include <ucs/arch/bitops.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/log.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/datastruct/mpool.inl>
@@ -72,18 +74,44 @@ ucp_tag_exp_get_req_queue(ucp_tag_match_t *tm, ucp_request_t *req)
     return ucp_tag_exp_get_queue(tm, req->recv.tag.tag, req->recv.tag.tag_mask);
 }
 
+static UCS_F_ALWAYS_INLINE int
+ucp_tag_exp_queue_is_empty(const ucp_request_queue_t *req_queue)
+{
+    return req_queue->start == req_queue->end;
+}
+
+/* Make sure the queue has room for one more request */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_tag_exp_queue_reserve(ucp_request_queue_t *req_queue)
+{
+    if (ucs_likely(req_queue->end < req_queue->size)) {
+        return UCS_OK;
+    }
+
+    return ucp_tag_exp_queue_grow(req_queue);
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_tag_exp_push(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                  ucp_request_t *req)
 {
-    req->recv.tag.sn = tm->expected.sn++;
-    ucs_queue_push(&req_queue->queue, &req->recv.queue);
+    unsigned index = req_queue->end++;
+
+    ucs_assert(index < req_queue->size);
+    req->recv.tag.sn            = tm->expected.sn++;
+    req_queue->tags[index]      = req->recv.tag.tag;
+    req_queue->tag_masks[index] = req->recv.tag.tag_mask;
+    req_queue->reqs[index]      = req;
 }
 
 static UCS_F_ALWAYS_INLINE void
 ucp_tag_exp_delete(ucp_request_t *req, ucp_tag_match_t *tm,
-                   ucp_request_queue_t *req_queue, ucs_queue_iter_t iter)
+                   ucp_request_queue_t *req_queue, unsigned index)
 {
+    unsigned count;
+
+    ucs_assert(req_queue->reqs[index] == req);
+
     if (!(req->flags & UCP_REQUEST_FLAG_OFFLOADED)) {
         --tm->expected.sw_all_count;
         --req_queue->sw_count;
@@ -91,34 +119,134 @@ ucp_tag_exp_delete(ucp_request_t *req, ucp_tag_match_t *tm,
             --req_queue->block_count;
         }
     }
-    ucs_queue_del_iter(&req_queue->queue, iter);
+
+    if (index == req_queue->start) {
+        /* Requests are usually matched in posting order */
+        ++req_queue->start;
+    } else {
+        count = req_queue->end - index - 1;
+        memmove(&req_queue->tags[index], &req_queue->tags[index + 1],
+                count * sizeof(*req_queue->tags));
+        memmove(&req_queue->tag_masks[index], &req_queue->tag_masks[index + 1],
+                count * sizeof(*req_queue->tag_masks));
+        memmove(&req_queue->reqs[index], &req_queue->reqs[index + 1],
+                count * sizeof(*req_queue->reqs));
+        --req_queue->end;
+    }
+
+    if (req_queue->start == req_queue->end) {
+        req_queue->start = 0;
+        req_queue->end   = 0;
+    }
+}
+
+/* Return the index of a request in the queue, or the queue end if not found */
+static UCS_F_ALWAYS_INLINE unsigned
+ucp_tag_exp_queue_find(const ucp_request_queue_t *req_queue,
+                       const ucp_request_t *req)
+{
+    unsigned index;
+
+    for (index = req_queue->start; index < req_queue->end; ++index) {
+        if (req_queue->reqs[index] == req) {
+            break;
+        }
+    }
+
+    return index;
+}
+
+/* Return the index of the first request which matches the tag, or the queue
+ * end if not found */
+static UCS_F_ALWAYS_INLINE unsigned
+ucp_tag_exp_queue_match(const ucp_request_queue_t *req_queue, ucp_tag_t tag)
+{
+    unsigned index = req_queue->start;
+#if defined(__AVX2__)
+    const __m256i vtag  = _mm256_set1_epi64x(tag);
+    const __m256i vzero = _mm256_setzero_si256();
+    __m256i vdiff;
+    int match_mask;
+
+    for (; (index + 4) <= req_queue->end; index += 4) {
+        vdiff      = _mm256_xor_si256(
+                _mm256_loadu_si256((const __m256i*)&req_queue->tags[index]),
+                vtag);
+        vdiff      = _mm256_and_si256(
+                vdiff, _mm256_loadu_si256(
+                        (const __m256i*)&req_queue->tag_masks[index]));
+        match_mask = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpeq_epi64(vdiff, vzero)));
+        if (match_mask != 0) {
+            return index + ucs_ffs32(match_mask);
+        }
+    }
+#elif defined(__SSE4_1__)
+    const __m128i vtag  = _mm_set1_epi64x(tag);
+    const __m128i vzero = _mm_setzero_si128();
+    __m128i vdiff;
+    int match_mask;
+
+    for (; (index + 2) <= req_queue->end; index += 2) {
+        vdiff      = _mm_xor_si128(
+                _mm_loadu_si128((const __m128i*)&req_queue->tags[index]),
+                vtag);
+        vdiff      = _mm_and_si128(
+                vdiff, _mm_loadu_si128(
+                        (const __m128i*)&req_queue->tag_masks[index]));
+        match_mask = _mm_movemask_pd(
+                _mm_castsi128_pd(_mm_cmpeq_epi64(vdiff, vzero)));
+        if (match_mask != 0) {
+            return index + ucs_ffs32(match_mask);
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint64x2_t vtag = vdupq_n_u64(tag);
+    uint64x2_t vmatch;
+
+    for (; (index + 2) <= req_queue->end; index += 2) {
+        vmatch = vceqzq_u64(vandq_u64(veorq_u64(vld1q_u64(&req_queue->tags[index]),
+                                                vtag),
+                                      vld1q_u64(&req_queue->tag_masks[index])));
+        if (vgetq_lane_u64(vmatch, 0)) {
+            return index;
+        } else if (vgetq_lane_u64(vmatch, 1)) {
+            return index + 1;
+        }
+    }
+#endif
+
+    for (; index < req_queue->end; ++index) {
+        if (ucp_tag_is_match(tag, req_queue->tags[index],
+                             req_queue->tag_masks[index])) {
+            break;
+        }
+    }
+
+    return index;
 }
 
 static UCS_F_ALWAYS_INLINE ucp_request_t *
 ucp_tag_exp_search(ucp_tag_match_t *tm, ucp_tag_t tag)
 {
-    ucp_request_queue_t *req_queue;
-    ucs_queue_iter_t iter;
+    ucp_request_queue_t *req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
     ucp_request_t *req;
+    unsigned index;
 
-    if (ucs_unlikely(!ucs_queue_is_empty(&tm->expected.wildcard.queue))) {
-        req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
+    if (ucs_unlikely(!ucp_tag_exp_queue_is_empty(&tm->expected.wildcard))) {
         return ucp_tag_exp_search_all(tm, req_queue, tag);
     }
 
     /* fast path - wildcard queue is empty, search only the specific queue */
-    req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
-    ucs_queue_for_each_safe(req, iter, &req_queue->queue, recv.queue) {
-        req = ucs_container_of(*iter, ucp_request_t, recv.queue);
-        ucs_trace_data("checking req %p tag %"PRIx64"/%"PRIx64" with tag %"PRIx64,
-                       req, req->recv.tag.tag, req->recv.tag.tag_mask, tag);
-        if (ucp_tag_is_match(tag, req->recv.tag.tag, req->recv.tag.tag_mask)) {
-            ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
-            ucp_tag_exp_delete(req, tm, req_queue, iter);
-            return req;
-        }
+    index = ucp_tag_exp_queue_match(req_queue, tag);
+    if (index == req_queue->end) {
+        return NULL;
     }
-    return NULL;
+
+    req = req_queue->reqs[index];
+    ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
+    ucp_tag_exp_delete(req, tm, req_queue, index);
+    return req;
 }
 
 static UCS_F_ALWAYS_INLINE ucp_tag_t ucp_rdesc_get_tag(ucp_recv_desc_t *rdesc)
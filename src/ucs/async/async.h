@@ -163,6 +163,28 @@ static inline int ucs_async_check_owner_thread(ucs_async_context_t *async)
     } while(0)
 
 
+/**
+ * Try to block the async handler without waiting.
+ *
+ * @param async Event context to block events for.
+ *
+ * @return Nonzero if the context was blocked, and must be unblocked by
+ *         @ref UCS_ASYNC_UNBLOCK. Zero if another thread holds the context.
+ */
+static inline int ucs_async_try_block(ucs_async_context_t *async)
+{
+    if (async->mode == UCS_ASYNC_MODE_THREAD_SPINLOCK) {
+        return ucs_recursive_spin_trylock(&async->thread.spinlock);
+    } else if (async->mode == UCS_ASYNC_MODE_THREAD_MUTEX) {
+        return ucs_recursive_mutex_try_block(&async->thread.mutex);
+    }
+
+    /* Signal and poll modes are blocked only by the calling thread */
+    UCS_ASYNC_BLOCK(async);
+    return 1;
+}
+
+
 /**
  * Unblock asynchronous event delivery, and invoke pending callbacks.
  *
@@ -366,19 +366,7 @@ ucs_async_thread_modify_event_fd(ucs_async_context_t *async, int event_fd,
 
 static int ucs_async_thread_mutex_try_block(ucs_async_context_t *async)
 {
-    if (pthread_mutex_trylock(&async->thread.mutex.lock)) {
-        /* not locked */
-        return 0;
-    }
-
-#if UCS_ENABLE_ASSERT
-    /* locked */
-    if (async->thread.mutex.count++ == 0) {
-        async->thread.mutex.owner = pthread_self();
-    }
-#endif
-
-    return 1;
+    return ucs_recursive_mutex_try_block(&async->thread.mutex);
 }
 
 static void ucs_async_thread_mutex_unblock(ucs_async_context_t *async)
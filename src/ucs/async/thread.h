@@ -51,6 +51,24 @@ ucs_recursive_mutex_block(ucs_async_thread_mutex_t *mutex)
 #endif
 }
 
+static UCS_F_ALWAYS_INLINE int
+ucs_recursive_mutex_try_block(ucs_async_thread_mutex_t *mutex)
+{
+    if (pthread_mutex_trylock(&mutex->lock)) {
+        /* not locked */
+        return 0;
+    }
+
+#if UCS_ENABLE_ASSERT
+    /* locked */
+    if (mutex->count++ == 0) {
+        mutex->owner = pthread_self();
+    }
+#endif
+
+    return 1;
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucs_recursive_mutex_unblock(ucs_async_thread_mutex_t *mutex)
 {
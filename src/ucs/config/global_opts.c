@@ -311,7 +311,9 @@ static ucs_config_field_t ucs_global_opts_read_only_table[] = {
  {"PROFILE_MODE", "",
   "Profile collection modes. If none is specified, profiling is disabled.\n"
   " - log   - Record all timestamps.\n"
-  " - accum - Accumulate measurements per location.",
+  " - accum - Accumulate measurements per location.\n"
+  " - ring  - Keep the last records of every thread. The records can be saved\n"
+  "           at any time by writing to the ucs/profile/snapshot VFS file.",
   ucs_offsetof(ucs_global_opts_t, profile_mode),
   UCS_CONFIG_TYPE_BITMAP(ucs_profile_mode_names)},
 
@@ -321,7 +323,8 @@ static ucs_config_field_t ucs_global_opts_read_only_table[] = {
   ucs_offsetof(ucs_global_opts_t, profile_file), UCS_CONFIG_TYPE_STRING},
 
  {"PROFILE_LOG_SIZE", "4m",
-  "Maximal size of profiling log. New records will replace old records.",
+  "Maximal size of profiling log per thread. New records will replace old\n"
+  "records. In ring mode, the size is rounded down to a power of 2 records.",
   ucs_offsetof(ucs_global_opts_t, profile_log_size), UCS_CONFIG_TYPE_MEMUNITS},
 
  {"RCACHE_STAT_MIN", "4k",
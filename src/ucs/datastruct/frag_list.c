@@ -373,6 +373,33 @@ ucs_frag_list_elem_t *ucs_frag_list_pull_slow(ucs_frag_list_t *head)
     return h;
 }
 
+void ucs_frag_list_purge(ucs_frag_list_t *head, ucs_frag_list_purge_cb_t cb,
+                         void *arg)
+{
+    ucs_frag_list_elem_t *h, *e;
+
+    while (!ucs_queue_is_empty(&head->ready_list)) {
+        e = ucs_queue_pull_elem_non_empty(&head->ready_list,
+                                          ucs_frag_list_elem_t, list);
+        cb(e, arg);
+    }
+
+    while (!ucs_queue_is_empty(&head->list)) {
+        h = ucs_queue_pull_elem_non_empty(&head->list, ucs_frag_list_elem_t,
+                                          list);
+        /* elements chained to the hole head are stored inside it */
+        while (!ucs_queue_is_empty(&h->head.list)) {
+            e = ucs_queue_pull_elem_non_empty(&h->head.list,
+                                              ucs_frag_list_elem_t, list);
+            cb(e, arg);
+        }
+        cb(h, arg);
+    }
+
+    head->elem_count = 0;
+    head->list_count = 0;
+}
+
 void ucs_frag_list_dump(ucs_frag_list_t *head, int how)
 {
     ucs_frag_list_elem_t *h, *e;
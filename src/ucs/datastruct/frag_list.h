@@ -130,6 +130,24 @@ ucs_status_t ucs_frag_list_init(ucs_frag_list_sn_t initial_sn, ucs_frag_list_t *
 void ucs_frag_list_cleanup(ucs_frag_list_t *head);
 
 
+/**
+ * Callback to release an element removed by @ref ucs_frag_list_purge.
+ *
+ * @param elem   Element which was removed from the frag_list.
+ * @param arg    User-defined argument passed to @ref ucs_frag_list_purge.
+ */
+typedef void (*ucs_frag_list_purge_cb_t)(ucs_frag_list_elem_t *elem, void *arg);
+
+
+/**
+ * Remove all elements from the frag_list, including ones which are still
+ * waiting for a missing sequence number, and pass each of them to @a cb.
+ * The frag_list can be cleaned up after this call.
+ */
+void ucs_frag_list_purge(ucs_frag_list_t *head, ucs_frag_list_purge_cb_t cb,
+                         void *arg);
+
+
 /* Slow path insert */
 ucs_frag_list_ooo_type_t ucs_frag_list_insert_slow(ucs_frag_list_t *head,
                                                    ucs_frag_list_elem_t *elem,
@@ -13,16 +13,179 @@
 
 #include <ucs/arch/atomic.h>
 #include <ucs/arch/bitops.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/assert.h>
+#include <ucs/debug/log.h>
 #include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/ptr_arith.h>
 
 
-#define UCS_MPMC_INVALID_VALUE -1
+#define UCS_MPMC_INVALID_VALUE UINT64_MAX
+
+
+ucs_status_t ucs_mpmc_ring_init(ucs_mpmc_ring_t *ring, unsigned length)
+{
+    uint64_t i;
+
+    length      = ucs_roundup_pow2(ucs_max(length, 2));
+    ring->cells = ucs_malloc(sizeof(*ring->cells) * length, "mpmc_ring");
+    if (ring->cells == NULL) {
+        ucs_error("failed to allocate MPMC ring of %u cells", length);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < length; ++i) {
+        ring->cells[i].seq   = i;
+        ring->cells[i].value = UCS_MPMC_INVALID_VALUE;
+    }
+
+    ring->mask = length - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    return UCS_OK;
+}
+
+void ucs_mpmc_ring_cleanup(ucs_mpmc_ring_t *ring)
+{
+    ucs_free(ring->cells);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_mpmc_ring_cell_t *
+ucs_mpmc_ring_cell(ucs_mpmc_ring_t *ring, uint64_t pos)
+{
+    return &ring->cells[pos & ring->mask];
+}
+
+/*
+ * Claim up to 'count' consecutive positions starting at '*pos_p', whose cells
+ * have a sequence number of 'position + seq_offset'. Return the number of
+ * claimed positions, or 0 if the first cell is not ready yet.
+ */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_mpmc_ring_claim(ucs_mpmc_ring_t *ring, volatile uint64_t *ring_pos,
+                    uint64_t seq_offset, unsigned count, uint64_t *pos_p)
+{
+    uint64_t pos, prev_pos;
+    unsigned avail;
+    int64_t diff;
+
+    pos = *ring_pos;
+    for (;;) {
+        for (avail = 0; avail < count; ++avail) {
+            if (ucs_mpmc_ring_cell(ring, pos + avail)->seq !=
+                (pos + avail + seq_offset)) {
+                break;
+            }
+        }
+
+        if (avail == 0) {
+            diff = ucs_mpmc_ring_cell(ring, pos)->seq - (pos + seq_offset);
+            if (diff < 0) {
+                /* The cell was not released by the previous lap yet */
+                return 0;
+            }
+
+            /* Another thread has already claimed this position */
+            pos = *ring_pos;
+            continue;
+        }
+
+        prev_pos = ucs_atomic_cswap64(ring_pos, pos, pos + avail);
+        if (prev_pos == pos) {
+            *pos_p = pos;
+            return avail;
+        }
+
+        pos = prev_pos;
+    }
+}
+
+unsigned ucs_mpmc_ring_push_batch(ucs_mpmc_ring_t *ring, const uint64_t *values,
+                                  unsigned count)
+{
+    ucs_mpmc_ring_cell_t *cell;
+    unsigned i, avail;
+    uint64_t pos;
+
+    avail = ucs_mpmc_ring_claim(ring, &ring->head, 0, count, &pos);
+    for (i = 0; i < avail; ++i) {
+        ucs_assert(values[i] != UCS_MPMC_INVALID_VALUE);
+        cell        = ucs_mpmc_ring_cell(ring, pos + i);
+        cell->value = values[i];
+        ucs_memory_cpu_store_fence();
+        cell->seq   = pos + i + 1;
+    }
+
+    return avail;
+}
+
+unsigned ucs_mpmc_ring_pull_batch(ucs_mpmc_ring_t *ring, uint64_t *values,
+                                  unsigned count)
+{
+    ucs_mpmc_ring_cell_t *cell;
+    unsigned i, avail, num_values;
+    uint64_t pos, value;
+
+    do {
+        avail = ucs_mpmc_ring_claim(ring, &ring->tail, 1, count, &pos);
+        ucs_memory_cpu_load_fence();
+
+        num_values = 0;
+        for (i = 0; i < avail; ++i) {
+            cell  = ucs_mpmc_ring_cell(ring, pos + i);
+            value = cell->value;
+            ucs_memory_cpu_fence();
+            cell->seq = pos + i + ring->mask + 1;
+
+            /* Skip the values removed by ucs_mpmc_ring_remove_if() */
+            if (value != UCS_MPMC_INVALID_VALUE) {
+                values[num_values++] = value;
+            }
+        }
+    } while ((num_values == 0) && (avail > 0));
+
+    return num_values;
+}
+
+void ucs_mpmc_ring_remove_if(ucs_mpmc_ring_t *ring,
+                             ucs_mpmc_queue_predicate_t predicate, void *arg)
+{
+    uint64_t pos, head, value;
+    ucs_mpmc_ring_cell_t *cell;
+
+    head = ring->head;
+    for (pos = ring->tail; pos != head; ++pos) {
+        cell = ucs_mpmc_ring_cell(ring, pos);
+        if (cell->seq != (pos + 1)) {
+            /* Not pushed yet, or already pulled */
+            continue;
+        }
+
+        ucs_memory_cpu_load_fence();
+        value = cell->value;
+        if ((value != UCS_MPMC_INVALID_VALUE) && predicate(value, arg)) {
+            /* If the cell was reused meanwhile, leave the new value intact */
+            ucs_atomic_cswap64(&cell->value, value, UCS_MPMC_INVALID_VALUE);
+        }
+    }
+}
 
 ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc)
 {
+    ucs_status_t status;
+
+    status = ucs_mpmc_ring_init(&mpmc->ring, UCS_MPMC_QUEUE_RING_SIZE);
+    if (status != UCS_OK) {
+        return status;
+    }
+
     ucs_queue_head_init(&mpmc->queue);
-    return ucs_spinlock_init(&mpmc->lock, 0);
+    status = ucs_spinlock_init(&mpmc->lock, 0);
+    if (status != UCS_OK) {
+        ucs_mpmc_ring_cleanup(&mpmc->ring);
+    }
+
+    return status;
 }
 
 void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc)
@@ -34,12 +197,18 @@ void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc)
                                              ucs_mpmc_elem_t, super);
         ucs_free(elem);
     }
+
+    ucs_mpmc_ring_cleanup(&mpmc->ring);
 }
 
 ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
 {
     ucs_mpmc_elem_t *elem;
 
+    if (ucs_likely(ucs_mpmc_ring_push_batch(&mpmc->ring, &value, 1))) {
+        return UCS_OK;
+    }
+
     elem = ucs_malloc(sizeof(ucs_mpmc_elem_t), "mpmc elem");
     if (elem == NULL) {
         return UCS_ERR_NO_MEMORY;
@@ -54,31 +223,49 @@ ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
     return UCS_OK;
 }
 
-ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
+static unsigned ucs_mpmc_queue_pull_overflow(ucs_mpmc_queue_t *mpmc,
+                                             uint64_t *values, unsigned count)
 {
-    ucs_status_t status = UCS_ERR_NO_PROGRESS;
+    unsigned num_values = 0;
     ucs_mpmc_elem_t *elem;
 
-    if (ucs_mpmc_queue_is_empty(mpmc)) {
-        return status;
+    if (ucs_queue_is_empty_no_deref(&mpmc->queue)) {
+        return 0;
     }
 
     ucs_spin_lock(&mpmc->lock);
-    while (!ucs_queue_is_empty(&mpmc->queue)) {
+    while ((num_values < count) && !ucs_queue_is_empty(&mpmc->queue)) {
         elem = ucs_queue_pull_elem_non_empty(&mpmc->queue, ucs_mpmc_elem_t,
                                              super);
         if (elem->value != UCS_MPMC_INVALID_VALUE) {
-            *value_p = elem->value;
-            status   = UCS_OK;
-            ucs_free(elem);
-            break;
+            values[num_values++] = elem->value;
         }
 
         ucs_free(elem);
     }
     ucs_spin_unlock(&mpmc->lock);
 
-    return status;
+    return num_values;
+}
+
+ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
+{
+    return (ucs_mpmc_queue_pull_batch(mpmc, value_p, 1) == 0) ?
+           UCS_ERR_NO_PROGRESS : UCS_OK;
+}
+
+unsigned ucs_mpmc_queue_pull_batch(ucs_mpmc_queue_t *mpmc, uint64_t *values,
+                                   unsigned count)
+{
+    unsigned num_values;
+
+    num_values = ucs_mpmc_ring_pull_batch(&mpmc->ring, values, count);
+    if (num_values < count) {
+        num_values += ucs_mpmc_queue_pull_overflow(mpmc, values + num_values,
+                                                   count - num_values);
+    }
+
+    return num_values;
 }
 
 void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
@@ -87,6 +274,8 @@ void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
     ucs_mpmc_elem_t *elem;
     ucs_queue_iter_t iter;
 
+    ucs_mpmc_ring_remove_if(&mpmc->ring, predicate, arg);
+
     ucs_spin_lock(&mpmc->lock);
     ucs_queue_for_each_safe(elem, iter, &mpmc->queue, super) {
         if (predicate(elem->value, arg)) {
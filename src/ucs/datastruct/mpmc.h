@@ -9,16 +9,52 @@
 
 #include "queue.h"
 
+#include <ucs/arch/cpu.h>
+#include <ucs/sys/compiler.h>
 #include <ucs/type/status.h>
 #include <ucs/type/spinlock.h>
 
+
+/* Number of cells in the lock-free ring of a MPMC queue */
+#define UCS_MPMC_QUEUE_RING_SIZE 256
+
+
+/**
+ * MPMC ring cell.
+ */
+typedef struct ucs_mpmc_ring_cell {
+    volatile uint64_t seq;      /* Ring position the cell is ready for */
+    volatile uint64_t value;    /* Stored value */
+} ucs_mpmc_ring_cell_t;
+
+
+/**
+ * A bounded lock-free multi-producer-multi-consumer ring of 64-bit values.
+ * Every cell has a sequence number which tells whether it is free for the
+ * producer of a given position, or holds a value for the consumer of that
+ * position, so a push or a pull is a single compare-and-swap of the ring
+ * position.
+ */
+typedef struct ucs_mpmc_ring {
+    volatile uint64_t    head;  /* Next position to push to */
+    UCS_CACHELINE_PADDING(uint64_t);
+    volatile uint64_t    tail;  /* Next position to pull from */
+    UCS_CACHELINE_PADDING(uint64_t);
+    ucs_mpmc_ring_cell_t *cells; /* Array of cells */
+    uint64_t             mask;  /* Number of cells minus 1 */
+} ucs_mpmc_ring_t;
+
+
 /**
  * A Multi-producer-multi-consumer thread-safe queue.
- * Every push/pull is a single atomic operation in "good" scenario.
+ * Values are kept in a lock-free ring, so every push/pull is a single atomic
+ * operation in "good" scenario. If the ring is full, values are added to an
+ * overflow list protected by a lock, and the order of values is not preserved.
  */
 typedef struct ucs_mpmc_queue {
+    ucs_mpmc_ring_t    ring;        /* Lock-free ring of values */
     ucs_spinlock_t     lock;        /* Protects 'queue' */
-    ucs_queue_head_t   queue;       /* Queue of data */
+    ucs_queue_head_t   queue;       /* Overflow queue of data */
 } ucs_mpmc_queue_t;
 
 
@@ -43,9 +79,69 @@ typedef int (*ucs_mpmc_queue_predicate_t)(uint64_t value, void *arg);
 
 
 /**
- * Initialize MPMC queue.
+ * Initialize MPMC ring.
+ *
+ * @param length   Ring length, rounded up to a power of 2.
+ */
+ucs_status_t ucs_mpmc_ring_init(ucs_mpmc_ring_t *ring, unsigned length);
+
+
+/**
+ * Destroy MPMC ring.
+ */
+void ucs_mpmc_ring_cleanup(ucs_mpmc_ring_t *ring);
+
+
+/**
+ * Push up to @a count values to the ring, in order.
+ *
+ * @param values   Values to push. UINT64_MAX is reserved and cannot be pushed.
+ * @param count    Number of values to push.
+ *
+ * @return Number of values pushed, which is less than @a count if the ring
+ *         is full.
+ */
+unsigned ucs_mpmc_ring_push_batch(ucs_mpmc_ring_t *ring, const uint64_t *values,
+                                  unsigned count);
+
+
+/**
+ * Pull up to @a count values from the ring, in order.
+ *
+ * @param values   Filled with the pulled values.
+ * @param count    Maximal number of values to pull.
+ *
+ * @return Number of values pulled, 0 if the ring is empty.
+ */
+unsigned ucs_mpmc_ring_pull_batch(ucs_mpmc_ring_t *ring, uint64_t *values,
+                                  unsigned count);
+
+
+/**
+ * Remove all values from the MPMC ring for which the given predicate returns
+ * "true" (nonzero) value. Removed values are replaced by tombstones, which are
+ * skipped by the consumers. Values which are pushed concurrently may be
+ * missed.
  *
- * @param length   Queue length.
+ * @param  [in] ring      MPMC ring.
+ * @param  [in] predicate Predicate to check candidates for removal.
+ * @param  [in] arg       User-defined argument for the predicate.
+ */
+void ucs_mpmc_ring_remove_if(ucs_mpmc_ring_t *ring,
+                             ucs_mpmc_queue_predicate_t predicate, void *arg);
+
+
+/**
+ * @return nonzero if the ring is empty, 0 if the ring *may* be non-empty.
+ */
+static inline int ucs_mpmc_ring_is_empty(ucs_mpmc_ring_t *ring)
+{
+    return ring->head == ring->tail;
+}
+
+
+/**
+ * Initialize MPMC queue.
  */
 ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc);
 
@@ -59,7 +155,7 @@ void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc);
 /**
  * Atomically push a value to the queue.
  *
- * @param value Value to push.
+ * @param value Value to push. UINT64_MAX is reserved and cannot be pushed.
  * @return UCS_ERR_NO_MEMORY if it fails to allocate the MPMC queue element.
  */
 ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value);
@@ -75,6 +171,18 @@ ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value);
 ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p);
 
 
+/**
+ * Pull up to @a count values from the queue.
+ *
+ * @param values   Filled with the pulled values.
+ * @param count    Maximal number of values to pull.
+ *
+ * @return Number of values pulled, 0 if there is currently no available item.
+ */
+unsigned ucs_mpmc_queue_pull_batch(ucs_mpmc_queue_t *mpmc, uint64_t *values,
+                                   unsigned count);
+
+
 /**
  * Remove all elements from the MPMC queue with the given value for which the
  * given predicate returns "true" (nonzero) value.
@@ -93,7 +201,8 @@ void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
  */
 static inline int ucs_mpmc_queue_is_empty(ucs_mpmc_queue_t *mpmc)
 {
-    return ucs_queue_is_empty_no_deref(&mpmc->queue);
+    return ucs_mpmc_ring_is_empty(&mpmc->ring) &&
+           ucs_queue_is_empty_no_deref(&mpmc->queue);
 }
 
 #endif
@@ -17,6 +17,34 @@
 #include <ucs/sys/checker.h>
 #include <ucs/sys/sys.h>
 #include <ucs/arch/cpu.h>
+#include <ucs/datastruct/list.h>
+#include <ucs/type/spinlock.h>
+
+#include <pthread.h>
+
+
+/* Maximal number of free elements kept by each thread */
+#define UCS_MPOOL_TC_SIZE  64
+
+/* Number of elements moved between a thread cache and the pool at once */
+#define UCS_MPOOL_TC_BATCH (UCS_MPOOL_TC_SIZE / 2)
+
+
+/* Free elements cached by a single thread */
+typedef struct ucs_mpool_tc_thread {
+    ucs_list_link_t   list;     /* Entry in ucs_mpool_tc_t::threads */
+    ucs_mpool_t       *mp;      /* Memory pool which owns the cache */
+    unsigned          count;    /* Number of cached elements */
+    ucs_mpool_elem_t  *elems[UCS_MPOOL_TC_SIZE]; /* Cached elements */
+} ucs_mpool_tc_thread_t;
+
+
+struct ucs_mpool_tc {
+    ucs_spinlock_t    lock;     /* Protects the fields below and growing */
+    pthread_key_t     key;      /* Thread-specific ucs_mpool_tc_thread_t */
+    ucs_mpool_elem_t  *freelist; /* Free list shared by all threads */
+    ucs_list_link_t   threads;  /* List of thread caches */
+};
 
 
 static size_t ucs_mpool_elem_total_size(ucs_mpool_data_t *data)
@@ -70,6 +98,137 @@ void ucs_mpool_params_reset(ucs_mpool_params_t *params)
     params->grow_factor     = 1.0;
     params->ops             = NULL;
     params->name            = "";
+    params->flags           = 0;
+}
+
+static ucs_mpool_elem_t **ucs_mpool_freelist_p(ucs_mpool_t *mp)
+{
+    return (mp->data->tc != NULL) ? &mp->data->tc->freelist : &mp->freelist;
+}
+
+/* Move 'count' elements from the top of a thread cache to the shared free
+ * list. Must be called with the lock held. */
+static void ucs_mpool_tc_thread_flush(ucs_mpool_t *mp,
+                                      ucs_mpool_tc_thread_t *thread,
+                                      unsigned count)
+{
+    ucs_mpool_elem_t *elem;
+
+    ucs_assert(count <= thread->count);
+    while (count-- > 0) {
+        elem = thread->elems[--thread->count];
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        ucs_mpool_add_to_freelist(mp, &mp->data->tc->freelist, elem);
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+}
+
+/* Called when a thread exits, to return its cached elements to the pool */
+static void ucs_mpool_tc_thread_destroy(void *arg)
+{
+    ucs_mpool_tc_thread_t *thread = arg;
+    ucs_mpool_tc_t *tc            = thread->mp->data->tc;
+
+    ucs_spin_lock(&tc->lock);
+    ucs_mpool_tc_thread_flush(thread->mp, thread, thread->count);
+    ucs_list_del(&thread->list);
+    ucs_spin_unlock(&tc->lock);
+
+    ucs_free(thread);
+}
+
+static ucs_mpool_tc_thread_t *ucs_mpool_tc_thread_get(ucs_mpool_t *mp)
+{
+    ucs_mpool_tc_t *tc = mp->data->tc;
+    ucs_mpool_tc_thread_t *thread;
+    int ret;
+
+    thread = pthread_getspecific(tc->key);
+    if (ucs_likely(thread != NULL)) {
+        return thread;
+    }
+
+    thread = ucs_malloc(sizeof(*thread), "mpool_tc_thread");
+    if (thread == NULL) {
+        return NULL;
+    }
+
+    thread->mp    = mp;
+    thread->count = 0;
+
+    ucs_spin_lock(&tc->lock);
+    ucs_list_add_tail(&tc->threads, &thread->list);
+    ucs_spin_unlock(&tc->lock);
+
+    ret = pthread_setspecific(tc->key, thread);
+    if (ret != 0) {
+        ucs_spin_lock(&tc->lock);
+        ucs_list_del(&thread->list);
+        ucs_spin_unlock(&tc->lock);
+        ucs_free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+static ucs_status_t ucs_mpool_tc_init(ucs_mpool_t *mp)
+{
+    ucs_mpool_tc_t *tc;
+    ucs_status_t status;
+    int ret;
+
+    if (mp->data->malloc_safe) {
+        ucs_error("mpool %s: thread cache cannot be used with malloc_safe",
+                  ucs_mpool_name(mp));
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    tc = ucs_malloc(sizeof(*tc), "mpool_tc");
+    if (tc == NULL) {
+        ucs_error("Failed to allocate memory pool thread cache context");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucs_spinlock_init(&tc->lock, 0);
+    if (status != UCS_OK) {
+        goto err_free;
+    }
+
+    ret = pthread_key_create(&tc->key, ucs_mpool_tc_thread_destroy);
+    if (ret != 0) {
+        ucs_error("pthread_key_create() failed: %m");
+        status = UCS_ERR_NO_RESOURCE;
+        goto err_destroy_lock;
+    }
+
+    tc->freelist = NULL;
+    ucs_list_head_init(&tc->threads);
+    mp->data->tc = tc;
+    mp->freelist = UCS_MPOOL_FREELIST_TC;
+    return UCS_OK;
+
+err_destroy_lock:
+    ucs_spinlock_destroy(&tc->lock);
+err_free:
+    ucs_free(tc);
+    return status;
+}
+
+static void ucs_mpool_tc_cleanup(ucs_mpool_t *mp)
+{
+    ucs_mpool_tc_t *tc = mp->data->tc;
+    ucs_mpool_tc_thread_t *thread, *tmp;
+
+    /* Threads which still exist will not call the destructor after the key is
+     * deleted, so return their cached elements here */
+    pthread_key_delete(tc->key);
+    ucs_list_for_each_safe(thread, tmp, &tc->threads, list) {
+        ucs_mpool_tc_thread_flush(mp, thread, thread->count);
+        ucs_free(thread);
+    }
+
+    ucs_spinlock_destroy(&tc->lock);
 }
 
 static size_t ucs_mpool_chunk_size(ucs_mpool_t *mp, unsigned num_elems)
@@ -113,6 +272,7 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
     mp->data->malloc_safe     = params->malloc_safe;
     mp->data->quota           = params->max_elems;
     mp->data->tail            = NULL;
+    mp->data->tc              = NULL;
     mp->data->chunks          = NULL;
     mp->data->ops             = params->ops;
     mp->data->name            = ucs_strdup(params->name, "mpool_data_name");
@@ -131,6 +291,13 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
         goto err_free_name;
     }
 
+    if (params->flags & UCS_MPOOL_FLAG_THREAD_CACHE) {
+        status = ucs_mpool_tc_init(mp);
+        if (status != UCS_OK) {
+            goto err_free_name;
+        }
+    }
+
     VALGRIND_CREATE_MEMPOOL(mp, 0, 0);
 
     ucs_debug("mpool %s: align %zu, maxelems %u, elemsize %zu",
@@ -153,10 +320,14 @@ void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
     ucs_mpool_data_t *data = mp->data;
     void *obj;
 
+    if (data->tc != NULL) {
+        ucs_mpool_tc_cleanup(mp);
+    }
+
     /* Cleanup all elements in the freelist and set their header to NULL to mark
      * them as released for the leak check.
      */
-    next_elem = mp->freelist;
+    next_elem = *ucs_mpool_freelist_p(mp);
     while (next_elem != NULL) {
         elem = next_elem;
         VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
@@ -193,6 +364,7 @@ void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
 
     ucs_debug("mpool %s destroyed", ucs_mpool_name(mp));
 
+    ucs_free(data->tc);
     ucs_free(data->name);
     ucs_free(data);
 }
@@ -209,7 +381,7 @@ const char *ucs_mpool_name(ucs_mpool_t *mp)
 
 int ucs_mpool_is_empty(ucs_mpool_t *mp)
 {
-    return (mp->freelist == NULL) && (mp->data->quota == 0);
+    return (*ucs_mpool_freelist_p(mp) == NULL) && (mp->data->quota == 0);
 }
 
 void *ucs_mpool_get(ucs_mpool_t *mp)
@@ -245,7 +417,7 @@ unsigned ucs_mpool_num_elems_per_chunk(ucs_mpool_t *mp,
     return ucs_min(data->quota, elem_size / ucs_mpool_elem_total_size(data));
 }
 
-void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
+static void ucs_mpool_grow_freelist(ucs_mpool_t *mp, unsigned num_elems)
 {
     ucs_mpool_data_t *data = mp->data;
     size_t chunk_size;
@@ -287,7 +459,7 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
         if (data->ops->obj_init != NULL) {
             data->ops->obj_init(mp, elem + 1, chunk);
         }
-        ucs_mpool_add_to_freelist(mp, elem);
+        ucs_mpool_add_to_freelist(mp, ucs_mpool_freelist_p(mp), elem);
     }
 
     chunk->next  = data->chunks;
@@ -304,14 +476,30 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
     VALGRIND_MAKE_MEM_NOACCESS(chunk + 1, chunk_size - sizeof(*chunk));
 }
 
-void *ucs_mpool_get_grow(ucs_mpool_t *mp)
+void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
+{
+    ucs_mpool_tc_t *tc = mp->data->tc;
+
+    if (tc == NULL) {
+        ucs_mpool_grow_freelist(mp, num_elems);
+        return;
+    }
+
+    ucs_spin_lock(&tc->lock);
+    ucs_mpool_grow_freelist(mp, num_elems);
+    ucs_spin_unlock(&tc->lock);
+}
+
+/* Allocate a new chunk and update the size of the next one. Must be called
+ * with the lock held if the pool has a thread cache. */
+static int ucs_mpool_grow_chunk(ucs_mpool_t *mp)
 {
     ucs_mpool_data_t *data = mp->data;
     unsigned num_elems;
 
-    ucs_mpool_grow(mp, data->elems_per_chunk);
-    if (mp->freelist == NULL) {
-        return NULL;
+    ucs_mpool_grow_freelist(mp, data->elems_per_chunk);
+    if (*ucs_mpool_freelist_p(mp) == NULL) {
+        return 0;
     }
 
     /* Calculate num of elems for next growing */
@@ -319,6 +507,89 @@ void *ucs_mpool_get_grow(ucs_mpool_t *mp)
     num_elems             = ucs_min(data->elems_per_chunk,
                                     data->chunks->num_elems);
     data->elems_per_chunk = (num_elems * data->grow_factor) + 0.5;
+    return 1;
+}
+
+/* Refill the calling thread cache from the shared free list */
+static void ucs_mpool_tc_thread_refill(ucs_mpool_t *mp,
+                                       ucs_mpool_tc_thread_t *thread)
+{
+    ucs_mpool_tc_t *tc = mp->data->tc;
+    ucs_mpool_elem_t *elem;
+
+    ucs_spin_lock(&tc->lock);
+    if ((tc->freelist != NULL) || ucs_mpool_grow_chunk(mp)) {
+        while ((thread->count < UCS_MPOOL_TC_BATCH) && (tc->freelist != NULL)) {
+            elem = tc->freelist;
+            VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+            tc->freelist                  = elem->next;
+            thread->elems[thread->count++] = elem;
+            VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+        }
+    }
+    ucs_spin_unlock(&tc->lock);
+}
+
+static void *ucs_mpool_tc_get(ucs_mpool_t *mp)
+{
+    ucs_mpool_tc_thread_t *thread;
+    ucs_mpool_elem_t *elem;
+    void *obj;
+
+    thread = ucs_mpool_tc_thread_get(mp);
+    if (ucs_unlikely(thread == NULL)) {
+        return NULL;
+    }
+
+    if (thread->count == 0) {
+        ucs_mpool_tc_thread_refill(mp, thread);
+        if (thread->count == 0) {
+            return NULL;
+        }
+    }
+
+    elem = thread->elems[--thread->count];
+    VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+    elem->mpool = mp;
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+
+    obj = elem + 1;
+    VALGRIND_MEMPOOL_ALLOC(mp, obj, mp->data->elem_size - sizeof(ucs_mpool_elem_t));
+    return obj;
+}
+
+void ucs_mpool_tc_put(ucs_mpool_t *mp, ucs_mpool_elem_t *elem)
+{
+    ucs_mpool_tc_t *tc = mp->data->tc;
+    ucs_mpool_tc_thread_t *thread;
+
+    thread = ucs_mpool_tc_thread_get(mp);
+    if (ucs_unlikely(thread == NULL)) {
+        ucs_spin_lock(&tc->lock);
+        ucs_mpool_add_to_freelist(mp, &tc->freelist, elem);
+        ucs_spin_unlock(&tc->lock);
+    } else {
+        if (thread->count == UCS_MPOOL_TC_SIZE) {
+            ucs_spin_lock(&tc->lock);
+            ucs_mpool_tc_thread_flush(mp, thread, UCS_MPOOL_TC_BATCH);
+            ucs_spin_unlock(&tc->lock);
+        }
+        thread->elems[thread->count++] = elem;
+    }
+
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    VALGRIND_MEMPOOL_FREE(mp, elem + 1);
+}
+
+void *ucs_mpool_get_grow(ucs_mpool_t *mp)
+{
+    if (mp->data->tc != NULL) {
+        return ucs_mpool_tc_get(mp);
+    }
+
+    if (!ucs_mpool_grow_chunk(mp)) {
+        return NULL;
+    }
 
     return ucs_mpool_get(mp);
 }
@@ -22,6 +22,20 @@ typedef union  ucs_mpool_elem    ucs_mpool_elem_t;
 typedef struct ucs_mpool         ucs_mpool_t;
 typedef struct ucs_mpool_data    ucs_mpool_data_t;
 typedef struct ucs_mpool_ops     ucs_mpool_ops_t;
+typedef struct ucs_mpool_tc      ucs_mpool_tc_t;
+
+
+/**
+ * Memory pool flags.
+ */
+typedef enum {
+    /**
+     * Keep a per-thread cache of free elements in front of the pool, which is
+     * refilled from and flushed to the pool in batches. The pool may then be
+     * used concurrently by multiple threads without external locking.
+     */
+    UCS_MPOOL_FLAG_THREAD_CACHE = UCS_BIT(0)
+} ucs_mpool_flags_t;
 
 
 /**
@@ -83,6 +97,9 @@ struct ucs_mpool_data {
     unsigned               quota;           /* How many more elements can be allocated */
     int                    malloc_safe;     /* Avoid triggering malloc() during put/get */
     ucs_mpool_elem_t       *tail;           /* Free list tail */
+    ucs_mpool_tc_t         *tc;             /* Per-thread cache context, if
+                                             * UCS_MPOOL_FLAG_THREAD_CACHE is
+                                             * set */
     ucs_mpool_chunk_t      *chunks;         /* List of allocated chunks */
     const ucs_mpool_ops_t  *ops;            /* Memory pool operations */
     char                   *name;           /* Name - used for debugging */
@@ -239,6 +256,11 @@ typedef struct ucs_mpool_params {
      * Memory pool name.
      */
     const char            *name;
+
+    /**
+     * Memory pool flags, see @ref ucs_mpool_flags_t.
+     */
+    unsigned              flags;
 } ucs_mpool_params_t;
 
 
@@ -335,6 +357,16 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems);
 void *ucs_mpool_get_grow(ucs_mpool_t *mp);
 
 
+/**
+ * Return an object to a memory pool with a per-thread cache.
+ * Used internally by ucs_mpool_put().
+ *
+ * @param mp               Memory pool structure.
+ * @param elem             Element to return.
+ */
+void ucs_mpool_tc_put(ucs_mpool_t *mp, ucs_mpool_elem_t *elem);
+
+
 /**
  * Return the number of elements in the chunk.
  * @param mp               Memory pool structure.
@@ -14,12 +14,18 @@
 #include <ucs/sys/sys.h>
 
 
+/* Free list of a memory pool with per-thread caches. It makes ucs_mpool_get()
+ * take the slow path, and ucs_mpool_put() return the object to the cache. */
+#define UCS_MPOOL_FREELIST_TC ((ucs_mpool_elem_t*)1)
+
+
 static inline void *ucs_mpool_get_inline(ucs_mpool_t *mp)
 {
     ucs_mpool_elem_t *elem;
     void *obj;
 
-    if (ucs_unlikely(mp->freelist == NULL)) {
+    if (ucs_unlikely((uintptr_t)mp->freelist <=
+                     (uintptr_t)UCS_MPOOL_FREELIST_TC)) {
         return ucs_mpool_get_grow(mp);
     }
 
@@ -36,14 +42,15 @@ static inline void *ucs_mpool_get_inline(ucs_mpool_t *mp)
 }
 
 static inline void
-ucs_mpool_add_to_freelist(ucs_mpool_t *mp, ucs_mpool_elem_t *elem)
+ucs_mpool_add_to_freelist(ucs_mpool_t *mp, ucs_mpool_elem_t **freelist_p,
+                          ucs_mpool_elem_t *elem)
 {
     ucs_mpool_elem_t *tail;
 
     if (ENABLE_DEBUG_DATA && ucs_global_opts.mpool_fifo) {
         elem->next = NULL;
-        if (mp->freelist == NULL) {
-            mp->freelist = elem;
+        if (*freelist_p == NULL) {
+            *freelist_p = elem;
         } else {
             tail = mp->data->tail;
             VALGRIND_MAKE_MEM_DEFINED(tail, sizeof *tail);
@@ -52,8 +59,8 @@ ucs_mpool_add_to_freelist(ucs_mpool_t *mp, ucs_mpool_elem_t *elem)
         }
         mp->data->tail = elem;
     } else {
-        elem->next = mp->freelist;
-        mp->freelist = elem;
+        elem->next  = *freelist_p;
+        *freelist_p = elem;
     }
 }
 
@@ -76,7 +83,12 @@ static inline void ucs_mpool_put_inline(void *obj)
 
     elem = ucs_mpool_obj_to_elem(obj);
     mp   = elem->mpool;
-    ucs_mpool_add_to_freelist(mp, elem);
+    if (ucs_unlikely(mp->freelist == UCS_MPOOL_FREELIST_TC)) {
+        ucs_mpool_tc_put(mp, elem);
+        return;
+    }
+
+    ucs_mpool_add_to_freelist(mp, &mp->freelist, elem);
     VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
     VALGRIND_MEMPOOL_FREE(mp, obj);
 }
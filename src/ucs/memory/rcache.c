@@ -146,6 +146,12 @@ static ucs_rcache_global_context_t ucs_rcache_global_context = {
     .pipe = UCS_ASYNC_PIPE_INITIALIZER
 };
 
+/* Index of the thread's slot in ucs_rcache_t::lookup::slots */
+static __thread unsigned ucs_rcache_lookup_slot_index = UINT_MAX;
+
+/* Used to assign the lookup slots to threads in a round-robin order */
+static volatile uint32_t ucs_rcache_lookup_next_slot = 0;
+
 void ucs_rcache_region_log(const char *file, int line, const char *function,
                            ucs_log_level_t level, ucs_rcache_t *rcache,
                            ucs_rcache_region_t *region, const char *fmt, ...)
@@ -370,9 +376,83 @@ static void ucs_rcache_find_regions(ucs_rcache_t *rcache, ucs_pgt_addr_t from,
                              ucs_rcache_region_collect_callback, list);
 }
 
+static UCS_F_ALWAYS_INLINE ucs_rcache_lookup_slot_t *
+ucs_rcache_lookup_slot(ucs_rcache_t *rcache)
+{
+    if (ucs_unlikely(ucs_rcache_lookup_slot_index == UINT_MAX)) {
+        ucs_rcache_lookup_slot_index =
+                ucs_atomic_fadd32(&ucs_rcache_lookup_next_slot, 1) %
+                UCS_RCACHE_LOOKUP_SLOTS;
+    }
+
+    return &rcache->lookup.slots[ucs_rcache_lookup_slot_index];
+}
+
+static int ucs_rcache_lookup_is_idle(ucs_rcache_t *rcache)
+{
+    unsigned i;
+
+    for (i = 0; i < UCS_RCACHE_LOOKUP_SLOTS; ++i) {
+        if (rcache->lookup.slots[i].count != 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Lock the page table in write mode and wait for lockless lookups to finish */
+static void ucs_rcache_pgt_wrlock(ucs_rcache_t *rcache)
+{
+    pthread_rwlock_wrlock(&rcache->pgt_lock);
+
+    /* Atomic operation is a full memory barrier, which orders setting the
+     * flag before checking the slots */
+    ucs_atomic_swap32(&rcache->lookup.writer, 1);
+    while (!ucs_rcache_lookup_is_idle(rcache)) {
+        sched_yield();
+    }
+}
+
+/* Same as ucs_rcache_pgt_wrlock(), but fail instead of waiting. Returns
+ * nonzero if the lock was acquired. */
+static int ucs_rcache_pgt_trywrlock(ucs_rcache_t *rcache)
+{
+    if (pthread_rwlock_trywrlock(&rcache->pgt_lock)) {
+        return 0;
+    }
+
+    ucs_atomic_swap32(&rcache->lookup.writer, 1);
+    if (ucs_rcache_lookup_is_idle(rcache)) {
+        return 1;
+    }
+
+    /* Do not wait for the lookups, since the calling thread could be in the
+     * middle of a lookup itself (e.g from a memory event callback) */
+    rcache->lookup.writer = 0;
+    pthread_rwlock_unlock(&rcache->pgt_lock);
+    return 0;
+}
+
+static void ucs_rcache_pgt_wrunlock(ucs_rcache_t *rcache)
+{
+    /* Make page table updates visible before allowing lockless lookups */
+    ucs_memory_cpu_store_fence();
+    rcache->lookup.writer = 0;
+    pthread_rwlock_unlock(&rcache->pgt_lock);
+}
+
 static void
 ucs_rcache_region_lru_get(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
 {
+    /* A region which is used by other threads is already out of the LRU, so
+     * check it without the lock to avoid bouncing the lock's cache line. If
+     * the region is added to the LRU concurrently, it will be skipped by
+     * eviction because it is in use. */
+    if (!(region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU)) {
+        return;
+    }
+
     /* A used region cannot be evicted */
     ucs_spin_lock(&rcache->lru.lock);
     ucs_rcache_region_lru_remove(rcache, region);
@@ -424,7 +504,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_DEREGS, 1);
 
         if (drop_lock) {
-            pthread_rwlock_unlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrunlock(rcache);
         }
 
         UCS_PROFILE_NAMED_CALL_VOID_ALWAYS("mem_dereg",
@@ -433,7 +513,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                                            region);
 
         if (drop_lock) {
-            pthread_rwlock_wrlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrlock(rcache);
         }
     }
 
@@ -493,14 +573,14 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
 
     /* Destroy region and de-register memory */
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        pthread_rwlock_wrlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrlock(rcache);
     }
 
     ucs_mem_region_destroy_internal(rcache, region,
                                     flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
 
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        pthread_rwlock_unlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrunlock(rcache);
     }
 }
 
@@ -649,7 +729,7 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
      * no rcache operations are performed to clean it.
      */
     if (!(rcache->params.flags & UCS_RCACHE_FLAG_SYNC_EVENTS) &&
-        !pthread_rwlock_trywrlock(&rcache->pgt_lock)) {
+        ucs_rcache_pgt_trywrlock(rcache)) {
         /* coverity[double_lock] */
         ucs_rcache_invalidate_range(rcache, start, end,
                                     UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
@@ -657,7 +737,7 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
         /* coverity[double_lock] */
         ucs_rcache_check_inv_queue(rcache, UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
         /* coverity[double_unlock] */
-        pthread_rwlock_unlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrunlock(rcache);
         return;
     }
 
@@ -703,11 +783,11 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
 /* Lock must be held in write mode */
 static void ucs_rcache_clean(ucs_rcache_t *rcache)
 {
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
     /* coverity[double_lock]*/
     ucs_rcache_check_inv_queue(rcache, 0);
     ucs_rcache_check_gc_list(rcache, 1);
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
 }
 
 /* Lock must be held in write mode */
@@ -940,7 +1020,7 @@ ucs_status_t ucs_rcache_create_region(ucs_rcache_t *rcache, void *address,
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
 
 retry:
     /* Align to page size */
@@ -1061,7 +1141,7 @@ out_set_region:
     *region_p = region;
 out_unlock:
     /* coverity[double_unlock]*/
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
     return status;
 }
 
@@ -1071,37 +1151,68 @@ void ucs_rcache_region_hold(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
     ucs_rcache_region_trace(rcache, region, "hold");
 }
 
+/* Page table lock must be held, or the lookup slot of the thread */
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_lookup_hit(ucs_rcache_t *rcache, ucs_pgt_addr_t start, size_t length,
+                      size_t alignment, int prot)
+{
+    ucs_pgt_region_t *pgt_region;
+    ucs_rcache_region_t *region;
+
+    if (!ucs_queue_is_empty(&rcache->inv_q)) {
+        return NULL;
+    }
+
+    pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable, start);
+    if (ucs_unlikely(pgt_region == NULL)) {
+        return NULL;
+    }
+
+    region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
+    if (((start + length) > region->super.end) ||
+        !ucs_rcache_region_test(region, prot, alignment)) {
+        return NULL;
+    }
+
+    ucs_rcache_region_hold(rcache, region);
+    ucs_rcache_region_validate_pfn(rcache, region);
+    ucs_rcache_region_lru_get(rcache, region);
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+    return region;
+}
+
 ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                             size_t alignment, int prot, void *arg,
                             ucs_rcache_region_t **region_p)
 {
-    ucs_pgt_addr_t start = (uintptr_t)address;
-    ucs_pgt_region_t *pgt_region;
+    ucs_rcache_lookup_slot_t *slot = ucs_rcache_lookup_slot(rcache);
+    ucs_pgt_addr_t start           = (uintptr_t)address;
     ucs_rcache_region_t *region;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_rdlock(&rcache->pgt_lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
-    if (ucs_queue_is_empty(&rcache->inv_q)) {
-        pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable,
-                                      start);
-        if (ucs_likely(pgt_region != NULL)) {
-            region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
-            if (((start + length) <= region->super.end) &&
-                ucs_rcache_region_test(region, prot, alignment)) {
-                ucs_rcache_region_hold(rcache, region);
-                ucs_rcache_region_validate_pfn(rcache, region);
-                ucs_rcache_region_lru_get(rcache, region);
-                *region_p = region;
-                UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
-                pthread_rwlock_unlock(&rcache->pgt_lock);
-                return UCS_OK;
-            }
-        }
+
+    /* The page table is not modified while the thread's lookup slot is
+     * non-zero, unless a writer is already holding the lock. Atomic operation
+     * is a full memory barrier, which orders updating the slot before checking
+     * the writer flag. */
+    ucs_atomic_add32(&slot->count, 1);
+    if (ucs_likely(!rcache->lookup.writer)) {
+        region = ucs_rcache_lookup_hit(rcache, start, length, alignment, prot);
+        ucs_atomic_sub32(&slot->count, 1);
+    } else {
+        ucs_atomic_sub32(&slot->count, 1);
+        pthread_rwlock_rdlock(&rcache->pgt_lock);
+        region = ucs_rcache_lookup_hit(rcache, start, length, alignment, prot);
+        pthread_rwlock_unlock(&rcache->pgt_lock);
+    }
+
+    if (ucs_likely(region != NULL)) {
+        *region_p = region;
+        return UCS_OK;
     }
-    pthread_rwlock_unlock(&rcache->pgt_lock);
 
     /* Fall back to slow version (with rw lock) in following cases:
      * - invalidation list not empty
@@ -1132,7 +1243,7 @@ void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
     comp = ucs_mpool_get(&rcache->mp);
     ucs_spin_unlock(&rcache->lock);
 
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
     if (comp != NULL) {
         comp->func = cb;
         comp->arg  = arg;
@@ -1145,7 +1256,7 @@ void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
     /* coverity[double_lock] */
     ucs_rcache_region_invalidate_internal(rcache, region, 0);
     /* coverity[double_unlock] */
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_PUTS, 1);
 }
 
@@ -1170,10 +1281,10 @@ static void ucs_rcache_before_fork(void)
              *   again on-demand.
              * - Other use cases shouldn't be affected
              */
-            pthread_rwlock_wrlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrlock(rcache);
             /* coverity[double_lock] */
             ucs_rcache_invalidate_range(rcache, 0, UCS_PGT_ADDR_MAX, 0);
-            pthread_rwlock_unlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrunlock(rcache);
         }
     }
     pthread_mutex_unlock(&ucs_rcache_global_context.lock);
@@ -1348,9 +1459,24 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_destroy_mp;
     }
 
+    ret = ucs_posix_memalign((void**)&self->lookup.slots,
+                             UCS_SYS_CACHE_LINE_SIZE,
+                             sizeof(*self->lookup.slots) *
+                             UCS_RCACHE_LOOKUP_SLOTS,
+                             "rcache_lookup_slots");
+    if (ret != 0) {
+        ucs_error("failed to allocate rcache lookup slots");
+        status = UCS_ERR_NO_MEMORY;
+        goto err_destroy_dist;
+    }
+
+    memset(self->lookup.slots, 0,
+           sizeof(*self->lookup.slots) * UCS_RCACHE_LOOKUP_SLOTS);
+    self->lookup.writer = 0;
+
     status = ucs_rcache_global_list_add(self);
     if (status != UCS_OK) {
-        goto err_destroy_dist;
+        goto err_free_slots;
     }
 
     ucs_rcache_vfs_init(self);
@@ -1368,6 +1494,8 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
 err_remove_vfs:
     ucs_vfs_obj_remove(self);
     ucs_rcache_global_list_remove(self);
+err_free_slots:
+    ucs_free(self->lookup.slots);
 err_destroy_dist:
     ucs_free(self->distribution);
 err_destroy_mp:
@@ -1412,6 +1540,7 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
     UCS_STATS_NODE_FREE(self->stats);
     ucs_free(self->name);
     ucs_free(self->distribution);
+    ucs_free(self->lookup.slots);
 }
 
 UCS_CLASS_DEFINE(ucs_rcache_t, void);
@@ -9,6 +9,7 @@
 
 #include "rcache.h"
 
+#include <ucs/arch/cpu.h>
 #include <ucs/datastruct/list.h>
 #include <ucs/stats/stats.h>
 #include <ucs/sys/ptr_arith.h>
@@ -55,6 +56,19 @@ enum {
 };
 
 
+/* Number of reader slots of the lockless lookup path. Threads are assigned to
+   the slots in a round-robin order, so a lookup updates a cache line which is
+   shared with other threads only when there are more threads than slots.
+ */
+#define UCS_RCACHE_LOOKUP_SLOTS 64
+
+
+/* Number of lockless lookups in progress by the threads assigned to a slot */
+typedef struct ucs_rcache_lookup_slot {
+    volatile uint32_t count;
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) ucs_rcache_lookup_slot_t;
+
+
 /* The structure represents a group in registration cache regions distribution.
    Regions are distributed by their size.
  */
@@ -70,6 +84,14 @@ struct ucs_rcache {
                                               regions whose refcount is 0 */
     ucs_pgtable_t       pgtable;         /**< page table to hold the regions */
 
+    struct {
+        volatile uint32_t        writer; /**< Set while 'pgt_lock' is held in
+                                              write mode, makes lookups fall
+                                              back to taking 'pgt_lock' */
+        ucs_rcache_lookup_slot_t *slots; /**< Lockless lookups in progress,
+                                              the page table is not modified
+                                              until all of them are done */
+    } lookup;
 
     ucs_spinlock_t      lock;            /**< Protects 'mp', 'inv_q' and 'gc_list'.
                                               This is a separate lock because we
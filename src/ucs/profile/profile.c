@@ -10,16 +10,24 @@
 
 #include "profile.h"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/datastruct/list.h>
 #include <ucs/debug/debug_int.h>
 #include <ucs/debug/log.h>
 #include <ucs/sys/lib.h>
+#include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/time/time.h>
+#include <ucs/vfs/base/vfs_obj.h>
 #include <pthread.h>
 
 
+/* Modes which record the sequence of events */
+#define UCS_PROFILE_RECORD_MODES \
+    (UCS_BIT(UCS_PROFILE_MODE_LOG) | UCS_BIT(UCS_PROFILE_MODE_RING))
+
+
 typedef struct ucs_profile_global_location {
     ucs_profile_location_t        super; /*< Location info */
     volatile ucs_profile_loc_id_t *loc_id_p; /*< Back-pointer to location index */
@@ -42,6 +50,14 @@ typedef struct ucs_profile_thread_context {
         int                           wraparound;    /**< Whether log was rotated */
     } log;
 
+    struct {
+        ucs_profile_record_t          *records;      /**< Ring of last records */
+        uint64_t                      mask;          /**< Ring size minus 1 */
+        volatile uint64_t             head;          /**< Number of records ever added */
+        ucs_profile_record_t          *snapshot;     /**< Records copied for writing */
+        size_t                        num_snapshot;  /**< Number of copied records */
+    } ring;
+
     struct {
         unsigned                      num_locations; /**< Number of valid locations */
         ucs_profile_thread_location_t *locations;    /**< Statistics per location */
@@ -64,6 +80,8 @@ struct ucs_profile_context  {
     pthread_mutex_t               mutex;            /**< Protects updating the locations array */
     pthread_key_t                 tls_key;          /**< TLS key for per-thread context */
     ucs_list_link_t               thread_list;      /**< List of all thread contexts */
+    uint32_t                      snapshot_index;   /**< Index of the last snapshot */
+    char                          last_file[1024];  /**< Last written file */
 };
 
 
@@ -77,6 +95,7 @@ struct ucs_profile_context  {
 const char *ucs_profile_mode_names[] = {
     [UCS_PROFILE_MODE_ACCUM] = "accum",
     [UCS_PROFILE_MODE_LOG]   = "log",
+    [UCS_PROFILE_MODE_RING]  = "ring",
     [UCS_PROFILE_MODE_LAST]  = NULL
 };
 
@@ -119,6 +138,12 @@ ucs_profile_write_profiling_records(ucs_profile_context_t *ctx, int fd,
 {
     ucs_status_t status;
 
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        return ucs_profile_file_write_records(fd, thread_ctx->ring.snapshot,
+                                              thread_ctx->ring.snapshot +
+                                              thread_ctx->ring.num_snapshot);
+    }
+
     if (!(ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_LOG))) {
         return UCS_OK;
     }
@@ -138,6 +163,10 @@ ucs_profile_write_profiling_records(ucs_profile_context_t *ctx, int fd,
 size_t ucs_profile_calc_num_records(ucs_profile_context_t *ctx,
                                     ucs_profile_thread_context_t *thread_ctx)
 {
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        return thread_ctx->ring.num_snapshot;
+    }
+
     if (!(ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_LOG))) {
         return 0;
     }
@@ -165,6 +194,9 @@ ucs_profile_file_write_thread(ucs_profile_context_t *ctx, int fd,
      * To avoid excess locking on fast-path, we assume that when we dump the
      * profiling data (at program exit), the profiled threads are not calling
      * ucs_profile_record() anymore.
+     * In ring mode, the records are copied by ucs_profile_ring_snapshot(),
+     * which drops the ones overwritten while copying, and the accumulated
+     * counters may be slightly behind.
      */
 
     ucs_debug("profiling thread context %p: write to file", thread_ctx);
@@ -272,7 +304,7 @@ static void ucs_profile_calc_blocks(ucs_profile_header_t *header,
     header->threads.size   = (thread_header_size + threads_locations_size) *
                              num_threads;
 
-    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) {
+    if (ctx->profile_mode & UCS_PROFILE_RECORD_MODES) {
         ucs_list_for_each(thread_ctx, &ctx->thread_list, list) {
             header->threads.size += 
                     ucs_profile_calc_num_records(ctx, thread_ctx) *
@@ -281,38 +313,101 @@ static void ucs_profile_calc_blocks(ucs_profile_header_t *header,
     }
 }
 
-static void ucs_profile_write(ucs_profile_context_t *ctx)
+/* Copy the records of a thread ring, while the thread may still add records */
+static void ucs_profile_ring_snapshot(ucs_profile_thread_context_t *thread_ctx)
+{
+    uint64_t size = thread_ctx->ring.mask + 1;
+    uint64_t head, start, min_valid, pos;
+    ucs_profile_record_t *snapshot;
+    size_t num_records;
+
+    thread_ctx->ring.snapshot     = NULL;
+    thread_ctx->ring.num_snapshot = 0;
+
+    head = thread_ctx->ring.head;
+    ucs_memory_cpu_load_fence();
+
+    start       = (head > size) ? (head - size) : 0;
+    num_records = head - start;
+    if (num_records == 0) {
+        return;
+    }
+
+    snapshot = ucs_malloc(sizeof(*snapshot) * num_records,
+                          "profile_ring_snapshot");
+    if (snapshot == NULL) {
+        ucs_error("failed to allocate profiling ring snapshot");
+        return;
+    }
+
+    for (pos = start; pos < head; ++pos) {
+        snapshot[pos - start] = thread_ctx->ring.records[pos &
+                                                         thread_ctx->ring.mask];
+    }
+
+    /* The thread may have overwritten the oldest records while they were
+     * copied. Unless the thread has exited, the record at the current head
+     * may be partially written. */
+    ucs_memory_cpu_load_fence();
+    min_valid = thread_ctx->ring.head + !thread_ctx->is_completed;
+    min_valid = (min_valid > size) ? (min_valid - size) : 0;
+    if (min_valid > start) {
+        num_records -= ucs_min(min_valid - start, num_records);
+        memmove(snapshot, snapshot + (head - start - num_records),
+                sizeof(*snapshot) * num_records);
+    }
+
+    thread_ctx->ring.snapshot     = snapshot;
+    thread_ctx->ring.num_snapshot = num_records;
+}
+
+static void ucs_profile_ring_snapshot_release(ucs_profile_context_t *ctx)
 {
+    ucs_profile_thread_context_t *thread_ctx;
+
+    ucs_list_for_each(thread_ctx, &ctx->thread_list, list) {
+        ucs_free(thread_ctx->ring.snapshot);
+        thread_ctx->ring.snapshot     = NULL;
+        thread_ctx->ring.num_snapshot = 0;
+    }
+}
+
+static ucs_status_t
+ucs_profile_write(ucs_profile_context_t *ctx, const char *fullpath)
+{
+    ucs_profile_thread_context_t *thread_ctx;
     ucs_profile_header_t header;
-    char fullpath[1024] = {0};
-    char filename[1024] = {0};
     ucs_time_t write_time;
     ucs_status_t status;
     int fd;
     ucs_string_buffer_t env_strb;
     const char *env_variables;
 
+    if (!ctx->profile_mode) {
+        return UCS_OK;
+    }
+
     ucs_string_buffer_init(&env_strb);
     ucs_config_parser_get_env_vars(&env_strb, " ");
     env_variables = ucs_string_buffer_cstr(&env_strb);
 
-    if (!ctx->profile_mode) {
-        goto out_free_env;
-    }
-
     pthread_mutex_lock(&ctx->mutex);
 
     write_time = ucs_get_time();
 
-    ucs_fill_filename_template(ctx->file_name, filename, sizeof(filename));
-    ucs_expand_path(filename, fullpath, sizeof(fullpath) - 1);
-
     fd = open(fullpath, O_WRONLY|O_CREAT|O_TRUNC, 0600);
     if (fd < 0) {
         ucs_error("failed to write profiling data to '%s': %m", fullpath);
+        status = UCS_ERR_IO_ERROR;
         goto out_unlock;
     }
 
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        ucs_list_for_each(thread_ctx, &ctx->thread_list, list) {
+            ucs_profile_ring_snapshot(thread_ctx);
+        }
+    }
+
     memset(&header, 0, sizeof(header));
     ucs_strncpy_safe(header.cmdline, ucs_get_process_cmdline(),
                      sizeof(header.cmdline));
@@ -329,7 +424,10 @@ static void ucs_profile_write(ucs_profile_context_t *ctx)
 
     ucs_profile_calc_blocks(&header, ctx, env_variables);
 
-    ucs_profile_file_write_data(fd, &header, sizeof(header));
+    status = ucs_profile_file_write_data(fd, &header, sizeof(header));
+    if (status != UCS_OK) {
+        goto out_close_fd;
+    }
 
     status = ucs_profile_file_write_data(fd, env_variables,
                                          header.env_vars.size);
@@ -347,12 +445,24 @@ static void ucs_profile_write(ucs_profile_context_t *ctx)
         goto out_close_fd;
     }
 
+    ucs_strncpy_zero(ctx->last_file, fullpath, sizeof(ctx->last_file));
+
 out_close_fd:
+    ucs_profile_ring_snapshot_release(ctx);
     close(fd);
 out_unlock:
     pthread_mutex_unlock(&ctx->mutex);
-out_free_env:
     ucs_string_buffer_cleanup(&env_strb);
+    return status;
+}
+
+static void ucs_profile_get_path(ucs_profile_context_t *ctx, char *fullpath,
+                                 size_t max)
+{
+    char filename[1024] = {0};
+
+    ucs_fill_filename_template(ctx->file_name, filename, sizeof(filename));
+    ucs_expand_path(filename, fullpath, max - 1);
 }
 
 static UCS_F_NOINLINE ucs_profile_thread_context_t*
@@ -393,6 +503,24 @@ ucs_profile_thread_init(ucs_profile_context_t *ctx)
         thread_ctx->log.wraparound = 0;
     }
 
+    /* Initialize ring mode */
+    thread_ctx->ring.snapshot     = NULL;
+    thread_ctx->ring.num_snapshot = 0;
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        num_records = ucs_max(ctx->max_file_size / sizeof(ucs_profile_record_t),
+                              1);
+        num_records = ucs_rounddown_pow2(num_records);
+        thread_ctx->ring.records = ucs_calloc(num_records,
+                                              sizeof(ucs_profile_record_t),
+                                              "profile_ring");
+        if (thread_ctx->ring.records == NULL) {
+            ucs_fatal("failed to allocate profiling ring");
+        }
+
+        thread_ctx->ring.mask = num_records - 1;
+        thread_ctx->ring.head = 0;
+    }
+
     /* Initialize accumulate mode */
     if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
         thread_ctx->accum.num_locations = 0;
@@ -418,6 +546,10 @@ static void ucs_profile_thread_cleanup(unsigned profile_mode,
         ucs_free(ctx->log.start);
     }
 
+    if (profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        ucs_free(ctx->ring.records);
+    }
+
     if (profile_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) {
         ucs_free(ctx->accum.locations);
     }
@@ -547,6 +679,9 @@ static void ucs_profile_thread_expand_locations(ucs_profile_context_t *ctx,
     thread_ctx = pthread_getspecific(ctx->tls_key);
     ucs_assert(thread_ctx != NULL);
 
+    /* Lock to avoid a race with ucs_profile_snapshot() */
+    pthread_mutex_lock(&ctx->mutex);
+
     new_num_locations = ucs_max(loc_id, thread_ctx->accum.num_locations);
     thread_ctx->accum.locations = ucs_realloc(thread_ctx->accum.locations,
                                        sizeof(*thread_ctx->accum.locations) *
@@ -562,6 +697,8 @@ static void ucs_profile_thread_expand_locations(ucs_profile_context_t *ctx,
     }
 
     thread_ctx->accum.num_locations = new_num_locations;
+
+    pthread_mutex_unlock(&ctx->mutex);
 }
 
 void ucs_profile_record(ucs_profile_context_t *ctx, ucs_profile_type_t type,
@@ -630,6 +767,16 @@ void ucs_profile_record(ucs_profile_context_t *ctx, ucs_profile_type_t type,
             thread_ctx->log.current    = thread_ctx->log.start;
             thread_ctx->log.wraparound = 1;
         }
+    } else if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        rec              = &thread_ctx->ring.records[thread_ctx->ring.head &
+                                                     thread_ctx->ring.mask];
+        rec->timestamp   = current_time;
+        rec->param64     = param64;
+        rec->param32     = param32;
+        rec->location    = loc_id - 1;
+        /* Publish the record to ucs_profile_ring_snapshot() */
+        ucs_memory_cpu_store_fence();
+        ++thread_ctx->ring.head;
     }
 }
 
@@ -687,6 +834,7 @@ static void ucs_profile_cleanup_completed_threads(ucs_profile_context_t *ctx)
 void ucs_profile_dump(ucs_profile_context_t *ctx)
 {
     ucs_profile_thread_context_t *thread_ctx;
+    char fullpath[1024] = {0};
 
     /* finalize profiling on current thread */
     thread_ctx = pthread_getspecific(ctx->tls_key);
@@ -696,10 +844,45 @@ void ucs_profile_dump(ucs_profile_context_t *ctx)
     }
 
     /* write and cleanup all completed threads (including the current thread) */
-    ucs_profile_write(ctx);
+    ucs_profile_get_path(ctx, fullpath, sizeof(fullpath));
+    ucs_profile_write(ctx, fullpath);
     ucs_profile_cleanup_completed_threads(ctx);
 }
 
+ucs_status_t ucs_profile_snapshot(ucs_profile_context_t *ctx,
+                                  const char *file_name)
+{
+    char fullpath[1024] = {0};
+    uint32_t index;
+
+    if (file_name != NULL) {
+        return ucs_profile_write(ctx, file_name);
+    }
+
+    index = ucs_atomic_fadd32(&ctx->snapshot_index, 1) + 1;
+    ucs_profile_get_path(ctx, fullpath, sizeof(fullpath));
+    ucs_snprintf_safe(fullpath + strlen(fullpath),
+                      sizeof(fullpath) - strlen(fullpath), ".%u", index);
+    return ucs_profile_write(ctx, fullpath);
+}
+
+static void ucs_profile_vfs_read_snapshot(void *obj, ucs_string_buffer_t *strb,
+                                          void *arg_ptr, uint64_t arg_u64)
+{
+    ucs_profile_context_t *ctx = obj;
+
+    pthread_mutex_lock(&ctx->mutex);
+    ucs_string_buffer_appendf(strb, "%s\n", ctx->last_file);
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+static ucs_status_t
+ucs_profile_vfs_write_snapshot(void *obj, const char *buffer, size_t size,
+                               void *arg_ptr, uint64_t arg_u64)
+{
+    return ucs_profile_snapshot(obj, NULL);
+}
+
 unsigned ucs_profile_calc_num_threads(size_t total_num_records,
                                       const ucs_profile_header_t *header)
 {
@@ -735,6 +918,13 @@ ucs_status_t ucs_profile_init(unsigned profile_mode, const char *file_name,
         goto free_ctx;
     }
 
+    if ((profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) &&
+        (profile_mode & UCS_BIT(UCS_PROFILE_MODE_LOG))) {
+        ucs_warn("profiling modes 'log' and 'ring' are mutually exclusive, "
+                 "using 'ring'");
+        profile_mode &= ~UCS_BIT(UCS_PROFILE_MODE_LOG);
+    }
+
     ucs_list_head_init(&ctx->thread_list);
     ctx->profile_mode     = profile_mode;
     ctx->file_name        = file_name;
@@ -743,6 +933,8 @@ ucs_status_t ucs_profile_init(unsigned profile_mode, const char *file_name,
     ctx->num_locations    = 0;
     ctx->locations        = NULL;
     ctx->max_locations    = 0;
+    ctx->snapshot_index   = 0;
+    ctx->last_file[0]     = '\0';
 
     if (profile_mode && !strlen(file_name)) {
         // TODO make sure profiling file is writeable
@@ -750,6 +942,14 @@ ucs_status_t ucs_profile_init(unsigned profile_mode, const char *file_name,
     }
 
     pthread_key_create(&(ctx->tls_key), ucs_profile_thread_key_destr);
+
+    if (profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        ucs_vfs_obj_add_dir(NULL, ctx, "ucs/profile");
+        ucs_vfs_obj_add_rw_file(ctx, ucs_profile_vfs_read_snapshot,
+                                ucs_profile_vfs_write_snapshot, NULL, 0,
+                                "snapshot");
+    }
+
     *ctx_p = ctx;
 
     return UCS_OK;
@@ -761,6 +961,10 @@ free_ctx:
 
 void ucs_profile_cleanup(ucs_profile_context_t *ctx)
 {
+    if (ctx->profile_mode & UCS_BIT(UCS_PROFILE_MODE_RING)) {
+        ucs_vfs_obj_remove(ctx);
+    }
+
     ucs_profile_dump(ctx);
     ucs_profile_check_active_threads(ctx);
     ucs_profile_reset_locations(ctx);
@@ -30,6 +30,8 @@ BEGIN_C_DECLS
 enum {
     UCS_PROFILE_MODE_ACCUM, /**< Accumulate elapsed time per location */
     UCS_PROFILE_MODE_LOG,   /**< Record all events */
+    UCS_PROFILE_MODE_RING,  /**< Keep the last events of every thread, which
+                                 can be saved while the process is running */
     UCS_PROFILE_MODE_LAST
 };
 
@@ -170,6 +172,22 @@ void ucs_profile_cleanup(ucs_profile_context_t *ctx);
 void ucs_profile_dump(ucs_profile_context_t *ctx);
 
 
+/**
+ * Save the current profiling data without stopping the profiled threads.
+ * In ring mode, the records of every thread are copied consistently, while
+ * the thread continues to add new records.
+ *
+ * @param [in] ctx       Profile context.
+ * @param [in] file_name File to write the profiling data to. If NULL, the
+ *                       configured profiling file name is used, with a
+ *                       snapshot index suffix.
+ *
+ * @return Status code.
+ */
+ucs_status_t ucs_profile_snapshot(ucs_profile_context_t *ctx,
+                                  const char *file_name);
+
+
 /*
  * Store a new record with the given data.
  * SHOULD NOT be used directly - use UCS_PROFILE macros instead.
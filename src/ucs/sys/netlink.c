@@ -121,7 +121,7 @@ ucs_netlink_send_request(int protocol, unsigned short nlmsg_type,
     iov[1].iov_len  = header_length;
 
     do {
-        status = ucs_socket_sendv_nb(netlink_fd, iov, 2, &bytes_sent);
+        status = ucs_socket_sendv_nb(netlink_fd, iov, 2, 0, &bytes_sent);
     } while (status == UCS_ERR_NO_PROGRESS);
 
     if (status != UCS_OK) {
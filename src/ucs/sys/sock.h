@@ -313,13 +313,15 @@ ucs_status_t ucs_socket_send(int fd, const void *data, size_t length);
  * @param [in]      iov             A pointer to an array of iovec buffers.
  * @param [in]      iov_cnt         The number of buffers pointed to by
  *                                  the iov parameter.
+ * @param [in]      flags           Flags that are passed to sendmsg() in
+ *                                  addition to MSG_NOSIGNAL (e.g. MSG_ZEROCOPY).
  * @param [out]     length_p        The amount of data transmitted is written to
  *                                  this argument.
  *
  * @return UCS_OK on success or an error code on failure.
  */
 ucs_status_t ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt,
-                                 size_t *length_p);
+                                 int flags, size_t *length_p);
 
 
 /**
@@ -10,31 +10,48 @@
 
 #include <ucs/time/timer_wheel.h>
 
+#include <ucs/arch/bitops.h>
 #include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
 #include <ucs/debug/memtrack_int.h>
 #include <ucs/sys/ptr_arith.h>
 
 
+/* Maximal number of ticks a timer can be scheduled ahead */
+#define UCS_TWHEEL_MAX_TICKS \
+    (UCS_BIT(UCS_TWHEEL_LEVEL_BITS * UCS_TWHEEL_NUM_LEVELS) - 1)
+
+
+static UCS_F_ALWAYS_INLINE unsigned ucs_twheel_slot(uint64_t tick,
+                                                    unsigned level)
+{
+    return (tick >> (level * UCS_TWHEEL_LEVEL_BITS)) & UCS_TWHEEL_LEVEL_MASK;
+}
+
 ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
                              ucs_time_t current_time)
 {
+    ucs_twheel_level_t *level;
     unsigned i;
 
     twheel->res         = ucs_roundup_pow2(resolution);
     twheel->res_order   = (unsigned) ucs_log2(twheel->res);
-    twheel->num_slots   = 1024;
+    twheel->num_slots   = UCS_TWHEEL_LEVEL_SLOTS;
     twheel->current     = 0;
     twheel->now         = current_time;
-    twheel->wheel       = ucs_malloc(sizeof(*twheel->wheel) * twheel->num_slots,
-                                     "twheel");
+    twheel->levels      = ucs_malloc(sizeof(*twheel->levels) *
+                                     UCS_TWHEEL_NUM_LEVELS, "twheel");
     twheel->count       = 0;
-    if (twheel->wheel == NULL) {
+    if (twheel->levels == NULL) {
         return UCS_ERR_NO_MEMORY;
     }
 
-    for (i = 0; i < twheel->num_slots; i++) {
-        ucs_list_head_init(&twheel->wheel[i]);
+    for (level = twheel->levels;
+         level < twheel->levels + UCS_TWHEEL_NUM_LEVELS; ++level) {
+        level->bitmap = 0;
+        for (i = 0; i < UCS_TWHEEL_LEVEL_SLOTS; i++) {
+            ucs_list_head_init(&level->slots[i]);
+        }
     }
 
     ucs_debug("high res timer created log=%d resolution=%lf usec wanted: %lf usec",
@@ -44,7 +61,7 @@ ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
 
 void ucs_twheel_cleanup(ucs_twheel_t *twheel)
 {
-    ucs_free(twheel->wheel);
+    ucs_free(twheel->levels);
 }
 
 ucs_status_t ucs_wtimer_init(ucs_wtimer_t *t, ucs_twheel_callback_t cb)
@@ -54,52 +71,150 @@ ucs_status_t ucs_wtimer_init(ucs_wtimer_t *t, ucs_twheel_callback_t cb)
     return UCS_OK;
 }
 
+static void ucs_twheel_insert(ucs_twheel_t *t, ucs_wtimer_t *timer)
+{
+    uint64_t delta = timer->expiry - t->current;
+    unsigned level = 0;
+    unsigned slot;
+
+    /* The timer's slot on the selected level is always ahead of the current
+     * one, so it is reached before the timer expires */
+    while ((level < (UCS_TWHEEL_NUM_LEVELS - 1)) &&
+           (delta >= UCS_BIT((level + 1) * UCS_TWHEEL_LEVEL_BITS))) {
+        ++level;
+    }
+
+    slot = ucs_twheel_slot(timer->expiry, level);
+    ucs_list_add_tail(&t->levels[level].slots[slot], &timer->list);
+    t->levels[level].bitmap |= UCS_BIT(slot);
+}
+
 void __ucs_wtimer_add(ucs_twheel_t *t, ucs_wtimer_t *timer, ucs_time_t delta)
 {
-    uint64_t slot;
+    uint64_t ticks;
 
     timer->is_active = 1;
-    slot = delta>>t->res_order;
-    if (ucs_unlikely(slot == 0)) {
+    ticks = delta>>t->res_order;
+    if (ucs_unlikely(ticks == 0)) {
         /* nothing really wrong with adding timer to the current slot. However
          * we want to guard against the case we spend to much time in hi res
          * timer processing */
         ucs_fatal("Timer resolution is too low. Min resolution %lf usec, wanted %lf usec",
                 ucs_time_to_usec(t->res), ucs_time_to_usec(delta));
     }
-    ucs_assert(slot > 0);
+    ucs_assert(ticks > 0);
 
-    if (ucs_unlikely(slot >= t->num_slots)) {
-        slot = t->num_slots - 1;
+    if (ucs_unlikely(ticks > UCS_TWHEEL_MAX_TICKS)) {
+        ticks = UCS_TWHEEL_MAX_TICKS;
     }
 
-    slot = (t->current + slot) % t->num_slots;
-    ucs_assert(slot != t->current);
-
-    ucs_list_add_tail(&t->wheel[slot], &timer->list);
+    timer->expiry = t->current + ticks;
+    ucs_twheel_insert(t, timer);
     t->count++;
 }
 
-void __ucs_twheel_sweep(ucs_twheel_t *t, ucs_time_t current_time)
+/* Return the tick when the next non-empty slot of the level is reached */
+static uint64_t ucs_twheel_level_next(ucs_twheel_t *t, unsigned level)
+{
+    uint64_t bitmap = t->levels[level].bitmap;
+    unsigned shift  = level * UCS_TWHEEL_LEVEL_BITS;
+    uint64_t block  = t->current >> shift;
+    unsigned offset = (block + 1) & UCS_TWHEEL_LEVEL_MASK;
+    uint64_t rotated;
+
+    if (bitmap == 0) {
+        return UINT64_MAX;
+    }
+
+    /* Bit 0 of the rotated bitmap corresponds to the slot after the current */
+    rotated = (bitmap >> offset) |
+              (bitmap << ((UCS_TWHEEL_LEVEL_SLOTS - offset) &
+                          UCS_TWHEEL_LEVEL_MASK));
+    return (block + 1 + ucs_ffs64(rotated)) << shift;
+}
+
+static uint64_t ucs_twheel_next_tick(ucs_twheel_t *t)
+{
+    uint64_t next_tick = UINT64_MAX;
+    unsigned level;
+
+    for (level = 0; level < UCS_TWHEEL_NUM_LEVELS; ++level) {
+        next_tick = ucs_min(next_tick, ucs_twheel_level_next(t, level));
+    }
+
+    return next_tick;
+}
+
+/* Move the timers of the current slot on the level to lower levels */
+static void ucs_twheel_cascade(ucs_twheel_t *t, unsigned level)
 {
+    unsigned slot = ucs_twheel_slot(t->current, level);
+    ucs_list_link_t timers;
     ucs_wtimer_t *timer;
-    uint64_t slot;
 
-    slot   = (current_time - t->now) >> t->res_order;
+    ucs_list_head_init(&timers);
+    ucs_list_splice_tail(&timers, &t->levels[level].slots[slot]);
+    ucs_list_head_init(&t->levels[level].slots[slot]);
+    t->levels[level].bitmap &= ~UCS_BIT(slot);
+
+    while (!ucs_list_is_empty(&timers)) {
+        timer = ucs_list_extract_head(&timers, ucs_wtimer_t, list);
+        ucs_twheel_insert(t, timer);
+    }
+}
+
+static void ucs_twheel_dispatch(ucs_twheel_t *t)
+{
+    unsigned slot           = ucs_twheel_slot(t->current, 0);
+    ucs_list_link_t *timers = &t->levels[0].slots[slot];
+    ucs_wtimer_t *timer;
+    unsigned level;
+
+    if (slot == 0) {
+        /* Starting a new round of the lowest level, cascade all levels which
+         * start a new round as well, from the highest one */
+        for (level = 1; (level < (UCS_TWHEEL_NUM_LEVELS - 1)) &&
+                        (ucs_twheel_slot(t->current, level) == 0); ++level);
+        for (; level > 0; --level) {
+            ucs_twheel_cascade(t, level);
+        }
+    }
+
+    /* Timers added by the callbacks are never scheduled to the current slot */
+    while (!ucs_list_is_empty(timers)) {
+        timer = ucs_list_extract_head(timers, ucs_wtimer_t, list);
+        ucs_assert(timer->expiry == t->current);
+        timer->is_active = 0;
+        timer->cb(timer);
+        t->count--;
+    }
+
+    t->levels[0].bitmap &= ~UCS_BIT(slot);
+}
+
+void __ucs_twheel_sweep(ucs_twheel_t *t, ucs_time_t current_time)
+{
+    uint64_t target;
+
+    target = t->current + ((current_time - t->now) >> t->res_order);
     t->now = current_time;
 
-    if (ucs_unlikely(slot >= t->num_slots)) {
-        slot = t->num_slots - 1;
+    /* Skip the slots without timers */
+    while (t->current < target) {
+        t->current = ucs_min(ucs_twheel_next_tick(t), target);
+        ucs_twheel_dispatch(t);
     }
+}
 
-    slot = (t->current + slot) % t->num_slots;
+ucs_time_t ucs_twheel_get_next_expiry(ucs_twheel_t *t)
+{
+    uint64_t next_tick;
 
-    for (; t->current != slot; t->current = (t->current+1) % t->num_slots) {
-        while (!ucs_list_is_empty(&t->wheel[t->current])) {
-            timer = ucs_list_extract_head(&t->wheel[t->current], ucs_wtimer_t, list);
-            timer->is_active = 0;
-            timer->cb(timer);
-            t->count--;
-        }
+    if (t->count == 0) {
+        return UCS_TIME_INFINITY;
     }
+
+    next_tick = ucs_twheel_next_tick(t);
+    ucs_assert(next_tick > t->current);
+    return t->now + ((next_tick - t->current) << t->res_order);
 }
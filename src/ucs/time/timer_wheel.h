@@ -12,6 +12,18 @@
 #include <ucs/debug/log.h>
 
 
+/* Number of slots in each level of the timer wheel is 2^UCS_TWHEEL_LEVEL_BITS */
+#define UCS_TWHEEL_LEVEL_BITS   6
+#define UCS_TWHEEL_LEVEL_SLOTS  UCS_BIT(UCS_TWHEEL_LEVEL_BITS)
+#define UCS_TWHEEL_LEVEL_MASK   (UCS_TWHEEL_LEVEL_SLOTS - 1)
+
+
+/* Number of levels. A timer which expires within UCS_TWHEEL_LEVEL_SLOTS^(n+1)
+ * ticks is kept on level n, and moved to a lower level when its slot is
+ * reached. */
+#define UCS_TWHEEL_NUM_LEVELS   4
+
+
 /* Forward declarations */
 typedef struct ucs_wtimer       ucs_wtimer_t;
 typedef struct ucs_timer_wheel  ucs_twheel_t;
@@ -29,17 +41,27 @@ typedef void (*ucs_twheel_callback_t)(ucs_wtimer_t *self);
 struct ucs_wtimer {
     ucs_twheel_callback_t  cb;         /* User callback */
     ucs_list_link_t        list;       /* Link in the list of timers */
+    uint64_t               expiry;     /* Expiration tick */
     int                    is_active;
 };
 
 
+/**
+ * Timer wheel level.
+ */
+typedef struct ucs_twheel_level {
+    uint64_t               bitmap;     /* Slots which may contain timers */
+    ucs_list_link_t        slots[UCS_TWHEEL_LEVEL_SLOTS];
+} ucs_twheel_level_t;
+
+
 struct ucs_timer_wheel {
     ucs_time_t             res;
     ucs_time_t             now;        /* when wheel was last updated */
-    uint64_t               current;
-    ucs_list_link_t        *wheel;
+    uint64_t               current;    /* Current tick */
+    ucs_twheel_level_t     *levels;
     unsigned               res_order;
-    unsigned               num_slots;
+    unsigned               num_slots;  /* Number of slots in a level */
     unsigned               count;
 };
 
@@ -48,7 +70,8 @@ struct ucs_timer_wheel {
  * Initialize the timer queue.
  *
  * @param twheel        Timer queue to initialize.
- * @param resolution    Timer resolution. Timer wheel range is from now to now + UCS_TWHEEL_NSLOTS * res
+ * @param resolution    Timer resolution. Timer wheel range is from now to
+ *                      now + UCS_TWHEEL_LEVEL_SLOTS^UCS_TWHEEL_NUM_LEVELS * res
  * @param current_time  Current time to initialize the timer with.
  */
 ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
@@ -96,6 +119,18 @@ static inline ucs_time_t ucs_twheel_get_time(ucs_twheel_t *t)
     return t->now;
 }
 
+/**
+ * Get the earliest time when a timer may expire.
+ *
+ * @param twheel        Timer wheel to query.
+ *
+ * @return Time of the next call to @ref ucs_twheel_sweep which would either
+ *         dispatch a timer or move timers closer to their expiration, so the
+ *         caller can sleep until then instead of polling. Returns
+ *         UCS_TIME_INFINITY if the wheel is empty.
+ */
+ucs_time_t ucs_twheel_get_next_expiry(ucs_twheel_t *t);
+
 /**
  * Checks for an empty timer wheel
  */
@@ -702,6 +702,17 @@ typedef struct uct_ep_connect_to_ep_params {
 } uct_ep_connect_to_ep_params_t;
 
 
+/**
+ * @ingroup UCT_AM
+ * @brief Short active message entry passed to @ref uct_ep_am_short_batch.
+ */
+typedef struct uct_am_short_batch_entry {
+    uint64_t                      header;  /**< Message header */
+    const void                    *payload; /**< Message payload */
+    unsigned                      length;  /**< Payload length in bytes */
+} uct_am_short_batch_entry_t;
+
+
 /**
  * @ingroup UCT_MD
  * @brief Parameters for comparing remote keys using @ref uct_rkey_compare.
@@ -1133,6 +1144,34 @@ ucs_status_t
 uct_rkey_compare(uct_component_h component, uct_rkey_t rkey1, uct_rkey_t rkey2,
                  const uct_rkey_compare_params_t *params, int *result);
 
+/**
+ * @ingroup UCT_AM
+ * @brief Send a batch of short active messages to the same peer.
+ *
+ * Post up to @a count short active messages with the same active message id,
+ * as if @ref uct_ep_am_short was called for each entry in order. Transports
+ * which support it reserve and publish the send resources of the whole batch
+ * at once, which saves the per-message synchronization with the remote peer.
+ * Transports without native support fall back to posting the messages one by
+ * one.
+ *
+ * @param [in] ep       Destination endpoint handle.
+ * @param [in] id       Active message id. Must be in range
+ *                      0..UCT_AM_ID_MAX-1.
+ * @param [in] entries  Array of messages to send. The length of each entry
+ *                      plus the header size must not exceed
+ *                      @ref uct_iface_attr_t::cap::am::max_short.
+ * @param [in] count    Number of entries in @a entries.
+ *
+ * @return Number of messages posted, starting from the first entry. If it is
+ *         less than @a count, the remaining entries should be posted again
+ *         after progress. UCS_ERR_NO_RESOURCE if no message could be posted,
+ *         or other error code as defined by @ref ucs_status_t.
+ */
+ssize_t uct_ep_am_short_batch(uct_ep_h ep, uint8_t id,
+                              const uct_am_short_batch_entry_t *entries,
+                              size_t count);
+
 END_C_DECLS
 
 #endif
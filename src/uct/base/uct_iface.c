@@ -793,6 +793,38 @@ ucs_status_t uct_ep_invalidate(uct_ep_h ep, unsigned flags)
     return iface->internal_ops->ep_invalidate(ep, flags);
 }
 
+static ssize_t
+uct_base_ep_am_short_batch(uct_ep_h ep, uint8_t id,
+                           const uct_am_short_batch_entry_t *entries,
+                           size_t count)
+{
+    ucs_status_t status;
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        status = uct_ep_am_short(ep, id, entries[i].header, entries[i].payload,
+                                 entries[i].length);
+        if (status != UCS_OK) {
+            return (i > 0) ? i : status;
+        }
+    }
+
+    return count;
+}
+
+ssize_t uct_ep_am_short_batch(uct_ep_h ep, uint8_t id,
+                              const uct_am_short_batch_entry_t *entries,
+                              size_t count)
+{
+    const uct_base_iface_t *iface = ucs_derived_of(ep->iface, uct_base_iface_t);
+
+    if (iface->internal_ops->ep_am_short_batch == NULL) {
+        return uct_base_ep_am_short_batch(ep, id, entries, count);
+    }
+
+    return iface->internal_ops->ep_am_short_batch(ep, id, entries, count);
+}
+
 void uct_ep_set_iface(uct_ep_h ep, uct_iface_t *iface)
 {
     ep->iface = iface;
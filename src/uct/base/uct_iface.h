@@ -301,6 +301,12 @@ typedef int (*uct_ep_is_connected_func_t)(
         uct_ep_h ep, const uct_ep_is_connected_params_t *params);
 
 
+/* Send a batch of short active messages */
+typedef ssize_t (*uct_ep_am_short_batch_func_t)(
+        uct_ep_h ep, uint8_t id, const uct_am_short_batch_entry_t *entries,
+        size_t count);
+
+
 /* Internal operations, not exposed by the external API */
 typedef struct uct_iface_internal_ops {
     uct_iface_estimate_perf_func_t   iface_estimate_perf;
@@ -310,6 +316,7 @@ typedef struct uct_iface_internal_ops {
     uct_ep_connect_to_ep_v2_func_t   ep_connect_to_ep_v2;
     uct_iface_is_reachable_v2_func_t iface_is_reachable_v2;
     uct_ep_is_connected_func_t       ep_is_connected;
+    uct_ep_am_short_batch_func_t     ep_am_short_batch; /* optional */
 } uct_iface_internal_ops_t;
 
 
@@ -21,6 +21,25 @@ typedef struct uct_srd_hdr {
 } UCS_S_PACKED uct_srd_hdr_t;
 
 
+/*
+ * Receive descriptor, kept in the reordering window of the sender until all
+ * packets preceding it have arrived.
+ */
+typedef struct uct_srd_recv_desc {
+    uct_ib_iface_recv_desc_t super;
+    ucs_frag_list_elem_t     elem;    /* Element in the reordering window */
+    uint32_t                 length;  /* Received packet length */
+} uct_srd_recv_desc_t;
+
+
+/*
+ * Receive side state of a remote sender EP
+ */
+typedef struct uct_srd_rx_ctx {
+    ucs_frag_list_t          ooo_pkts; /* Reordering window */
+} uct_srd_rx_ctx_t;
+
+
 typedef struct uct_srd_am_short_hdr {
     uct_srd_hdr_t   srd_hdr;
     uint64_t        am_hdr;
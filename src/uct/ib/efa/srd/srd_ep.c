@@ -11,6 +11,8 @@
 #include "srd_ep.h"
 #include "srd_iface.h"
 
+#include <uct/ib/base/ib_log.h>
+
 
 static UCS_CLASS_INIT_FUNC(uct_srd_ep_t, const uct_ep_params_t *params)
 {
@@ -34,6 +36,8 @@ static UCS_CLASS_INIT_FUNC(uct_srd_ep_t, const uct_ep_params_t *params)
     self->path_index = UCT_EP_PARAMS_GET_PATH_INDEX(params);
     self->psn        = UCT_SRD_INITIAL_PSN;
     self->inflight   = 0;
+    ucs_list_head_init(&self->outstanding_list);
+    ucs_arbiter_group_init(&self->pending_group);
 
     uct_ib_iface_fill_ah_attr_from_addr(&iface->super, ib_addr,
                                         self->path_index, &ah_attr, &path_mtu);
@@ -56,33 +60,66 @@ static UCS_CLASS_INIT_FUNC(uct_srd_ep_t, const uct_ep_params_t *params)
     return UCS_OK;
 }
 
-void uct_srd_ep_send_op_completion(uct_srd_send_op_t *send_op)
+static void uct_srd_ep_flush_progress(uct_srd_ep_t *ep)
 {
-    if (send_op->ep != NULL) {
-        send_op->ep->inflight--;
+    uct_srd_send_op_t *send_op;
+
+    /* Flush requests which reached the head have no sends posted before them */
+    while (!ucs_list_is_empty(&ep->outstanding_list)) {
+        send_op = ucs_list_head(&ep->outstanding_list, uct_srd_send_op_t,
+                                list);
+        if (!(send_op->flags & UCT_SRD_SEND_OP_FLAG_FLUSH)) {
+            break;
+        }
+
+        ucs_list_del(&send_op->list);
+        uct_invoke_completion(send_op->user_comp, UCS_OK);
+        ucs_mpool_put(send_op);
     }
+}
+
+void uct_srd_ep_send_op_completion(uct_srd_send_op_t *send_op)
+{
+    uct_srd_ep_t *ep = send_op->ep;
 
     ucs_list_del(&send_op->list);
+    if (send_op->user_comp != NULL) {
+        uct_invoke_completion(send_op->user_comp, UCS_OK);
+    }
+
     ucs_mpool_put(send_op);
+
+    if (ep != NULL) {
+        ep->inflight--;
+        uct_srd_ep_flush_progress(ep);
+    }
 }
 
 static void uct_srd_ep_send_op_purge(uct_srd_ep_t *ep)
 {
     uct_srd_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_srd_iface_t);
-    uct_srd_send_op_t *send_op;
+    uct_srd_send_op_t *send_op, *tmp;
 
-    ucs_list_for_each(send_op, &iface->tx.outstanding_list, list) {
-        if (send_op->ep == ep) {
-            /*
-             * Make ep invalid, as ibv_poll_cq() will return this
-             * send_op after it has been released.
-             */
-            send_op->ep = NULL;
-            if (--ep->inflight == 0) {
-                break;
-            }
+    ucs_list_for_each_safe(send_op, tmp, &ep->outstanding_list, list) {
+        ucs_list_del(&send_op->list);
+        if (send_op->user_comp != NULL) {
+            uct_invoke_completion(send_op->user_comp, UCS_ERR_CANCELED);
+            send_op->user_comp = NULL;
         }
+
+        if (send_op->flags & UCT_SRD_SEND_OP_FLAG_FLUSH) {
+            ucs_mpool_put(send_op);
+            continue;
+        }
+
+        /*
+         * Make ep invalid, as ibv_poll_cq() will return this
+         * send_op after it has been released.
+         */
+        send_op->ep = NULL;
+        ucs_list_add_tail(&iface->tx.outstanding_list, &send_op->list);
+        ep->inflight--;
     }
 }
 
@@ -90,18 +127,28 @@ static UCS_CLASS_CLEANUP_FUNC(uct_srd_ep_t)
 {
     ucs_trace_func("");
 
-    if (self->inflight != 0) {
-        uct_srd_ep_send_op_purge(self);
-        ucs_assertv(self->inflight == 0,
-                    "ep=%p failed to complete %u send operations",
-                    self, self->inflight);
-    }
+    uct_srd_ep_pending_purge(&self->super.super, NULL, NULL);
+    ucs_arbiter_group_cleanup(&self->pending_group);
+
+    uct_srd_ep_send_op_purge(self);
+    ucs_assertv(self->inflight == 0,
+                "ep=%p failed to complete %u send operations",
+                self, self->inflight);
 }
 
 UCS_CLASS_DEFINE(uct_srd_ep_t, uct_base_ep_t);
 UCS_CLASS_DEFINE_NEW_FUNC(uct_srd_ep_t, uct_ep_t, const uct_ep_params_t*);
 UCS_CLASS_DEFINE_DELETE_FUNC(uct_srd_ep_t, uct_ep_t);
 
+static UCS_F_ALWAYS_INLINE void
+uct_srd_ep_send_op_start(uct_srd_iface_t *iface, uct_srd_ep_t *ep,
+                         uct_srd_send_op_t *send_op)
+{
+    ucs_list_add_tail(&ep->outstanding_list, &send_op->list);
+    iface->tx.available--;
+    ep->inflight++;
+}
+
 static UCS_F_ALWAYS_INLINE
 void uct_srd_post_send(uct_srd_iface_t *iface, uct_srd_ep_t *ep,
                        struct ibv_send_wr *wr, unsigned send_flags,
@@ -114,15 +161,26 @@ void uct_srd_post_send(uct_srd_iface_t *iface, uct_srd_ep_t *ep,
     wr->wr.ud.ah         = ep->ah;
     wr->send_flags       = send_flags;
 
+    uct_ib_log_post_send(&iface->super, iface->qp, wr, max_log_sge,
+                         uct_srd_dump_packet);
+
     ret = ibv_post_send(iface->qp, wr, &bad_wr);
     if (ucs_unlikely(ret != 0)) {
         ucs_fatal("ibv_post_send(iface=%p) returned %d (%m)", iface, ret);
     }
 
-    iface->tx.available--;
+    uct_srd_ep_send_op_start(iface, ep, (uct_srd_send_op_t*)wr->wr_id);
     ep->psn++;
 }
 
+static UCS_F_ALWAYS_INLINE void
+uct_srd_ep_send_op_init(uct_srd_ep_t *ep, uct_srd_send_op_t *send_op)
+{
+    send_op->ep        = ep;
+    send_op->user_comp = NULL;
+    send_op->flags     = 0;
+}
+
 static UCS_F_ALWAYS_INLINE uct_srd_send_op_t *
 uct_srd_ep_get_send_op(uct_srd_iface_t *iface, uct_srd_ep_t *ep)
 {
@@ -135,10 +193,26 @@ uct_srd_ep_get_send_op(uct_srd_iface_t *iface, uct_srd_ep_t *ep)
         return NULL;
     }
 
-    send_op->ep = ep;
+    uct_srd_ep_send_op_init(ep, send_op);
     return send_op;
 }
 
+static UCS_F_ALWAYS_INLINE uct_srd_send_desc_t *
+uct_srd_ep_get_send_desc(uct_srd_iface_t *iface, uct_srd_ep_t *ep)
+{
+    uct_srd_send_desc_t *desc = uct_srd_iface_get_send_desc(iface);
+
+    if (ucs_unlikely(desc == NULL)) {
+        ucs_trace_poll("iface=%p ep=%p has no send_desc resource (psn=%u)",
+                       iface, ep, ep->psn);
+        UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+        return NULL;
+    }
+
+    uct_srd_ep_send_op_init(ep, &desc->super);
+    return desc;
+}
+
 static UCS_F_ALWAYS_INLINE void
 uct_srd_hdr_set(const uct_srd_ep_t *ep, uct_srd_hdr_t *neth, uint8_t id)
 {
@@ -174,9 +248,237 @@ ucs_status_t uct_srd_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t hdr,
     iface->tx.wr_inl.wr_id   = (uintptr_t)send_op;
 
     uct_srd_post_send(iface, ep, &iface->tx.wr_inl, IBV_SEND_INLINE, 2);
-    ucs_list_add_tail(&iface->tx.outstanding_list, &send_op->list);
-    ep->inflight++;
 
     UCT_TL_EP_STAT_OP(&ep->super, AM, SHORT, sizeof(am->am_hdr) + length);
     return UCS_OK;
 }
+
+ssize_t uct_srd_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id,
+                            uct_pack_callback_t pack_cb, void *arg,
+                            unsigned flags)
+{
+    uct_srd_ep_t *ep       = ucs_derived_of(tl_ep, uct_srd_ep_t);
+    uct_srd_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_srd_iface_t);
+    uct_srd_send_desc_t *desc;
+    uct_srd_hdr_t *neth;
+    size_t length;
+
+    UCT_CHECK_AM_ID(id);
+
+    desc = uct_srd_ep_get_send_desc(iface, ep);
+    if (desc == NULL) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    neth   = (uct_srd_hdr_t*)(desc + 1);
+    length = pack_cb(neth + 1, arg);
+    ucs_assertv((sizeof(*neth) + length) <= iface->super.config.seg_size,
+                "length=%zu seg_size=%u", length,
+                iface->super.config.seg_size);
+
+    uct_srd_hdr_set(ep, neth, id);
+
+    iface->tx.sge[0].addr     = (uintptr_t)neth;
+    iface->tx.sge[0].length   = sizeof(*neth) + length;
+    iface->tx.sge[0].lkey     = desc->lkey;
+    iface->tx.wr_desc.num_sge = 1;
+    iface->tx.wr_desc.wr_id   = (uintptr_t)desc;
+
+    uct_srd_post_send(iface, ep, &iface->tx.wr_desc, 0, 1);
+
+    UCT_TL_EP_STAT_OP(&ep->super, AM, BCOPY, length);
+    return length;
+}
+
+ucs_status_t uct_srd_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                 unsigned header_length, const uct_iov_t *iov,
+                                 size_t iovcnt, unsigned flags,
+                                 uct_completion_t *comp)
+{
+    uct_srd_ep_t *ep       = ucs_derived_of(tl_ep, uct_srd_ep_t);
+    uct_srd_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_srd_iface_t);
+    uct_srd_send_desc_t *desc;
+    uct_srd_hdr_t *neth;
+    size_t num_sge;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, iface->config.max_send_sge - 1,
+                       "uct_srd_ep_am_zcopy");
+    UCT_SRD_CHECK_AM_ZCOPY(iface, id, header_length,
+                           uct_iov_total_length(iov, iovcnt));
+
+    desc = uct_srd_ep_get_send_desc(iface, ep);
+    if (desc == NULL) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    neth = (uct_srd_hdr_t*)(desc + 1);
+    uct_srd_hdr_set(ep, neth, id);
+    memcpy(neth + 1, header, header_length);
+    desc->super.user_comp = comp;
+
+    iface->tx.sge[0].addr     = (uintptr_t)neth;
+    iface->tx.sge[0].length   = sizeof(*neth) + header_length;
+    iface->tx.sge[0].lkey     = desc->lkey;
+    num_sge                   = uct_ib_verbs_sge_fill_iov(&iface->tx.sge[1],
+                                                          iov, iovcnt);
+    iface->tx.wr_desc.num_sge = num_sge + 1;
+    iface->tx.wr_desc.wr_id   = (uintptr_t)desc;
+
+    uct_srd_post_send(iface, ep, &iface->tx.wr_desc, 0, num_sge + 1);
+
+    UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY,
+                      header_length + uct_iov_total_length(iov, iovcnt));
+    return UCS_INPROGRESS;
+}
+
+ucs_status_t uct_srd_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+#if HAVE_DECL_EFADV_DEVICE_ATTR_CAPS_RDMA_READ
+    uct_srd_ep_t *ep       = ucs_derived_of(tl_ep, uct_srd_ep_t);
+    uct_srd_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_srd_iface_t);
+    size_t length          = uct_iov_total_length(iov, iovcnt);
+    struct ibv_sge sge[UCT_IB_MAX_IOV];
+    uct_srd_send_op_t *send_op;
+    size_t num_sge;
+    int ret;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, iface->config.max_send_sge,
+                       "uct_srd_ep_get_zcopy");
+    UCT_CHECK_LENGTH(length, iface->super.config.max_inl_cqe[UCT_IB_DIR_TX] + 1,
+                     iface->config.max_get_zcopy, "get_zcopy");
+
+    send_op = uct_srd_ep_get_send_op(iface, ep);
+    if (send_op == NULL) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    send_op->user_comp = comp;
+    num_sge            = uct_ib_verbs_sge_fill_iov(sge, iov, iovcnt);
+
+    ibv_wr_start(iface->qp_ex);
+    iface->qp_ex->wr_id    = (uintptr_t)send_op;
+    iface->qp_ex->wr_flags = IBV_SEND_SIGNALED;
+    ibv_wr_rdma_read(iface->qp_ex, uct_ib_md_direct_rkey(rkey), remote_addr);
+    ibv_wr_set_sge_list(iface->qp_ex, num_sge, sge);
+    ibv_wr_set_ud_addr(iface->qp_ex, ep->ah, ep->dest_qpn, UCT_IB_KEY);
+    ret = ibv_wr_complete(iface->qp_ex);
+    if (ucs_unlikely(ret != 0)) {
+        ucs_fatal("ibv_wr_complete(iface=%p) returned %d (%m)", iface, ret);
+    }
+
+    /* RDMA read is not seen by the remote receive path, do not consume PSN */
+    uct_srd_ep_send_op_start(iface, ep, send_op);
+
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, length);
+    return UCS_INPROGRESS;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+ucs_status_t uct_srd_ep_flush(uct_ep_h tl_ep, unsigned flags,
+                              uct_completion_t *comp)
+{
+    uct_srd_ep_t *ep       = ucs_derived_of(tl_ep, uct_srd_ep_t);
+    uct_srd_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_srd_iface_t);
+    uct_srd_send_op_t *send_op;
+
+    /* Posted sends cannot be canceled, so cancel is handled as local flush */
+    if (!ucs_arbiter_group_is_empty(&ep->pending_group)) {
+        UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    if (ep->inflight == 0) {
+        UCT_TL_EP_STAT_FLUSH(&ep->super);
+        return UCS_OK;
+    }
+
+    if (comp != NULL) {
+        send_op = ucs_mpool_get(&iface->tx.send_op_mp);
+        if (send_op == NULL) {
+            return UCS_ERR_NO_RESOURCE;
+        }
+
+        uct_srd_ep_send_op_init(ep, send_op);
+        send_op->user_comp = comp;
+        send_op->flags     = UCT_SRD_SEND_OP_FLAG_FLUSH;
+        ucs_list_add_tail(&ep->outstanding_list, &send_op->list);
+    }
+
+    UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+    return UCS_INPROGRESS;
+}
+
+ucs_status_t uct_srd_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
+                                    unsigned flags)
+{
+    uct_srd_ep_t *ep       = ucs_derived_of(tl_ep, uct_srd_ep_t);
+    uct_srd_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_srd_iface_t);
+
+    if (uct_srd_iface_can_tx(iface)) {
+        return UCS_ERR_BUSY;
+    }
+
+    UCS_STATIC_ASSERT(sizeof(uct_pending_req_priv_arb_t) <=
+                      UCT_PENDING_REQ_PRIV_LEN);
+    uct_pending_req_arb_group_push(&ep->pending_group, req);
+    ucs_arbiter_group_schedule(&iface->tx.pending_q, &ep->pending_group);
+    UCT_TL_EP_STAT_PEND(&ep->super);
+    return UCS_OK;
+}
+
+ucs_arbiter_cb_result_t
+uct_srd_ep_do_pending(ucs_arbiter_t *arbiter, ucs_arbiter_group_t *group,
+                      ucs_arbiter_elem_t *elem, void *arg)
+{
+    uct_pending_req_t *req = ucs_container_of(elem, uct_pending_req_t, priv);
+    uct_srd_ep_t *ep       = ucs_container_of(group, uct_srd_ep_t,
+                                              pending_group);
+    uct_srd_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_srd_iface_t);
+    ucs_status_t status;
+
+    status = req->func(req);
+    if (status == UCS_OK) {
+        return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
+    } else if (status == UCS_INPROGRESS) {
+        return UCS_ARBITER_CB_RESULT_NEXT_GROUP;
+    } else if (!uct_srd_iface_can_tx(iface)) {
+        return UCS_ARBITER_CB_RESULT_STOP;
+    }
+
+    return UCS_ARBITER_CB_RESULT_DESCHED_GROUP;
+}
+
+static ucs_arbiter_cb_result_t
+uct_srd_ep_pending_purge_cb(ucs_arbiter_t *arbiter, ucs_arbiter_group_t *group,
+                            ucs_arbiter_elem_t *elem, void *arg)
+{
+    uct_pending_req_t *req       = ucs_container_of(elem, uct_pending_req_t,
+                                                    priv);
+    uct_srd_ep_t *ep             = ucs_container_of(group, uct_srd_ep_t,
+                                                    pending_group);
+    uct_purge_cb_args_t *cb_args = arg;
+
+    if (cb_args->cb != NULL) {
+        cb_args->cb(req, cb_args->arg);
+    } else {
+        ucs_debug("ep=%p cancelling user pending request %p", ep, req);
+    }
+
+    return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
+}
+
+void uct_srd_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
+                              void *arg)
+{
+    uct_srd_ep_t *ep         = ucs_derived_of(tl_ep, uct_srd_ep_t);
+    uct_srd_iface_t *iface   = ucs_derived_of(tl_ep->iface, uct_srd_iface_t);
+    uct_purge_cb_args_t args = {cb, arg};
+
+    ucs_arbiter_group_purge(&iface->tx.pending_q, &ep->pending_group,
+                            uct_srd_ep_pending_purge_cb, &args);
+}
@@ -18,14 +18,22 @@
 typedef struct uct_srd_send_op      uct_srd_send_op_t;
 
 
+enum {
+    /* Flush request, completed when all preceding sends are completed */
+    UCT_SRD_SEND_OP_FLAG_FLUSH = UCS_BIT(0)
+};
+
+
 typedef struct uct_srd_ep {
-    uct_base_ep_t   super;
-    uint64_t        ep_uuid;          /* Random EP identifier */
-    uint32_t        dest_qpn;         /* Remote QP */
-    uint32_t        inflight;         /* Entries outstanding list */
-    struct ibv_ah   *ah;              /* Remote peer */
-    uct_srd_psn_t   psn;              /* Next PSN to send */
-    uint8_t         path_index;
+    uct_base_ep_t       super;
+    uint64_t            ep_uuid;          /* Random EP identifier */
+    uint32_t            dest_qpn;         /* Remote QP */
+    uint32_t            inflight;         /* Sends on outstanding list */
+    ucs_list_link_t     outstanding_list; /* Sends and flushes in post order */
+    ucs_arbiter_group_t pending_group;    /* Pending requests */
+    struct ibv_ah       *ah;              /* Remote peer */
+    uct_srd_psn_t       psn;              /* Next PSN to send */
+    uint8_t             path_index;
 } uct_srd_ep_t;
 
 
@@ -35,9 +43,20 @@ typedef struct uct_srd_ep {
 struct uct_srd_send_op {
     ucs_list_link_t                  list;         /* Link in ep outstanding send list */
     uct_srd_ep_t                     *ep;          /* Sender EP */
+    uct_completion_t                 *user_comp;   /* User completion, or NULL */
+    uint8_t                          flags;        /* UCT_SRD_SEND_OP_FLAG_xx */
 } UCS_V_ALIGNED(UCT_SRD_SEND_OP_ALIGN);
 
 
+/*
+ * Send descriptor with a registered buffer, followed by the packet.
+ */
+typedef struct uct_srd_send_desc {
+    uct_srd_send_op_t                super;
+    uint32_t                         lkey;         /* Packet buffer key */
+} uct_srd_send_desc_t;
+
+
 UCS_CLASS_DECLARE_NEW_FUNC(uct_srd_ep_t, uct_ep_t, const uct_ep_params_t*);
 UCS_CLASS_DECLARE_DELETE_FUNC(uct_srd_ep_t, uct_ep_t);
 
@@ -45,6 +64,32 @@ UCS_CLASS_DECLARE_DELETE_FUNC(uct_srd_ep_t, uct_ep_t);
 ucs_status_t uct_srd_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t hdr,
                                  const void *buffer, unsigned length);
 
+ssize_t uct_srd_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id,
+                            uct_pack_callback_t pack_cb, void *arg,
+                            unsigned flags);
+
+ucs_status_t uct_srd_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                 unsigned header_length, const uct_iov_t *iov,
+                                 size_t iovcnt, unsigned flags,
+                                 uct_completion_t *comp);
+
+ucs_status_t uct_srd_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
+ucs_status_t uct_srd_ep_flush(uct_ep_h tl_ep, unsigned flags,
+                              uct_completion_t *comp);
+
+ucs_status_t uct_srd_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
+                                    unsigned flags);
+
+void uct_srd_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
+                              void *arg);
+
+ucs_arbiter_cb_result_t
+uct_srd_ep_do_pending(ucs_arbiter_t *arbiter, ucs_arbiter_group_t *group,
+                      ucs_arbiter_elem_t *elem, void *arg);
+
 void uct_srd_ep_send_op_completion(uct_srd_send_op_t *send_op);
 
 
@@ -16,6 +16,55 @@
 
 static uct_iface_ops_t uct_srd_iface_tl_ops;
 
+void uct_srd_dump_packet(uct_base_iface_t *iface, uct_am_trace_type_t type,
+                         void *data, size_t length, size_t valid_length,
+                         char *buffer, size_t max)
+{
+    uct_srd_hdr_t *neth = data;
+    char *p, *endp;
+
+    p    = buffer;
+    endp = buffer + max;
+
+    snprintf(p, endp - p, " uuid 0x%"PRIx64" psn %u am %d ", neth->ep_uuid,
+             neth->psn, neth->id);
+    p += strlen(p);
+
+    uct_iface_dump_am(iface, type, neth->id, neth + 1, length - sizeof(*neth),
+                      p, endp - p);
+}
+
+static ucs_status_t
+uct_srd_iface_estimate_perf(uct_iface_h tl_iface, uct_perf_attr_t *perf_attr)
+{
+    uct_srd_iface_t *iface = ucs_derived_of(tl_iface, uct_srd_iface_t);
+    uct_ep_operation_t op  = UCT_ATTR_VALUE(PERF, perf_attr, operation,
+                                            OPERATION, UCT_EP_OP_LAST);
+    ucs_status_t status;
+
+    status = uct_ib_iface_estimate_perf(tl_iface, perf_attr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if ((perf_attr->field_mask & UCT_PERF_ATTR_FIELD_LATENCY) &&
+        (op == UCT_EP_OP_GET_ZCOPY)) {
+        /* RDMA read data returns to the initiator, after a full round trip */
+        perf_attr->latency.c *= 2;
+    }
+
+    if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_MAX_INFLIGHT_EPS) {
+        /* All endpoints share the send queue of the single SRD QP */
+        perf_attr->max_inflight_eps = iface->config.tx_qp_len;
+    }
+
+    if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_FLAGS) {
+        perf_attr->flags |= UCT_PERF_ATTR_FLAGS_TX_RX_SHARED;
+    }
+
+    return UCS_OK;
+}
+
 ucs_status_t
 uct_srd_iface_get_address(uct_iface_h tl_iface, uct_iface_addr_t *iface_addr)
 {
@@ -29,7 +78,7 @@ uct_srd_iface_get_address(uct_iface_h tl_iface, uct_iface_addr_t *iface_addr)
 
 static uct_ib_iface_ops_t uct_srd_iface_ops = {
     .super = {
-        .iface_estimate_perf   = uct_base_iface_estimate_perf,
+        .iface_estimate_perf   = uct_srd_iface_estimate_perf,
         .iface_vfs_refresh     = (uct_iface_vfs_refresh_func_t)
             ucs_empty_function,
         .ep_query              = (uct_ep_query_func_t)
@@ -52,7 +101,7 @@ uct_srd_iface_create_qp(uct_srd_iface_t *iface,
                         const uct_srd_iface_config_t *config,
                         struct efadv_device_attr *efa_attr)
 {
-#ifdef HAVE_DECL_EFA_DV_RDMA_READ
+#if HAVE_DECL_EFADV_DEVICE_ATTR_CAPS_RDMA_READ
     struct efadv_qp_init_attr efa_qp_init_attr = {0};
     struct ibv_qp_init_attr_ex qp_init_attr    = {0};
 #else
@@ -78,7 +127,7 @@ uct_srd_iface_create_qp(uct_srd_iface_t *iface,
     qp_init_attr.cap.max_inline_data = ucs_min(config->super.tx.min_inline,
                                                md->super.dev.max_inline_data);
 
-#ifdef HAVE_DECL_EFA_DV_RDMA_READ
+#if HAVE_DECL_EFADV_DEVICE_ATTR_CAPS_RDMA_READ
     qp_init_attr.pd             = pd;
     qp_init_attr.comp_mask      = IBV_QP_INIT_ATTR_PD |
                                   IBV_QP_INIT_ATTR_SEND_OPS_FLAGS;
@@ -109,10 +158,11 @@ uct_srd_iface_create_qp(uct_srd_iface_t *iface,
         return UCS_ERR_IO_ERROR;
     }
 
-    iface->config.max_inline = qp_init_attr.cap.max_inline_data;
-    iface->config.tx_qp_len  = qp_init_attr.cap.max_send_wr;
-    iface->tx.available      = qp_init_attr.cap.max_send_wr;
-    iface->rx.available      = qp_init_attr.cap.max_recv_wr;
+    iface->config.max_inline   = qp_init_attr.cap.max_inline_data;
+    iface->config.max_send_sge = qp_init_attr.cap.max_send_sge;
+    iface->config.tx_qp_len    = qp_init_attr.cap.max_send_wr;
+    iface->tx.available        = qp_init_attr.cap.max_send_wr;
+    iface->rx.available        = qp_init_attr.cap.max_recv_wr;
 
     ucs_debug("iface=%p: created SRD QP 0x%x on " UCT_IB_IFACE_FMT
               " TX wr:%d sge:%d inl:%d resp:%d RX wr:%d sge:%d resp:%d",
@@ -166,6 +216,34 @@ static ucs_mpool_ops_t uct_srd_send_op_mpool_ops = {
 };
 
 
+static void uct_srd_iface_send_desc_init(uct_iface_h tl_iface, void *obj,
+                                         uct_mem_h memh)
+{
+    uct_srd_send_desc_t *desc = obj;
+
+    desc->lkey = uct_ib_memh_get_lkey(memh);
+}
+
+static void uct_srd_iface_rx_desc_release(ucs_frag_list_elem_t *elem,
+                                          void *arg)
+{
+    ucs_mpool_put_inline(ucs_container_of(elem, uct_srd_recv_desc_t, elem));
+}
+
+static void uct_srd_iface_rx_ctx_cleanup(uct_srd_iface_t *iface)
+{
+    uct_srd_rx_ctx_t *ctx;
+
+    kh_foreach_value(&iface->rx.ctx_hash, ctx, {
+        ucs_frag_list_purge(&ctx->ooo_pkts, uct_srd_iface_rx_desc_release,
+                            NULL);
+        ucs_frag_list_cleanup(&ctx->ooo_pkts);
+        ucs_free(ctx);
+    });
+
+    kh_destroy_inplace(uct_srd_rx_ctx_hash, &iface->rx.ctx_hash);
+}
+
 static void uct_srd_iface_send_op_purge(uct_srd_iface_t *iface)
 {
     uct_srd_send_op_t *send_op;
@@ -217,6 +295,7 @@ static UCS_CLASS_INIT_FUNC(uct_srd_iface_t, uct_md_h md, uct_worker_h worker,
     uct_ib_iface_init_attr_t init_attr = {0};
     ucs_mpool_params_t mp_params;
     struct efadv_device_attr efa_attr;
+    unsigned rx_available;
     ucs_status_t status;
     int mtu, ret;
 
@@ -234,6 +313,8 @@ static UCS_CLASS_INIT_FUNC(uct_srd_iface_t, uct_md_h md, uct_worker_h worker,
 
     init_attr.cq_len[UCT_IB_DIR_TX] = config->super.tx.queue_len;
     init_attr.cq_len[UCT_IB_DIR_RX] = config->super.rx.queue_len;
+    init_attr.rx_priv_len           = sizeof(uct_srd_recv_desc_t) -
+                                      sizeof(uct_ib_iface_recv_desc_t);
     init_attr.rx_hdr_len            = sizeof(uct_srd_hdr_t);
     init_attr.seg_size              = ucs_min(mtu, config->super.seg_size);
     init_attr.qp_type               = IBV_QPT_DRIVER;
@@ -251,6 +332,7 @@ static UCS_CLASS_INIT_FUNC(uct_srd_iface_t, uct_md_h md, uct_worker_h worker,
 
     ucs_arbiter_init(&self->tx.pending_q);
     ucs_list_head_init(&self->tx.outstanding_list);
+    kh_init_inplace(uct_srd_rx_ctx_hash, &self->rx.ctx_hash);
 
     ucs_mpool_params_reset(&mp_params);
     mp_params.name            = "srd_send_op";
@@ -262,13 +344,24 @@ static UCS_CLASS_INIT_FUNC(uct_srd_iface_t, uct_md_h md, uct_worker_h worker,
 
     status = ucs_mpool_init(&mp_params, &self->tx.send_op_mp);
     if (status != UCS_OK) {
-        return status;
+        goto err_destroy_rx_ctx_hash;
+    }
+
+    status = uct_iface_mpool_init(&self->super.super, &self->tx.desc_mp,
+                                  sizeof(uct_srd_send_desc_t) +
+                                  self->super.config.seg_size,
+                                  sizeof(uct_srd_send_desc_t),
+                                  UCT_SRD_SEND_OP_ALIGN, &config->super.tx.mp,
+                                  config->super.tx.queue_len,
+                                  uct_srd_iface_send_desc_init, "srd_send_desc");
+    if (status != UCS_OK) {
+        goto err_cleanup_send_op_mp;
     }
 
     status = uct_ib_iface_recv_mpool_init(&self->super, &config->super, params,
                                           "srd_recv_desc", &self->rx.mp);
     if (status != UCS_OK) {
-        goto err_cleanup_send_op_mp;
+        goto err_cleanup_desc_mp;
     }
 
     status = uct_srd_iface_create_qp(self, config, &efa_attr);
@@ -279,18 +372,30 @@ static UCS_CLASS_INIT_FUNC(uct_srd_iface_t, uct_md_h md, uct_worker_h worker,
     uct_ud_send_wr_init(&self->tx.wr_inl, self->tx.sge, 1);
     uct_ud_send_wr_init(&self->tx.wr_desc, self->tx.sge, 0);
 
-    self->super.config.sl      = uct_ib_iface_config_select_sl(&config->super);
-    self->config.max_send_sge  = efa_attr.max_sq_sge;
-    self->config.max_get_zcopy = efa_attr.max_rdma_size;
+    self->super.config.sl = uct_ib_iface_config_select_sl(&config->super);
+    if (uct_ib_efadv_has_rdma_read(&efa_attr)) {
+        self->config.max_get_zcopy = ucs_min(config->tx.max_get_zcopy,
+                                             efa_attr.max_rdma_size);
+    } else {
+        self->config.max_get_zcopy = 0;
+    }
 
-    uct_srd_iface_post_recv(self);
+    /* Fill the receive queue, peers do not wait for receive credits */
+    do {
+        rx_available = self->rx.available;
+        uct_srd_iface_post_recv(self);
+    } while (self->rx.available != rx_available);
 
     return UCS_OK;
 
 err_cleanup_rx_mp:
     ucs_mpool_cleanup(&self->rx.mp, 1);
+err_cleanup_desc_mp:
+    ucs_mpool_cleanup(&self->tx.desc_mp, 1);
 err_cleanup_send_op_mp:
     ucs_mpool_cleanup(&self->tx.send_op_mp, 1);
+err_destroy_rx_ctx_hash:
+    kh_destroy_inplace(uct_srd_rx_ctx_hash, &self->rx.ctx_hash);
     return status;
 }
 
@@ -301,7 +406,9 @@ static UCS_CLASS_CLEANUP_FUNC(uct_srd_iface_t)
     uct_srd_iface_send_op_purge(self);
     ucs_arbiter_cleanup(&self->tx.pending_q);
     uct_ib_destroy_qp(self->qp);
+    uct_srd_iface_rx_ctx_cleanup(self);
     ucs_mpool_cleanup(&self->rx.mp, 0);
+    ucs_mpool_cleanup(&self->tx.desc_mp, 1);
     ucs_mpool_cleanup(&self->tx.send_op_mp, 1);
     ucs_assertv(ucs_list_is_empty(&self->tx.outstanding_list),
                 "iface=%p tx outstanding list is not empty", self);
@@ -323,6 +430,11 @@ ucs_config_field_t uct_srd_iface_config_table[] = {
     {"SRD_", "", NULL, ucs_offsetof(uct_srd_iface_config_t, ud_common),
      UCS_CONFIG_TYPE_TABLE(uct_ud_iface_common_config_table)},
 
+    {"MAX_GET_ZCOPY", "auto",
+     "Maximal size of get operation with zcopy protocol.",
+     ucs_offsetof(uct_srd_iface_config_t, tx.max_get_zcopy),
+     UCS_CONFIG_TYPE_MEMUNITS},
+
     {NULL}
 };
 
@@ -352,11 +464,182 @@ uct_srd_iface_poll_tx(uct_srd_iface_t *iface)
     return num_wcs;
 }
 
+static UCS_F_NOINLINE uct_srd_rx_ctx_t *
+uct_srd_iface_rx_ctx_add(uct_srd_iface_t *iface, uint64_t ep_uuid)
+{
+    uct_srd_rx_ctx_t *ctx;
+    ucs_status_t status;
+    khiter_t iter;
+    int ret;
+
+    ctx = ucs_malloc(sizeof(*ctx), "srd_rx_ctx");
+    if (ctx == NULL) {
+        ucs_error("iface=%p failed to allocate rx context", iface);
+        return NULL;
+    }
+
+    status = ucs_frag_list_init(UCT_SRD_INITIAL_PSN - 1, &ctx->ooo_pkts, -1
+                                UCS_STATS_ARG(iface->super.super.stats));
+    if (status != UCS_OK) {
+        goto err_free;
+    }
+
+    iter = kh_put(uct_srd_rx_ctx_hash, &iface->rx.ctx_hash, ep_uuid, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        ucs_error("iface=%p failed to add rx context", iface);
+        goto err_cleanup;
+    }
+
+    kh_value(&iface->rx.ctx_hash, iter) = ctx;
+    return ctx;
+
+err_cleanup:
+    ucs_frag_list_cleanup(&ctx->ooo_pkts);
+err_free:
+    ucs_free(ctx);
+    return NULL;
+}
+
+static UCS_F_ALWAYS_INLINE uct_srd_rx_ctx_t *
+uct_srd_iface_rx_ctx_get(uct_srd_iface_t *iface, uint64_t ep_uuid)
+{
+    khiter_t iter;
+
+    iter = kh_get(uct_srd_rx_ctx_hash, &iface->rx.ctx_hash, ep_uuid);
+    if (ucs_likely(iter != kh_end(&iface->rx.ctx_hash))) {
+        return kh_value(&iface->rx.ctx_hash, iter);
+    }
+
+    return uct_srd_iface_rx_ctx_add(iface, ep_uuid);
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_srd_iface_rx_am(uct_srd_iface_t *iface, uct_srd_recv_desc_t *desc,
+                    unsigned length)
+{
+    uct_srd_hdr_t *neth = uct_ib_iface_recv_desc_hdr(&iface->super,
+                                                     &desc->super);
+
+    uct_ib_iface_invoke_am_desc(&iface->super, neth->id, neth + 1,
+                                length - sizeof(*neth), &desc->super);
+}
+
+static void
+uct_srd_iface_rx_pull(uct_srd_iface_t *iface, uct_srd_rx_ctx_t *ctx)
+{
+    ucs_frag_list_elem_t *elem;
+    uct_srd_recv_desc_t *desc;
+
+    while ((elem = ucs_frag_list_pull(&ctx->ooo_pkts)) != NULL) {
+        desc = ucs_container_of(elem, uct_srd_recv_desc_t, elem);
+        uct_srd_iface_rx_am(iface, desc, desc->length);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_srd_iface_process_rx(uct_srd_iface_t *iface, uct_srd_hdr_t *neth,
+                         unsigned length, uct_srd_recv_desc_t *desc)
+{
+    uct_srd_rx_ctx_t *ctx;
+    ucs_frag_list_ooo_type_t ooo_type;
+
+    ctx = uct_srd_iface_rx_ctx_get(iface, neth->ep_uuid);
+    if (ucs_unlikely(ctx == NULL)) {
+        goto out_release;
+    }
+
+    ooo_type = ucs_frag_list_insert(&ctx->ooo_pkts, &desc->elem, neth->psn);
+    switch (ooo_type) {
+    case UCS_FRAG_LIST_INSERT_FAST:
+        uct_srd_iface_rx_am(iface, desc, length);
+        return;
+    case UCS_FRAG_LIST_INSERT_FIRST:
+        /* The packet filled the first hole, deliver it and the ones after */
+        uct_srd_iface_rx_am(iface, desc, length);
+        uct_srd_iface_rx_pull(iface, ctx);
+        return;
+    case UCS_FRAG_LIST_INSERT_READY:
+        desc->length = length;
+        uct_srd_iface_rx_pull(iface, ctx);
+        return;
+    case UCS_FRAG_LIST_INSERT_SLOW:
+        /* Arrived ahead of a preceding packet, keep it in the window */
+        desc->length = length;
+        return;
+    default:
+        ucs_trace_data("iface=%p drop packet uuid=0x%"PRIx64" psn=%u "
+                       "head_sn=%u ooo_type=%d", iface, neth->ep_uuid,
+                       neth->psn, ucs_frag_list_sn(&ctx->ooo_pkts), ooo_type);
+        break;
+    }
+
+out_release:
+    ucs_mpool_put_inline(desc);
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_srd_iface_poll_rx(uct_srd_iface_t *iface)
+{
+    unsigned num_wcs = iface->super.config.rx_max_poll;
+    struct ibv_wc wc[num_wcs];
+    ucs_status_t status;
+    uct_srd_hdr_t *neth;
+    int i;
+
+    status = uct_ib_poll_cq(iface->super.cq[UCT_IB_DIR_RX], &num_wcs, wc);
+    if (status != UCS_OK) {
+        num_wcs = 0;
+        goto out;
+    }
+
+    UCS_STATS_UPDATE_COUNTER(iface->super.stats,
+                             UCT_IB_IFACE_STAT_RX_COMPLETION, num_wcs);
+
+    UCT_IB_IFACE_VERBS_FOREACH_RXWQE(&iface->super, i, neth, wc, num_wcs) {
+        uct_ib_log_recv_completion(&iface->super, &wc[i], neth,
+                                   wc[i].byte_len, uct_srd_dump_packet);
+        uct_srd_iface_process_rx(iface, neth, wc[i].byte_len,
+                                 (uct_srd_recv_desc_t*)wc[i].wr_id);
+    }
+
+    iface->rx.available += num_wcs;
+out:
+    uct_srd_iface_post_recv(iface);
+    return num_wcs;
+}
+
 static unsigned uct_srd_iface_progress(uct_iface_h tl_iface)
 {
     uct_srd_iface_t *iface = ucs_derived_of(tl_iface, uct_srd_iface_t);
+    unsigned count;
+
+    count  = uct_srd_iface_poll_rx(iface);
+    count += uct_srd_iface_poll_tx(iface);
+
+    if (uct_srd_iface_can_tx(iface)) {
+        ucs_arbiter_dispatch(&iface->tx.pending_q, 1, uct_srd_ep_do_pending,
+                             NULL);
+    }
+
+    return count;
+}
+
+static ucs_status_t uct_srd_iface_flush(uct_iface_h tl_iface, unsigned flags,
+                                        uct_completion_t *comp)
+{
+    uct_srd_iface_t *iface = ucs_derived_of(tl_iface, uct_srd_iface_t);
+
+    if (comp != NULL) {
+        return UCS_ERR_UNSUPPORTED;
+    }
 
-    return uct_srd_iface_poll_tx(iface);
+    if (iface->tx.available < (int32_t)iface->config.tx_qp_len) {
+        UCT_TL_IFACE_STAT_FLUSH_WAIT(&iface->super.super);
+        return UCS_INPROGRESS;
+    }
+
+    UCT_TL_IFACE_STAT_FLUSH(&iface->super.super);
+    return UCS_OK;
 }
 
 ucs_status_t
@@ -378,11 +661,16 @@ uct_srd_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *iface_attr)
     iface_attr->cap.am.opt_zcopy_align  = UCS_SYS_PCI_MAX_PAYLOAD;
     iface_attr->cap.get.opt_zcopy_align = UCS_SYS_PCI_MAX_PAYLOAD;
 
-    iface_attr->cap.flags = UCT_IFACE_FLAG_AM_BCOPY | UCT_IFACE_FLAG_AM_ZCOPY |
+    iface_attr->cap.flags = UCT_IFACE_FLAG_AM_SHORT | UCT_IFACE_FLAG_AM_BCOPY |
+                            UCT_IFACE_FLAG_AM_ZCOPY |
                             UCT_IFACE_FLAG_CONNECT_TO_IFACE |
                             UCT_IFACE_FLAG_PENDING | UCT_IFACE_FLAG_EP_CHECK |
                             UCT_IFACE_FLAG_CB_SYNC |
                             UCT_IFACE_FLAG_ERRHANDLE_PEER_FAILURE;
+    if (iface->config.max_get_zcopy != 0) {
+        iface_attr->cap.flags |= UCT_IFACE_FLAG_GET_ZCOPY;
+    }
+
     iface_attr->iface_addr_len = sizeof(uct_srd_iface_addr_t);
     iface_attr->ep_addr_len    = 0;
     iface_attr->max_conn_priv  = 0;
@@ -437,8 +725,7 @@ uct_srd_query_tl_devices(uct_md_h md, uct_tl_device_resource_t **tl_devices_p,
 }
 
 static uct_iface_ops_t uct_srd_iface_tl_ops = {
-    .ep_flush                 = (uct_ep_flush_func_t)
-        ucs_empty_function_return_unsupported,
+    .ep_flush                 = uct_srd_ep_flush,
     .ep_fence                 = (uct_ep_fence_func_t)
         ucs_empty_function_return_unsupported,
     .ep_create                = UCS_CLASS_NEW_FUNC_NAME(uct_srd_ep_t),
@@ -447,20 +734,15 @@ static uct_iface_ops_t uct_srd_iface_tl_ops = {
     .ep_connect_to_ep         = (uct_ep_connect_to_ep_func_t)
         ucs_empty_function_return_unsupported,
     .ep_destroy               = UCS_CLASS_DELETE_FUNC_NAME(uct_srd_ep_t),
-    .ep_am_bcopy              = (uct_ep_am_bcopy_func_t)
-        ucs_empty_function_return_unsupported,
-    .ep_am_zcopy              = (uct_ep_am_zcopy_func_t)
-        ucs_empty_function_return_unsupported,
-    .ep_get_zcopy             = (uct_ep_get_zcopy_func_t)
-        ucs_empty_function_return_unsupported,
+    .ep_am_bcopy              = uct_srd_ep_am_bcopy,
+    .ep_am_zcopy              = uct_srd_ep_am_zcopy,
+    .ep_get_zcopy             = uct_srd_ep_get_zcopy,
     .ep_am_short              = uct_srd_ep_am_short,
     .ep_am_short_iov          = (uct_ep_am_short_iov_func_t)
         ucs_empty_function_return_unsupported,
-    .ep_pending_add           = (uct_ep_pending_add_func_t)
-        ucs_empty_function_return_unsupported,
-    .ep_pending_purge         = (uct_ep_pending_purge_func_t)
-        ucs_empty_function_return_unsupported,
-    .iface_flush              = uct_base_iface_flush,
+    .ep_pending_add           = uct_srd_ep_pending_add,
+    .ep_pending_purge         = uct_srd_ep_pending_purge,
+    .iface_flush              = uct_srd_iface_flush,
     .iface_fence              = (uct_iface_fence_func_t)
         ucs_empty_function_return_unsupported,
     .iface_progress_enable    = uct_base_iface_progress_enable,
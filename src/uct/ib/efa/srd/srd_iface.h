@@ -12,11 +12,15 @@
 
 #include <uct/ib/ud/base/ud_iface_common.h>
 
+#include <ucs/datastruct/khash.h>
 #include <ucs/datastruct/ptr_array.h>
 
 BEGIN_C_DECLS
 
 
+KHASH_MAP_INIT_INT64(uct_srd_rx_ctx_hash, uct_srd_rx_ctx_t*);
+
+
 typedef struct uct_srd_iface_config {
     uct_ib_iface_config_t        super;
     uct_ud_iface_common_config_t ud_common;
@@ -30,13 +34,15 @@ typedef struct uct_srd_iface_config {
 typedef struct uct_srd_iface {
     uct_ib_iface_t             super;
     struct ibv_qp              *qp;
-#ifdef HAVE_DECL_EFA_DV_RDMA_READ
+#if HAVE_DECL_EFADV_DEVICE_ATTR_CAPS_RDMA_READ
     struct ibv_qp_ex           *qp_ex;
 #endif
 
     struct {
         unsigned               available;
         ucs_mpool_t            mp;
+        /* Reordering state of every sender EP, by its uuid */
+        khash_t(uct_srd_rx_ctx_hash) ctx_hash;
     } rx;
 
     struct {
@@ -46,6 +52,7 @@ typedef struct uct_srd_iface {
         struct ibv_send_wr     wr_inl;
         struct ibv_send_wr     wr_desc;
         ucs_mpool_t            send_op_mp;
+        ucs_mpool_t            desc_mp;
         uct_srd_am_short_hdr_t am_inl_hdr;
         ucs_list_link_t        outstanding_list;
     } tx;
@@ -80,6 +87,16 @@ typedef struct uct_srd_iface {
     UCT_SRD_CHECK_AM_LEN(_iface, _id, (_hdr_len) + (_data_len), \
                          (_iface)->config.max_inline, "am_short");
 
+#define UCT_SRD_CHECK_AM_ZCOPY(_iface, _id, _hdr_len, _data_len) \
+    UCT_CHECK_AM_ID(_id); \
+    UCT_SRD_CHECK_AM_LEN(_iface, _id, (_hdr_len) + (_data_len), \
+                         (_iface)->super.config.seg_size, "am_zcopy");
+
+
+void uct_srd_dump_packet(uct_base_iface_t *iface, uct_am_trace_type_t type,
+                         void *data, size_t length, size_t valid_length,
+                         char *buffer, size_t max);
+
 
 static UCS_F_ALWAYS_INLINE int
 uct_srd_iface_can_tx(const uct_srd_iface_t *iface)
@@ -107,6 +124,25 @@ uct_srd_iface_get_send_op(uct_srd_iface_t *iface)
 }
 
 
+static UCS_F_ALWAYS_INLINE uct_srd_send_desc_t *
+uct_srd_iface_get_send_desc(uct_srd_iface_t *iface)
+{
+    uct_srd_send_desc_t *desc;
+
+    if (ucs_unlikely(!uct_srd_iface_can_tx(iface))) {
+        return NULL;
+    }
+
+    desc = ucs_mpool_get(&iface->tx.desc_mp);
+    if (ucs_unlikely(desc == NULL)) {
+        ucs_trace_data("iface=%p out of tx descs", iface);
+        UCT_TL_IFACE_STAT_TX_NO_DESC(&iface->super.super);
+    }
+
+    return desc;
+}
+
+
 END_C_DECLS
 
 #endif
@@ -22,7 +22,7 @@
 /* congestion avoidance settings. See ud_ep.h for details */
 #define UCT_UD_CA_AI_VALUE      1   /* window += AI_VALUE */
 #define UCT_UD_CA_MD_FACTOR     2   /* window = window/factor */
-#define UCT_UD_CA_DUP_ACK_CNT   2   /* TODO: not implemented yet */
+#define UCT_UD_CA_DUP_ACK_CNT   2   /* SACKed packets above a hole to resend it */
 #define UCT_UD_RESENDS_PER_ACK  4   /* request per every N resends */
 #define UCT_UD_SKB_ALIGN        UCS_SYS_CACHE_LINE_SIZE
 #define UCT_UD_SKIP_SWEEP       8
@@ -57,6 +57,7 @@ enum {
     UCT_UD_PACKET_FLAG_NACK    = UCS_BIT(27),
     UCT_UD_PACKET_FLAG_PUT     = UCS_BIT(28),
     UCT_UD_PACKET_FLAG_CTL     = UCS_BIT(29),
+    UCT_UD_PACKET_FLAG_SACK    = UCS_BIT(30),
 
     UCT_UD_PACKET_DEST_ID_MASK = UCS_MASK(UCT_UD_PACKET_DEST_ID_SHIFT)
 };
@@ -74,6 +75,7 @@ E - explicit congestion notification (ecn)
 N - negative acknowledgement
 P - put emulation (will be disabled in the future)
 C - control packet extended header
+S - selective acknowledgement, uct_ud_sack_t follows the header
 
 Active message packet header
 
@@ -87,10 +89,10 @@ Active message packet header
 
 Control packet header
 
- 3   2 2 2 2 2 2 2             1 1
- 1   9 8 7 6 5 4 3             6 5                             0
+ 3 3 2 2 2 2 2 2 2             1 1
+ 1 0 9 8 7 6 5 4 3             6 5                             0
 +---------------------------------------------------------------+
-|rsv|C|P|N|E|A|0|            dest_ep_id (24 bit)                |
+|r|S|C|P|N|E|A|0|            dest_ep_id (24 bit)                |
 +---------------------------------------------------------------+
 |       ack_psn (16 bit)        |           psn (16 bit)        |
 +---------------------------------------------------------------+
@@ -105,7 +107,8 @@ Control packet header
             uint8_t nack:1;
             uint8_t put:1;
             uint8_t ctl:1;
-            uint8_t reserved:2;
+            uint8_t sack:1;
+            uint8_t reserved:1;
         } ctl;
         struct { // am true
             uint8_t ack_req:1;
@@ -125,11 +128,25 @@ typedef struct uct_ud_neth {
 #define UCT_UD_RX_HDR_LEN (UCT_IB_GRH_LEN + sizeof(uct_ud_neth_t))
 
 
+/*
+ * Selective acknowledgement, carried by ACK/NACK packets when the receiver
+ * holds out-of-order packets. ack_psn + 1 is always missing, so bit i of the
+ * mask stands for psn ack_psn + 2 + i.
+ */
+typedef struct uct_ud_sack {
+    uint64_t            mask;
+} UCS_S_PACKED uct_ud_sack_t;
+
+#define UCT_UD_SACK_PSN_OFFSET 2
+#define UCT_UD_SACK_MAX_PSNS   (sizeof(uint64_t) * 8)
+
+
 enum {
     UCT_UD_SEND_SKB_FLAG_ACK_REQ    = UCS_BIT(0), /* ACK was requested for this skb */
     UCT_UD_SEND_SKB_FLAG_COMP       = UCS_BIT(1), /* This skb contains a completion */
     UCT_UD_SEND_SKB_FLAG_ZCOPY      = UCS_BIT(2), /* This skb contains a zero-copy segment */
     UCT_UD_SEND_SKB_FLAG_RESENDING  = UCS_BIT(3), /* An active control skb refers to this skb */
+    UCT_UD_SEND_SKB_FLAG_SACKED     = UCS_BIT(4), /* Remote side reported this skb in SACK */
 
 #if UCS_ENABLE_ASSERT
     UCT_UD_SEND_SKB_FLAG_CTL_ACK    = UCS_BIT(5), /* This is a control-ack skb */
@@ -201,6 +218,7 @@ typedef struct uct_ud_recv_skb {
     union {
         struct {
             ucs_frag_list_elem_t     elem;
+            uint32_t                 len;
         } ooo;
         struct {
             ucs_queue_elem_t         queue;
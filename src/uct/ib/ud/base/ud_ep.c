@@ -130,14 +130,27 @@ static void uct_ud_ep_reset(uct_ud_ep_t *ep)
     ep->resend.pos       = ucs_queue_iter_begin(&ep->tx.window);
     ep->resend.psn       = ep->tx.psn;
     ep->resend.max_psn   = ep->tx.acked_psn;
+    ep->resend.sack_psn  = ep->tx.acked_psn;
     ep->tx.resend_count  = 0;
     ep->rx_creq_count    = 0;
 
     ep->rx.acked_psn = UCT_UD_INITIAL_PSN - 1;
-    ucs_frag_list_init(ep->tx.psn-1, &ep->rx.ooo_pkts, 0 /*TODO: ooo support */
+    ucs_frag_list_init(ep->tx.psn-1, &ep->rx.ooo_pkts, -1
                        UCS_STATS_ARG(ep->super.stats));
 }
 
+static void uct_ud_ep_rx_skb_release(ucs_frag_list_elem_t *elem, void *arg)
+{
+    ucs_mpool_put(ucs_container_of(elem, uct_ud_recv_skb_t, u.ooo.elem));
+}
+
+static void uct_ud_ep_rx_cleanup(uct_ud_ep_t *ep)
+{
+    /* release packets which are held after a hole */
+    ucs_frag_list_purge(&ep->rx.ooo_pkts, uct_ud_ep_rx_skb_release, NULL);
+    ucs_frag_list_cleanup(&ep->rx.ooo_pkts);
+}
+
 static ucs_status_t uct_ud_ep_free_by_timeout(uct_ud_ep_t *ep,
                                               uct_ud_iface_t *iface)
 {
@@ -485,7 +498,7 @@ static UCS_CLASS_CLEANUP_FUNC(uct_ud_ep_t)
     ucs_wtimer_remove(&iface->tx.timer, &self->timer);
     uct_ud_iface_remove_ep(iface, self);
     uct_ud_iface_cep_remove_ep(iface, self);
-    ucs_frag_list_cleanup(&self->rx.ooo_pkts);
+    uct_ud_ep_rx_cleanup(self);
 
     ucs_arbiter_group_purge(&iface->tx.pending_q, &self->tx.pending.group,
                             uct_ud_ep_pending_cancel_cb, 0);
@@ -520,7 +533,7 @@ static ucs_status_t uct_ud_ep_connect_to_iface(uct_ud_ep_t *ep,
     uct_ib_device_t *dev  = uct_ib_iface_device(&iface->super);
     char buf[128];
 
-    ucs_frag_list_cleanup(&ep->rx.ooo_pkts);
+    uct_ud_ep_rx_cleanup(ep);
     uct_ud_ep_reset(ep);
 
     ucs_debug(UCT_IB_IFACE_FMT" lid %d qpn 0x%x epid %u ep %p connected to "
@@ -535,7 +548,7 @@ static ucs_status_t uct_ud_ep_connect_to_iface(uct_ud_ep_t *ep,
 
 static ucs_status_t uct_ud_ep_disconnect_from_iface(uct_ud_ep_t *ep)
 {
-    ucs_frag_list_cleanup(&ep->rx.ooo_pkts);
+    uct_ud_ep_rx_cleanup(ep);
     uct_ud_ep_reset(ep);
 
     ep->dest_ep_id = UCT_UD_EP_NULL_ID;
@@ -701,7 +714,7 @@ uct_ud_ep_connect_to_ep_v2(uct_ep_h tl_ep,
 
     uct_ud_ep_set_dest_ep_id(ep, uct_ib_unpack_uint24(ep_addr->ep_id));
 
-    ucs_frag_list_cleanup(&ep->rx.ooo_pkts);
+    uct_ud_ep_rx_cleanup(ep);
     uct_ud_ep_reset(ep);
 
     ucs_debug(UCT_IB_IFACE_FMT" slid %d qpn 0x%x epid %u connected to %s "
@@ -744,6 +757,90 @@ uct_ud_ep_process_ack(uct_ud_iface_t *iface, uct_ud_ep_t *ep,
     ep->tx.send_time = ucs_get_time();
 }
 
+static void uct_ud_ep_process_sack(uct_ud_iface_t *iface, uct_ud_ep_t *ep,
+                                   uct_ud_neth_t *neth)
+{
+    uint64_t mask          = ((uct_ud_sack_t*)(neth + 1))->mask;
+    uct_ud_psn_t base_psn  = neth->ack_psn + UCT_UD_SACK_PSN_OFFSET;
+    ucs_queue_iter_t iter  = ucs_queue_iter_begin(&ep->tx.window);
+    ucs_queue_iter_t pos   = NULL;
+    uct_ud_psn_t prev_psn  = ep->tx.acked_psn + 1;
+    uct_ud_psn_t lost_psn, psn_offset;
+    uct_ud_send_skb_t *skb;
+    unsigned i;
+
+    /* SACK of an older ack_psn describes holes which were already filled */
+    if ((neth->ack_psn != ep->tx.acked_psn) || (mask == 0)) {
+        return;
+    }
+
+    /* sack_psn is meaningful only inside the current tx window */
+    if ((uct_ud_psn_t)(ep->resend.sack_psn - ep->tx.acked_psn) >=
+        (uct_ud_psn_t)(ep->tx.psn - ep->tx.acked_psn)) {
+        ep->resend.sack_psn = ep->tx.acked_psn;
+    }
+
+    while (!ucs_queue_iter_end(&ep->tx.window, iter)) {
+        skb = ucs_queue_iter_elem(skb, iter, queue);
+        if ((pos == NULL) &&
+            UCT_UD_PSN_COMPARE(skb->neth->psn, >, ep->resend.sack_psn)) {
+            pos = iter;
+        }
+
+        psn_offset = skb->neth->psn - base_psn;
+        if (UCT_UD_PSN_COMPARE(skb->neth->psn, >=, base_psn)) {
+            if (psn_offset >= UCT_UD_SACK_MAX_PSNS) {
+                break;
+            }
+            if (mask & UCS_BIT(psn_offset)) {
+                skb->flags |= UCT_UD_SEND_SKB_FLAG_SACKED;
+            }
+        }
+
+        if (pos == NULL) {
+            prev_psn = skb->neth->psn;
+        }
+        iter = ucs_queue_iter_next(iter);
+    }
+
+    if (ucs_popcount(mask) < UCT_UD_CA_DUP_ACK_CNT) {
+        return;
+    }
+
+    /* every hole below the (DUP_ACK_CNT)-th highest SACKed psn is lost */
+    for (i = 1; i < UCT_UD_CA_DUP_ACK_CNT; ++i) {
+        mask &= ~UCS_BIT(ucs_ilog2(mask));
+    }
+    lost_psn = base_psn + ucs_ilog2(mask) - 1;
+    if (UCT_UD_PSN_COMPARE(lost_psn, <=, ep->resend.sack_psn) ||
+        (pos == NULL)) {
+        return;
+    }
+
+    ucs_debug("ep(%p): sack acked_psn %u mask 0x%"PRIx64" lost_psn %u "
+              "sack_psn %u",
+              ep, ep->tx.acked_psn, ((uct_ud_sack_t*)(neth + 1))->mask,
+              lost_psn, ep->resend.sack_psn);
+
+    if (UCT_UD_PSN_COMPARE(ep->resend.psn, >, ep->resend.max_psn)) {
+        /* resend is not active: start it right after the holes which were
+         * already resent because of previous SACKs */
+        if (ep->resend.sack_psn == ep->tx.acked_psn) {
+            uct_ud_ep_ca_drop(ep);
+        }
+        ep->resend.pos = pos;
+        ep->resend.psn = prev_psn;
+    }
+
+    if (UCT_UD_PSN_COMPARE(ep->resend.max_psn, <, lost_psn)) {
+        ep->resend.max_psn = lost_psn;
+    }
+
+    ep->resend.sack_psn = lost_psn;
+    uct_ud_ep_set_state(ep, UCT_UD_EP_FLAG_TX_NACKED);
+    uct_ud_ep_ctl_op_add(iface, ep, UCT_UD_EP_OP_RESEND);
+}
+
 static inline void uct_ud_ep_rx_put(uct_ud_neth_t *neth, unsigned byte_len)
 {
     uct_ud_put_hdr_t *put_hdr;
@@ -990,18 +1087,65 @@ uct_ud_send_skb_t *uct_ud_ep_prepare_creq(uct_ud_ep_t *ep)
     return skb;
 }
 
+static void uct_ud_ep_rx_data(uct_ud_iface_t *iface, uct_ud_neth_t *neth,
+                              unsigned byte_len, uct_ud_recv_skb_t *skb,
+                              int is_async)
+{
+    uint32_t am_id = uct_ud_neth_get_am_id(neth);
+
+    if (ucs_unlikely(!(neth->packet_type & UCT_UD_PACKET_FLAG_AM) &&
+                     (neth->packet_type & UCT_UD_PACKET_FLAG_PUT))) {
+        /* TODO: remove once ucp implements put */
+        uct_ud_ep_rx_put(neth, byte_len);
+        ucs_mpool_put(skb);
+        return;
+    }
+
+    if (ucs_unlikely(is_async &&
+                     !(iface->super.super.am[am_id].flags & UCT_CB_FLAG_ASYNC))) {
+        skb->u.am.len = byte_len - sizeof(*neth);
+        ucs_queue_push(&iface->rx.pending_q, &skb->u.am.queue);
+    } else {
+        /* Avoid reordering with respect to pending operations, if user AM handler
+         * initiates sends from any endpoint created on the iface.
+         * This flag would be cleared after all incoming messages
+         * are processed. */
+        uct_ud_iface_raise_pending_async_ev(iface);
+
+        uct_ib_iface_invoke_am_desc(&iface->super, am_id, neth + 1,
+                                    byte_len - sizeof(*neth), &skb->super);
+    }
+}
+
+/* Deliver packets which became in-order after a hole was filled */
+static void uct_ud_ep_rx_pull(uct_ud_iface_t *iface, uct_ud_ep_t *ep,
+                              int is_async)
+{
+    ucs_frag_list_elem_t *elem;
+    uct_ud_recv_skb_t *skb;
+    uct_ud_neth_t *neth;
+
+    while ((elem = ucs_frag_list_pull(&ep->rx.ooo_pkts)) != NULL) {
+        skb  = ucs_container_of(elem, uct_ud_recv_skb_t, u.ooo.elem);
+        neth = UCS_PTR_BYTE_OFFSET(uct_ib_iface_recv_desc_hdr(
+                                           &iface->super,
+                                           (uct_ib_iface_recv_desc_t*)skb),
+                                   UCT_IB_GRH_LEN);
+        uct_ud_ep_rx_data(iface, neth, skb->u.ooo.len, skb, is_async);
+    }
+}
+
 void uct_ud_ep_process_rx(uct_ud_iface_t *iface, uct_ud_neth_t *neth, unsigned byte_len,
                           uct_ud_recv_skb_t *skb, int is_async)
 {
     uint32_t dest_id;
-    uint32_t is_am, am_id;
+    uint32_t is_am;
     uct_ud_ep_t *ep = 0; /* todo: check why gcc complaints about uninitialized var */
     ucs_frag_list_ooo_type_t ooo_type;
 
     UCT_UD_IFACE_HOOK_CALL_RX(iface, neth, byte_len);
 
     dest_id = uct_ud_neth_get_dest_id(neth);
-    am_id   = uct_ud_neth_get_am_id(neth);
     is_am   = neth->packet_type & UCT_UD_PACKET_FLAG_AM;
 
     if (ucs_unlikely(dest_id == UCT_UD_EP_NULL_ID)) {
@@ -1037,12 +1181,17 @@ void uct_ud_ep_process_rx(uct_ud_iface_t *iface, uct_ud_neth_t *neth, unsigned b
     }
 
     if (ucs_unlikely(!is_am)) {
+        if (neth->packet_type & UCT_UD_PACKET_FLAG_SACK) {
+            uct_ud_ep_process_sack(iface, ep, neth);
+        }
+
         if (neth->packet_type & UCT_UD_PACKET_FLAG_NACK) {
             uct_ud_ep_set_state(ep, UCT_UD_EP_FLAG_TX_NACKED);
             goto out;
         }
 
-        if ((size_t)byte_len == sizeof(*neth)) {
+        if (((size_t)byte_len == sizeof(*neth)) ||
+            (neth->packet_type & UCT_UD_PACKET_FLAG_SACK)) {
             goto out;
         }
         if (neth->packet_type & UCT_UD_PACKET_FLAG_CTL) {
@@ -1051,38 +1200,37 @@ void uct_ud_ep_process_rx(uct_ud_iface_t *iface, uct_ud_neth_t *neth, unsigned b
         }
     }
 
-    ooo_type = ucs_frag_list_insert(&ep->rx.ooo_pkts, &skb->u.ooo.elem, neth->psn);
-    if (ucs_unlikely(ooo_type != UCS_FRAG_LIST_INSERT_FAST)) {
-        if ((ooo_type != UCS_FRAG_LIST_INSERT_DUP) &&
-            (ooo_type != UCS_FRAG_LIST_INSERT_FAIL)) {
-            ucs_fatal("Out of order is not implemented: got %d", ooo_type);
-        }
-        ucs_trace_data("DUP/OOB - schedule ack, head_sn=%d sn=%d",
-                       ep->rx.ooo_pkts.head_sn, neth->psn);
-        goto out;
-    }
-
-    if (ucs_unlikely(!is_am && (neth->packet_type & UCT_UD_PACKET_FLAG_PUT))) {
-        /* TODO: remove once ucp implements put */
-        uct_ud_ep_rx_put(neth, byte_len);
+    if (ucs_unlikely(UCT_UD_PSN_COMPARE(neth->psn, >,
+                                        ep->rx.ooo_pkts.head_sn + 1) &&
+                     !uct_ud_ep_is_connected(ep))) {
+        /* CREP resets the expected psn, so keep nothing before it arrives */
+        ucs_trace_data("ep %p: not connected, drop ooo psn %u head_sn %u", ep,
+                       neth->psn, ep->rx.ooo_pkts.head_sn);
         goto out;
     }
 
-    if (ucs_unlikely(is_async &&
-                     !(iface->super.super.am[am_id].flags & UCT_CB_FLAG_ASYNC))) {
-        skb->u.am.len = byte_len - sizeof(*neth);
-        ucs_queue_push(&iface->rx.pending_q, &skb->u.am.queue);
-    } else {
-        /* Avoid reordering with respect to pending operations, if user AM handler
-         * initiates sends from any endpoint created on the iface.
-         * This flag would be cleared after all incoming messages
-         * are processed. */
-        uct_ud_iface_raise_pending_async_ev(iface);
-
-        uct_ib_iface_invoke_am_desc(&iface->super, am_id, neth + 1,
-                                    byte_len - sizeof(*neth), &skb->super);
+    ooo_type = ucs_frag_list_insert(&ep->rx.ooo_pkts, &skb->u.ooo.elem, neth->psn);
+    switch (ooo_type) {
+    case UCS_FRAG_LIST_INSERT_FAST:
+        uct_ud_ep_rx_data(iface, neth, byte_len, skb, is_async);
+        return;
+    case UCS_FRAG_LIST_INSERT_FIRST:
+        uct_ud_ep_rx_data(iface, neth, byte_len, skb, is_async);
+        uct_ud_ep_rx_pull(iface, ep, is_async);
+        return;
+    case UCS_FRAG_LIST_INSERT_READY:
+        skb->u.ooo.len = byte_len;
+        uct_ud_ep_rx_pull(iface, ep, is_async);
+        return;
+    case UCS_FRAG_LIST_INSERT_SLOW:
+        /* keep the packet until the hole before it is filled */
+        skb->u.ooo.len = byte_len;
+        return;
+    default:
+        ucs_trace_data("DUP/OOB - schedule ack, head_sn=%d sn=%d",
+                       ep->rx.ooo_pkts.head_sn, neth->psn);
+        break;
     }
-    return;
 
 out:
     ucs_mpool_put(skb);
@@ -1362,9 +1510,22 @@ static void uct_ud_ep_resend(uct_ud_ep_t *ep)
         return;
     }
 
+    /* stop if the resend window was extended by SACK, and its end was reached
+     * by skipping packets */
+    if (UCT_UD_PSN_COMPARE(sent_skb->neth->psn, >, ep->resend.max_psn)) {
+        ep->resend.psn = ep->resend.max_psn + 1;
+        uct_ud_ep_resend_end(ep);
+        return;
+    }
+
     /* Update resend position */
     ep->resend.pos = ucs_queue_iter_next(resend_pos);
 
+    /* skip skb which was reported by the remote side in SACK */
+    if (sent_skb->flags & UCT_UD_SEND_SKB_FLAG_SACKED) {
+        return;
+    }
+
     /* skip skb which was already resent but didn't get send completion yet */
     if (sent_skb->flags & UCT_UD_SEND_SKB_FLAG_RESENDING) {
         ucs_debug("ep(%p): skb %p already being resent", ep, sent_skb);
@@ -1460,10 +1621,35 @@ static void uct_ud_ep_resend(uct_ud_ep_t *ep)
     ++ep->tx.resend_count;
 }
 
+/* Build the SACK mask from the packets which are held after a hole */
+static uint64_t uct_ud_ep_rx_sack_mask(uct_ud_ep_t *ep)
+{
+    uct_ud_psn_t base_psn = ucs_frag_list_sn(&ep->rx.ooo_pkts) +
+                            UCT_UD_SACK_PSN_OFFSET;
+    uint64_t mask         = 0;
+    ucs_frag_list_elem_t *h;
+    uct_ud_psn_t psn, bit;
+
+    ucs_queue_for_each(h, &ep->rx.ooo_pkts.list, list) {
+        for (psn = h->head.first_sn;
+             UCT_UD_PSN_COMPARE(psn, <=, h->head.last_sn); ++psn) {
+            bit = psn - base_psn;
+            if (bit >= UCT_UD_SACK_MAX_PSNS) {
+                return mask;
+            }
+            mask |= UCS_BIT(bit);
+        }
+    }
+
+    return mask;
+}
+
 static void uct_ud_ep_send_ack(uct_ud_iface_t *iface, uct_ud_ep_t *ep)
 {
     int ctl_flags        = 0;
     uint32_t packet_type = ep->dest_ep_id;
+    uint64_t sack_mask;
+    size_t ack_len;
     uct_ud_ctl_desc_t *cdesc;
     uct_ud_send_skb_t *skb;
 
@@ -1486,9 +1672,16 @@ static void uct_ud_ep_send_ack(uct_ud_iface_t *iface, uct_ud_ep_t *ep)
         packet_type |= UCT_UD_PACKET_FLAG_NACK;
     }
 
-    if ((sizeof(uct_ud_neth_t) <= iface->config.max_inline) &&
+    sack_mask = uct_ud_ep_rx_sack_mask(ep);
+    ack_len   = sizeof(uct_ud_neth_t);
+    if (sack_mask != 0) {
+        packet_type |= UCT_UD_PACKET_FLAG_SACK;
+        ack_len     += sizeof(uct_ud_sack_t);
+    }
+
+    if ((ack_len <= iface->config.max_inline) &&
         !(ctl_flags & UCT_UD_IFACE_SEND_CTL_FLAG_SIGNALED)) {
-        skb        = ucs_alloca(sizeof(*skb) + sizeof(uct_ud_neth_t));
+        skb        = ucs_alloca(sizeof(*skb) + ack_len);
         skb->flags = 0;
 #if UCS_ENABLE_ASSERT
         skb->lkey  = 0;
@@ -1500,8 +1693,11 @@ static void uct_ud_ep_send_ack(uct_ud_iface_t *iface, uct_ud_ep_t *ep)
 
     uct_ud_neth_init_data(ep, skb->neth);
     skb->flags             = UCT_UD_SEND_SKB_FLAG_CTL_ACK;
-    skb->len               = sizeof(uct_ud_neth_t);
+    skb->len               = ack_len;
     skb->neth->packet_type = packet_type;
+    if (sack_mask != 0) {
+        ((uct_ud_sack_t*)(skb->neth + 1))->mask = sack_mask;
+    }
 
     if (ctl_flags & UCT_UD_IFACE_SEND_CTL_FLAG_INLINE) {
         uct_ud_iface_send_ctl(iface, ep, skb, NULL, 0, ctl_flags, 1);
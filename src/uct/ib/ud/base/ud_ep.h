@@ -157,6 +157,17 @@ do { \
  * When retransmitting, ack is requested if:
  * psn == acked_psn + 1 or
  * psn % UCT_UD_RESENDS_PER_ACK = 0
+ *
+ * Selective acknowledgement and fast retransmit
+ *
+ * The receiver keeps packets which arrived after a hole, and reports them
+ * with a SACK mask on the ACK/NACK packets. The sender marks the reported
+ * skbs as SACKED, and the resend operation skips them.
+ * A hole is considered lost once UCT_UD_CA_DUP_ACK_CNT packets above it were
+ * SACKed. In that case the resend window is extended up to the lost holes
+ * without waiting for the slow timer. resend.sack_psn keeps the highest psn
+ * that was scheduled this way, so a SACK which arrives before the resent
+ * packet was acknowledged does not trigger another resend of the same hole.
  */
 
 /*
@@ -253,6 +264,7 @@ struct uct_ud_ep {
          ucs_queue_iter_t       pos;       /* points to the part of tx window that needs to be resent */
          uct_ud_psn_t           psn;       /* last psn that was retransmitted */
          uct_ud_psn_t           max_psn;   /* max psn that should be retransmitted */
+         uct_ud_psn_t           sack_psn;  /* max psn scheduled for resend by SACK */
     } resend;
     ucs_conn_match_elem_t conn_match;
     uct_ud_ep_conn_sn_t   conn_sn;      /* connection sequence number. assigned in connect_to_iface() */
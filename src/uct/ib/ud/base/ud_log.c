@@ -38,8 +38,16 @@ void uct_ud_dump_packet(uct_base_iface_t *iface, uct_am_trace_type_t type,
         p += strlen(p);
         uct_iface_dump_am(iface, type, am_id, neth + 1,
                           length - sizeof(*neth), p, endp - p);
-    } else if (neth->packet_type & UCT_UD_PACKET_FLAG_NACK) {
-        snprintf(p, endp - p, " NACK");
+    } else if (neth->packet_type & (UCT_UD_PACKET_FLAG_NACK |
+                                    UCT_UD_PACKET_FLAG_SACK)) {
+        if (neth->packet_type & UCT_UD_PACKET_FLAG_NACK) {
+            snprintf(p, endp - p, " NACK");
+            p += strlen(p);
+        }
+        if (neth->packet_type & UCT_UD_PACKET_FLAG_SACK) {
+            snprintf(p, endp - p, " SACK 0x%"PRIx64,
+                     ((uct_ud_sack_t*)(neth + 1))->mask);
+        }
     } else if (neth->packet_type & UCT_UD_PACKET_FLAG_PUT) {
         puth = (uct_ud_put_hdr_t *)(neth + 1);
         snprintf(p, endp - p, " PUT: 0x%0lx len %zu", puth->rva,
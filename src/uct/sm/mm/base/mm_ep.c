@@ -230,34 +230,19 @@ UCS_CLASS_DEFINE_NEW_FUNC(uct_mm_ep_t, uct_ep_t, const uct_ep_params_t *);
 UCS_CLASS_DEFINE_DELETE_FUNC(uct_mm_ep_t, uct_ep_t);
 
 
-static inline ucs_status_t
-uct_mm_ep_get_remote_elem(uct_mm_ep_t *ep, uint64_t head,
-                          uct_mm_fifo_element_t **elem)
-{
-    uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
-    uint64_t new_head, prev_head;
-    uint64_t elem_index;   /* index of the element to write */
-
-    elem_index = head & iface->fifo_mask;
-    *elem      = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems, elem_index);
-    new_head   = (head + 1) & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
-
-    /* try to get ownership of the head element */
-    prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head), head,
-                                   new_head);
-    if (prev_head != head) {
-        return UCS_ERR_NO_RESOURCE;
-    }
-
-    return UCS_OK;
-}
-
 static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
 {
     ucs_memory_cpu_load_fence();
     ep->cached_tail = ep->fifo_ctl->tail;
 }
 
+static UCS_F_ALWAYS_INLINE size_t
+uct_mm_ep_num_free_elems(uint64_t head, uint64_t tail, uct_mm_iface_t *iface)
+{
+    return iface->config.fifo_size -
+           ((head - tail) & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
+}
+
 static UCS_F_ALWAYS_INLINE void uct_mm_ep_peer_check(uct_mm_ep_t *ep,
                                                      unsigned flags)
 {
@@ -275,24 +260,18 @@ uct_mm_ep_no_resources_handle(uct_mm_ep_t *ep, unsigned flags)
     return UCS_ERR_NO_RESOURCE;
 }
 
-/* A common mm active message sending function.
- * The first parameter indicates the origin of the call.
+/* Reserve up to max_elems consecutive elements in the remote FIFO by advancing
+ * its head with a single atomic operation. On success, the head value before
+ * the reservation is returned in head_p, and the number of reserved elements
+ * is returned in num_elems_p.
  */
-static UCS_F_ALWAYS_INLINE ssize_t uct_mm_ep_am_common_send(
-        uct_mm_send_op_t send_op, uct_mm_ep_t *ep, uct_mm_iface_t *iface,
-        uint8_t am_id, size_t length, uint64_t header, const void *payload,
-        uct_pack_callback_t pack_cb, void *arg, const uct_iov_t *iov,
-        size_t iovcnt, unsigned flags)
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_mm_ep_reserve_elems(uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+                        size_t max_elems, unsigned flags, uint64_t *head_p,
+                        size_t *num_elems_p)
 {
-    uct_mm_fifo_element_t *elem;
-    ucs_status_t status;
-    void *base_address;
-    uint8_t elem_flags;
-    uint64_t head;
-    ucs_iov_iter_t iov_iter;
-    void *desc_data;
-
-    UCT_CHECK_AM_ID(am_id);
+    uint64_t head, new_head, prev_head;
+    size_t num_elems;
 
 retry:
     head = ep->fifo_ctl->head;
@@ -315,13 +294,75 @@ retry:
         }
     }
 
-    status = uct_mm_ep_get_remote_elem(ep, head, &elem);
-    if (status != UCS_OK) {
-        ucs_assert(status == UCS_ERR_NO_RESOURCE);
+    if (max_elems == 1) {
+        num_elems = 1;
+    } else {
+        num_elems = uct_mm_ep_num_free_elems(head, ep->cached_tail, iface);
+        if (num_elems < max_elems) {
+            /* try to find more free elements for the batch */
+            uct_mm_ep_update_cached_tail(ep);
+            num_elems = uct_mm_ep_num_free_elems(head, ep->cached_tail, iface);
+        }
+        num_elems = ucs_min(num_elems, max_elems);
+    }
+
+    new_head = (head + num_elems) & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+
+    /* try to get ownership of the elements starting from head */
+    prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head), head,
+                                   new_head);
+    if (prev_head != head) {
         ucs_trace_poll("couldn't get an available FIFO element. retrying");
         goto retry;
     }
 
+    *head_p      = head;
+    *num_elems_p = num_elems;
+    return UCS_OK;
+}
+
+/* Mark a written FIFO element as ready to be consumed by the receiver */
+static UCS_F_ALWAYS_INLINE void
+uct_mm_ep_elem_publish(uct_mm_iface_t *iface, uct_mm_fifo_element_t *elem,
+                       uint64_t head, uint8_t elem_flags)
+{
+    /* set the owner bit to indicate that the writing is complete.
+     * the owner bit flips after every FIFO wraparound */
+    if (head & iface->config.fifo_size) {
+        elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+    }
+    elem->flags = elem_flags;
+}
+
+/* A common mm active message sending function.
+ * The first parameter indicates the origin of the call.
+ */
+static UCS_F_ALWAYS_INLINE ssize_t uct_mm_ep_am_common_send(
+        uct_mm_send_op_t send_op, uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+        uint8_t am_id, size_t length, uint64_t header, const void *payload,
+        uct_pack_callback_t pack_cb, void *arg, const uct_iov_t *iov,
+        size_t iovcnt, unsigned flags)
+{
+    uct_mm_fifo_element_t *elem;
+    ucs_status_t status;
+    void *base_address;
+    uint8_t elem_flags;
+    uint64_t head;
+    size_t num_elems;
+    ucs_iov_iter_t iov_iter;
+    void *desc_data;
+
+    UCT_CHECK_AM_ID(am_id);
+
+    status = uct_mm_ep_reserve_elems(ep, iface, 1, flags, &head, &num_elems);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucs_assert(num_elems == 1);
+    elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                      head & iface->fifo_mask);
+
     switch (send_op) {
     case UCT_MM_SEND_AM_SHORT:
         /* write to the remote FIFO */
@@ -374,12 +415,7 @@ retry:
      * 'writing is complete' flag which the reader checks */
     ucs_memory_cpu_store_fence();
 
-    /* set the owner bit to indicate that the writing is complete.
-     * the owner bit flips after every FIFO wraparound */
-    if (head & iface->config.fifo_size) {
-        elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
-    }
-    elem->flags = elem_flags;
+    uct_mm_ep_elem_publish(iface, elem, head, elem_flags);
 
     if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
         uct_mm_ep_signal_remote(ep);
@@ -430,6 +466,71 @@ ucs_status_t uct_mm_ep_am_short_iov(uct_ep_h tl_ep, uint8_t id,
                                                   NULL, iov, iovcnt, 0);
 }
 
+ssize_t uct_mm_ep_am_short_batch(uct_ep_h tl_ep, uint8_t id,
+                                 const uct_am_short_batch_entry_t *entries,
+                                 size_t count)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_fifo_element_t *elem;
+    ucs_status_t status;
+    size_t i, num_elems;
+    uint64_t head;
+
+    UCT_CHECK_AM_ID(id);
+
+    if (ucs_unlikely(count == 0)) {
+        return 0;
+    }
+
+    for (i = 0; i < count; ++i) {
+        UCT_CHECK_LENGTH(entries[i].length + sizeof(entries[i].header), 0,
+                         iface->config.fifo_elem_size -
+                                 sizeof(uct_mm_fifo_element_t),
+                         "am_short_batch");
+    }
+
+    status = uct_mm_ep_reserve_elems(ep, iface, count, 0, &head, &num_elems);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* write all reserved elements */
+    for (i = 0; i < num_elems; ++i) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                          (head + i) & iface->fifo_mask);
+        uct_am_short_fill_data(elem + 1, entries[i].header, entries[i].payload,
+                               entries[i].length, UCS_ARCH_MEMCPY_NT_DEST);
+        elem->length = entries[i].length + sizeof(entries[i].header);
+        elem->am_id  = id;
+
+        uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_SEND,
+                              UCT_MM_FIFO_ELEM_FLAG_INLINE, id, elem + 1,
+                              elem->length,
+                              (head + i) & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
+        UCT_TL_EP_STAT_OP(&ep->super, AM, SHORT, elem->length);
+    }
+
+    /* memory barrier - make sure that the data of all elements is flushed
+     * before any of them is marked as ready */
+    ucs_memory_cpu_store_fence();
+
+    /* publish the elements in FIFO order, since the receiver consumes them
+     * one by one */
+    for (i = 0; i < num_elems; ++i) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                          (head + i) & iface->fifo_mask);
+        uct_mm_ep_elem_publish(iface, elem, head + i,
+                               UCT_MM_FIFO_ELEM_FLAG_INLINE);
+    }
+
+    if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
+        uct_mm_ep_signal_remote(ep);
+    }
+
+    return num_elems;
+}
+
 ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_cb,
                            void *arg, unsigned flags)
 {
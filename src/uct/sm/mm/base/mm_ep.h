@@ -61,6 +61,10 @@ ucs_status_t uct_mm_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t header,
 ucs_status_t uct_mm_ep_am_short_iov(uct_ep_h tl_ep, uint8_t id,
                                     const uct_iov_t *iov, size_t iovcnt);
 
+ssize_t uct_mm_ep_am_short_batch(uct_ep_h tl_ep, uint8_t id,
+                                 const uct_am_short_batch_entry_t *entries,
+                                 size_t count);
+
 ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_cb,
                            void *arg, unsigned flags);
 
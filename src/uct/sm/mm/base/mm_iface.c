@@ -604,7 +604,8 @@ static uct_iface_internal_ops_t uct_mm_iface_internal_ops = {
     .ep_invalidate         = (uct_ep_invalidate_func_t)ucs_empty_function_return_unsupported,
     .ep_connect_to_ep_v2   = (uct_ep_connect_to_ep_v2_func_t)ucs_empty_function_return_unsupported,
     .iface_is_reachable_v2 = uct_mm_iface_is_reachable_v2,
-    .ep_is_connected       = uct_mm_ep_is_connected
+    .ep_is_connected       = uct_mm_ep_is_connected,
+    .ep_am_short_batch     = uct_mm_ep_am_short_batch
 };
 
 static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
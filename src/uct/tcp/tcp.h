@@ -31,6 +31,9 @@
 /* Maximum number of events to wait on event set */
 #define UCT_TCP_MAX_EVENTS                    16
 
+/* Number of submission queue entries of io_uring progress engine */
+#define UCT_TCP_IO_URING_ENTRIES              256
+
 /* How long should be string to keep [%s:%s] string
  * where %s value can be -/Tx/Rx */
 #define UCT_TCP_EP_CTX_CAPS_STR_MAX           8
@@ -51,6 +54,9 @@
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
 
+/* Maximum size of a data that can be read by GET Zcopy operation */
+#define UCT_TCP_EP_GET_ZCOPY_MAX              SIZE_MAX
+
 #define UCT_TCP_CONFIG_MAX_CONN_RETRIES      "MAX_CONN_RETRIES"
 
 /* TX and RX caps */
@@ -70,6 +76,16 @@
 /* The seconds between individual keepalive probes */
 #define UCT_TCP_EP_DEFAULT_KEEPALIVE_INTVL   2
 
+/* Flag which is passed to sendmsg() to avoid copying Zcopy payload to the
+ * socket buffer, or 0 if the kernel doesn't support MSG_ZEROCOPY */
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#  define UCT_TCP_HAVE_MSG_ZEROCOPY          1
+#  define UCT_TCP_MSG_ZEROCOPY               MSG_ZEROCOPY
+#else
+#  define UCT_TCP_HAVE_MSG_ZEROCOPY          0
+#  define UCT_TCP_MSG_ZEROCOPY               0
+#endif
+
 
 /**
  * TCP EP connection manager ID
@@ -114,7 +130,10 @@ enum {
     /* EP is on EP PTR map. */
     UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9),
     /* EP has some operations done without flush */
-    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10)
+    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10),
+    /* GET reply payload is being received to the user's buffer on
+     * a given EP. */
+    UCT_TCP_EP_FLAG_GET_RX             = UCS_BIT(11)
 };
 
 
@@ -146,8 +165,23 @@ typedef enum uct_tcp_ep_conn_state {
     UCT_TCP_EP_CONN_STATE_CONNECTED
 } uct_tcp_ep_conn_state_t;
 
-/* Forward declaration */
+/**
+ * TCP progress engine, which is used to wait for socket events
+ */
+typedef enum uct_tcp_io_engine {
+    /* Readiness notifications by epoll_wait() on every progress call */
+    UCT_TCP_IO_ENGINE_EPOLL,
+    /* Poll requests are posted to io_uring and their completions are reaped
+     * from the shared completion queue without a system call */
+    UCT_TCP_IO_ENGINE_IO_URING,
+    /* Use io_uring if it is supported by the system, otherwise epoll */
+    UCT_TCP_IO_ENGINE_AUTO,
+    UCT_TCP_IO_ENGINE_LAST
+} uct_tcp_io_engine_t;
+
+/* Forward declarations */
 typedef struct uct_tcp_ep uct_tcp_ep_t;
+typedef struct uct_tcp_io_uring uct_tcp_io_uring_t;
 
 typedef ucs_callback_t uct_tcp_ep_progress_t;
 
@@ -225,7 +259,15 @@ typedef enum uct_tcp_ep_am_id {
     /* AM ID reserved for TCP internal PUT ACK message */
     UCT_TCP_EP_PUT_ACK_AM_ID   = UCT_AM_ID_MAX + 2,
     /* AM ID reserved for TCP internal keepalive message */
-    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3
+    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3,
+    /* AM ID reserved for TCP internal GET REQ message */
+    UCT_TCP_EP_GET_REQ_AM_ID   = UCT_AM_ID_MAX + 4,
+    /* AM ID reserved for TCP internal GET REP message */
+    UCT_TCP_EP_GET_REP_AM_ID   = UCT_AM_ID_MAX + 5,
+    /* AM ID reserved for TCP internal atomic REQ message */
+    UCT_TCP_EP_AMO_REQ_AM_ID   = UCT_AM_ID_MAX + 6,
+    /* AM ID reserved for TCP internal atomic REP message */
+    UCT_TCP_EP_AMO_REP_AM_ID   = UCT_AM_ID_MAX + 7
 } uct_tcp_ep_am_id_t;
 
 
@@ -247,6 +289,54 @@ typedef struct uct_tcp_ep_put_ack_hdr {
 } UCS_S_PACKED uct_tcp_ep_put_ack_hdr_t;
 
 
+/**
+ * TCP GET request header
+ */
+typedef struct uct_tcp_ep_get_req_hdr {
+    uint64_t                      addr;        /* Address of a remote memory buffer */
+    size_t                        length;      /* Length of a remote memory buffer */
+} UCS_S_PACKED uct_tcp_ep_get_req_hdr_t;
+
+
+/**
+ * TCP GET reply header, followed by the remote memory buffer content
+ */
+typedef struct uct_tcp_ep_get_rep_hdr {
+    size_t                        length;      /* Length of the payload */
+} UCS_S_PACKED uct_tcp_ep_get_rep_hdr_t;
+
+
+/**
+ * TCP atomic operation opcodes, in addition to @ref uct_atomic_op_t
+ */
+enum {
+    UCT_TCP_EP_AMO_OP_CSWAP = UCT_ATOMIC_OP_LAST
+};
+
+
+/**
+ * TCP atomic request header
+ */
+typedef struct uct_tcp_ep_amo_req_hdr {
+    uint64_t                      addr;        /* Address of a remote 64-bit value */
+    uint64_t                      value;       /* Operand (or swap value of CSWAP) */
+    uint64_t                      compare;     /* Compare value of CSWAP */
+    uint32_t                      sn;          /* Sequence number of the operation
+                                                * in PUT operations order */
+    uint8_t                       opcode;      /* Atomic operation opcode */
+    uint8_t                       fetch;       /* Whether the original value has
+                                                * to be sent back */
+} UCS_S_PACKED uct_tcp_ep_amo_req_hdr_t;
+
+
+/**
+ * TCP atomic reply header
+ */
+typedef struct uct_tcp_ep_amo_rep_hdr {
+    uint64_t                      result;      /* Original remote value */
+} UCS_S_PACKED uct_tcp_ep_amo_rep_hdr_t;
+
+
 /**
  * TCP PUT completion
  */
@@ -261,6 +351,53 @@ typedef struct uct_tcp_ep_put_completion {
 } uct_tcp_ep_put_completion_t;
 
 
+/**
+ * TCP MSG_ZEROCOPY completion
+ */
+typedef struct uct_tcp_ep_zerocopy_completion {
+    uct_completion_t              *comp;           /* User's completion passed to
+                                                    * Zcopy operation or uct_ep_flush */
+    uint32_t                      wait_sn;         /* Number of MSG_ZEROCOPY sends which
+                                                    * have to be reported as completed
+                                                    * by the kernel */
+    ucs_queue_elem_t              elem;            /* Element to insert completion into
+                                                    * TCP EP MSG_ZEROCOPY pending queue */
+} uct_tcp_ep_zerocopy_completion_t;
+
+
+/**
+ * TCP GET Zcopy or fetching atomic operation waiting for a reply
+ */
+typedef struct uct_tcp_ep_fetch_op {
+    uct_completion_t              *comp;           /* User's completion */
+    uint32_t                      put_sn;          /* Sequence number of the operation
+                                                    * in PUT operations order, the reply
+                                                    * acknowledges all preceding ones */
+    uint8_t                       am_id;           /* Expected reply AM ID */
+    uint64_t                      *result;         /* Atomic result buffer */
+    size_t                        length;          /* Remaining GET payload length */
+    size_t                        iov_index;       /* Current IOV index */
+    size_t                        iov_cnt;         /* Number of IOVs to receive to */
+    ucs_queue_elem_t              elem;            /* Element to insert the operation
+                                                    * into TCP EP fetch queue */
+    struct iovec                  iov[0];          /* IOVs to receive GET payload to */
+} uct_tcp_ep_fetch_op_t;
+
+
+/**
+ * TCP GET or atomic reply which is waiting for TX resources
+ */
+typedef struct uct_tcp_ep_reply {
+    uint8_t                       am_id;           /* Reply AM ID */
+    union {
+        uct_tcp_ep_get_req_hdr_t  get;             /* GET request to reply to */
+        uint64_t                  result;          /* Atomic operation result */
+    };
+    ucs_queue_elem_t              elem;            /* Element to insert the reply
+                                                    * into TCP EP reply queue */
+} uct_tcp_ep_reply_t;
+
+
 /**
  * TCP endpoint communication context
  */
@@ -279,11 +416,15 @@ typedef struct uct_tcp_ep_ctx {
  * buffer from TCP EP context
  */
 typedef struct uct_tcp_ep_zcopy_tx {
-    uct_tcp_am_hdr_t              super;     /* UCT TCP AM header */
-    uct_completion_t              *comp;     /* Local UCT completion object */
-    size_t                        iov_index; /* Current IOV index */
-    size_t                        iov_cnt;   /* Number of IOVs that should be sent */
-    struct iovec                  iov[0];    /* IOVs that should be sent */
+    uct_tcp_am_hdr_t              super;      /* UCT TCP AM header */
+    uct_completion_t              *comp;      /* Local UCT completion object */
+    int                           send_flags; /* Flags passed to sendmsg() for
+                                               * user's payload */
+    size_t                        payload_iov_index; /* Index of the first IOV
+                                                      * with user's payload */
+    size_t                        iov_index;  /* Current IOV index */
+    size_t                        iov_cnt;    /* Number of IOVs that should be sent */
+    struct iovec                  iov[0];     /* IOVs that should be sent */
 } uct_tcp_ep_zcopy_tx_t;
 
 
@@ -349,6 +490,22 @@ struct uct_tcp_ep {
     ucs_queue_head_t              pending_q;    /* Pending operations */
     ucs_queue_head_t              put_comp_q;   /* Flush completions waiting for
                                                  * outstanding PUTs acknowledgment */
+    ucs_queue_head_t              fetch_q;      /* GET and fetching atomic
+                                                 * operations waiting for replies */
+    ucs_queue_head_t              reply_q;      /* Replies to GET and atomic
+                                                 * requests waiting for TX
+                                                 * resources */
+    struct {
+        uint32_t                  sn;           /* Number of sendmsg(MSG_ZEROCOPY)
+                                                 * calls which sent data */
+        uint32_t                  done_sn;      /* Number of MSG_ZEROCOPY sends
+                                                 * reported as completed by the
+                                                 * kernel */
+        ucs_queue_head_t          comp_q;       /* Completions waiting for
+                                                 * MSG_ZEROCOPY notifications */
+        ucs_list_link_t           list;         /* Element in TCP iface list of EPs
+                                                 * waiting for notifications */
+    } zerocopy;
     union {
         ucs_list_link_t           list;         /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;         /* Connection matching element, used by EPs
@@ -373,14 +530,19 @@ typedef struct uct_tcp_iface {
                                                       * EPs created with
                                                       * CONNECT_TO_EP method */
     ucs_list_link_t               ep_list;           /* List of endpoints */
+    ucs_list_link_t               zerocopy_ep_list;  /* List of endpoints waiting for
+                                                      * MSG_ZEROCOPY notifications */
     char                          if_name[IFNAMSIZ]; /* Network interface name */
     ucs_sys_event_set_t           *event_set;        /* Event set identifier */
+    uct_tcp_io_uring_t            *io_uring;         /* io_uring progress engine,
+                                                      * NULL if epoll is used */
     ucs_mpool_t                   tx_mpool;          /* TX memory pool */
     ucs_mpool_t                   rx_mpool;          /* RX memory pool */
     size_t                        outstanding;       /* How much data in the EP send buffers
                                                       * + how many non-blocking connections
                                                       * are in progress + how many EPs are
                                                       * waiting for PUT Zcopy operation ACKs
+                                                      * or MSG_ZEROCOPY notifications
                                                       * (0/1 for each EP) */
     ucs_range_spec_t              port_range;        /** Range of ports to use for bind() */
 
@@ -389,6 +551,8 @@ typedef struct uct_tcp_iface {
         size_t                    rx_seg_size;       /* RX AM buffer size */
         size_t                    sendv_thresh;      /* Minimum size of user's payload from which
                                                       * non-blocking vector send should be used */
+        size_t                    zerocopy_thresh;   /* Minimum size of Zcopy payload from which
+                                                      * MSG_ZEROCOPY send should be used */
         size_t                    max_iov;           /* Maximum supported IOVs limited by
                                                       * user configuration and service buffers
                                                       * (TCP protocol and user's AM headers) */
@@ -403,6 +567,8 @@ typedef struct uct_tcp_iface {
         ucs_ternary_auto_value_t  ep_bind_src_addr;  /* Bind EP's FD to ifaddr */
         int                       prefer_default;    /* Prefer default gateway */
         int                       put_enable;        /* Enable PUT Zcopy operation support */
+        int                       get_enable;        /* Enable GET Zcopy operation support */
+        int                       atomic_enable;     /* Enable atomic operations support */
         int                       conn_nb;           /* Use non-blocking connect() */
         unsigned                  max_poll;          /* Number of events to poll per socket*/
         uint8_t                   max_conn_retries;  /* How many connection establishment attempts
@@ -441,8 +607,11 @@ typedef struct uct_tcp_iface_config {
     size_t                         rx_seg_size;
     size_t                         max_iov;
     size_t                         sendv_thresh;
+    size_t                         zerocopy_thresh;
     int                            prefer_default;
     int                            put_enable;
+    int                            get_enable;
+    int                            atomic_enable;
     int                            conn_nb;
     unsigned                       max_poll;
     unsigned                       max_conn_retries;
@@ -459,6 +628,7 @@ typedef struct uct_tcp_iface_config {
         ucs_time_t                 intvl;
     } keepalive;
     ucs_ternary_auto_value_t       ep_bind_src_addr;
+    uct_tcp_io_engine_t            io_engine;
 } uct_tcp_iface_config_t;
 
 
@@ -503,6 +673,7 @@ typedef struct uct_tcp_ep_pending_purge_arg {
 
 extern uct_component_t uct_tcp_component;
 extern const char *uct_tcp_address_type_names[];
+extern const char *uct_tcp_io_engine_names[];
 extern const uct_tcp_cm_state_t uct_tcp_ep_cm_state[];
 extern const ucs_conn_match_ops_t uct_tcp_cm_conn_match_ops;
 extern const uct_tcp_ep_progress_t uct_tcp_ep_progress_rx_cb[];
@@ -588,6 +759,8 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
 
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep);
 
+unsigned uct_tcp_ep_zerocopy_progress(uct_tcp_ep_t *ep);
+
 ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header,
                                  const void *payload, unsigned length);
 
@@ -607,6 +780,24 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_atomic64_post(uct_ep_h uct_ep, unsigned opcode,
+                                      uint64_t value, uint64_t remote_addr,
+                                      uct_rkey_t rkey);
+
+ucs_status_t uct_tcp_ep_atomic64_fetch(uct_ep_h uct_ep, uct_atomic_op_t opcode,
+                                       uint64_t value, uint64_t *result,
+                                       uint64_t remote_addr, uct_rkey_t rkey,
+                                       uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_atomic_cswap64(uct_ep_h uct_ep, uint64_t compare,
+                                       uint64_t swap, uint64_t remote_addr,
+                                       uct_rkey_t rkey, uint64_t *result,
+                                       uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags);
 
@@ -654,6 +845,22 @@ ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep);
 
 int uct_tcp_keepalive_is_enabled(uct_tcp_iface_t *iface);
 
+ucs_status_t uct_tcp_io_uring_create(unsigned entries,
+                                     ucs_async_context_t *async,
+                                     uct_tcp_io_uring_t **ring_p);
+
+void uct_tcp_io_uring_destroy(uct_tcp_io_uring_t *ring);
+
+int uct_tcp_io_uring_fd(uct_tcp_io_uring_t *ring);
+
+ucs_status_t uct_tcp_io_uring_set_events(uct_tcp_io_uring_t *ring, int fd,
+                                         ucs_event_set_types_t events,
+                                         void *arg);
+
+ucs_status_t uct_tcp_io_uring_wait(uct_tcp_io_uring_t *ring,
+                                   unsigned *num_events,
+                                   ucs_event_set_handler_t handler, void *arg);
+
 static UCS_F_ALWAYS_INLINE int uct_tcp_ep_ctx_buf_empty(uct_tcp_ep_ctx_t *ctx)
 {
     ucs_assert((ctx->length == 0) || (ctx->buf != NULL));
@@ -12,6 +12,10 @@
 #include "tcp/tcp.h"
 
 #include <ucs/async/async.h>
+#include <ucs/arch/atomic.h>
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+#  include <linux/errqueue.h>
+#endif
 
 
 /* Forward declarations */
@@ -130,8 +134,56 @@ int uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
     return uct_tcp_iface_is_self_addr(iface, (struct sockaddr*)&ep->peer_addr);
 }
 
+static UCS_F_ALWAYS_INLINE int
+uct_tcp_ep_zerocopy_is_pending(const uct_tcp_ep_t *ep)
+{
+    return ep->zerocopy.sn != ep->zerocopy.done_sn;
+}
+
+static void uct_tcp_ep_zerocopy_purge(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_ep_zerocopy_completion_t *zcomp;
+
+    ucs_queue_for_each_extract(zcomp, &ep->zerocopy.comp_q, elem, 1) {
+        uct_invoke_completion(zcomp->comp, status);
+        ucs_mpool_put_inline(zcomp);
+    }
+}
+
+/* Drop MSG_ZEROCOPY state of the socket, since the kernel will not send
+ * notifications for it anymore */
+static void uct_tcp_ep_zerocopy_reset(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    uct_tcp_ep_zerocopy_purge(ep, status);
+
+    if (uct_tcp_ep_zerocopy_is_pending(ep)) {
+        ucs_list_del(&ep->zerocopy.list);
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
+    ep->zerocopy.sn      = 0;
+    ep->zerocopy.done_sn = 0;
+}
+
 static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
 {
+    uct_tcp_ep_fetch_op_t *op;
+    uct_tcp_ep_reply_t *reply;
+
+    uct_tcp_ep_zerocopy_reset(ep, UCS_ERR_CANCELED);
+
+    ucs_queue_for_each_extract(op, &ep->fetch_q, elem, 1) {
+        ucs_assert(op->comp == NULL);
+        ucs_mpool_put_inline(op);
+    }
+
+    ucs_queue_for_each_extract(reply, &ep->reply_q, elem, 1) {
+        ucs_mpool_put_inline(reply);
+    }
+
     if (ep->tx.buf != NULL) {
         uct_tcp_ep_ctx_reset(&ep->tx);
     }
@@ -241,6 +293,12 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->fetch_q);
+    ucs_queue_head_init(&self->reply_q);
+    ucs_queue_head_init(&self->zerocopy.comp_q);
+    ucs_list_head_init(&self->zerocopy.list);
+    self->zerocopy.sn      = 0;
+    self->zerocopy.done_sn = 0;
 
     if (dest_addr != NULL) {
         memcpy(&self->peer_addr[0], dest_addr, iface->config.sockaddr_len);
@@ -351,6 +409,24 @@ uct_tcp_ep_zcopy_completed(uct_tcp_ep_t *ep, uct_completion_t *comp,
     }
 }
 
+static void uct_tcp_ep_fetch_purge(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_ep_fetch_op_t *op;
+
+    /* Replies to the sent requests may still arrive, so keep the operations
+     * in the queue, but drop the replies instead of writing them to the
+     * user's buffers */
+    ucs_queue_for_each(op, &ep->fetch_q, elem) {
+        if (op->comp != NULL) {
+            uct_invoke_completion(op->comp, status);
+            op->comp = NULL;
+        }
+
+        op->result  = NULL;
+        op->iov_cnt = 0;
+    }
+}
+
 static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
 {
     uct_tcp_ep_put_completion_t *put_comp;
@@ -369,6 +445,9 @@ static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
         uct_invoke_completion(put_comp->comp, status);
         ucs_mpool_put_inline(put_comp);
     }
+
+    uct_tcp_ep_fetch_purge(ep, status);
+    uct_tcp_ep_zerocopy_purge(ep, status);
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
@@ -735,9 +814,12 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
 
     ucs_queue_splice(&to_ep->pending_q, &from_ep->pending_q);
     ucs_queue_splice(&to_ep->put_comp_q, &from_ep->put_comp_q);
+    ucs_queue_splice(&to_ep->fetch_q, &from_ep->fetch_q);
+    ucs_queue_splice(&to_ep->reply_q, &from_ep->reply_q);
 
     to_ep->flags |= from_ep->flags & (UCT_TCP_EP_FLAG_ZCOPY_TX           |
                                       UCT_TCP_EP_FLAG_PUT_RX             |
+                                      UCT_TCP_EP_FLAG_GET_RX             |
                                       UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK |
                                       UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK |
                                       UCT_TCP_EP_FLAG_NEED_FLUSH);
@@ -994,7 +1076,10 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
         ucs_trace("tcp_ep %p: set events to %c%c", ep,
                   (new_events & UCS_EVENT_SET_EVREAD)  ? 'r' : '-',
                   (new_events & UCS_EVENT_SET_EVWRITE) ? 'w' : '-');
-        if (new_events == 0) {
+        if (iface->io_uring != NULL) {
+            status = uct_tcp_io_uring_set_events(iface->io_uring, ep->fd,
+                                                 new_events, (void*)ep);
+        } else if (new_events == 0) {
             status = ucs_event_set_del(iface->event_set, ep->fd);
         } else if (old_events != 0) {
             status = ucs_event_set_mod(iface->event_set, ep->fd, ep->events,
@@ -1010,14 +1095,218 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
     }
 }
 
-static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
-                                             uct_tcp_ep_put_ack_hdr_t *put_ack)
+static void uct_tcp_ep_zerocopy_completed(uct_tcp_ep_t *ep, uint32_t done_sn)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zerocopy_completion_t *zcomp;
+
+    ucs_assertv(uct_tcp_ep_zerocopy_is_pending(ep), "ep=%p", ep);
+
+    if (UCS_CIRCULAR_COMPARE32(done_sn, <=, ep->zerocopy.done_sn)) {
+        return;
+    }
+
+    ucs_assertv(UCS_CIRCULAR_COMPARE32(done_sn, <=, ep->zerocopy.sn),
+                "ep=%p done_sn=%u sn=%u", ep, done_sn, ep->zerocopy.sn);
+    ep->zerocopy.done_sn = done_sn;
+
+    ucs_queue_for_each_extract(zcomp, &ep->zerocopy.comp_q, elem,
+                               UCS_CIRCULAR_COMPARE32(zcomp->wait_sn, <=,
+                                                      done_sn)) {
+        uct_invoke_completion(zcomp->comp, UCS_OK);
+        ucs_mpool_put_inline(zcomp);
+    }
+
+    if (!uct_tcp_ep_zerocopy_is_pending(ep)) {
+        ucs_assert(ucs_queue_is_empty(&ep->zerocopy.comp_q));
+        ucs_list_del(&ep->zerocopy.list);
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+}
+
+unsigned uct_tcp_ep_zerocopy_progress(uct_tcp_ep_t *ep)
+{
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    char cbuf[CMSG_SPACE(sizeof(struct sock_extended_err)) * 4];
+    uint32_t done_sn = ep->zerocopy.done_sn;
+    unsigned count   = 0;
+    struct sock_extended_err *serr;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    ssize_t ret;
+
+    if (!uct_tcp_ep_zerocopy_is_pending(ep)) {
+        return 0;
+    }
+
+    for (;;) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = cbuf;
+        msg.msg_controllen = sizeof(cbuf);
+
+        ret = recvmsg(ep->fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (ret < 0) {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) ||
+                (errno == EINTR)) {
+                break;
+            }
+
+            /* The socket was closed or failed, no more notifications
+             * are expected for it */
+            ucs_debug("tcp_ep %p: recvmsg(fd=%d, MSG_ERRQUEUE) failed: %m",
+                      ep, ep->fd);
+            uct_tcp_ep_zerocopy_reset(ep, UCS_ERR_CONNECTION_RESET);
+            return count + 1;
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (!(((cmsg->cmsg_level == SOL_IP) &&
+                   (cmsg->cmsg_type == IP_RECVERR)) ||
+                  ((cmsg->cmsg_level == SOL_IPV6) &&
+                   (cmsg->cmsg_type == IPV6_RECVERR)))) {
+                continue;
+            }
+
+            serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if ((serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) ||
+                (serr->ee_errno != 0)) {
+                ucs_debug("tcp_ep %p: unexpected error queue message: "
+                          "origin %u errno %u", ep, serr->ee_origin,
+                          serr->ee_errno);
+                continue;
+            }
+
+            /* [ee_info, ee_data] is the range of completed sends, and TCP
+             * reports them in order */
+            ucs_trace("tcp_ep %p: MSG_ZEROCOPY sends [%u..%u] completed%s", ep,
+                      serr->ee_info, serr->ee_data,
+                      (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) ?
+                      " (copied)" : "");
+            if (UCS_CIRCULAR_COMPARE32(serr->ee_data + 1, >, done_sn)) {
+                done_sn = serr->ee_data + 1;
+            }
+            ++count;
+        }
+    }
+
+    if (count > 0) {
+        uct_tcp_ep_zerocopy_completed(ep, done_sn);
+    }
+
+    return count;
+#else
+    return 0;
+#endif
+}
+
+/* Completion of a Zcopy operation which data was sent by MSG_ZEROCOPY has to
+ * be deferred until the kernel releases the user's buffers. Returns UCS_OK if
+ * there is nothing to wait for. */
+static ucs_status_t
+uct_tcp_ep_zerocopy_comp_add(uct_tcp_ep_t *ep, int send_flags,
+                             uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zerocopy_completion_t *zcomp;
+
+    if (ucs_likely(!(send_flags & UCT_TCP_MSG_ZEROCOPY)) ||
+        !uct_tcp_ep_zerocopy_is_pending(ep)) {
+        return UCS_OK;
+    }
+
+    if (comp == NULL) {
+        return UCS_INPROGRESS;
+    }
+
+    zcomp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(zcomp == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate MSG_ZEROCOPY completion "
+                  "from mpool", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    zcomp->wait_sn = ep->zerocopy.sn;
+    zcomp->comp    = comp;
+    ucs_queue_push(&ep->zerocopy.comp_q, &zcomp->elem);
+
+    return UCS_INPROGRESS;
+}
+
+/* Send IOVs, where the first copy_iov_cnt ones are TCP service headers which
+ * reside in the TX buffer or on the stack. They are always copied to the
+ * socket, and only the user's payload may be sent with MSG_ZEROCOPY, since
+ * the kernel keeps referencing the pages of zero-copied data after return. */
+static ucs_status_t
+uct_tcp_ep_zerocopy_sendv(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                          size_t copy_iov_cnt, size_t *sent_length_p)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    size_t copy_length     = 0;
+    size_t zcopy_length;
+    ucs_status_t status;
+
+    if (copy_iov_cnt > 0) {
+        status = ucs_socket_sendv_nb(ep->fd, iov, copy_iov_cnt, 0,
+                                     &copy_length);
+        if ((status != UCS_OK) ||
+            (copy_length < ucs_iovec_total_length(iov, copy_iov_cnt))) {
+            *sent_length_p = copy_length;
+            return status;
+        }
+    }
+
+    status = ucs_socket_sendv_nb(ep->fd, &iov[copy_iov_cnt],
+                                 iov_cnt - copy_iov_cnt, UCT_TCP_MSG_ZEROCOPY,
+                                 &zcopy_length);
+    if (status == UCS_ERR_IO_ERROR) {
+        /* sendmsg(MSG_ZEROCOPY) fails with ENOBUFS when the socket runs out
+         * of memory to track notifications, fall back to copying the data */
+        status = ucs_socket_sendv_nb(ep->fd, &iov[copy_iov_cnt],
+                                     iov_cnt - copy_iov_cnt, 0, &zcopy_length);
+    } else if ((status == UCS_OK) && (zcopy_length > 0)) {
+        /* Every MSG_ZEROCOPY send which queued some data is completed by
+         * a notification with the next sequence number */
+        if (!uct_tcp_ep_zerocopy_is_pending(ep)) {
+            ucs_list_add_tail(&iface->zerocopy_ep_list, &ep->zerocopy.list);
+            uct_tcp_iface_outstanding_inc(iface);
+        }
+
+        ep->zerocopy.sn++;
+    }
+
+    *sent_length_p = copy_length + zcopy_length;
+    if ((status == UCS_ERR_NO_PROGRESS) && (copy_length > 0)) {
+        /* Service headers were sent */
+        return UCS_OK;
+    }
+
+    return status;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_sendv_nb(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                    size_t copy_iov_cnt, int send_flags, size_t *sent_length_p)
+{
+    if (ucs_likely(!(send_flags & UCT_TCP_MSG_ZEROCOPY))) {
+        return ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, 0, sent_length_p);
+    }
+
+    return uct_tcp_ep_zerocopy_sendv(ep, iov, iov_cnt, copy_iov_cnt,
+                                     sent_length_p);
+}
+
+static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep, uint32_t put_sn)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
     uct_tcp_ep_put_completion_t *put_comp;
+    ucs_status_t status;
 
-    if (put_ack->sn == ep->tx.put_sn) {
+    if (put_sn == ep->tx.put_sn) {
         /* Since there are no other PUT operations in-flight, can remove flag
          * and decrement iface outstanding operations counter */
         ucs_assert(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK);
@@ -1027,8 +1316,14 @@ static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
 
     ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem,
                                (UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn,
-                                                       <=, put_ack->sn))) {
-        uct_invoke_completion(put_comp->comp, UCS_OK);
+                                                       <=, put_sn))) {
+        /* PUT payload may be still referenced by the kernel if it was sent
+         * with MSG_ZEROCOPY, then wait for all notifications */
+        status = uct_tcp_ep_zerocopy_comp_add(ep, UCT_TCP_MSG_ZEROCOPY,
+                                              put_comp->comp);
+        if (status != UCS_INPROGRESS) {
+            uct_invoke_completion(put_comp->comp, status);
+        }
         ucs_mpool_put_inline(put_comp);
     }
 }
@@ -1135,8 +1430,11 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     ucs_assertv((ep->tx.offset < ep->tx.length) &&
                 (ctx->iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
-                                 ctx->iov_cnt - ctx->iov_index, &sent_length);
+    status = uct_tcp_ep_sendv_nb(ep, &ctx->iov[ctx->iov_index],
+                                 ctx->iov_cnt - ctx->iov_index,
+                                 (ctx->iov_index < ctx->payload_iov_index) ?
+                                 (ctx->payload_iov_index - ctx->iov_index) : 0,
+                                 ctx->send_flags, &sent_length);
     if (ucs_unlikely(status != UCS_OK)) {
         if (status == UCS_ERR_NO_PROGRESS) {
             ucs_assert(sent_length == 0);
@@ -1154,7 +1452,13 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
         ucs_iov_advance(ctx->iov, ctx->iov_cnt,
                         &ctx->iov_index, sent_length);
     } else {
-        uct_tcp_ep_zcopy_completed(ep, ctx->comp, UCS_OK);
+        status = uct_tcp_ep_zerocopy_comp_add(ep, ctx->send_flags, ctx->comp);
+        if (status == UCS_INPROGRESS) {
+            /* The completion will be invoked upon MSG_ZEROCOPY notification */
+            uct_tcp_ep_zcopy_completed(ep, NULL, UCS_OK);
+        } else {
+            uct_tcp_ep_zcopy_completed(ep, ctx->comp, status);
+        }
     }
 
     ucs_assert(sent_length <= SSIZE_MAX);
@@ -1316,9 +1620,12 @@ static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
     }
 }
 
-/* Forward declaration - the function depends on AM send
+/* Forward declarations - the functions depend on AM send
  * functions implemented below */
 static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep);
+static void uct_tcp_ep_post_reply(uct_tcp_ep_t *ep,
+                                  const uct_tcp_ep_reply_t *reply);
+static void uct_tcp_ep_post_replies(uct_tcp_ep_t *ep);
 
 static unsigned uct_tcp_ep_progress_data_tx(void *arg)
 {
@@ -1343,6 +1650,10 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg)
         uct_tcp_ep_check_tx_completion(ep);
     }
 
+    if (!ucs_queue_is_empty(&ep->reply_q)) {
+        uct_tcp_ep_post_replies(ep);
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK) {
         uct_tcp_ep_post_put_ack(ep);
     }
@@ -1431,6 +1742,154 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
+static void uct_tcp_ep_handle_get_req(uct_tcp_ep_t *ep,
+                                      const uct_tcp_ep_get_req_hdr_t *get_req)
+{
+    uct_tcp_ep_reply_t reply;
+
+    ucs_assert(get_req->addr || !get_req->length);
+
+    reply.am_id = UCT_TCP_EP_GET_REP_AM_ID;
+    reply.get   = *get_req;
+    uct_tcp_ep_post_reply(ep, &reply);
+}
+
+static void uct_tcp_ep_handle_amo_req(uct_tcp_ep_t *ep,
+                                      const uct_tcp_ep_amo_req_hdr_t *amo_req)
+{
+    uint64_t *ptr = (uint64_t*)(uintptr_t)amo_req->addr;
+    uct_tcp_ep_reply_t reply;
+
+    switch (amo_req->opcode) {
+    case UCT_ATOMIC_OP_ADD:
+        reply.result = ucs_atomic_fadd64(ptr, amo_req->value);
+        break;
+    case UCT_ATOMIC_OP_AND:
+        reply.result = ucs_atomic_fand64(ptr, amo_req->value);
+        break;
+    case UCT_ATOMIC_OP_OR:
+        reply.result = ucs_atomic_for64(ptr, amo_req->value);
+        break;
+    case UCT_ATOMIC_OP_XOR:
+        reply.result = ucs_atomic_fxor64(ptr, amo_req->value);
+        break;
+    case UCT_ATOMIC_OP_SWAP:
+        reply.result = ucs_atomic_swap64(ptr, amo_req->value);
+        break;
+    case UCT_TCP_EP_AMO_OP_CSWAP:
+        reply.result = ucs_atomic_cswap64(ptr, amo_req->compare,
+                                          amo_req->value);
+        break;
+    default:
+        ucs_fatal("tcp_ep %p: unexpected atomic opcode %u", ep,
+                  amo_req->opcode);
+    }
+
+    ucs_trace_data("tcp_ep %p: executed atomic op %u on %p [value %" PRIu64
+                   " compare %" PRIu64 " result %" PRIu64 "]", ep,
+                   amo_req->opcode, ptr, amo_req->value, amo_req->compare,
+                   reply.result);
+
+    ep->rx.put_sn = amo_req->sn;
+    if (amo_req->fetch) {
+        reply.am_id = UCT_TCP_EP_AMO_REP_AM_ID;
+        uct_tcp_ep_post_reply(ep, &reply);
+    } else {
+        /* Non-fetching atomic operation is acknowledged as PUT, so that
+         * flush completes only after it was executed */
+        uct_tcp_ep_post_put_ack(ep);
+    }
+}
+
+static void uct_tcp_ep_fetch_completed(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_fetch_op_t *op = ucs_queue_pull_elem_non_empty(
+            &ep->fetch_q, uct_tcp_ep_fetch_op_t, elem);
+    uint32_t put_sn           = op->put_sn;
+
+    if (op->comp != NULL) {
+        uct_invoke_completion(op->comp, UCS_OK);
+    }
+
+    ucs_mpool_put_inline(op);
+
+    /* The peer replies after handling all requests which were sent before,
+     * so the reply acknowledges the preceding PUT operations as well */
+    uct_tcp_ep_handle_put_ack(ep, put_sn);
+}
+
+static inline ucs_status_t
+uct_tcp_ep_get_rx_advance(uct_tcp_ep_t *ep, uct_tcp_ep_fetch_op_t *op,
+                          size_t recv_length)
+{
+    ucs_assert(recv_length <= op->length);
+    op->length -= recv_length;
+    if (op->iov_cnt != 0) {
+        ucs_iov_advance(op->iov, op->iov_cnt, &op->iov_index, recv_length);
+    }
+
+    if (op->length != 0) {
+        return UCS_INPROGRESS;
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        uct_tcp_ep_ctx_reset(&ep->rx);
+    }
+
+    uct_tcp_ep_fetch_completed(ep);
+    return UCS_OK;
+}
+
+static void uct_tcp_ep_handle_get_rep(uct_tcp_ep_t *ep,
+                                      const uct_tcp_ep_get_rep_hdr_t *get_rep)
+{
+    uct_tcp_ep_fetch_op_t *op = ucs_queue_head_elem_non_empty(
+            &ep->fetch_q, uct_tcp_ep_fetch_op_t, elem);
+    size_t copied_length;
+    ucs_status_t status;
+
+    ucs_assertv((op->am_id == UCT_TCP_EP_GET_REP_AM_ID) &&
+                (op->length == get_rep->length),
+                "ep=%p am_id=%u length=%zu/%zu", ep, op->am_id, op->length,
+                get_rep->length);
+
+    copied_length = ucs_min(op->length, ep->rx.length - ep->rx.offset);
+    if (op->iov_cnt != 0) {
+        ucs_iov_copy(&op->iov[op->iov_index], op->iov_cnt - op->iov_index, 0,
+                     UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+                     copied_length, UCS_IOV_COPY_FROM_BUF);
+    }
+    ep->rx.offset += copied_length;
+
+    status = uct_tcp_ep_get_rx_advance(ep, op, copied_length);
+    if (status == UCS_OK) {
+        return;
+    }
+
+    /* The rest of the payload is received directly to the user's buffer,
+     * the RX buffer is kept to drop the payload of a canceled operation */
+    ucs_assert(ep->rx.offset == ep->rx.length);
+    uct_tcp_ep_ctx_rewind(&ep->rx);
+    ep->flags |= UCT_TCP_EP_FLAG_GET_RX;
+}
+
+static void uct_tcp_ep_handle_amo_rep(uct_tcp_ep_t *ep,
+                                      const uct_tcp_ep_amo_rep_hdr_t *amo_rep)
+{
+    uct_tcp_ep_fetch_op_t *op = ucs_queue_head_elem_non_empty(
+            &ep->fetch_q, uct_tcp_ep_fetch_op_t, elem);
+
+    ucs_assertv(op->am_id == UCT_TCP_EP_AMO_REP_AM_ID, "ep=%p am_id=%u", ep,
+                op->am_id);
+
+    if (op->result != NULL) {
+        *op->result = amo_rep->result;
+    }
+
+    uct_tcp_ep_fetch_completed(ep);
+}
+
 static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -1522,9 +1981,31 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
                  * release a EP RX buffer */
                 goto out;
             }
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REP_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_rep_hdr_t));
+            uct_tcp_ep_handle_get_rep(ep, (uct_tcp_ep_get_rep_hdr_t*)(hdr + 1));
+            handled++;
+            if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+                /* GET RX is in progress, the EP RX buffer is used to drop
+                 * the payload if the operation is canceled */
+                goto out;
+            }
+        } else if (hdr->am_id == UCT_TCP_EP_AMO_REP_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_amo_rep_hdr_t));
+            uct_tcp_ep_handle_amo_rep(ep, (uct_tcp_ep_amo_rep_hdr_t*)(hdr + 1));
+            handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_req_hdr_t));
+            uct_tcp_ep_handle_get_req(ep, (uct_tcp_ep_get_req_hdr_t*)(hdr + 1));
+            handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_AMO_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_amo_req_hdr_t));
+            uct_tcp_ep_handle_amo_req(ep, (uct_tcp_ep_amo_req_hdr_t*)(hdr + 1));
+            handled++;
         } else if (hdr->am_id == UCT_TCP_EP_PUT_ACK_AM_ID) {
             ucs_assert(hdr->length == sizeof(uint32_t));
-            uct_tcp_ep_handle_put_ack(ep, (uct_tcp_ep_put_ack_hdr_t*)(hdr + 1));
+            uct_tcp_ep_handle_put_ack(ep,
+                                      ((uct_tcp_ep_put_ack_hdr_t*)(hdr + 1))->sn);
             handled++;
         } else if (hdr->am_id == UCT_TCP_EP_KEEPALIVE_AM_ID) {
             /* just ignore keepalive requests */
@@ -1600,14 +2081,53 @@ static unsigned uct_tcp_ep_progress_put_rx(uct_tcp_ep_t *ep)
     return 1;
 }
 
+static unsigned uct_tcp_ep_progress_get_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface    = ucs_derived_of(ep->super.super.iface,
+                                               uct_tcp_iface_t);
+    uct_tcp_ep_fetch_op_t *op = ucs_queue_head_elem_non_empty(
+            &ep->fetch_q, uct_tcp_ep_fetch_op_t, elem);
+    size_t recv_length;
+    ucs_status_t status;
+    void *buffer;
+
+    ucs_assert(op->length != 0);
+
+    if (op->iov_cnt != 0) {
+        buffer      = op->iov[op->iov_index].iov_base;
+        recv_length = ucs_min(op->iov[op->iov_index].iov_len, op->length);
+    } else {
+        /* The operation was canceled, drop the payload */
+        buffer      = ep->rx.buf;
+        recv_length = ucs_min(iface->config.rx_seg_size, op->length);
+    }
+
+    status = ucs_socket_recv_nb(ep->fd, buffer, 0, &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            uct_tcp_ep_handle_recv_err(ep, status);
+        }
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+
+    uct_tcp_ep_get_rx_advance(ep, op, recv_length);
+
+    return 1;
+}
+
 static unsigned uct_tcp_ep_progress_data_rx(void *arg)
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
 
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
+    if (ucs_likely(!(ep->flags & (UCT_TCP_EP_FLAG_PUT_RX |
+                                  UCT_TCP_EP_FLAG_GET_RX)))) {
         return uct_tcp_ep_progress_am_rx(ep);
-    } else {
+    } else if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
         return uct_tcp_ep_progress_put_rx(ep);
+    } else {
+        return uct_tcp_ep_progress_get_rx(ep);
     }
 }
 
@@ -1734,7 +2254,8 @@ uct_tcp_ep_am_sendv_get_trace_payload(uct_tcp_am_hdr_t *hdr,
 static inline ucs_status_t
 uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
                     size_t send_limit, const void *header,
-                    struct iovec *iov, size_t iov_cnt)
+                    struct iovec *iov, size_t iov_cnt, size_t copy_iov_cnt,
+                    int send_flags)
 {
     uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
                                                          uct_tcp_iface_t);
@@ -1746,7 +2267,8 @@ uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
     ucs_assertv((ep->tx.length <= send_limit) &&
                 (iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    status = uct_tcp_ep_sendv_nb(ep, iov, iov_cnt, copy_iov_cnt, send_flags,
+                                 &sent_length);
     if (ucs_unlikely((status != UCS_OK) && (status != UCS_ERR_NO_PROGRESS))) {
         return uct_tcp_ep_handle_send_err(ep, status);
     }
@@ -1784,6 +2306,13 @@ static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep)
     uct_tcp_ep_put_ack_hdr_t *put_ack;
     ucs_status_t status;
 
+    if (!ucs_queue_is_empty(&ep->reply_q)) {
+        /* PUT ACK acknowledges GET/AMO requests received before it, so it
+         * must not overtake the replies to these requests */
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
+        return;
+    }
+
     /* Make sure that we are sending nothing through this EP at the moment.
      * This check is needed to avoid mixing AM/PUT data sent from this EP
      * and this PUT ACK message */
@@ -1821,7 +2350,7 @@ uct_tcp_ep_am_short_sendv(uct_tcp_ep_t *ep, uct_tcp_iface_t *iface,
     size_t offset;
 
     status = uct_tcp_ep_am_sendv(ep, 1, hdr, iface->config.tx_seg_size, &header, iov,
-                                 iov_cnt);
+                                 iov_cnt, 0, 0);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
@@ -2005,12 +2534,15 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
     }
 
     /* User-defined payload */
+    ctx->payload_iov_index = ctx->iov_cnt;
     ucs_iov_iter_init(&uct_iov_iter);
     io_vec_cnt       = iovcnt;
     *zcopy_payload_p = uct_iov_to_iovec(&ctx->iov[ctx->iov_cnt], &io_vec_cnt,
                                         iov, iovcnt, SIZE_MAX, &uct_iov_iter);
     *ctx_p           = ctx;
     ctx->iov_cnt    += io_vec_cnt;
+    ctx->send_flags  = (*zcopy_payload_p >= iface->config.zerocopy_thresh) ?
+                       UCT_TCP_MSG_ZEROCOPY : 0;
 
     return UCS_OK;
 }
@@ -2041,7 +2573,8 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     ctx->super.length = payload_length + header_length;
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, iface->config.rx_seg_size,
-                                 header, ctx->iov, ctx->iov_cnt);
+                                 header, ctx->iov, ctx->iov_cnt,
+                                 ctx->payload_iov_index, ctx->send_flags);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
@@ -2054,7 +2587,7 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
         return UCS_INPROGRESS;
     }
 
-    return UCS_OK;
+    return uct_tcp_ep_zerocopy_comp_add(ep, ctx->send_flags, comp);
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -2114,7 +2647,8 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     put_req.sn        = ep->tx.put_sn + 1;
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
-                                 &put_req, ctx->iov, ctx->iov_cnt);
+                                 &put_req, ctx->iov, ctx->iov_cnt,
+                                 ctx->payload_iov_index, ctx->send_flags);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
@@ -2146,6 +2680,307 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     return UCS_INPROGRESS;
 }
 
+static ucs_status_t
+uct_tcp_ep_send_reply(uct_tcp_ep_t *ep, const uct_tcp_ep_reply_t *reply)
+{
+    uct_tcp_iface_t *iface           = ucs_derived_of(ep->super.super.iface,
+                                                      uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx       = NULL;
+    uct_tcp_am_hdr_t *hdr            = NULL;
+    uct_tcp_ep_get_rep_hdr_t get_rep = {0};
+    uct_iov_t iov;
+    ucs_status_t status;
+
+    if (reply->am_id == UCT_TCP_EP_AMO_REP_AM_ID) {
+        status = uct_tcp_ep_am_prepare(iface, ep, reply->am_id, &hdr);
+        if (ucs_unlikely(status != UCS_OK)) {
+            return status;
+        }
+
+        hdr->length = sizeof(uct_tcp_ep_amo_rep_hdr_t);
+        ((uct_tcp_ep_amo_rep_hdr_t*)(hdr + 1))->result = reply->result;
+        return uct_tcp_ep_am_send(ep, hdr);
+    }
+
+    ucs_assert(reply->am_id == UCT_TCP_EP_GET_REP_AM_ID);
+
+    /* Stream the requested memory back to the peer directly from the
+     * local buffer */
+    iov.buffer = (void*)(uintptr_t)reply->get.addr;
+    iov.length = reply->get.length;
+    iov.memh   = UCT_MEM_HANDLE_NULL;
+    iov.stride = 0;
+    iov.count  = 1;
+
+    status = uct_tcp_ep_prepare_zcopy(iface, ep, reply->am_id, &get_rep,
+                                      sizeof(get_rep), &iov, 1, "get_rep",
+                                      /* GET reply payload length is not
+                                       * set to TCP AM hdr as for PUT */
+                                      &ep->tx.length, &ctx);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    ctx->super.length = sizeof(get_rep);
+    get_rep.length    = ep->tx.length;
+
+    status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_GET_ZCOPY_MAX,
+                                 &get_rep, ctx->iov, ctx->iov_cnt,
+                                 ctx->payload_iov_index, ctx->send_flags);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+        uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &get_rep,
+                                         sizeof(get_rep), NULL);
+    }
+
+    return UCS_OK;
+}
+
+static void uct_tcp_ep_post_reply(uct_tcp_ep_t *ep,
+                                  const uct_tcp_ep_reply_t *reply)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_reply_t *queued_reply;
+    ucs_status_t status;
+
+    /* The reply acknowledges all operations received before the request, so
+     * a pending PUT ACK must not be sent after it, otherwise the peer would
+     * get a duplicate acknowledgment */
+    ep->flags &= ~UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
+
+    if (ucs_queue_is_empty(&ep->reply_q)) {
+        status = uct_tcp_ep_send_reply(ep, reply);
+        if (ucs_likely(status != UCS_ERR_NO_RESOURCE)) {
+            return;
+        }
+    }
+
+    queued_reply = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(queued_reply == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate reply from mpool", ep);
+        return;
+    }
+
+    *queued_reply = *reply;
+    ucs_queue_push(&ep->reply_q, &queued_reply->elem);
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+}
+
+static void uct_tcp_ep_post_replies(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_reply_t *reply;
+
+    ucs_queue_for_each_extract(reply, &ep->reply_q, elem,
+                               uct_tcp_ep_send_reply(ep, reply) !=
+                               UCS_ERR_NO_RESOURCE) {
+        ucs_mpool_put_inline(reply);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_tcp_ep_put_sn_advance(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
+{
+    ep->tx.put_sn++;
+    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK)) {
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
+        uct_tcp_iface_outstanding_inc(iface);
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_NEED_FLUSH;
+}
+
+static ucs_status_t
+uct_tcp_ep_fetch_send(uct_tcp_ep_t *ep, uct_tcp_am_hdr_t *hdr,
+                      uct_tcp_ep_fetch_op_t *op)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_mpool_put_inline(op);
+        return status;
+    }
+
+    /* A reply to the request acknowledges all operations sent before it,
+     * so it is handled the same way as PUT ACK */
+    uct_tcp_ep_put_sn_advance(iface, ep);
+    op->put_sn = ep->tx.put_sn;
+    ucs_queue_push(&ep->fetch_q, &op->elem);
+
+    return UCS_INPROGRESS;
+}
+
+static UCS_F_ALWAYS_INLINE uct_tcp_ep_fetch_op_t*
+uct_tcp_ep_fetch_op_get(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                        uint8_t am_id, uct_completion_t *comp)
+{
+    uct_tcp_ep_fetch_op_t *op;
+
+    op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate fetch operation from mpool",
+                  ep);
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        return NULL;
+    }
+
+    op->am_id     = am_id;
+    op->comp      = comp;
+    op->result    = NULL;
+    op->length    = 0;
+    op->iov_index = 0;
+    op->iov_cnt   = 0;
+    return op;
+}
+
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_get_req_hdr_t *get_req;
+    uct_tcp_ep_fetch_op_t *op;
+    ucs_iov_iter_t uct_iov_iter;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt,
+                       iface->config.max_iov - UCT_TCP_EP_ZCOPY_SERVICE_IOV_COUNT,
+                       "get_zcopy");
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    op = uct_tcp_ep_fetch_op_get(iface, ep, UCT_TCP_EP_GET_REP_AM_ID, comp);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_iov_iter_init(&uct_iov_iter);
+    op->iov_cnt = iovcnt;
+    op->length  = uct_iov_to_iovec(op->iov, &op->iov_cnt, iov, iovcnt,
+                                   SIZE_MAX, &uct_iov_iter);
+    /* Skip leading empty IOVs */
+    ucs_iov_advance(op->iov, op->iov_cnt, &op->iov_index, 0);
+
+    hdr->length     = sizeof(*get_req);
+    get_req         = (uct_tcp_ep_get_req_hdr_t*)(hdr + 1);
+    get_req->addr   = remote_addr;
+    get_req->length = op->length;
+
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, op->length);
+
+    return uct_tcp_ep_fetch_send(ep, hdr, op);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_amo_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                       unsigned opcode, uint64_t value, uint64_t compare,
+                       uint64_t remote_addr, int fetch, uct_tcp_am_hdr_t **hdr_p)
+{
+    uct_tcp_ep_amo_req_hdr_t *amo_req;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_AMO_REQ_AM_ID, hdr_p);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    (*hdr_p)->length = sizeof(*amo_req);
+    amo_req          = (uct_tcp_ep_amo_req_hdr_t*)(*hdr_p + 1);
+    amo_req->addr    = remote_addr;
+    amo_req->value   = value;
+    amo_req->compare = compare;
+    amo_req->opcode  = opcode;
+    amo_req->sn      = ep->tx.put_sn + 1;
+    amo_req->fetch   = fetch;
+
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_tcp_ep_amo_fetch(uct_tcp_ep_t *ep, unsigned opcode, uint64_t value,
+                     uint64_t compare, uint64_t remote_addr, uint64_t *result,
+                     uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_fetch_op_t *op;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_amo_prepare(iface, ep, opcode, value, compare,
+                                    remote_addr, 1, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    op = uct_tcp_ep_fetch_op_get(iface, ep, UCT_TCP_EP_AMO_REP_AM_ID, comp);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    op->result = result;
+    UCT_TL_EP_STAT_ATOMIC(&ep->super);
+
+    return uct_tcp_ep_fetch_send(ep, hdr, op);
+}
+
+ucs_status_t uct_tcp_ep_atomic64_post(uct_ep_h uct_ep, unsigned opcode,
+                                      uint64_t value, uint64_t remote_addr,
+                                      uct_rkey_t rkey)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_amo_prepare(iface, ep, opcode, value, 0, remote_addr,
+                                    0, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    UCT_TL_EP_STAT_ATOMIC(&ep->super);
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    /* Wait for PUT ACK from the peer to complete flush */
+    uct_tcp_ep_put_sn_advance(iface, ep);
+    return UCS_OK;
+}
+
+ucs_status_t uct_tcp_ep_atomic64_fetch(uct_ep_h uct_ep, uct_atomic_op_t opcode,
+                                       uint64_t value, uint64_t *result,
+                                       uint64_t remote_addr, uct_rkey_t rkey,
+                                       uct_completion_t *comp)
+{
+    return uct_tcp_ep_amo_fetch(ucs_derived_of(uct_ep, uct_tcp_ep_t), opcode,
+                                value, 0, remote_addr, result, comp);
+}
+
+ucs_status_t uct_tcp_ep_atomic_cswap64(uct_ep_h uct_ep, uint64_t compare,
+                                       uint64_t swap, uint64_t remote_addr,
+                                       uct_rkey_t rkey, uint64_t *result,
+                                       uct_completion_t *comp)
+{
+    return uct_tcp_ep_amo_fetch(ucs_derived_of(uct_ep, uct_tcp_ep_t),
+                                UCT_TCP_EP_AMO_OP_CSWAP, swap, compare,
+                                remote_addr, result, comp);
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
@@ -2225,6 +3060,14 @@ ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
         return UCS_INPROGRESS;
     }
 
+    status = uct_tcp_ep_zerocopy_comp_add(ep, UCT_TCP_MSG_ZEROCOPY, comp);
+    if (status != UCS_OK) {
+        if (status == UCS_INPROGRESS) {
+            UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+        }
+        return status;
+    }
+
     UCT_TL_EP_STAT_FLUSH(&ep->super);
     return UCS_OK;
 }
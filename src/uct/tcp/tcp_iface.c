@@ -23,6 +23,13 @@
 
 extern ucs_class_t UCS_CLASS_DECL_NAME(uct_tcp_iface_t);
 
+const char *uct_tcp_io_engine_names[] = {
+    [UCT_TCP_IO_ENGINE_EPOLL]    = "epoll",
+    [UCT_TCP_IO_ENGINE_IO_URING] = "io_uring",
+    [UCT_TCP_IO_ENGINE_AUTO]     = "auto",
+    [UCT_TCP_IO_ENGINE_LAST]     = NULL
+};
+
 static ucs_config_field_t uct_tcp_iface_config_table[] = {
   {"", "MAX_NUM_EPS=256", NULL,
    ucs_offsetof(uct_tcp_iface_config_t, super),
@@ -45,6 +52,14 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"ZEROCOPY_THRESH", "inf",
+   "Threshold for sending AM/PUT Zcopy payload with MSG_ZEROCOPY flag, which\n"
+   "lets the kernel transmit the user's buffer without copying it to the socket\n"
+   "buffer. The operation is completed when the kernel notifies that the buffer\n"
+   "was released. \"inf\" disables MSG_ZEROCOPY.",
+   ucs_offsetof(uct_tcp_iface_config_t, zerocopy_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -53,6 +68,16 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Enable PUT Zcopy support",
    ucs_offsetof(uct_tcp_iface_config_t, put_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"GET_ENABLE", "y",
+   "Enable GET Zcopy support. The remote memory is sent back by the peer's\n"
+   "TCP transport from its receive path.",
+   ucs_offsetof(uct_tcp_iface_config_t, get_enable), UCS_CONFIG_TYPE_BOOL},
+
+  {"ATOMIC_ENABLE", "y",
+   "Enable 64-bit atomic operations support. The operations are executed by\n"
+   "the peer's TCP transport in its receive path using CPU atomics.",
+   ucs_offsetof(uct_tcp_iface_config_t, atomic_enable), UCS_CONFIG_TYPE_BOOL},
+
   {"CONN_NB", "n",
    "Enable non-blocking connection establishment. It may improve startup "
    "time, but can lead to connection resets due to high load on TCP/IP stack",
@@ -117,6 +142,17 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    ucs_offsetof(uct_tcp_iface_config_t, ep_bind_src_addr),
                 UCS_CONFIG_TYPE_TERNARY},
 
+  {"IO_ENGINE", "epoll",
+   "Engine which is used to wait for socket events:\n"
+   " epoll    - call epoll_wait() on every progress call.\n"
+   " io_uring - post poll requests to io_uring and reap their completions from\n"
+   "            the shared completion queue, so an idle progress call does not\n"
+   "            enter the kernel, and re-armed requests of all sockets are\n"
+   "            submitted by a single system call.\n"
+   " auto     - use io_uring if it is supported, otherwise epoll.",
+   ucs_offsetof(uct_tcp_iface_config_t, io_engine),
+   UCS_CONFIG_TYPE_ENUM(uct_tcp_io_engine_names)},
+
   {NULL}
 };
 
@@ -345,6 +381,29 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
             attr->cap.put.opt_zcopy_align  = 1;
             attr->cap.flags               |= UCT_IFACE_FLAG_PUT_ZCOPY;
         }
+
+        if (iface->config.get_enable) {
+            /* GET */
+            attr->cap.get.max_iov          = iface->config.max_iov -
+                                             UCT_TCP_EP_ZCOPY_SERVICE_IOV_COUNT;
+            attr->cap.get.max_zcopy        = UCT_TCP_EP_GET_ZCOPY_MAX;
+            attr->cap.get.opt_zcopy_align  = 1;
+            attr->cap.flags               |= UCT_IFACE_FLAG_GET_ZCOPY;
+        }
+    }
+
+    if (iface->config.atomic_enable) {
+        attr->cap.flags              |= UCT_IFACE_FLAG_ATOMIC_CPU;
+        attr->cap.atomic64.op_flags   = UCS_BIT(UCT_ATOMIC_OP_ADD) |
+                                        UCS_BIT(UCT_ATOMIC_OP_AND) |
+                                        UCS_BIT(UCT_ATOMIC_OP_OR)  |
+                                        UCS_BIT(UCT_ATOMIC_OP_XOR);
+        attr->cap.atomic64.fop_flags  = UCS_BIT(UCT_ATOMIC_OP_ADD)  |
+                                        UCS_BIT(UCT_ATOMIC_OP_AND)  |
+                                        UCS_BIT(UCT_ATOMIC_OP_OR)   |
+                                        UCS_BIT(UCT_ATOMIC_OP_XOR)  |
+                                        UCS_BIT(UCT_ATOMIC_OP_SWAP) |
+                                        UCS_BIT(UCT_ATOMIC_OP_CSWAP);
     }
 
     attr->bandwidth.dedicated = 0;
@@ -372,6 +431,12 @@ static ucs_status_t uct_tcp_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
 
+    if (iface->io_uring != NULL) {
+        /* io_uring fd is readable when its completion queue is not empty */
+        *fd_p = uct_tcp_io_uring_fd(iface->io_uring);
+        return UCS_OK;
+    }
+
     return ucs_event_set_fd_get(iface->event_set, fd_p);
 }
 
@@ -390,6 +455,25 @@ static void uct_tcp_iface_handle_events(void *callback_data,
     if (events & UCS_EVENT_SET_EVWRITE) {
         *count += uct_tcp_ep_cm_state[ep->conn_state].tx_progress(ep);
     }
+    if (events & UCS_EVENT_SET_EVERR) {
+        /* Error queue of the socket contains MSG_ZEROCOPY notifications */
+        *count += uct_tcp_ep_zerocopy_progress(ep);
+    }
+}
+
+static unsigned uct_tcp_iface_zerocopy_progress(uct_tcp_iface_t *iface)
+{
+    unsigned count = 0;
+    uct_tcp_ep_t *ep, *tmp_ep;
+
+    /* Poll EPs which may be not added to the event set, since they don't
+     * wait for RX/TX events */
+    ucs_list_for_each_safe(ep, tmp_ep, &iface->zerocopy_ep_list,
+                           zerocopy.list) {
+        count += uct_tcp_ep_zerocopy_progress(ep);
+    }
+
+    return count;
 }
 
 unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
@@ -401,10 +485,18 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     ucs_status_t status;
 
     do {
-        read_events = ucs_min(ucs_sys_event_set_max_wait_events, max_events);
-        status = ucs_event_set_wait(iface->event_set, &read_events,
-                                    0, uct_tcp_iface_handle_events,
-                                    (void *)&count);
+        if (iface->io_uring != NULL) {
+            read_events = ucs_min(UCT_TCP_MAX_EVENTS, max_events);
+            status      = uct_tcp_io_uring_wait(iface->io_uring, &read_events,
+                                                uct_tcp_iface_handle_events,
+                                                (void*)&count);
+        } else {
+            read_events = ucs_min(ucs_sys_event_set_max_wait_events,
+                                  max_events);
+            status      = ucs_event_set_wait(iface->event_set, &read_events, 0,
+                                             uct_tcp_iface_handle_events,
+                                             (void*)&count);
+        }
         max_events -= read_events;
         ucs_trace_poll("iface=%p ucs_event_set_wait() returned %d: "
                        "read events=%u, total=%u",
@@ -413,6 +505,10 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     } while ((max_events > 0) && (read_events == UCT_TCP_MAX_EVENTS) &&
              ((status == UCS_OK) || (status == UCS_INPROGRESS)));
 
+    if (ucs_unlikely(!ucs_list_is_empty(&iface->zerocopy_ep_list))) {
+        count += uct_tcp_iface_zerocopy_progress(iface);
+    }
+
     return count;
 }
 
@@ -471,6 +567,9 @@ uct_tcp_iface_connect_handler(int listen_fd, ucs_event_set_types_t events,
 ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
                                        int set_nb)
 {
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    int optval = 1;
+#endif
     ucs_status_t status;
 
     if (set_nb) {
@@ -493,7 +592,22 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
         return status;
     }
 
-    return ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
+    status = ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    if (iface->config.zerocopy_thresh != UCS_MEMUNITS_INF) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval,
+                                   sizeof(optval));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
+    return UCS_OK;
 }
 
 static uct_iface_ops_t uct_tcp_iface_ops = {
@@ -502,6 +616,10 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
     .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
+    .ep_atomic_cswap64        = uct_tcp_ep_atomic_cswap64,
+    .ep_atomic64_post         = uct_tcp_ep_atomic64_post,
+    .ep_atomic64_fetch        = uct_tcp_ep_atomic64_fetch,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
@@ -623,6 +741,78 @@ err:
     return status;
 }
 
+static ucs_status_t
+uct_tcp_iface_io_engine_init(uct_tcp_iface_t *iface,
+                             uct_tcp_io_engine_t io_engine)
+{
+    ucs_status_t status;
+
+    iface->io_uring = NULL;
+    if (io_engine == UCT_TCP_IO_ENGINE_EPOLL) {
+        return UCS_OK;
+    }
+
+    status = uct_tcp_io_uring_create(UCT_TCP_IO_URING_ENTRIES,
+                                     iface->super.worker->async,
+                                     &iface->io_uring);
+    if (status == UCS_OK) {
+        ucs_debug("tcp_iface %p: using io_uring progress engine", iface);
+        return UCS_OK;
+    }
+
+    iface->io_uring = NULL;
+    if (io_engine == UCT_TCP_IO_ENGINE_AUTO) {
+        ucs_debug("tcp_iface %p: io_uring is not available, fallback to epoll",
+                  iface);
+        return UCS_OK;
+    }
+
+    ucs_error("tcp_iface %p: failed to create io_uring progress engine: %s",
+              iface, ucs_status_string(status));
+    return status;
+}
+
+static void
+uct_tcp_iface_zerocopy_init(uct_tcp_iface_t *iface, size_t zerocopy_thresh)
+{
+#if UCT_TCP_HAVE_MSG_ZEROCOPY
+    int optval = 1;
+    ucs_status_t status;
+    int fd, ret;
+
+    iface->config.zerocopy_thresh = UCS_MEMUNITS_INF;
+    if (zerocopy_thresh == UCS_MEMUNITS_INF) {
+        return;
+    }
+
+    /* Check that the kernel supports SO_ZEROCOPY for TCP sockets, since
+     * MSG_ZEROCOPY is silently ignored without it */
+    status = ucs_socket_create(iface->config.ifaddr.ss_family, SOCK_STREAM,
+                               IPPROTO_TCP, &fd);
+    if (status != UCS_OK) {
+        return;
+    }
+
+    ret = setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval));
+    ucs_close_fd(&fd);
+    if (ret < 0) {
+        ucs_debug("tcp_iface %p: SO_ZEROCOPY is not supported (%m), "
+                  "MSG_ZEROCOPY is disabled", iface);
+        return;
+    }
+
+    iface->config.zerocopy_thresh = zerocopy_thresh;
+    ucs_debug("tcp_iface %p: using MSG_ZEROCOPY for Zcopy payload >= %zu",
+              iface, zerocopy_thresh);
+#else
+    if (zerocopy_thresh != UCS_MEMUNITS_INF) {
+        ucs_debug("tcp_iface %p: MSG_ZEROCOPY is not supported", iface);
+    }
+
+    iface->config.zerocopy_thresh = UCS_MEMUNITS_INF;
+#endif
+}
+
 static ucs_mpool_ops_t uct_tcp_mpool_ops = {
     .chunk_alloc   = ucs_mpool_chunk_malloc,
     .chunk_release = ucs_mpool_chunk_free,
@@ -716,6 +906,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                                      self->config.zcopy.hdr_offset;
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
+    self->config.get_enable        = config->get_enable;
+    self->config.atomic_enable     = config->atomic_enable;
     self->config.conn_nb           = config->conn_nb;
     self->config.max_poll          = config->max_poll;
     self->config.max_conn_retries  = config->max_conn_retries;
@@ -797,6 +989,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     }
 
     ucs_list_head_init(&self->ep_list);
+    ucs_list_head_init(&self->zerocopy_ep_list);
+    uct_tcp_iface_zerocopy_init(self, config->zerocopy_thresh);
     ucs_conn_match_init(&self->conn_match_ctx, self->config.sockaddr_len,
                         UCT_TCP_CM_CONN_SN_MAX, &uct_tcp_cm_conn_match_ops);
     status = UCS_PTR_MAP_INIT(tcp_ep, &self->ep_ptr_map);
@@ -808,13 +1002,22 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_rx_mpool;
     }
 
-    status = uct_tcp_iface_listener_init(self);
+    status = uct_tcp_iface_io_engine_init(self, config->io_engine);
     if (status != UCS_OK) {
         goto err_cleanup_event_set;
     }
 
+    status = uct_tcp_iface_listener_init(self);
+    if (status != UCS_OK) {
+        goto err_cleanup_io_engine;
+    }
+
     return UCS_OK;
 
+err_cleanup_io_engine:
+    if (self->io_uring != NULL) {
+        uct_tcp_io_uring_destroy(self->io_uring);
+    }
 err_cleanup_event_set:
     ucs_event_set_cleanup(self->event_set);
 err_cleanup_rx_mpool:
@@ -890,6 +1093,9 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
     ucs_close_fd(&self->listen_fd);
+    if (self->io_uring != NULL) {
+        uct_tcp_io_uring_destroy(self->io_uring);
+    }
     ucs_event_set_cleanup(self->event_set);
 }
 
@@ -0,0 +1,634 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2024. ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "tcp.h"
+
+#include <ucs/datastruct/khash.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/async/async.h>
+#include <ucs/arch/cpu.h>
+#include <sys/syscall.h>
+
+#if defined(HAVE_LINUX_IO_URING_H) && defined(__NR_io_uring_setup) && \
+    defined(__NR_io_uring_enter)
+#  define UCT_TCP_HAVE_IO_URING 1
+#else
+#  define UCT_TCP_HAVE_IO_URING 0
+#endif
+
+#if UCT_TCP_HAVE_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <poll.h>
+
+
+#ifndef IORING_SQ_CQ_OVERFLOW
+#  define IORING_SQ_CQ_OVERFLOW         UCS_BIT(1)
+#endif
+
+
+/* User data of the completions which have to be ignored (e.g. poll removal) */
+#define UCT_TCP_IO_URING_IGNORE_UDATA   UINT64_MAX
+
+
+/**
+ * Poll request state of a socket registered on io_uring
+ */
+typedef struct uct_tcp_io_uring_fd {
+    void                  *arg;    /* Callback data passed to the handler */
+    uint32_t              gen;     /* Generation of the last posted poll
+                                    * request, used to filter stale
+                                    * completions after re-arm or removal */
+    ucs_event_set_types_t events;  /* Requested events */
+    ucs_event_set_types_t armed;   /* Events of the in-flight poll request,
+                                    * 0 if no request is in flight */
+} uct_tcp_io_uring_fd_t;
+
+
+KHASH_MAP_INIT_INT(uct_tcp_io_uring_fds, uct_tcp_io_uring_fd_t);
+
+
+/**
+ * Event which was reaped from the completion queue
+ */
+typedef struct uct_tcp_io_uring_event {
+    int                   fd;
+    uint32_t              gen;
+    ucs_event_set_types_t events;
+} uct_tcp_io_uring_event_t;
+
+
+struct uct_tcp_io_uring {
+    int                           fd;        /* io_uring file descriptor */
+    ucs_async_context_t           *async;    /* Protects the SQ and the fd
+                                              * table, since sockets may be
+                                              * added from async context */
+    uint32_t                      gen;       /* Poll request generation
+                                              * counter */
+    khash_t(uct_tcp_io_uring_fds) fds;       /* Registered sockets */
+    int                           in_wait;   /* Defer submissions to the end
+                                              * of the wait call */
+    struct {
+        void                      *ring;     /* Mapped SQ ring */
+        size_t                    ring_size;
+        struct io_uring_sqe       *sqes;     /* Mapped SQE array */
+        size_t                    sqes_size;
+        unsigned                  *head;
+        unsigned                  *tail;
+        unsigned                  *flags;
+        unsigned                  *array;
+        unsigned                  mask;
+        unsigned                  entries;
+        unsigned                  pending;   /* Queued but not submitted SQEs */
+    } sq;
+    struct {
+        void                      *ring;     /* Mapped CQ ring, may be the
+                                              * same as the SQ ring */
+        size_t                    ring_size;
+        struct io_uring_cqe       *cqes;
+        unsigned                  *head;
+        unsigned                  *tail;
+        unsigned                  mask;
+    } cq;
+};
+
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_tcp_io_uring_load_acquire(const unsigned *ptr)
+{
+    unsigned value = *(const volatile unsigned*)ptr;
+
+    ucs_memory_cpu_load_fence();
+    return value;
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_tcp_io_uring_store_release(unsigned *ptr, unsigned value)
+{
+    ucs_memory_cpu_store_fence();
+    *(volatile unsigned*)ptr = value;
+}
+
+static int uct_tcp_io_uring_setup(unsigned entries,
+                                  struct io_uring_params *params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uct_tcp_io_uring_enter(int fd, unsigned to_submit,
+                                  unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                   NULL, 0);
+}
+
+static void *uct_tcp_io_uring_mmap(int fd, size_t size, off_t offset)
+{
+    return mmap(NULL, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, fd, offset);
+}
+
+static ucs_status_t uct_tcp_io_uring_submit(uct_tcp_io_uring_t *ring)
+{
+    int ret;
+
+    while (ring->sq.pending > 0) {
+        ret = uct_tcp_io_uring_enter(ring->fd, ring->sq.pending, 0, 0);
+        if (ret < 0) {
+            if ((errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY)) {
+                return UCS_ERR_NO_PROGRESS;
+            }
+
+            ucs_error("io_uring_enter(fd=%d, to_submit=%u) failed: %m",
+                      ring->fd, ring->sq.pending);
+            return UCS_ERR_IO_ERROR;
+        }
+
+        ucs_assert(ret <= ring->sq.pending);
+        ring->sq.pending -= ret;
+    }
+
+    return UCS_OK;
+}
+
+static int uct_tcp_io_uring_cq_is_empty(uct_tcp_io_uring_t *ring)
+{
+    return (*ring->cq.head == uct_tcp_io_uring_load_acquire(ring->cq.tail)) &&
+           !(uct_tcp_io_uring_load_acquire(ring->sq.flags) &
+             IORING_SQ_CQ_OVERFLOW);
+}
+
+static void uct_tcp_io_uring_flush_overflow(uct_tcp_io_uring_t *ring)
+{
+    int ret;
+
+    if (!(uct_tcp_io_uring_load_acquire(ring->sq.flags) &
+          IORING_SQ_CQ_OVERFLOW)) {
+        return;
+    }
+
+    /* Completions which did not fit the CQ ring are kept by the kernel, and
+     * moved to the ring only when entering it with GETEVENTS */
+    ret = uct_tcp_io_uring_enter(ring->fd, 0, 0, IORING_ENTER_GETEVENTS);
+    if ((ret < 0) && (errno != EINTR) && (errno != EAGAIN) &&
+        (errno != EBUSY)) {
+        ucs_error("io_uring_enter(fd=%d, GETEVENTS) failed: %m", ring->fd);
+    }
+}
+
+static struct io_uring_sqe *uct_tcp_io_uring_get_sqe(uct_tcp_io_uring_t *ring)
+{
+    struct io_uring_sqe *sqe;
+    unsigned tail;
+
+    tail = *ring->sq.tail;
+    if ((tail - uct_tcp_io_uring_load_acquire(ring->sq.head)) >=
+        ring->sq.entries) {
+        /* SQ is full - flush it to the kernel and retry */
+        if ((uct_tcp_io_uring_submit(ring) != UCS_OK) ||
+            ((tail - uct_tcp_io_uring_load_acquire(ring->sq.head)) >=
+             ring->sq.entries)) {
+            return NULL;
+        }
+    }
+
+    sqe                                  = &ring->sq.sqes[tail &
+                                                          ring->sq.mask];
+    ring->sq.array[tail & ring->sq.mask] = tail & ring->sq.mask;
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+static void uct_tcp_io_uring_commit_sqe(uct_tcp_io_uring_t *ring)
+{
+    uct_tcp_io_uring_store_release(ring->sq.tail, *ring->sq.tail + 1);
+    ring->sq.pending++;
+}
+
+static UCS_F_ALWAYS_INLINE uint64_t
+uct_tcp_io_uring_user_data(int fd, uint32_t gen)
+{
+    return ((uint64_t)gen << 32) | (uint32_t)fd;
+}
+
+static ucs_status_t
+uct_tcp_io_uring_poll_add(uct_tcp_io_uring_t *ring, int fd,
+                          uct_tcp_io_uring_fd_t *entry)
+{
+    struct io_uring_sqe *sqe;
+    uint32_t poll_events;
+
+    sqe = uct_tcp_io_uring_get_sqe(ring);
+    if (sqe == NULL) {
+        ucs_error("io_uring %d: submission queue is full", ring->fd);
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    poll_events = 0;
+    if (entry->events & UCS_EVENT_SET_EVREAD) {
+        poll_events |= POLLIN;
+    }
+    if (entry->events & UCS_EVENT_SET_EVWRITE) {
+        poll_events |= POLLOUT;
+    }
+
+    entry->gen         = ++ring->gen;
+    entry->armed       = entry->events;
+    sqe->opcode        = IORING_OP_POLL_ADD;
+    sqe->fd            = fd;
+    sqe->poll32_events = poll_events;
+    sqe->user_data     = uct_tcp_io_uring_user_data(fd, entry->gen);
+    uct_tcp_io_uring_commit_sqe(ring);
+
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_tcp_io_uring_poll_remove(uct_tcp_io_uring_t *ring, int fd,
+                             uct_tcp_io_uring_fd_t *entry)
+{
+    struct io_uring_sqe *sqe;
+
+    sqe = uct_tcp_io_uring_get_sqe(ring);
+    if (sqe == NULL) {
+        ucs_error("io_uring %d: submission queue is full", ring->fd);
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    sqe->opcode    = IORING_OP_POLL_REMOVE;
+    sqe->fd        = -1;
+    sqe->addr      = uct_tcp_io_uring_user_data(fd, entry->gen);
+    sqe->user_data = UCT_TCP_IO_URING_IGNORE_UDATA;
+    uct_tcp_io_uring_commit_sqe(ring);
+
+    /* Completion of the removed request is filtered by the generation */
+    entry->gen   = ++ring->gen;
+    entry->armed = 0;
+    return UCS_OK;
+}
+
+ucs_status_t uct_tcp_io_uring_create(unsigned entries,
+                                     ucs_async_context_t *async,
+                                     uct_tcp_io_uring_t **ring_p)
+{
+    struct io_uring_params params;
+    uct_tcp_io_uring_t *ring;
+    ucs_status_t status;
+
+    ring = ucs_calloc(1, sizeof(*ring), "uct_tcp_io_uring");
+    if (ring == NULL) {
+        ucs_error("failed to allocate TCP io_uring context");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    memset(&params, 0, sizeof(params));
+    ring->fd = uct_tcp_io_uring_setup(entries, &params);
+    if (ring->fd < 0) {
+        ucs_debug("io_uring_setup(entries=%u) failed: %m", entries);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_free;
+    }
+
+    if (!(params.features & IORING_FEAT_NODROP)) {
+        /* Without NODROP, CQ overflow may lose poll completions */
+        ucs_debug("io_uring %d: IORING_FEAT_NODROP is not supported",
+                  ring->fd);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close;
+    }
+
+    ring->sq.ring_size = params.sq_off.array +
+                         (params.sq_entries * sizeof(unsigned));
+    ring->cq.ring_size = params.cq_off.cqes +
+                         (params.cq_entries * sizeof(struct io_uring_cqe));
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq.ring_size = ucs_max(ring->sq.ring_size, ring->cq.ring_size);
+        ring->cq.ring_size = ring->sq.ring_size;
+    }
+
+    ring->sq.ring = uct_tcp_io_uring_mmap(ring->fd, ring->sq.ring_size,
+                                          IORING_OFF_SQ_RING);
+    if (ring->sq.ring == MAP_FAILED) {
+        ucs_error("io_uring %d: failed to map SQ ring: %m", ring->fd);
+        status = UCS_ERR_IO_ERROR;
+        goto err_close;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq.ring = ring->sq.ring;
+    } else {
+        ring->cq.ring = uct_tcp_io_uring_mmap(ring->fd, ring->cq.ring_size,
+                                              IORING_OFF_CQ_RING);
+        if (ring->cq.ring == MAP_FAILED) {
+            ucs_error("io_uring %d: failed to map CQ ring: %m", ring->fd);
+            status = UCS_ERR_IO_ERROR;
+            goto err_unmap_sq_ring;
+        }
+    }
+
+    ring->sq.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sq.sqes      = uct_tcp_io_uring_mmap(ring->fd, ring->sq.sqes_size,
+                                               IORING_OFF_SQES);
+    if (ring->sq.sqes == MAP_FAILED) {
+        ucs_error("io_uring %d: failed to map SQEs: %m", ring->fd);
+        status = UCS_ERR_IO_ERROR;
+        goto err_unmap_cq_ring;
+    }
+
+    ring->sq.head    = UCS_PTR_BYTE_OFFSET(ring->sq.ring, params.sq_off.head);
+    ring->sq.tail    = UCS_PTR_BYTE_OFFSET(ring->sq.ring, params.sq_off.tail);
+    ring->sq.flags   = UCS_PTR_BYTE_OFFSET(ring->sq.ring, params.sq_off.flags);
+    ring->sq.array   = UCS_PTR_BYTE_OFFSET(ring->sq.ring, params.sq_off.array);
+    ring->sq.mask    = *(unsigned*)UCS_PTR_BYTE_OFFSET(ring->sq.ring,
+                                                       params.sq_off.ring_mask);
+    ring->sq.entries = params.sq_entries;
+    ring->sq.pending = 0;
+    ring->cq.head    = UCS_PTR_BYTE_OFFSET(ring->cq.ring, params.cq_off.head);
+    ring->cq.tail    = UCS_PTR_BYTE_OFFSET(ring->cq.ring, params.cq_off.tail);
+    ring->cq.cqes    = UCS_PTR_BYTE_OFFSET(ring->cq.ring, params.cq_off.cqes);
+    ring->cq.mask    = *(unsigned*)UCS_PTR_BYTE_OFFSET(ring->cq.ring,
+                                                       params.cq_off.ring_mask);
+    ring->in_wait    = 0;
+    ring->gen        = 0;
+    ring->async      = async;
+
+    kh_init_inplace(uct_tcp_io_uring_fds, &ring->fds);
+
+    ucs_debug("created io_uring %d with %u SQ and %u CQ entries", ring->fd,
+              params.sq_entries, params.cq_entries);
+    *ring_p = ring;
+    return UCS_OK;
+
+err_unmap_cq_ring:
+    if (ring->cq.ring != ring->sq.ring) {
+        munmap(ring->cq.ring, ring->cq.ring_size);
+    }
+err_unmap_sq_ring:
+    munmap(ring->sq.ring, ring->sq.ring_size);
+err_close:
+    close(ring->fd);
+err_free:
+    ucs_free(ring);
+    return status;
+}
+
+void uct_tcp_io_uring_destroy(uct_tcp_io_uring_t *ring)
+{
+    if (kh_size(&ring->fds) != 0) {
+        ucs_warn("io_uring %d: %u sockets are still registered", ring->fd,
+                 kh_size(&ring->fds));
+    }
+
+    kh_destroy_inplace(uct_tcp_io_uring_fds, &ring->fds);
+    munmap(ring->sq.sqes, ring->sq.sqes_size);
+    if (ring->cq.ring != ring->sq.ring) {
+        munmap(ring->cq.ring, ring->cq.ring_size);
+    }
+    munmap(ring->sq.ring, ring->sq.ring_size);
+    close(ring->fd);
+    ucs_free(ring);
+}
+
+int uct_tcp_io_uring_fd(uct_tcp_io_uring_t *ring)
+{
+    return ring->fd;
+}
+
+ucs_status_t uct_tcp_io_uring_set_events(uct_tcp_io_uring_t *ring, int fd,
+                                         ucs_event_set_types_t events,
+                                         void *arg)
+{
+    uct_tcp_io_uring_fd_t *entry;
+    ucs_status_t status;
+    khiter_t iter;
+    int ret;
+
+    UCS_ASYNC_BLOCK(ring->async);
+
+    iter = kh_get(uct_tcp_io_uring_fds, &ring->fds, fd);
+    if (iter == kh_end(&ring->fds)) {
+        if (events == 0) {
+            status = UCS_OK;
+            goto out;
+        }
+
+        iter = kh_put(uct_tcp_io_uring_fds, &ring->fds, fd, &ret);
+        if (ret == UCS_KH_PUT_FAILED) {
+            status = UCS_ERR_NO_MEMORY;
+            goto out;
+        }
+
+        entry        = &kh_val(&ring->fds, iter);
+        entry->gen   = ++ring->gen;
+        entry->armed = 0;
+    } else {
+        entry = &kh_val(&ring->fds, iter);
+    }
+
+    entry->arg    = arg;
+    entry->events = events;
+
+    if ((entry->armed != 0) && (entry->armed != events)) {
+        status = uct_tcp_io_uring_poll_remove(ring, fd, entry);
+        if (status != UCS_OK) {
+            goto out;
+        }
+    }
+
+    if (events == 0) {
+        kh_del(uct_tcp_io_uring_fds, &ring->fds, iter);
+        /* Flush the removal immediately, since the in-flight poll request
+         * holds a reference to the socket which is about to be closed */
+        status = uct_tcp_io_uring_submit(ring);
+        goto out;
+    }
+
+    if (entry->armed == 0) {
+        status = uct_tcp_io_uring_poll_add(ring, fd, entry);
+        if (status != UCS_OK) {
+            goto out;
+        }
+    }
+
+    status = ring->in_wait ? UCS_OK : uct_tcp_io_uring_submit(ring);
+
+out:
+    UCS_ASYNC_UNBLOCK(ring->async);
+    return (status == UCS_ERR_NO_PROGRESS) ? UCS_OK : status;
+}
+
+static unsigned
+uct_tcp_io_uring_reap(uct_tcp_io_uring_t *ring,
+                      uct_tcp_io_uring_event_t *events, unsigned max_events)
+{
+    unsigned count = 0;
+    uct_tcp_io_uring_fd_t *entry;
+    struct io_uring_cqe *cqe;
+    unsigned head, tail;
+    khiter_t iter;
+    int fd;
+
+    head = *ring->cq.head;
+    tail = uct_tcp_io_uring_load_acquire(ring->cq.tail);
+
+    for (; (head != tail) && (count < max_events); ++head) {
+        cqe = &ring->cq.cqes[head & ring->cq.mask];
+        if (cqe->user_data == UCT_TCP_IO_URING_IGNORE_UDATA) {
+            continue;
+        }
+
+        fd   = (int)(uint32_t)cqe->user_data;
+        iter = kh_get(uct_tcp_io_uring_fds, &ring->fds, fd);
+        if (iter == kh_end(&ring->fds)) {
+            continue;
+        }
+
+        entry = &kh_val(&ring->fds, iter);
+        if (uct_tcp_io_uring_user_data(fd, entry->gen) != cqe->user_data) {
+            /* Completion of a removed or re-armed poll request */
+            continue;
+        }
+
+        entry->armed = 0;
+        if (cqe->res < 0) {
+            ucs_diag("io_uring %d: poll on fd %d failed: %s", ring->fd, fd,
+                     strerror(-cqe->res));
+        }
+
+        events[count].fd     = fd;
+        events[count].gen    = entry->gen;
+        events[count].events = 0;
+        if ((cqe->res < 0) || (cqe->res & (POLLERR | POLLHUP))) {
+            /* Let the handler detect the error by doing IO */
+            events[count].events = entry->events;
+        }
+        if (cqe->res & POLLIN) {
+            events[count].events |= UCS_EVENT_SET_EVREAD;
+        }
+        if (cqe->res & POLLOUT) {
+            events[count].events |= UCS_EVENT_SET_EVWRITE;
+        }
+        events[count].events &= entry->events;
+        if (cqe->res & POLLERR) {
+            /* Error queue may contain MSG_ZEROCOPY notifications */
+            events[count].events |= UCS_EVENT_SET_EVERR;
+        }
+        ++count;
+    }
+
+    uct_tcp_io_uring_store_release(ring->cq.head, head);
+    return count;
+}
+
+ucs_status_t uct_tcp_io_uring_wait(uct_tcp_io_uring_t *ring,
+                                   unsigned *num_events,
+                                   ucs_event_set_handler_t handler, void *arg)
+{
+    uct_tcp_io_uring_event_t events[UCT_TCP_MAX_EVENTS];
+    uct_tcp_io_uring_fd_t *entry;
+    unsigned i, count;
+    ucs_status_t status;
+    khiter_t iter;
+    void *fd_arg;
+
+    ucs_assert(*num_events <= UCT_TCP_MAX_EVENTS);
+
+    /* Reaping completions is done from the shared CQ ring and does not
+     * require a system call */
+    if (uct_tcp_io_uring_cq_is_empty(ring) && (ring->sq.pending == 0)) {
+        *num_events = 0;
+        return UCS_OK;
+    }
+
+    UCS_ASYNC_BLOCK(ring->async);
+    if (*ring->cq.head == uct_tcp_io_uring_load_acquire(ring->cq.tail)) {
+        uct_tcp_io_uring_flush_overflow(ring);
+    }
+
+    count         = uct_tcp_io_uring_reap(ring, events, *num_events);
+    ring->in_wait = 1;
+    UCS_ASYNC_UNBLOCK(ring->async);
+
+    for (i = 0; i < count; ++i) {
+        UCS_ASYNC_BLOCK(ring->async);
+        iter = kh_get(uct_tcp_io_uring_fds, &ring->fds, events[i].fd);
+        if ((iter == kh_end(&ring->fds)) ||
+            (kh_val(&ring->fds, iter).gen != events[i].gen)) {
+            /* The socket was removed or re-armed by a previous handler */
+            UCS_ASYNC_UNBLOCK(ring->async);
+            continue;
+        }
+
+        fd_arg = kh_val(&ring->fds, iter).arg;
+        UCS_ASYNC_UNBLOCK(ring->async);
+
+        if (events[i].events != 0) {
+            handler(fd_arg, events[i].events, arg);
+        }
+
+        /* Re-arm the poll request if the handler did not change it, to keep
+         * level-triggered semantics */
+        UCS_ASYNC_BLOCK(ring->async);
+        iter = kh_get(uct_tcp_io_uring_fds, &ring->fds, events[i].fd);
+        if (iter != kh_end(&ring->fds)) {
+            entry = &kh_val(&ring->fds, iter);
+            if ((entry->armed == 0) && (entry->events != 0)) {
+                uct_tcp_io_uring_poll_add(ring, events[i].fd, entry);
+            }
+        }
+        UCS_ASYNC_UNBLOCK(ring->async);
+    }
+
+    /* Submit all re-armed poll requests with a single system call */
+    UCS_ASYNC_BLOCK(ring->async);
+    ring->in_wait = 0;
+    status        = uct_tcp_io_uring_submit(ring);
+    UCS_ASYNC_UNBLOCK(ring->async);
+
+    *num_events = count;
+    return ((status == UCS_OK) || (status == UCS_ERR_NO_PROGRESS)) ?
+           UCS_OK : status;
+}
+
+#else
+
+ucs_status_t uct_tcp_io_uring_create(unsigned entries,
+                                     ucs_async_context_t *async,
+                                     uct_tcp_io_uring_t **ring_p)
+{
+    ucs_debug("io_uring support is not compiled in");
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void uct_tcp_io_uring_destroy(uct_tcp_io_uring_t *ring)
+{
+}
+
+int uct_tcp_io_uring_fd(uct_tcp_io_uring_t *ring)
+{
+    return -1;
+}
+
+ucs_status_t uct_tcp_io_uring_set_events(uct_tcp_io_uring_t *ring, int fd,
+                                         ucs_event_set_types_t events,
+                                         void *arg)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t uct_tcp_io_uring_wait(uct_tcp_io_uring_t *ring,
+                                   unsigned *num_events,
+                                   ucs_event_set_handler_t handler, void *arg)
+{
+    *num_events = 0;
+    return UCS_ERR_UNSUPPORTED;
+}
+
+#endif
@@ -212,6 +212,7 @@ void test_perf::test_params_init(const test_spec &test,
     params.uct.am_hdr_size = 8;
     params.alignment       = ucs_get_page_size();
     params.max_outstanding = test.max_outstanding;
+    params.batch_size      = 16;
     params.send_mem_type   = test.send_mem_type;
     params.recv_mem_type   = test.recv_mem_type;
     params.percentile_rank = 50.0;
@@ -19,6 +19,7 @@
 extern "C" {
 #include <ucp/core/ucp_context.h>
 #include <ucp/core/ucp_am.h>
+#include <ucp/api/ucpx.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_resource.h>
 #include <ucs/datastruct/mpool.inl>
@@ -893,6 +894,89 @@ UCS_TEST_P(test_ucp_am_nbx, rx_persistent_data)
     EXPECT_EQ(UCS_OK, request_wait(sptr));
 }
 
+UCS_TEST_P(test_ucp_am_nbx, send_batch, "RNDV_THRESH=inf")
+{
+    static const size_t sizes[] = {0, 8, 1 * UCS_KBYTE, 16 * UCS_KBYTE};
+    static const unsigned num_rounds = 3;
+    std::vector<ucp_am_batch_entry_t> entries;
+    std::vector<std::vector<char>> buffers;
+    ucp_request_param_t param;
+    ucs_status_t status;
+
+    set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_data_cb, this);
+    m_hdr.resize(8);
+    ucs::fill_random(m_hdr);
+
+    for (unsigned i = 0; i < num_rounds * ucs_static_array_size(sizes); ++i) {
+        buffers.emplace_back(sizes[i % ucs_static_array_size(sizes)]);
+        mem_buffer::pattern_fill(buffers.back().data(), buffers.back().size(),
+                                 SEED);
+    }
+
+    for (auto &buffer : buffers) {
+        ucp_am_batch_entry_t entry = {};
+
+        entry.ep            = sender().ep();
+        entry.id            = TEST_AM_NBX_ID;
+        entry.header        = m_hdr.data();
+        entry.header_length = m_hdr.size();
+        entry.buffer        = buffer.data();
+        entry.count         = buffer.size();
+        entries.push_back(entry);
+    }
+
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+    param.flags        = get_send_flag();
+
+    m_send_counter += entries.size();
+    status = ucp_am_send_nbx_batch(sender().worker(), entries.data(),
+                                   entries.size(), &param);
+    ASSERT_TRUE((status == UCS_OK) || (status == UCS_INPROGRESS))
+            << ucs_status_string(status);
+
+    for (auto &entry : entries) {
+        EXPECT_FALSE(UCS_PTR_IS_ERR(entry.request));
+        EXPECT_EQ(UCS_OK, request_wait(entry.request));
+    }
+
+    wait_receives();
+    EXPECT_EQ(m_send_counter, m_recv_counter);
+}
+
+#if ENABLE_PARAMS_CHECK
+UCS_TEST_P(test_ucp_am_nbx, send_batch_invalid_id)
+{
+    ucp_am_batch_entry_t entries[2] = {};
+    char data                       = 'd';
+    ucp_request_param_t param;
+    ucs_status_t status;
+
+    set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_rx_check_cb, this);
+
+    entries[0].ep     = sender().ep();
+    entries[0].id     = UINT16_MAX + 1;
+    entries[0].buffer = &data;
+    entries[0].count  = sizeof(data);
+    entries[1]        = entries[0];
+    entries[1].id     = TEST_AM_NBX_ID;
+
+    param.op_attr_mask = 0;
+
+    {
+        scoped_log_handler wrap_err(wrap_errors_logger);
+        status = ucp_am_send_nbx_batch(sender().worker(), entries, 2, &param);
+    }
+
+    /* An invalid entry fails alone, and does not prevent sending the rest */
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, status);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, UCS_PTR_STATUS(entries[0].request));
+    EXPECT_EQ(UCS_OK, request_wait(entries[1].request));
+
+    m_send_counter = 1;
+    wait_receives();
+}
+#endif
+
 // Check that max_short limits are adjusted when rndv threshold is set
 UCS_TEST_P(test_ucp_am_nbx, max_short_thresh_rndv, "RNDV_THRESH=0")
 {
@@ -1455,6 +1539,162 @@ UCS_TEST_P(test_ucp_am_nbx_eager_data_release, multi)
 
 UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_eager_data_release)
 
+class test_ucp_am_nbx_recv_ring : public test_ucp_am_nbx {
+public:
+    static const size_t   RING_BUFFER_SIZE = 256 * UCS_KBYTE;
+    static const unsigned RING_NUM_BUFFERS = 4;
+
+    test_ucp_am_nbx_recv_ring() :
+        m_ring(RING_BUFFER_SIZE * RING_NUM_BUFFERS), m_handler_counter(0)
+    {
+    }
+
+protected:
+    ucs_status_t set_recv_ring(void *buffer)
+    {
+        ucp_am_recv_ring_param_t param;
+
+        param.id          = TEST_AM_NBX_ID;
+        param.buffer      = buffer;
+        param.buffer_size = RING_BUFFER_SIZE;
+        param.num_buffers = RING_NUM_BUFFERS;
+        param.cb          = am_ring_cb;
+        param.arg         = this;
+
+        return ucp_worker_set_am_recv_ring(receiver().worker(), &param);
+    }
+
+    void post_ring_buffers()
+    {
+        for (auto index : m_ring_indices) {
+            ASSERT_UCS_OK(ucp_worker_am_recv_ring_post(receiver().worker(),
+                                                       TEST_AM_NBX_ID,
+                                                       index));
+        }
+
+        m_ring_indices.clear();
+    }
+
+    virtual ucs_status_t
+    am_data_handler(const void *header, size_t header_length, void *data,
+                    size_t length, const ucp_am_recv_param_t *rx_param)
+    {
+        ++m_handler_counter;
+        return test_ucp_am_nbx::am_data_handler(header, header_length, data,
+                                                length, rx_param);
+    }
+
+    /* Send messages until the ring is exhausted, then check that the next
+     * message goes to the handler and the ring is used after reposting */
+    void test_recv_ring(size_t size)
+    {
+        const size_t header_size = ucs_min(max_am_hdr(), 8);
+
+        ASSERT_LE(size, RING_BUFFER_SIZE);
+
+        set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_data_cb, this);
+        ASSERT_UCS_OK(set_recv_ring(m_ring.data()));
+
+        for (unsigned i = 0; i < RING_NUM_BUFFERS; ++i) {
+            test_am_send_recv(size, header_size);
+        }
+
+        EXPECT_EQ(0, m_handler_counter);
+        ASSERT_EQ(RING_NUM_BUFFERS, m_ring_indices.size());
+        for (unsigned i = 0; i < RING_NUM_BUFFERS; ++i) {
+            EXPECT_EQ(i, m_ring_indices[i]);
+        }
+
+        test_am_send_recv(size, header_size);
+        EXPECT_EQ(1, m_handler_counter);
+
+        post_ring_buffers();
+        test_am_send_recv(size, header_size);
+        EXPECT_EQ(1, m_handler_counter);
+        EXPECT_EQ(1, m_ring_indices.size());
+
+        /* Messages larger than the ring buffers go to the handler */
+        test_am_send_recv(RING_BUFFER_SIZE + 1, header_size);
+        EXPECT_EQ(2, m_handler_counter);
+
+        post_ring_buffers();
+        ASSERT_UCS_OK(set_recv_ring(NULL));
+        test_am_send_recv(size, header_size);
+        EXPECT_EQ(3, m_handler_counter);
+    }
+
+    static void am_ring_cb(void *arg, const void *header, size_t header_length,
+                           unsigned index, size_t length, ucs_status_t status,
+                           const ucp_am_recv_param_t *param)
+    {
+        auto self = reinterpret_cast<test_ucp_am_nbx_recv_ring*>(arg);
+
+        EXPECT_UCS_OK(status);
+        EXPECT_LT(self->m_recv_counter, self->m_send_counter);
+        EXPECT_FALSE(param->recv_attr &
+                     (UCP_AM_RECV_ATTR_FLAG_DATA | UCP_AM_RECV_ATTR_FLAG_RNDV));
+        ASSERT_LT(index, RING_NUM_BUFFERS);
+
+        self->check_header(header, header_length);
+        mem_buffer::pattern_check(&self->m_ring[index * RING_BUFFER_SIZE],
+                                  length, SEED);
+        self->m_ring_indices.push_back(index);
+        self->m_recv_counter++;
+    }
+
+    std::vector<char>     m_ring;
+    std::vector<unsigned> m_ring_indices;
+    size_t                m_handler_counter;
+};
+
+const size_t test_ucp_am_nbx_recv_ring::RING_BUFFER_SIZE;
+const unsigned test_ucp_am_nbx_recv_ring::RING_NUM_BUFFERS;
+
+UCS_TEST_P(test_ucp_am_nbx_recv_ring, eager_multi, "RNDV_THRESH=inf",
+           "ZCOPY_THRESH=inf")
+{
+    test_recv_ring(fragment_size() * 3);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_recv_ring, rndv, "RNDV_THRESH=1024")
+{
+    test_recv_ring(64 * UCS_KBYTE);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_recv_ring, single_fragment, "RNDV_THRESH=inf",
+           "ZCOPY_THRESH=inf")
+{
+    set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_data_cb, this);
+    ASSERT_UCS_OK(set_recv_ring(m_ring.data()));
+
+    test_am_send_recv(128);
+    EXPECT_EQ(1, m_handler_counter);
+    EXPECT_TRUE(m_ring_indices.empty());
+}
+
+UCS_TEST_P(test_ucp_am_nbx_recv_ring, invalid)
+{
+    scoped_log_handler wrap_err(wrap_errors_logger);
+
+    /* The ring requires a handler for its AM id */
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, set_recv_ring(m_ring.data()));
+
+    set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_data_cb, this);
+    ASSERT_UCS_OK(set_recv_ring(m_ring.data()));
+
+#if ENABLE_PARAMS_CHECK
+    /* All buffers are already posted */
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucp_worker_am_recv_ring_post(receiver().worker(), TEST_AM_NBX_ID,
+                                           0));
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucp_worker_am_recv_ring_post(receiver().worker(), TEST_AM_NBX_ID,
+                                           RING_NUM_BUFFERS));
+#endif
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_recv_ring)
+
 class test_ucp_am_nbx_align : public test_ucp_am_nbx_reply {
 public:
     test_ucp_am_nbx_align()
@@ -2064,6 +2304,8 @@ public:
         /* FIXME: Advertise error handling support for RNDV PPLN protocol.
          * Remove this once invalidation workflow is implemented. */
         modify_config("RNDV_PIPELINE_ERROR_HANDLING", "y");
+        /* Use fixed-size fragments to check the number of fragments */
+        modify_config("RNDV_PIPELINE_RAMP_START", "inf", SETENV_IF_NOT_EXIST);
         test_ucp_am_nbx::init();
     }
 
@@ -2109,6 +2351,11 @@ protected:
         check_stats(receiver(), UCP_WORKER_STAT_RNDV_RTR_MTYPE, stats_cntr_value);
     }
 
+    uint64_t get_stats(entity &e, uint64_t cntr)
+    {
+        return UCS_STATS_GET_COUNTER(e.worker()->stats, cntr);
+    }
+
     void set_mem_type(ucs_memory_type_t mem_type) {
         m_mem_type = mem_type;
     }
@@ -2167,6 +2414,23 @@ UCS_TEST_P(test_ucp_am_nbx_rndv_ppln, cuda_buff_cuda_frag,
     test_ppln_send(UCS_MEMORY_TYPE_CUDA, num_frags, num_frags);
 }
 
+UCS_TEST_P(test_ucp_am_nbx_rndv_ppln, cuda_buff_cuda_frag_ramp,
+           "RNDV_FRAG_MEM_TYPE=cuda", "RNDV_PIPELINE_RAMP_START=64k")
+{
+    const size_t num_frags = 2;
+
+    if (!sender().is_rndv_put_ppln_supported()) {
+        UCS_TEST_SKIP_R("RNDV pipeline is not supported");
+    }
+
+    set_mem_type(UCS_MEMORY_TYPE_CUDA);
+    test_am_send_recv(get_rndv_frag_size(UCS_MEMORY_TYPE_CUDA) * num_frags);
+
+    /* Small fragments of the ramp precede the full-size fragments */
+    EXPECT_GT(get_stats(sender(), UCP_WORKER_STAT_RNDV_PUT_MTYPE_ZCOPY),
+              num_frags);
+}
+
 UCS_TEST_P(test_ucp_am_nbx_rndv_ppln, empty_rndv_frag_mem_type,
            "RNDV_FRAG_MEM_TYPE=")
 {
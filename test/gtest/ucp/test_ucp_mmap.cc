@@ -8,6 +8,8 @@
 
 #include "ucp_test.h"
 
+#include <ucp/api/ucpx.h>
+
 extern "C" {
 #include <ucp/core/ucp_context.h>
 #include <ucp/core/ucp_mm.h>
@@ -1216,6 +1218,157 @@ UCS_TEST_P(test_ucp_rkey_compare, rkey_compare)
 UCP_INSTANTIATE_TEST_CASE_GPU_AWARE(test_ucp_rkey_compare)
 
 
+class test_ucp_rkey_cache : public test_ucp_mmap {
+public:
+    void init() override
+    {
+        modify_config("RKEY_CACHE_SIZE", ucs::to_string(m_cache_size));
+        test_ucp_mmap::init();
+    }
+
+protected:
+    struct packed_rkey {
+        std::unique_ptr<mem_chunk> chunk;
+        void                       *buffer;
+        size_t                     size;
+
+        packed_rkey(ucp_context_h context) : chunk(new mem_chunk(context))
+        {
+            ASSERT_UCS_OK(ucp_rkey_pack(context, chunk->memh, &buffer, &size));
+        }
+
+        ~packed_rkey()
+        {
+            ucp_rkey_buffer_release(buffer);
+        }
+
+        bool operator==(const packed_rkey &other) const
+        {
+            return (size == other.size) && !memcmp(buffer, other.buffer, size);
+        }
+    };
+
+    void skip_identical(const packed_rkey &prkey1, const packed_rkey &prkey2)
+    {
+        if (prkey1 == prkey2) {
+            /* Memory domains without remote keys pack the same buffer */
+            UCS_TEST_SKIP_R("identical packed remote keys");
+        }
+    }
+
+    ucp_rkey_h unpack(const packed_rkey &prkey)
+    {
+        ucp_rkey_h rkey;
+
+        ASSERT_UCS_OK(ucp_ep_rkey_unpack(receiver().ep(), prkey.buffer, &rkey));
+        return rkey;
+    }
+
+    static const unsigned m_cache_size = 4;
+};
+
+UCS_TEST_P(test_ucp_rkey_cache, hit)
+{
+    packed_rkey prkey(sender().ucph());
+    ucp_rkey_h rkey1, rkey2, rkey3;
+
+    rkey1 = unpack(prkey);
+    rkey2 = unpack(prkey);
+    EXPECT_EQ(rkey1, rkey2);
+
+    ucp_rkey_destroy(rkey1);
+    ucp_rkey_destroy(rkey2);
+
+    /* The cache still holds the remote key */
+    rkey3 = unpack(prkey);
+    EXPECT_EQ(rkey1, rkey3);
+    ucp_rkey_destroy(rkey3);
+}
+
+UCS_TEST_P(test_ucp_rkey_cache, invalidate)
+{
+    packed_rkey prkey1(sender().ucph());
+    packed_rkey prkey2(sender().ucph());
+    ucp_rkey_h rkey1, rkey2;
+
+    skip_identical(prkey1, prkey2);
+    rkey1 = unpack(prkey1);
+    rkey2 = unpack(prkey2);
+    EXPECT_NE(rkey1, rkey2);
+
+    EXPECT_UCS_OK(ucp_ep_rkey_cache_invalidate(receiver().ep(), prkey1.buffer));
+    EXPECT_EQ(UCS_ERR_NO_ELEM,
+              ucp_ep_rkey_cache_invalidate(receiver().ep(), prkey1.buffer));
+
+    /* Invalidated remote key is released by the last user */
+    EXPECT_EQ(prkey1.chunk->memh->md_map & rkey1->md_map, rkey1->md_map);
+    ucp_rkey_destroy(rkey1);
+
+    EXPECT_UCS_OK(ucp_ep_rkey_cache_invalidate(receiver().ep(), NULL));
+    EXPECT_EQ(UCS_ERR_NO_ELEM,
+              ucp_ep_rkey_cache_invalidate(receiver().ep(), prkey2.buffer));
+    ucp_rkey_destroy(rkey2);
+}
+
+UCS_TEST_P(test_ucp_rkey_cache, evict)
+{
+    std::vector<std::unique_ptr<packed_rkey>> prkeys;
+    unsigned i;
+
+    for (i = 0; i < m_cache_size * 2; ++i) {
+        prkeys.emplace_back(new packed_rkey(sender().ucph()));
+        ucp_rkey_destroy(unpack(*prkeys.back()));
+    }
+
+    skip_identical(*prkeys[0], *prkeys[1]);
+
+    /* Least recently used remote keys were evicted */
+    for (i = 0; i < m_cache_size; ++i) {
+        EXPECT_EQ(UCS_ERR_NO_ELEM,
+                  ucp_ep_rkey_cache_invalidate(receiver().ep(),
+                                               prkeys[i]->buffer));
+    }
+
+    for (; i < prkeys.size(); ++i) {
+        EXPECT_UCS_OK(ucp_ep_rkey_cache_invalidate(receiver().ep(),
+                                                   prkeys[i]->buffer));
+    }
+}
+
+UCS_TEST_P(test_ucp_rkey_cache, unpack_perf)
+{
+    const size_t count = 100000 / ucs::test_time_multiplier();
+    packed_rkey prkey(sender().ucph());
+    ucp_ep_h ep = receiver().ep();
+    double time_nocache, time_cache;
+    ucs_time_t start;
+    ucp_rkey_h rkey;
+    size_t i;
+
+    /* Without the cache, every unpack parses the buffer and allocates the
+     * remote key */
+    start = ucs_get_time();
+    for (i = 0; i < count; ++i) {
+        ASSERT_UCS_OK(ucp_ep_rkey_unpack_reachable(ep, prkey.buffer, 0, &rkey));
+        ucp_rkey_destroy(rkey);
+    }
+    time_nocache = ucs_time_to_nsec(ucs_get_time() - start) / count;
+
+    start = ucs_get_time();
+    for (i = 0; i < count; ++i) {
+        ASSERT_UCS_OK(ucp_ep_rkey_unpack(ep, prkey.buffer, &rkey));
+        ucp_rkey_destroy(rkey);
+    }
+    time_cache = ucs_time_to_nsec(ucs_get_time() - start) / count;
+
+    UCS_TEST_MESSAGE << "rkey unpack+destroy: " << time_nocache
+                     << " nsec without cache, " << time_cache
+                     << " nsec with cache";
+}
+
+UCP_INSTANTIATE_TEST_CASE_GPU_AWARE(test_ucp_rkey_cache)
+
+
 class test_ucp_mmap_export : public test_ucp_mmap {
 public:
     static void
@@ -10,6 +10,7 @@
 #include <common/mem_buffer.h>
 #include <unordered_map>
 #include <memory>
+#include <dirent.h>
 
 extern "C" {
 #include <ucp/core/ucp_rkey.h>
@@ -19,6 +20,7 @@ extern "C" {
 #include <ucp/proto/proto_perf.h>
 #include <ucp/proto/proto_init.h>
 #include <ucs/datastruct/linear_func.h>
+#include <ucs/vfs/base/vfs_obj.h>
 #include <ucp/proto/proto_select.inl>
 #include <ucp/core/ucp_worker.inl>
 }
@@ -345,6 +347,388 @@ UCS_TEST_P(test_perf_node, replace_null)
 
 UCP_INSTANTIATE_TEST_CASE_TLS(test_perf_node, all, "all")
 
+class test_perf_ppln : public test_ucp_proto {
+protected:
+    static const size_t FRAG_SIZE = 512 * UCS_KBYTE;
+
+    /* Pipeline performance of a fragment which is limited by the transport */
+    ucp_proto_perf_t *create_ppln_perf(size_t first_frag_size)
+    {
+        ucp_proto_perf_factors_t factors = UCP_PROTO_PERF_FACTORS_INITIALIZER;
+        ucp_proto_perf_t *frag_perf, *ppln_perf;
+
+        factors[UCP_PROTO_PERF_FACTOR_LOCAL_CPU] =
+                ucs_linear_func_make(0.5e-6, 0.2e-9);
+        factors[UCP_PROTO_PERF_FACTOR_LOCAL_TL]  =
+                ucs_linear_func_make(1e-6, 1e-9);
+
+        ASSERT_UCS_OK(ucp_proto_perf_create("frag", &frag_perf));
+        ASSERT_UCS_OK(ucp_proto_perf_add_funcs(frag_perf, 0, FRAG_SIZE,
+                                               factors, NULL, NULL));
+        ASSERT_UCS_OK(ucp_proto_perf_create("ppln", &ppln_perf));
+        EXPECT_NE(nullptr, ucp_proto_perf_add_ppln(frag_perf, ppln_perf,
+                                                   SIZE_MAX, first_frag_size));
+        ucp_proto_perf_destroy(frag_perf);
+        return ppln_perf;
+    }
+
+    static ucs_linear_func_t
+    ppln_func(ucp_proto_perf_t *perf, ucp_proto_perf_factor_id_t factor_id)
+    {
+        return ucp_proto_perf_segment_func(
+                ucp_proto_perf_find_segment_lb(perf, FRAG_SIZE + 1), factor_id);
+    }
+};
+
+UCS_TEST_P(test_perf_ppln, ramp_frags)
+{
+    EXPECT_EQ(0, ucp_proto_perf_ppln_ramp_frags(0, FRAG_SIZE));
+    EXPECT_EQ(0, ucp_proto_perf_ppln_ramp_frags(FRAG_SIZE, FRAG_SIZE));
+    EXPECT_EQ(0, ucp_proto_perf_ppln_ramp_frags(SIZE_MAX, FRAG_SIZE));
+    EXPECT_EQ(1, ucp_proto_perf_ppln_ramp_frags(FRAG_SIZE - 1, FRAG_SIZE));
+    EXPECT_EQ(3, ucp_proto_perf_ppln_ramp_frags(64 * UCS_KBYTE, FRAG_SIZE));
+    EXPECT_EQ(4, ucp_proto_perf_ppln_ramp_frags(60 * UCS_KBYTE, FRAG_SIZE));
+}
+
+UCS_TEST_P(test_perf_ppln, ramp_model)
+{
+    const size_t first_frag_size = 64 * UCS_KBYTE;
+    ucp_proto_perf_t *fixed_perf = create_ppln_perf(0);
+    ucp_proto_perf_t *ramp_perf  = create_ppln_perf(first_frag_size);
+
+    /* Bottleneck factor: same bandwidth, and an overhead for every fragment
+     * of the ramp */
+    ucs_linear_func_t fixed_tl = ppln_func(fixed_perf,
+                                           UCP_PROTO_PERF_FACTOR_LOCAL_TL);
+    ucs_linear_func_t ramp_tl  = ppln_func(ramp_perf,
+                                           UCP_PROTO_PERF_FACTOR_LOCAL_TL);
+    EXPECT_NEAR(fixed_tl.m, ramp_tl.m, 1e-15);
+    EXPECT_NEAR(fixed_tl.c + (3 * 1e-6), ramp_tl.c, 1e-12);
+
+    /* Overlapped factor: the pipeline is filled by the first fragment */
+    ucs_linear_func_t fixed_cpu = ppln_func(fixed_perf,
+                                            UCP_PROTO_PERF_FACTOR_LOCAL_CPU);
+    ucs_linear_func_t ramp_cpu  = ppln_func(ramp_perf,
+                                            UCP_PROTO_PERF_FACTOR_LOCAL_CPU);
+    EXPECT_NEAR(0.5e-6 + (0.2e-9 * FRAG_SIZE), fixed_cpu.c, 1e-12);
+    EXPECT_NEAR(0.5e-6 + (0.2e-9 * first_frag_size), ramp_cpu.c, 1e-12);
+    EXPECT_EQ(0, ramp_cpu.m);
+
+    ucp_proto_perf_destroy(ramp_perf);
+    ucp_proto_perf_destroy(fixed_perf);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_perf_ppln, all, "all")
+
+class test_ucp_proto_cache : public test_ucp_proto {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_TAG | UCP_FEATURE_AM);
+    }
+
+protected:
+    virtual void init()
+    {
+        char dir_template[] = "/tmp/ucx_proto_cache_XXXXXX";
+
+        ASSERT_NE(nullptr, mkdtemp(dir_template));
+        m_cache_dir = dir_template;
+        modify_config("PROTO_ENABLE", "y");
+        modify_config("PROTO_CACHE_DIR", m_cache_dir);
+        /* Do not connect, to measure connection establishment as well */
+        ucp_test::init();
+    }
+
+    virtual void cleanup()
+    {
+        ucp_test::cleanup();
+
+        for (const auto &file : cache_files()) {
+            unlink((m_cache_dir + "/" + file).c_str());
+        }
+        rmdir(m_cache_dir.c_str());
+    }
+
+    std::vector<std::string> cache_files() const
+    {
+        std::vector<std::string> files;
+        struct dirent *entry;
+        DIR *dir;
+
+        dir = opendir(m_cache_dir.c_str());
+        if (dir == NULL) {
+            return files;
+        }
+
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] != '.') {
+                files.push_back(entry->d_name);
+            }
+        }
+
+        closedir(dir);
+        return files;
+    }
+
+    /* Connect and select protocols for the first messages, and return the
+     * selected protocols */
+    std::string first_messages(double &time_usec)
+    {
+        static const ucp_operation_id_t op_ids[] = {UCP_OP_ID_TAG_SEND,
+                                                    UCP_OP_ID_TAG_SEND_SYNC,
+                                                    UCP_OP_ID_AM_SEND};
+        std::stringstream selection;
+        ucp_proto_select_param_t select_param;
+
+        ucs_time_t start_time = ucs_get_time();
+        sender().connect(&receiver(), get_ep_params());
+
+        ucp_worker_cfg_index_t ep_cfg_index = sender().ep()->cfg_index;
+        auto proto_select = &ucs_array_elem(&worker()->ep_config,
+                                            ep_cfg_index).proto_select;
+        for (auto op_id : op_ids) {
+            select_param.op_id_flags   = op_id;
+            select_param.op_attr       = 0;
+            select_param.dt_class      = UCP_DATATYPE_CONTIG;
+            select_param.mem_type      = UCS_MEMORY_TYPE_HOST;
+            select_param.sys_dev       = UCS_SYS_DEVICE_ID_UNKNOWN;
+            select_param.sg_count      = 1;
+            select_param.op.padding[0] = 0;
+            select_param.op.padding[1] = 0;
+
+            auto select_elem = ucp_proto_select_lookup_slow(
+                    worker(), proto_select, 0, ep_cfg_index,
+                    UCP_WORKER_CFG_INDEX_NULL, &select_param);
+            EXPECT_NE(nullptr, select_elem);
+            if (select_elem == nullptr) {
+                continue;
+            }
+
+            auto thresh = select_elem->thresholds;
+            do {
+                selection << thresh->proto_config.proto->name << ":"
+                          << thresh->max_msg_length << " ";
+            } while ((thresh++)->max_msg_length != SIZE_MAX);
+            selection << std::endl;
+        }
+
+        time_usec = ucs_time_to_usec(ucs_get_time() - start_time);
+        return selection.str();
+    }
+
+    void restart()
+    {
+        /* Destroy the workers, which saves the cache, and create new ones */
+        ucp_test::cleanup();
+        create_entity();
+        if (!is_self()) {
+            create_entity();
+        }
+    }
+
+    std::string m_cache_dir;
+};
+
+UCS_TEST_P(test_ucp_proto_cache, warm_restart)
+{
+    double cold_time, warm_time;
+
+    std::string cold_selection = first_messages(cold_time);
+    EXPECT_EQ(0u, worker()->proto_cache.num_hits);
+    EXPECT_TRUE(cache_files().empty());
+
+    restart();
+    EXPECT_EQ(1u, cache_files().size());
+
+    std::string warm_selection = first_messages(warm_time);
+    EXPECT_GT(worker()->proto_cache.num_hits, 0u);
+    EXPECT_EQ(0u, worker()->proto_cache.num_misses);
+    EXPECT_EQ(cold_selection, warm_selection);
+
+    UCS_TEST_MESSAGE << "time to first message: cold cache " << cold_time
+                     << " usec, warm cache " << warm_time << " usec";
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_proto_cache)
+
+class test_ucp_proto_tune : public test_ucp_proto {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_TAG);
+    }
+
+protected:
+    virtual void init()
+    {
+        modify_config("PROTO_TUNE", "y");
+        modify_config("PROTO_TUNE_MIN_SAMPLES", "4");
+        test_ucp_proto::init();
+    }
+
+    const ucp_proto_select_elem_t *tag_send_select_elem()
+    {
+        ucp_worker_cfg_index_t ep_cfg_index = sender().ep()->cfg_index;
+        ucp_proto_select_param_t select_param;
+        ucp_memory_info_t mem_info;
+
+        ucp_memory_info_set_host(&mem_info);
+        ucp_proto_select_param_init(&select_param, UCP_OP_ID_TAG_SEND, 0, 0,
+                                    UCP_DATATYPE_CONTIG, &mem_info, 1);
+        return ucp_proto_select_lookup_slow(
+                worker(),
+                &ucs_array_elem(&worker()->ep_config, ep_cfg_index)
+                         .proto_select,
+                0, ep_cfg_index, UCP_WORKER_CFG_INDEX_NULL, &select_param);
+    }
+
+    static std::string
+    selection_str(const ucp_proto_select_elem_t *select_elem)
+    {
+        const ucp_proto_threshold_elem_t *thresh = select_elem->thresholds;
+        std::stringstream selection;
+
+        do {
+            selection << thresh->proto_config.proto->name << ":"
+                      << thresh->max_msg_length << " ";
+        } while ((thresh++)->max_msg_length != SIZE_MAX);
+
+        return selection.str();
+    }
+
+    /* Pretend the protocol completed 'num_samples' operations 'factor' times
+     * slower than estimated */
+    static void inject_samples(const ucp_proto_config_t *proto_config,
+                               unsigned num_samples, double factor)
+    {
+        auto proto = const_cast<ucp_proto_init_elem_t*>(
+                proto_config->init_elem);
+
+        proto->tune.num_samples = num_samples;
+        proto->tune.estimated   = num_samples * 1e-6;
+        proto->tune.measured    = proto->tune.estimated * factor;
+    }
+
+    std::string vfs_thresholds()
+    {
+        ucs_string_buffer_t strb;
+
+        std::string path = std::string("/ucp/context/") + context()->name +
+                           "/worker/" + worker()->name +
+                           "/proto_tune/thresholds";
+        ucs_string_buffer_init(&strb);
+        EXPECT_UCS_OK(ucs_vfs_path_read_file(path.c_str(), &strb));
+        std::string result = ucs_string_buffer_cstr(&strb);
+        ucs_string_buffer_cleanup(&strb);
+        return result;
+    }
+
+    void send_recv(size_t size, unsigned count)
+    {
+        std::string send_buf(size, 'a'), recv_buf(size, 0);
+        ucp_request_param_t param;
+
+        param.op_attr_mask = 0;
+        for (unsigned i = 0; i < count; ++i) {
+            void *rreq = ucp_tag_recv_nbx(receiver().worker(), &recv_buf[0],
+                                          size, 1, 0, &param);
+            void *sreq = ucp_tag_send_nbx(sender().ep(), send_buf.data(), size,
+                                          1, &param);
+            ASSERT_UCS_OK(request_wait(sreq));
+            ASSERT_UCS_OK(request_wait(rreq));
+            ASSERT_EQ(send_buf, recv_buf);
+        }
+    }
+};
+
+UCS_TEST_P(test_ucp_proto_tune, slow_protocol_threshold)
+{
+    auto select_elem         = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+    auto proto_config        = &select_elem->thresholds[0].proto_config;
+    std::string initial      = selection_str(select_elem);
+    ucp_proto_query_attr_t proto_attr;
+
+    inject_samples(proto_config, 4, 1000.0);
+    ucp_proto_tune_update(worker());
+    EXPECT_EQ(1u, worker()->proto_tune.num_updates);
+
+    /* The protocol for the smallest messages now looks much slower, so its
+     * range should shrink in favor of other protocols */
+    std::string tuned = selection_str(select_elem);
+    UCS_TEST_MESSAGE << "initial: " << initial;
+    UCS_TEST_MESSAGE << "tuned:   " << tuned;
+    EXPECT_NE(initial, tuned);
+
+    ucp_proto_config_query(worker(), proto_config, 0, &proto_attr);
+    EXPECT_NEAR(1000.0, proto_attr.tune_factor, 1e-6);
+    EXPECT_NE(std::string::npos, vfs_thresholds().find("x1000.00"));
+
+    /* Requests which selected the old thresholds must still be able to
+     * complete, and new requests must use the tuned thresholds */
+    send_recv(1024, 10);
+    send_recv(256 * UCS_KBYTE, 2);
+}
+
+UCS_TEST_P(test_ucp_proto_tune, hysteresis, "PROTO_TUNE_HYSTERESIS=0.5")
+{
+    auto select_elem    = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+    auto proto_config   = &select_elem->thresholds[0].proto_config;
+    std::string initial = selection_str(select_elem);
+
+    /* Small deviation from the estimation does not rebuild the thresholds */
+    inject_samples(proto_config, 4, 1.3);
+    ucp_proto_tune_update(worker());
+    EXPECT_EQ(0u, worker()->proto_tune.num_updates);
+    EXPECT_EQ(1.0, proto_config->init_elem->tune.factor);
+
+    /* Too few samples are not used */
+    inject_samples(proto_config, 3, 10.0);
+    ucp_proto_tune_update(worker());
+    EXPECT_EQ(0u, worker()->proto_tune.num_updates);
+
+    inject_samples(proto_config, 4, 10.0);
+    ucp_proto_tune_update(worker());
+    EXPECT_EQ(1u, worker()->proto_tune.num_updates);
+
+    /* Going back by less than the hysteresis keeps the tuned thresholds */
+    std::string tuned = selection_str(select_elem);
+    inject_samples(proto_config, 4, 7.0);
+    ucp_proto_tune_update(worker());
+    EXPECT_EQ(1u, worker()->proto_tune.num_updates);
+    EXPECT_EQ(tuned, selection_str(select_elem));
+}
+
+UCS_TEST_P(test_ucp_proto_tune, online, "PROTO_TUNE_INTERVAL=0")
+{
+    static const size_t sizes[] = {1024, 8 * UCS_KBYTE, 256 * UCS_KBYTE};
+    const ucp_proto_init_elem_t *proto;
+    unsigned num_sampled;
+
+    for (size_t size : sizes) {
+        send_recv(size, 16);
+    }
+
+    /* Count protocols which have pending samples, or which already folded
+     * them into their correction factor */
+    auto select_elem = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+    num_sampled = 0;
+    ucs_array_for_each(proto, &select_elem->proto_init.protocols) {
+        if ((proto->tune.num_samples > 0) || (proto->tune.factor != 1.0)) {
+            ++num_sampled;
+        }
+    }
+    EXPECT_GT(num_sampled, 0u);
+
+    UCS_TEST_MESSAGE << "updates: " << worker()->proto_tune.num_updates;
+    UCS_TEST_MESSAGE << vfs_thresholds();
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_proto_tune)
+
 static std::ostream &operator<<(std::ostream &os, const ucp_proto_perf_t *perf)
 {
     ucs_string_buffer_t strb = UCS_STRING_BUFFER_INITIALIZER;
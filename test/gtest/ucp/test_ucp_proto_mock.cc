@@ -690,8 +690,8 @@ UCS_TEST_P(test_ucp_proto_mock_tcp, am_send_1_lane)
     check_ep_config(sender(), {
         {0,      8184,   "short",                                       "tcp/mock"},
         {8185,   65528,  "zero-copy",                                   "tcp/mock"},
-        {65529,  366864, "multi-frag zero-copy",                        "tcp/mock"},
-        {366865, INF,    "rendezvous zero-copy fenced write to remote", "tcp/mock"},
+        {65529,  221929, "multi-frag zero-copy",                        "tcp/mock"},
+        {221930, INF,    "rendezvous zero-copy read from remote",       "tcp/mock"},
     }, key);
 }
 
@@ -14,6 +14,7 @@
 
 extern "C" {
 #include <ucp/core/ucp_request.inl>
+#include <ucp/stream/stream.h>
 }
 
 
@@ -659,6 +660,108 @@ UCS_TEST_P(test_ucp_stream, send_zero_ending_iov_recv_data) {
 
 UCP_INSTANTIATE_TEST_CASE(test_ucp_stream)
 
+class test_ucp_stream_coalesce : public test_ucp_stream_base {
+public:
+    virtual void init() {
+        ucp_test::init();
+
+        sender().connect(&receiver(), get_ep_params());
+        if (!is_loopback()) {
+            receiver().connect(&sender(), get_ep_params());
+        }
+    }
+
+    ucp_ep_params_t get_ep_params() {
+        ucp_ep_params_t params = test_ucp_stream_base::get_ep_params();
+        params.field_mask     |= UCP_EP_PARAM_FIELD_FLAGS;
+        params.flags          |= UCP_EP_PARAMS_FLAGS_STREAM_COALESCE;
+        return params;
+    }
+
+protected:
+    void send(const std::vector<char> &sbuf, size_t offset, size_t length) {
+        ucp::data_type_desc_t dt_desc(DATATYPE, &sbuf[offset], length);
+        ucs_status_ptr_t sstatus = stream_send_nb(dt_desc);
+
+        ASSERT_FALSE(UCS_PTR_IS_ERR(sstatus));
+        request_wait(sstatus);
+    }
+
+    size_t recv(std::vector<char> &rbuf, size_t offset, size_t length) {
+        ucs_time_t deadline = ucs::get_deadline();
+        size_t rlength;
+        void *rdata;
+
+        do {
+            progress();
+            rdata = ucp_stream_recv_data_nb(receiver().ep(), &rlength);
+            EXPECT_FALSE(UCS_PTR_IS_ERR(rdata));
+            if (UCS_PTR_IS_PTR(rdata)) {
+                memcpy(&rbuf[offset], rdata, rlength);
+                ucp_stream_data_release(receiver().ep(), rdata);
+                offset += rlength;
+                length -= rlength;
+            }
+        } while ((length > 0) && (ucs_get_time() < deadline));
+
+        return offset;
+    }
+
+    const ucp_stream_coalesce_t *coalesce() {
+        return sender().ep()->ext->stream.coalesce;
+    }
+};
+
+UCS_TEST_P(test_ucp_stream_coalesce, small_sends) {
+    const size_t num_sends = 1000 / ucs::test_time_multiplier();
+    std::vector<char> sbuf(num_sends * UCS_KBYTE);
+    size_t ssize = 0;
+    size_t length;
+
+    ucs::fill_random(sbuf);
+    for (size_t i = 0; i < num_sends; ++i) {
+        /* Every 100th send is too large to be coalesced */
+        length = ((i % 100) == 99) ? UCS_KBYTE : (1 + (i % 64));
+        send(sbuf, ssize, length);
+        ssize += length;
+    }
+
+    std::vector<char> rbuf(ssize, 'r');
+    EXPECT_EQ(ssize, recv(rbuf, 0, ssize));
+    EXPECT_TRUE(std::equal(rbuf.begin(), rbuf.end(), sbuf.begin()));
+
+    ASSERT_TRUE(coalesce() != NULL);
+    EXPECT_GT(coalesce()->num_sends, coalesce()->num_msgs);
+    EXPECT_EQ(0u, coalesce()->length);
+}
+
+UCS_TEST_P(test_ucp_stream_coalesce, flush, "STREAM_COALESCE_TIMEOUT=inf") {
+    const size_t num_sends = 16;
+    const size_t length    = 8;
+    std::vector<char> sbuf(num_sends * length);
+    std::vector<char> rbuf(sbuf.size(), 'r');
+    size_t rlength;
+
+    ucs::fill_random(sbuf);
+    for (size_t i = 0; i < num_sends; ++i) {
+        send(sbuf, i * length, length);
+    }
+
+    /* The data is staged until the endpoint is flushed */
+    short_progress_loop();
+    EXPECT_TRUE(ucp_stream_recv_data_nb(receiver().ep(), &rlength) == NULL);
+    ASSERT_TRUE(coalesce() != NULL);
+    EXPECT_EQ(sbuf.size(), coalesce()->length);
+
+    flush_ep(sender());
+    EXPECT_EQ(sbuf.size(), recv(rbuf, 0, rbuf.size()));
+    EXPECT_EQ(sbuf, rbuf);
+    EXPECT_EQ(num_sends, coalesce()->num_sends);
+    EXPECT_EQ(1u, coalesce()->num_msgs);
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_stream_coalesce)
+
 class test_ucp_stream_many2one : public test_ucp_stream_base {
 protected:
     struct request_wrapper_t {
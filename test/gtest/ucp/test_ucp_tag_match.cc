@@ -564,6 +564,95 @@ UCS_TEST_P(test_ucp_tag_match, sync_send_unexp) {
     request_free(my_send_req);
 }
 
+UCS_TEST_P(test_ucp_tag_match, exp_wildcard_order) {
+    static const ucp_tag_t tag     = 0x111337;
+    static const unsigned num_reqs = 9;
+    std::vector<uint64_t> recv_data(num_reqs, 0);
+    std::vector<request*> reqs;
+    ucp_tag_t tag_mask;
+    uint64_t send_data;
+
+    /* Interleave specific, partially masked and any-tag receives. Messages
+       must be matched in posting order regardless of the queue they are on */
+    for (unsigned i = 0; i < num_reqs; ++i) {
+        tag_mask = (i % 3 == 0) ? UCP_TAG_MASK_FULL :
+                   (i % 3 == 1) ? 0xffff : 0;
+        reqs.push_back(recv_nb(&recv_data[i], sizeof(recv_data[i]), DATATYPE,
+                               tag, tag_mask));
+        ASSERT_TRUE(!UCS_PTR_IS_ERR(reqs.back()));
+    }
+
+    for (unsigned i = 0; i < num_reqs; ++i) {
+        send_data = i + 1;
+        send_b(&send_data, sizeof(send_data), DATATYPE, tag);
+    }
+
+    for (unsigned i = 0; i < num_reqs; ++i) {
+        wait(reqs[i]);
+        EXPECT_EQ(UCS_OK, reqs[i]->status);
+        EXPECT_EQ(i + 1, recv_data[i]) << "request " << i;
+        request_free(reqs[i]);
+    }
+}
+
+UCS_TEST_P(test_ucp_tag_match, exp_queue_depth_perf) {
+    /* Tags which are multiples of the hash size fall into the same bucket */
+    static const ucp_tag_t tag_stride = 1021;
+    const unsigned max_depth          = 4096 / ucs::test_time_multiplier();
+    uint64_t wild_data, send_data;
+    request *wild_req;
+    ucs_time_t start_time;
+
+    for (int wildcard = 0; wildcard <= 1; ++wildcard) {
+        for (unsigned depth = 16; depth <= max_depth; depth *= 4) {
+            std::vector<uint64_t> recv_data(depth, 0);
+            std::vector<request*> reqs(depth);
+
+            /* A non-matching wildcard receive forces searching both the
+               specific and the wildcard queues */
+            wild_req = NULL;
+            if (wildcard) {
+                wild_req = recv_nb(&wild_data, sizeof(wild_data), DATATYPE,
+                                   0xdeadULL << 32, 0xffffffff00000000ULL);
+                ASSERT_TRUE(!UCS_PTR_IS_ERR(wild_req));
+            }
+
+            for (unsigned i = 0; i < depth; ++i) {
+                reqs[i] = recv_nb(&recv_data[i], sizeof(recv_data[i]), DATATYPE,
+                                  (i + 1) * tag_stride, UCP_TAG_MASK_FULL);
+                ASSERT_TRUE(!UCS_PTR_IS_ERR(reqs[i]));
+            }
+
+            /* Match the last posted receive first, to scan the whole queue */
+            start_time = ucs_get_time();
+            for (unsigned i = depth; i-- > 0;) {
+                send_data = i;
+                send_b(&send_data, sizeof(send_data), DATATYPE,
+                       (i + 1) * tag_stride);
+            }
+
+            for (unsigned i = 0; i < depth; ++i) {
+                wait(reqs[i]);
+                EXPECT_EQ(i, recv_data[i]);
+                request_free(reqs[i]);
+            }
+
+            UCS_TEST_MESSAGE << "depth " << depth
+                             << (wildcard ? " with wildcard: " : ": ")
+                             << ucs_time_to_usec(ucs_get_time() - start_time) /
+                                depth
+                             << " usec per message";
+
+            if (wild_req != NULL) {
+                ucp_request_cancel(receiver().worker(), wild_req);
+                wait(wild_req);
+                EXPECT_EQ(UCS_ERR_CANCELED, wild_req->status);
+                request_free(wild_req);
+            }
+        }
+    }
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_tag_match)
 
 class test_ucp_tag_match_rndv : public test_ucp_tag_match {
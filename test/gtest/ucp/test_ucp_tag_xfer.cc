@@ -11,6 +11,7 @@
 #include "ucp_datatype.h"
 
 extern "C" {
+#include <ucp/api/ucpx.h>
 #include <ucp/core/ucp_resource.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucs/datastruct/queue.h>
@@ -122,6 +123,8 @@ public:
     void test_xfer_contig(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_generic(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_iov(size_t size, bool expected, bool sync, bool truncated);
+    void test_xfer_strided(size_t size, bool expected, bool sync,
+                           bool truncated);
     void test_xfer_generic_err(size_t size, bool expected, bool sync, bool truncated);
 
 protected:
@@ -145,6 +148,9 @@ protected:
     void test_xfer_len_offset();
     virtual size_t get_msg_size();
 
+    static std::vector<size_t>
+    strided_offsets(const ucp_dt_strided_param_t &param, size_t count);
+
     /* Init number of lanes which will be used */
     virtual unsigned num_lanes()
     {
@@ -441,6 +447,95 @@ void test_ucp_tag_xfer::test_xfer_iov(size_t size, bool expected, bool sync,
                                "IOV"));
 }
 
+std::vector<size_t>
+test_ucp_tag_xfer::strided_offsets(const ucp_dt_strided_param_t &param,
+                                   size_t count)
+{
+    std::vector<size_t> offsets;
+    size_t idx[UCP_DT_STRIDED_MAX_DIMS] = {0};
+    size_t elem, byte;
+    ssize_t offset;
+    unsigned dim;
+
+    for (elem = 0; elem < count; ++elem) {
+        do {
+            offset = elem * param.extent;
+            for (dim = 0; dim < param.num_dims; ++dim) {
+                offset += idx[dim] * param.dims[dim].stride;
+            }
+            for (byte = 0; byte < param.elem_size; ++byte) {
+                offsets.push_back(offset + byte);
+            }
+
+            for (dim = 0; dim < param.num_dims; ++dim) {
+                if (++idx[dim] < param.dims[dim].count) {
+                    break;
+                }
+                idx[dim] = 0;
+            }
+        } while (dim < param.num_dims);
+    }
+
+    return offsets;
+}
+
+void test_ucp_tag_xfer::test_xfer_strided(size_t size, bool expected,
+                                          bool sync, bool truncated)
+{
+    /* Sender: 2D layout of 4-byte blocks, 60 bytes per element */
+    ucp_dt_strided_param_t send_param = {};
+    send_param.elem_size              = 4;
+    send_param.num_dims               = 2;
+    send_param.dims[0].count          = 5;
+    send_param.dims[0].stride         = 12;
+    send_param.dims[1].count          = 3;
+    send_param.dims[1].stride         = 64;
+    send_param.extent                 = 200;
+
+    /* Receiver: 1D layout of 6-byte blocks, 60 bytes per element */
+    ucp_dt_strided_param_t recv_param = {};
+    recv_param.elem_size              = 6;
+    recv_param.num_dims               = 1;
+    recv_param.dims[0].count          = 10;
+    recv_param.dims[0].stride         = 10;
+    recv_param.extent                 = 104;
+
+    size_t count = size / 60;
+    ucp_datatype_t send_dt, recv_dt;
+    ucs_status_t status;
+    size_t recvd, i;
+
+    /* if count is zero, truncation has no effect */
+    if (truncated && (count == 0)) {
+        truncated = false;
+    }
+
+    std::vector<size_t> send_offsets = strided_offsets(send_param, count);
+    std::vector<size_t> recv_offsets = strided_offsets(recv_param, count);
+    std::vector<char> sendbuf(count * send_param.extent, 0);
+    std::vector<char> recvbuf(count * recv_param.extent, 0);
+
+    ucs::fill_random(sendbuf);
+
+    status = ucp_dt_create_strided(&send_param, &send_dt);
+    ASSERT_UCS_OK(status);
+    status = ucp_dt_create_strided(&recv_param, &recv_dt);
+    ASSERT_UCS_OK(status);
+
+    recvd = do_xfer(sendbuf.data(), recvbuf.data(), count, send_dt, recv_dt,
+                    expected, sync, truncated);
+    if (!truncated) {
+        ASSERT_EQ(count * 60, recvd);
+        for (i = 0; i < recvd; ++i) {
+            ASSERT_EQ(sendbuf[send_offsets[i]], recvbuf[recv_offsets[i]])
+                    << "size=" << size << " byte " << i;
+        }
+    }
+
+    ucp_dt_destroy(recv_dt);
+    ucp_dt_destroy(send_dt);
+}
+
 void test_ucp_tag_xfer::test_xfer_generic_err(size_t size, bool expected,
                                               bool sync, bool truncated)
 {
@@ -639,6 +734,30 @@ UCS_TEST_P(test_ucp_tag_xfer, iov_unexp) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_iov, false, false, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp_truncated) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, false, true);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_unexp) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, false, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp_sync) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, true, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_unexp_rndv, "RNDV_THRESH=1000") {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, false, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp_sync_rndv, "RNDV_THRESH=1000") {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, true, false);
+}
+
 UCS_TEST_P(test_ucp_tag_xfer, generic_err_exp, "PROTO_INDIRECT_ID=y") {
     test_xfer(&test_ucp_tag_xfer::test_xfer_generic_err, true, false, false);
 }
@@ -852,6 +971,26 @@ UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_generic_exp_rndv_probe, "RNDV_TH
     test_xfer_probe(false, false, true, false);
 }
 
+/* rndv send_generic with packing offloaded to background threads */
+
+UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_generic_exp_rndv_offload,
+           "RNDV_THRESH=1000", "GENERIC_DT_OFFLOAD_THREADS=2",
+           "GENERIC_DT_OFFLOAD_THRESH=0") {
+    test_run_xfer(false, false, true, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_generic_unexp_rndv_offload,
+           "RNDV_THRESH=1000", "GENERIC_DT_OFFLOAD_THREADS=2",
+           "GENERIC_DT_OFFLOAD_THRESH=0") {
+    test_run_xfer(false, false, false, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_contig_exp_rndv_offload,
+           "RNDV_THRESH=1000", "GENERIC_DT_OFFLOAD_THREADS=1",
+           "GENERIC_DT_OFFLOAD_THRESH=0") {
+    test_run_xfer(false, true, true, false, false);
+}
+
 /* rndv send_generic_recv_contig am_rndv with bcopy on the sender side */
 
 UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_contig_exp_rndv, "RNDV_THRESH=1000") {
@@ -215,6 +215,10 @@ public:
         UCS_ASYNC_BLOCK(&m_async);
     }
 
+    bool try_block() {
+        return ucs_async_try_block(&m_async);
+    }
+
     void unblock() {
         UCS_ASYNC_UNBLOCK(&m_async);
     }
@@ -734,6 +738,34 @@ UCS_TEST_P(test_async, check_blocks) {
     check_is_blocked(&le, false);
 }
 
+UCS_TEST_P(test_async, try_block) {
+    local_event le(GetParam());
+
+    /* The owner may block the context recursively */
+    ASSERT_TRUE(le.try_block());
+    ASSERT_TRUE(le.try_block());
+    check_is_blocked(&le, true);
+    le.unblock();
+    check_is_blocked(&le, true);
+    le.unblock();
+    check_is_blocked(&le, false);
+
+    if ((GetParam() != UCS_ASYNC_MODE_THREAD_SPINLOCK) &&
+        (GetParam() != UCS_ASYNC_MODE_THREAD_MUTEX)) {
+        return;
+    }
+
+    /* Another thread does not wait for the owner */
+    le.block();
+    std::thread([&le]() { EXPECT_FALSE(le.try_block()); }).join();
+    le.unblock();
+
+    std::thread([&le]() {
+        EXPECT_TRUE(le.try_block());
+        le.unblock();
+    }).join();
+}
+
 class local_timer_long_handler : public local_timer {
 public:
     local_timer_long_handler(ucs_async_mode_t mode, int sleep_usec) :
@@ -10,6 +10,7 @@ extern "C" {
 }
 
 #include <time.h>
+#include <set>
 
 class frag_list : public ucs::test {
 protected:
@@ -333,3 +334,62 @@ UCS_TEST_F(frag_list, random_arrival) {
         last_sn = out->sn;
     }
 }
+
+static void frag_list_purge_cb(ucs_frag_list_elem_t *elem, void *arg)
+{
+    std::set<ucs_frag_list_elem_t*> *purged =
+            reinterpret_cast<std::set<ucs_frag_list_elem_t*>*>(arg);
+
+    EXPECT_TRUE(purged->insert(elem).second);
+}
+
+/**
+ * purge ready and out of order elements
+ */
+UCS_TEST_F(frag_list, purge) {
+    pkt pkts[20];
+    std::set<ucs_frag_list_elem_t*> purged;
+    ucs_frag_list_elem_t *elem;
+    unsigned i;
+    int err;
+
+    init_pkts(pkts, 20);
+
+    /* two holes: 5..9 and 12..19 */
+    for (i = 5; i < 10; i++) {
+        err = ucs_frag_list_insert(&m_frags, &pkts[i].elem, i);
+        EXPECT_EQ(UCS_FRAG_LIST_INSERT_SLOW, err);
+    }
+    for (i = 12; i < 20; i++) {
+        err = ucs_frag_list_insert(&m_frags, &pkts[i].elem, i);
+        EXPECT_EQ(UCS_FRAG_LIST_INSERT_SLOW, err);
+    }
+
+    /* fill the first hole, pull part of the ready elements */
+    for (i = 4; i > 1; i--) {
+        err = ucs_frag_list_insert(&m_frags, &pkts[i].elem, i);
+        EXPECT_EQ(UCS_FRAG_LIST_INSERT_SLOW, err);
+    }
+    err = ucs_frag_list_insert(&m_frags, &pkts[1].elem, 1);
+    EXPECT_EQ(UCS_FRAG_LIST_INSERT_FIRST, err);
+
+    for (i = 2; i < 5; i++) {
+        elem = ucs_frag_list_pull(&m_frags);
+        ASSERT_TRUE(elem != NULL);
+        EXPECT_EQ(i, ucs_container_of(elem, pkt, elem)->sn);
+    }
+
+    ucs_frag_list_purge(&m_frags, frag_list_purge_cb, &purged);
+
+    /* 5..9 remained on the ready list, 12..19 were waiting for the hole */
+    EXPECT_EQ(13u, purged.size());
+    for (i = 5; i < 10; i++) {
+        EXPECT_EQ(1u, purged.count(&pkts[i].elem));
+    }
+    for (i = 12; i < 20; i++) {
+        EXPECT_EQ(1u, purged.count(&pkts[i].elem));
+    }
+
+    EXPECT_TRUE(ucs_frag_list_empty(&m_frags));
+    EXPECT_TRUE(ucs_frag_list_pull(&m_frags) == NULL);
+}
@@ -10,6 +10,9 @@ extern "C" {
 #include <ucs/datastruct/mpmc.h>
 }
 #include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <thread>
 
 
 class test_mpmc : public ucs::test {
@@ -128,3 +131,188 @@ UCS_TEST_F(test_mpmc, multi_threaded) {
     EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
     ucs_mpmc_queue_cleanup(&mpmc);
 }
+
+UCS_TEST_F(test_mpmc, ring_batch) {
+    const unsigned length = 8;
+    uint64_t values[16];
+    ucs_mpmc_ring_t ring;
+
+    ASSERT_UCS_OK(ucs_mpmc_ring_init(&ring, length - 1));
+    EXPECT_TRUE(ucs_mpmc_ring_is_empty(&ring));
+
+    for (unsigned i = 0; i < 16; ++i) {
+        values[i] = i;
+    }
+
+    /* The ring length is rounded up to a power of 2 */
+    EXPECT_EQ(length, ucs_mpmc_ring_push_batch(&ring, values, 10));
+    EXPECT_EQ(0u, ucs_mpmc_ring_push_batch(&ring, values, 1));
+    EXPECT_FALSE(ucs_mpmc_ring_is_empty(&ring));
+
+    EXPECT_EQ(3u, ucs_mpmc_ring_pull_batch(&ring, values, 3));
+    for (unsigned i = 0; i < 3; ++i) {
+        EXPECT_EQ(i, values[i]);
+    }
+
+    /* Wrap around the end of the ring */
+    values[0] = 100;
+    values[1] = 101;
+    values[2] = 102;
+    values[3] = 103;
+    EXPECT_EQ(3u, ucs_mpmc_ring_push_batch(&ring, values, 4));
+
+    EXPECT_EQ(length, ucs_mpmc_ring_pull_batch(&ring, values, 16));
+    for (unsigned i = 0; i < 5; ++i) {
+        EXPECT_EQ(i + 3, values[i]);
+    }
+    for (unsigned i = 5; i < length; ++i) {
+        EXPECT_EQ(100 + i - 5, values[i]);
+    }
+
+    EXPECT_EQ(0u, ucs_mpmc_ring_pull_batch(&ring, values, 16));
+    EXPECT_TRUE(ucs_mpmc_ring_is_empty(&ring));
+    ucs_mpmc_ring_cleanup(&ring);
+}
+
+static int test_mpmc_is_even(uint64_t value, void *arg)
+{
+    return (value % 2) == 0;
+}
+
+UCS_TEST_F(test_mpmc, remove_if) {
+    /* Overflow the ring to have values in both the ring and the list */
+    const unsigned count = UCS_MPMC_QUEUE_RING_SIZE * 3;
+    ucs_mpmc_queue_t mpmc;
+    uint64_t values[7];
+    unsigned num_values, total;
+
+    ASSERT_UCS_OK(ucs_mpmc_queue_init(&mpmc));
+
+    for (unsigned i = 0; i < count; ++i) {
+        ASSERT_UCS_OK(ucs_mpmc_queue_push(&mpmc, i));
+    }
+
+    ucs_mpmc_queue_remove_if(&mpmc, test_mpmc_is_even, NULL);
+
+    total = 0;
+    do {
+        num_values = ucs_mpmc_queue_pull_batch(&mpmc, values,
+                                               ucs_static_array_size(values));
+        for (unsigned i = 0; i < num_values; ++i) {
+            EXPECT_EQ(1u, values[i] % 2) << values[i];
+        }
+        total += num_values;
+    } while (num_values > 0);
+
+    EXPECT_EQ(count / 2, total);
+    EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+    ucs_mpmc_queue_cleanup(&mpmc);
+}
+
+class test_mpmc_ring_perf : public ucs::test {
+protected:
+    static const uint64_t STOP = UINT64_MAX - 1;
+
+    static void
+    push_all(ucs_mpmc_ring_t *ring, const uint64_t *values, unsigned count)
+    {
+        unsigned pushed = 0;
+        unsigned n;
+
+        while (pushed < count) {
+            n = ucs_mpmc_ring_push_batch(ring, values + pushed, count - pushed);
+            if (n == 0) {
+                /* Let the consumers run if the CPUs are oversubscribed */
+                sched_yield();
+            }
+            pushed += n;
+        }
+    }
+
+    void measure(unsigned num_threads, unsigned batch)
+    {
+        const unsigned num_producers = num_threads / 2;
+        const uint64_t per_producer  = (2000000 / ucs::test_time_multiplier()) /
+                                       num_producers;
+        std::vector<std::thread> threads;
+        const uint64_t stop          = STOP;
+        std::atomic<uint64_t> sum(0);
+        ucs_mpmc_ring_t ring;
+        ucs_time_t start;
+        double elapsed;
+
+        ASSERT_UCS_OK(ucs_mpmc_ring_init(&ring, 1024));
+
+        start = ucs_get_time();
+        for (unsigned i = 0; i < num_producers; ++i) {
+            threads.emplace_back([&]() {
+                std::vector<uint64_t> values(batch);
+                uint64_t next = 0;
+                unsigned count;
+
+                while (next < per_producer) {
+                    count = std::min<uint64_t>(batch, per_producer - next);
+                    for (unsigned j = 0; j < count; ++j) {
+                        values[j] = next + j;
+                    }
+
+                    push_all(&ring, &values[0], count);
+                    next += count;
+                }
+                push_all(&ring, &stop, 1);
+            });
+            threads.emplace_back([&]() {
+                std::vector<uint64_t> values(batch);
+                uint64_t local_sum = 0;
+                unsigned count, num_stops;
+
+                /* Every producer sends one STOP, so every consumer exits after
+                   receiving one and returns the others it has pulled */
+                do {
+                    count     = ucs_mpmc_ring_pull_batch(&ring, &values[0],
+                                                         batch);
+                    num_stops = 0;
+                    if (count == 0) {
+                        sched_yield();
+                    }
+                    for (unsigned j = 0; j < count; ++j) {
+                        if (values[j] == stop) {
+                            ++num_stops;
+                        } else {
+                            local_sum += values[j];
+                        }
+                    }
+                } while (num_stops == 0);
+
+                while (--num_stops > 0) {
+                    push_all(&ring, &stop, 1);
+                }
+                sum += local_sum;
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        elapsed = ucs_time_to_sec(ucs_get_time() - start);
+
+        EXPECT_EQ(num_producers * per_producer * (per_producer - 1) / 2,
+                  sum.load());
+        EXPECT_TRUE(ucs_mpmc_ring_is_empty(&ring));
+
+        UCS_TEST_MESSAGE << num_threads << " threads, batch " << batch << ": "
+                         << (2 * per_producer * num_producers / elapsed / 1e6)
+                         << " Mops/sec";
+        ucs_mpmc_ring_cleanup(&ring);
+    }
+};
+
+UCS_TEST_F(test_mpmc_ring_perf, contention) {
+    const unsigned max_threads = (ucs::test_time_multiplier() == 1) ? 64 : 8;
+
+    for (unsigned num_threads = 2; num_threads <= max_threads;
+         num_threads *= 2) {
+        measure(num_threads, 1);
+        measure(num_threads, 16);
+    }
+}
@@ -7,11 +7,13 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/type/spinlock.h>
 }
 
 #include <limits.h>
 #include <vector>
 #include <queue>
+#include <thread>
 
 class test_mpool : public ucs::test {
 protected:
@@ -495,3 +497,184 @@ UCS_TEST_SKIP_COND_F(test_mpool_fifo, alloc_release, !ENABLE_DEBUG_DATA)
 
     ucs_mpool_cleanup(&mp, 0); // skip individual put as obj could be corrupted
 }
+
+class test_mpool_tc : public test_mpool {
+protected:
+    ucs_status_t setup_tc_mpool(ucs_mpool_t *mp, unsigned max_elems,
+                                unsigned flags)
+    {
+        static ucs_mpool_ops_t mpool_ops = {ucs_mpool_chunk_malloc,
+                                            ucs_mpool_chunk_free, NULL, NULL,
+                                            obj_str};
+        ucs_mpool_params_t mp_params;
+
+        ucs_mpool_params_reset(&mp_params);
+        mp_params.elem_size       = header_size + data_size;
+        mp_params.align_offset    = header_size;
+        mp_params.alignment       = align;
+        mp_params.elems_per_chunk = 256;
+        mp_params.max_elems       = max_elems;
+        mp_params.ops             = &mpool_ops;
+        mp_params.flags           = flags;
+        mp_params.name            = "tests";
+        return ucs_mpool_init(&mp_params, mp);
+    }
+
+    template <typename F>
+    static void run_threads(unsigned num_threads, F func)
+    {
+        std::vector<std::thread> threads;
+
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.emplace_back(func, i);
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+UCS_TEST_F(test_mpool_tc, malloc_safe) {
+    ucs_mpool_ops_t ops = {ucs_mpool_chunk_malloc, ucs_mpool_chunk_free, NULL,
+                           NULL, NULL};
+    ucs_mpool_params_t mp_params;
+    ucs_mpool_t mp;
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size   = data_size;
+    mp_params.malloc_safe = 1;
+    mp_params.ops         = &ops;
+    mp_params.flags       = UCS_MPOOL_FLAG_THREAD_CACHE;
+    mp_params.name        = "tests";
+
+    scoped_log_handler log_handler(hide_errors_logger);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, ucs_mpool_init(&mp_params, &mp));
+}
+
+UCS_TEST_F(test_mpool_tc, get_put_mt) {
+    const unsigned num_threads = 8;
+    const unsigned max_elems   = 1024;
+    const unsigned num_iters   = 10000 / ucs::test_time_multiplier();
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    ASSERT_UCS_OK(setup_tc_mpool(&mp, max_elems, UCS_MPOOL_FLAG_THREAD_CACHE));
+
+    run_threads(num_threads, [&](unsigned thread_index) {
+        std::vector<void*> held;
+
+        for (unsigned i = 0; i < num_iters; ++i) {
+            /* Hold a varying number of objects to cross the cache batch
+               boundaries in both directions */
+            while (held.size() < (i % 100)) {
+                void *obj = ucs_mpool_get(&mp);
+                ASSERT_TRUE(obj != NULL);
+                memset(obj, thread_index, data_size);
+                held.push_back(obj);
+            }
+            while (held.size() > (i % 37)) {
+                void *obj = held.back();
+                EXPECT_EQ(thread_index, *(uint8_t*)obj);
+                ucs_mpool_put(obj);
+                held.pop_back();
+            }
+        }
+
+        /* Objects released by another thread */
+        for (unsigned i = 0; i < held.size(); ++i) {
+            ucs_mpool_put(held[i]);
+        }
+    });
+
+    /* Exited threads must have returned all their cached objects */
+    for (unsigned i = 0; i < max_elems; ++i) {
+        void *obj = ucs_mpool_get(&mp);
+        ASSERT_TRUE(obj != NULL) << "object " << i;
+        objs.push_back(obj);
+    }
+    EXPECT_TRUE(ucs_mpool_get(&mp) == NULL);
+    EXPECT_TRUE(ucs_mpool_is_empty(&mp));
+
+    for (auto obj : objs) {
+        ucs_mpool_put(obj);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_tc, leak_check) {
+    ucs_mpool_t mp;
+
+    ASSERT_UCS_OK(setup_tc_mpool(&mp, 256, UCS_MPOOL_FLAG_THREAD_CACHE));
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(ucs_mpool_get(&mp) != NULL);
+    }
+    /* Leave some objects in the cache of this thread */
+    ucs_mpool_put(ucs_mpool_get(&mp));
+
+    leak_count = 0;
+    scoped_log_handler log_handler(mpool_log_leak_handler);
+    ucs_mpool_cleanup(&mp, 1);
+
+    EXPECT_EQ(5u, leak_count);
+}
+
+UCS_TEST_F(test_mpool_tc, get_put_perf) {
+    const unsigned max_threads = (ucs::test_time_multiplier() == 1) ? 64 : 4;
+    const unsigned num_ops     = 4000000 / ucs::test_time_multiplier();
+    const unsigned burst       = 16;
+
+    for (unsigned num_threads = 1; num_threads <= max_threads;
+         num_threads *= 2) {
+        for (unsigned flags : {0u, (unsigned)UCS_MPOOL_FLAG_THREAD_CACHE}) {
+            unsigned iters = num_ops / num_threads / burst;
+            ucs_spinlock_t lock;
+            ucs_time_t start;
+            double elapsed;
+            ucs_mpool_t mp;
+
+            ASSERT_UCS_OK(ucs_spinlock_init(&lock, 0));
+            ASSERT_UCS_OK(setup_tc_mpool(&mp, UINT_MAX, flags));
+
+            /* A pool without a thread cache is protected by a lock, as the
+               callers of such a pool must do today */
+            start = ucs_get_time();
+            run_threads(num_threads, [&](unsigned thread_index) {
+                void *objs[burst];
+
+                for (unsigned i = 0; i < iters; ++i) {
+                    for (unsigned j = 0; j < burst; ++j) {
+                        if (flags == 0) {
+                            ucs_spin_lock(&lock);
+                            objs[j] = ucs_mpool_get(&mp);
+                            ucs_spin_unlock(&lock);
+                        } else {
+                            objs[j] = ucs_mpool_get(&mp);
+                        }
+                    }
+                    for (unsigned j = 0; j < burst; ++j) {
+                        if (flags == 0) {
+                            ucs_spin_lock(&lock);
+                            ucs_mpool_put(objs[j]);
+                            ucs_spin_unlock(&lock);
+                        } else {
+                            ucs_mpool_put(objs[j]);
+                        }
+                    }
+                }
+            });
+            elapsed = ucs_time_to_sec(ucs_get_time() - start);
+
+            UCS_TEST_MESSAGE << num_threads << " threads, "
+                             << (flags ? "thread cache" : "locked pool")
+                             << ": "
+                             << (iters * num_threads * burst * 2 / elapsed /
+                                 1e6)
+                             << " Mops/sec";
+
+            ucs_mpool_cleanup(&mp, 1);
+            ucs_spinlock_destroy(&lock);
+        }
+    }
+}
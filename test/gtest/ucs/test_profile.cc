@@ -10,16 +10,18 @@ extern "C" {
 #include <ucs/time/time.h>
 #include <ucs/profile/profile.h>
 #include <ucs/config/parser.h>
+#include <ucs/vfs/base/vfs_obj.h>
 #include <ucp/api/ucp.h>
 }
 
 #include <pthread.h>
 #include <fstream>
+#include <thread>
 
 class scoped_profile {
 public:
     scoped_profile(ucs::test_base &test, const std::string &file_name,
-                   const char *mode) :
+                   const char *mode, const char *log_size = NULL) :
         m_test(test), m_file_name(file_name), m_tls_env(TLS_ENV, TLS_ENV_VALUE)
     {
         ucp_config_t *config;
@@ -29,6 +31,9 @@ public:
         m_test.push_config();
         m_test.modify_config("PROFILE_MODE", mode);
         m_test.modify_config("PROFILE_FILE", m_file_name.c_str());
+        if (log_size != NULL) {
+            m_test.modify_config("PROFILE_LOG_SIZE", log_size);
+        }
         ucs_profile_init(ucs_global_opts.profile_mode,
                          ucs_global_opts.profile_file,
                          ucs_global_opts.profile_log_size,
@@ -110,6 +115,8 @@ protected:
     void test_env(const void **ptr, const ucs_profile_block_header_t &env_vars);
 
     void do_test(unsigned int_mode, const std::string &str_mode);
+
+    void test_records(const std::string &data, size_t exp_num_records);
 };
 
 static int sum(int a, int b)
@@ -305,7 +312,8 @@ void test_profile::do_test(unsigned int_mode, const std::string& str_mode)
     const int ITER           = 5;
     uint64_t exp_count       = (int_mode & UCS_BIT(UCS_PROFILE_MODE_ACCUM)) ?
                                ITER : 0;
-    uint64_t exp_num_records = (int_mode & UCS_BIT(UCS_PROFILE_MODE_LOG)) ?
+    uint64_t exp_num_records = (int_mode & (UCS_BIT(UCS_PROFILE_MODE_LOG) |
+                                            UCS_BIT(UCS_PROFILE_MODE_RING))) ?
                                (NUM_LOCAITONS * ITER) : 0;
 
 
@@ -354,7 +362,8 @@ void test_profile::do_test(unsigned int_mode, const std::string& str_mode)
         uint64_t prev_ts = records[0].timestamp;
         int nesting      = 0;
 
-        if (!(hdr->mode & UCS_BIT(UCS_PROFILE_MODE_LOG))) {
+        if (!(hdr->mode & (UCS_BIT(UCS_PROFILE_MODE_LOG) |
+                           UCS_BIT(UCS_PROFILE_MODE_RING)))) {
             EXPECT_EQ(0, thread_hdr->num_records);
         }
 
@@ -420,13 +429,122 @@ UCS_TEST_P(test_profile, log_accum) {
             "log,accum");
 }
 
+UCS_TEST_P(test_profile, ring) {
+    do_test(UCS_BIT(UCS_PROFILE_MODE_RING), "ring");
+}
+
+UCS_TEST_P(test_profile, ring_accum) {
+    do_test(UCS_BIT(UCS_PROFILE_MODE_RING) | UCS_BIT(UCS_PROFILE_MODE_ACCUM),
+            "ring,accum");
+}
+
+void test_profile::test_records(const std::string &data,
+                                size_t exp_num_records)
+{
+    const ucs_profile_header_t *hdr =
+            reinterpret_cast<const ucs_profile_header_t*>(&data[0]);
+    uint32_t num_locations = hdr->locations.size /
+                             sizeof(ucs_profile_location_t);
+    const void *ptr        = &data[hdr->threads.offset];
+    const void *end        = UCS_PTR_BYTE_OFFSET(ptr, hdr->threads.size);
+
+    ASSERT_EQ(data.size(), hdr->threads.offset + hdr->threads.size);
+
+    while (ptr < end) {
+        /* coverity[tainted_data_downcast] */
+        const ucs_profile_thread_header_t *thread_hdr =
+                reinterpret_cast<const ucs_profile_thread_header_t*>(ptr);
+        const ucs_profile_record_t *records =
+                reinterpret_cast<const ucs_profile_record_t*>(
+                        reinterpret_cast<const ucs_profile_thread_location_t*>(
+                                thread_hdr + 1) + num_locations);
+
+        if (exp_num_records != 0) {
+            EXPECT_EQ(exp_num_records, thread_hdr->num_records);
+        }
+
+        for (uint64_t i = 0; i < thread_hdr->num_records; ++i) {
+            EXPECT_LT(records[i].location, num_locations);
+            if (i > 0) {
+                EXPECT_GE(records[i].timestamp, records[i - 1].timestamp);
+            }
+        }
+
+        ptr = records + thread_hdr->num_records;
+    }
+
+    EXPECT_EQ(end, ptr);
+}
+
+UCS_TEST_P(test_profile, ring_wraparound) {
+    const size_t RING_SIZE = 64;
+    const std::string log_size =
+            ucs::to_string((RING_SIZE + 1) * sizeof(ucs_profile_record_t));
+
+    scoped_profile p(*this, PROFILE_FILENAME, "ring", log_size.c_str());
+    run_profiled_code(100);
+
+    /* Only the last records are kept, and the log size is rounded down */
+    test_records(p.read(), RING_SIZE);
+}
+
+UCS_TEST_P(test_profile, ring_snapshot) {
+    const std::string snapshot_file = std::string(PROFILE_FILENAME) + ".snap";
+    const int NUM_SNAPSHOTS         = 10;
+    volatile bool stop              = false;
+    ucs_string_buffer_t strb;
+    std::thread thread;
+
+    scoped_profile p(*this, PROFILE_FILENAME, "ring,accum", "4k");
+
+    thread = std::thread([&stop]() {
+        while (!stop) {
+            profile_test_func1();
+            profile_test_func2(1, 2);
+        }
+    });
+
+    for (int i = 0; i < NUM_SNAPSHOTS; ++i) {
+        /* Save the records while the profiled thread is running */
+        ASSERT_UCS_OK(ucs_profile_snapshot(ucs_profile_default_ctx,
+                                           snapshot_file.c_str()));
+
+        std::ifstream f(snapshot_file.c_str());
+        test_records(std::string(std::istreambuf_iterator<char>(f),
+                                 std::istreambuf_iterator<char>()), 0);
+        sched_yield();
+    }
+
+    /* Request a snapshot through VFS and read back the file name */
+    ASSERT_UCS_OK(ucs_vfs_path_write_file("/ucs/profile/snapshot", "1", 1));
+    ucs_string_buffer_init(&strb);
+    ASSERT_UCS_OK(ucs_vfs_path_read_file("/ucs/profile/snapshot", &strb));
+    std::string vfs_file = ucs_string_buffer_cstr(&strb);
+    ucs_string_buffer_cleanup(&strb);
+
+    stop = true;
+    thread.join();
+
+    EXPECT_NE(std::string::npos, vfs_file.find(PROFILE_FILENAME)) << vfs_file;
+    vfs_file = vfs_file.substr(0, vfs_file.find('\n'));
+    std::ifstream f(vfs_file.c_str());
+    test_records(std::string(std::istreambuf_iterator<char>(f),
+                             std::istreambuf_iterator<char>()), 0);
+
+    unlink(vfs_file.c_str());
+    unlink(snapshot_file.c_str());
+}
+
 INSTANTIATE_TEST_SUITE_P(st, test_profile, ::testing::Values(1));
 INSTANTIATE_TEST_SUITE_P(mt, test_profile, ::testing::Values(2, 4, 8));
 
 class test_profile_perf : public test_profile {
+protected:
+    void test_overhead(const char *mode);
 };
 
-UCS_TEST_SKIP_COND_P(test_profile_perf, overhead, RUNNING_ON_VALGRIND) {
+void test_profile_perf::test_overhead(const char *mode)
+{
 
 #if defined(__x86_64__) || defined(__powerpc64__)
     const double EXP_OVERHEAD_NSEC = 100.0;
@@ -438,7 +556,7 @@ UCS_TEST_SKIP_COND_P(test_profile_perf, overhead, RUNNING_ON_VALGRIND) {
     const int COUNT                = 100000;
     double overhead_nsec           = 0.0;
 
-    scoped_profile p(*this, PROFILE_FILENAME, "accum");
+    scoped_profile p(*this, PROFILE_FILENAME, mode);
 
     for (int retry = 0; retry < (ucs::perf_retry_count + 1); ++retry) {
         ucs_time_t  time_profile_on  = 0;
@@ -466,7 +584,7 @@ UCS_TEST_SKIP_COND_P(test_profile_perf, overhead, RUNNING_ON_VALGRIND) {
 
         overhead_nsec = ucs_time_to_nsec(time_profile_on - time_profile_off) /
                         COUNT / ITERS;
-        UCS_TEST_MESSAGE << "overhead: " << overhead_nsec << " nsec";
+        UCS_TEST_MESSAGE << mode << " overhead: " << overhead_nsec << " nsec";
 
         if (!ucs::perf_retry_count) {
             UCS_TEST_MESSAGE << "not validating performance";
@@ -481,4 +599,12 @@ UCS_TEST_SKIP_COND_P(test_profile_perf, overhead, RUNNING_ON_VALGRIND) {
     EXPECT_LT(overhead_nsec, EXP_OVERHEAD_NSEC) << "Profiling overhead is too high";
 }
 
+UCS_TEST_SKIP_COND_P(test_profile_perf, overhead, RUNNING_ON_VALGRIND) {
+    test_overhead("accum");
+}
+
+UCS_TEST_SKIP_COND_P(test_profile_perf, overhead_ring, RUNNING_ON_VALGRIND) {
+    test_overhead("ring");
+}
+
 INSTANTIATE_TEST_SUITE_P(st, test_profile_perf, ::testing::Values(1));
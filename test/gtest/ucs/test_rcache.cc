@@ -678,6 +678,31 @@ UCS_MT_TEST_F(test_rcache, shared_region, 6) {
     shared_free(mem);
 }
 
+UCS_MT_TEST_F(test_rcache, shared_region_hits_perf, 8) {
+    static const size_t size = 1 * 1024 * 1024;
+    const unsigned count     = 100000 / ucs::test_time_multiplier();
+
+    void *mem = shared_malloc(size);
+
+    /* Keep the region registered while the threads hit it concurrently */
+    region *region = get(mem, size);
+    barrier();
+
+    ucs_time_t start_time = ucs_get_time();
+    for (unsigned i = 0; i < count; ++i) {
+        put(get(mem, size));
+    }
+    double elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+
+    if (barrier()) {
+        UCS_TEST_MESSAGE << num_threads() << " threads: "
+                         << (count / elapsed / 1e6) << "M hits/sec per thread";
+    }
+
+    put(region);
+    shared_free(mem);
+}
+
 class test_rcache_no_register : public test_rcache {
 protected:
     bool m_fail_reg;
@@ -26,6 +26,7 @@ protected:
         ucs_time_t   end_time;
         ucs_time_t   d;
         ucs_time_t   total_time;
+        uint64_t     expired_tick;
         twheel       *self;
     };
 
@@ -78,7 +79,8 @@ bool twheel::check_all_timers_triggered(std::vector<struct hr_timer> &t)
 void twheel::timer_expired(struct hr_timer *t)
 {
     t->total_time += (m_wheel.now - t->start_time);
-    t->end_time   = m_wheel.now;
+    t->end_time     = m_wheel.now;
+    t->expired_tick = m_wheel.current;
 }
 
 void twheel::add_timer(struct hr_timer *t)
@@ -257,3 +259,125 @@ UCS_TEST_F(twheel, delayed_sweep) {
     GTEST_FAIL() << "Timers were not triggered after timeout";
 }
 
+
+UCS_TEST_F(twheel, hierarchical_expiry) {
+    static const uint64_t max_ticks = UCS_BIT(UCS_TWHEEL_LEVEL_BITS *
+                                              UCS_TWHEEL_NUM_LEVELS) - 1;
+    std::vector<uint64_t> ticks = {1, 2, 63, 64, 65, 4095, 4096, 4097, 100000,
+                                   262143, 262144, 5000000, max_ticks,
+                                   max_ticks * 2};
+    uint64_t start_tick         = m_wheel.current;
+    ucs_time_t now              = m_wheel.now;
+
+    for (int i = 0; i < N_TIMERS; i++) {
+        ticks.push_back(1 + ucs::rand() % (max_ticks / 8));
+    }
+
+    std::vector<struct hr_timer> t(ticks.size());
+    init_timerv(&t[0], t.size());
+    for (size_t i = 0; i < t.size(); i++) {
+        t[i].d = ticks[i] * m_wheel.res;
+        add_timer(&t[i]);
+    }
+
+    /* Removed timers must not be dispatched */
+    for (size_t i = ticks.size() - N_TIMERS; i < t.size(); i += 3) {
+        ucs_wtimer_remove(&m_wheel, &t[i].timer);
+    }
+
+    while (!ucs_twheel_is_empty(&m_wheel)) {
+        now += m_wheel.res * (1 + (ucs::rand() % 10000));
+        ucs_twheel_sweep(&m_wheel, now);
+    }
+
+    for (size_t i = 0; i < t.size(); i++) {
+        if ((i >= ticks.size() - N_TIMERS) &&
+            (((i - (ticks.size() - N_TIMERS)) % 3) == 0)) {
+            EXPECT_EQ((ucs_time_t)0, t[i].end_time) << "timer " << i;
+        } else {
+            EXPECT_EQ(start_tick + std::min(ticks[i], max_ticks),
+                      t[i].expired_tick) << "timer " << i;
+        }
+    }
+}
+
+UCS_TEST_F(twheel, next_expiry) {
+    struct hr_timer t[2];
+    ucs_time_t expiry;
+
+    EXPECT_EQ(UCS_TIME_INFINITY, ucs_twheel_get_next_expiry(&m_wheel));
+
+    init_timerv(t, 2);
+    t[0].d = 10 * m_wheel.res;
+    t[1].d = 100000 * m_wheel.res;
+    add_timer(&t[1]);
+    add_timer(&t[0]);
+    EXPECT_EQ(m_wheel.now + t[0].d, ucs_twheel_get_next_expiry(&m_wheel));
+
+    ucs_twheel_sweep(&m_wheel, m_wheel.now + t[0].d);
+    EXPECT_NE((ucs_time_t)0, t[0].end_time);
+
+    /* Sleeping until the returned time and sweeping must eventually reach the
+       far timer without ever passing its deadline */
+    expiry = m_wheel.now + (t[1].d - t[0].d);
+    while (t[1].end_time == 0) {
+        ucs_time_t next = ucs_twheel_get_next_expiry(&m_wheel);
+        ASSERT_GT(next, m_wheel.now);
+        ASSERT_LE(next, expiry);
+        ucs_twheel_sweep(&m_wheel, next);
+    }
+
+    EXPECT_EQ(expiry, m_wheel.now);
+    EXPECT_EQ(UCS_TIME_INFINITY, ucs_twheel_get_next_expiry(&m_wheel));
+}
+
+class twheel_perf : public ucs::test {
+protected:
+    static void timer_func(ucs_wtimer_t *self)
+    {
+    }
+
+    void measure(unsigned num_timers)
+    {
+        /* Spread the timers over about 1 second with 32us resolution */
+        static const uint64_t range = 32768;
+        std::vector<ucs_wtimer_t> timers(num_timers);
+        ucs_time_t now = ucs_get_time();
+        ucs_time_t start_time;
+        double sweep_time;
+        ucs_twheel_t wheel;
+        unsigned num_sweeps;
+
+        ASSERT_UCS_OK(ucs_twheel_init(&wheel, ucs_time_from_usec(32), now));
+
+        for (size_t i = 0; i < timers.size(); ++i) {
+            ucs_wtimer_init(&timers[i], timer_func);
+            ucs_wtimer_add(&wheel, &timers[i],
+                           wheel.res * (1 + (ucs::rand() % range)));
+        }
+
+        /* Sweep every tick until all timers are dispatched */
+        num_sweeps = 0;
+        start_time = ucs_get_time();
+        while (!ucs_twheel_is_empty(&wheel)) {
+            now += wheel.res;
+            ucs_twheel_sweep(&wheel, now);
+            ++num_sweeps;
+        }
+        sweep_time = ucs_time_to_nsec(ucs_get_time() - start_time);
+
+        UCS_TEST_MESSAGE << num_timers << " timers: "
+                         << (sweep_time / num_sweeps) << " nsec per sweep, "
+                         << (sweep_time / num_timers) << " nsec per timer";
+
+        ucs_twheel_cleanup(&wheel);
+    }
+};
+
+UCS_TEST_F(twheel_perf, sweep) {
+    measure(1000);
+    measure(100000);
+    if (ucs::test_time_multiplier() == 1) {
+        measure(1000000);
+    }
+}
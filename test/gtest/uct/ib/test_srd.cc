@@ -6,6 +6,10 @@
 
 #include <uct/uct_test.h>
 
+extern "C" {
+#include <uct/ib/efa/srd/srd_ep.h>
+}
+
 
 // FIXME: Add SRD transport to UCT_TEST_IB_TLS when possible
 class test_srd : public uct_test {
@@ -13,7 +17,103 @@ public:
     virtual void init();
 
 protected:
-    entity *m_e1, *m_e2;
+    struct recv_msg {
+        uint64_t    hdr;
+        std::string data;
+    };
+
+    struct pending_req {
+        uct_pending_req_t uct;
+        test_srd          *test;
+        int               count;
+    };
+
+    static ucs_status_t am_handler(void *arg, void *data, size_t length,
+                                   unsigned flags)
+    {
+        test_srd *self = reinterpret_cast<test_srd*>(arg);
+        recv_msg msg;
+
+        msg.hdr  = *reinterpret_cast<uint64_t*>(data);
+        msg.data = std::string(reinterpret_cast<char*>(data) + sizeof(uint64_t),
+                               length - sizeof(uint64_t));
+        self->m_recv.push_back(msg);
+        return UCS_OK;
+    }
+
+    static size_t pack_cb(void *dest, void *arg)
+    {
+        const recv_msg *msg = reinterpret_cast<const recv_msg*>(arg);
+
+        memcpy(dest, &msg->hdr, sizeof(msg->hdr));
+        memcpy(UCS_PTR_BYTE_OFFSET(dest, sizeof(msg->hdr)), msg->data.data(),
+               msg->data.size());
+        return sizeof(msg->hdr) + msg->data.size();
+    }
+
+    static ucs_status_t pending_cb(uct_pending_req_t *uct_req)
+    {
+        pending_req *req = ucs_container_of(uct_req, pending_req, uct);
+        char payload[]   = "pending";
+        ucs_status_t status;
+
+        status = uct_ep_am_short(req->test->m_e1->ep(0), 1, req->count,
+                                 payload, sizeof(payload));
+        if (status == UCS_OK) {
+            ++req->count;
+        }
+
+        return status;
+    }
+
+    void set_am_handler(uint8_t id)
+    {
+        ucs_status_t status;
+
+        status = uct_iface_set_am_handler(m_e2->iface(), id, am_handler,
+                                          this, 0);
+        ASSERT_UCS_OK(status);
+    }
+
+    void check_recv(size_t index, uint64_t hdr, const std::string &data)
+    {
+        ASSERT_LT(index, m_recv.size());
+        EXPECT_EQ(hdr, m_recv[index].hdr);
+        EXPECT_EQ(data, m_recv[index].data);
+    }
+
+    void short_progress_until_recv(size_t count)
+    {
+        ucs_time_t deadline = ucs_get_time() +
+                              ucs_time_from_sec(DEFAULT_TIMEOUT_SEC);
+
+        while ((m_recv.size() < count) && (ucs_get_time() < deadline)) {
+            short_progress_loop();
+        }
+
+        ASSERT_EQ(count, m_recv.size());
+    }
+
+    void flush_ep(entity *e)
+    {
+        uct_completion_t comp = {comp_cb, 1, UCS_OK};
+        ucs_status_t status;
+
+        status = uct_ep_flush(e->ep(0), 0, &comp);
+        if (status == UCS_INPROGRESS) {
+            wait_for_value(&comp.count, 0, true);
+            status = comp.status;
+        }
+
+        ASSERT_UCS_OK(status);
+    }
+
+    static void comp_cb(uct_completion_t *comp)
+    {
+    }
+
+    entity                *m_e1, *m_e2;
+    std::vector<recv_msg> m_recv;
 };
 
 void test_srd::init()
@@ -45,15 +145,22 @@ UCS_TEST_P(test_srd, am_short)
     char payload[]  = "the payload";
     int count       = 10;
 
-    /* TODO: Add RX checks when available */
-    status = uct_ep_am_short(m_e1->ep(0), 31, header++, payload, sizeof(payload));
+    set_am_handler(31);
+    set_am_handler(14);
+
+    status = uct_ep_am_short(m_e1->ep(0), 31, header, payload, sizeof(payload));
     ASSERT_UCS_OK(status);
-    status = uct_ep_am_short(m_e1->ep(0), 14, header, payload, sizeof(payload));
+    status = uct_ep_am_short(m_e1->ep(0), 14, header + 1, payload,
+                             sizeof(payload));
     ASSERT_UCS_OK(status);
 
     while (count-- > 0) {
         short_progress_loop();
     }
+
+    short_progress_until_recv(2);
+    check_recv(0, header, std::string(payload, sizeof(payload)));
+    check_recv(1, header + 1, std::string(payload, sizeof(payload)));
 }
 
 UCS_TEST_P(test_srd, am_short_failure)
@@ -69,4 +176,206 @@ UCS_TEST_P(test_srd, am_short_failure)
     ASSERT_UCS_STATUS_EQ(UCS_ERR_INVALID_PARAM, status);
 }
 
+UCS_TEST_P(test_srd, am_bcopy)
+{
+    std::vector<recv_msg> msgs(16);
+    ssize_t packed_len;
+
+    set_am_handler(5);
+
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        msgs[i].hdr  = i;
+        msgs[i].data = std::string(ucs::rand() % 1024, 'a' + i);
+        packed_len   = uct_ep_am_bcopy(m_e1->ep(0), 5, pack_cb, &msgs[i], 0);
+        ASSERT_EQ((ssize_t)(sizeof(uint64_t) + msgs[i].data.size()),
+                  packed_len);
+    }
+
+    flush_ep(m_e1);
+    short_progress_until_recv(msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        check_recv(i, msgs[i].hdr, msgs[i].data);
+    }
+}
+
+UCS_TEST_P(test_srd, am_zcopy)
+{
+    const size_t length   = 2048;
+    uint64_t header       = 0xdeadbeef;
+    mapped_buffer sendbuf(length, 0, *m_e1);
+    uct_completion_t comp = {comp_cb, 1, UCS_OK};
+    uct_iov_t iov;
+    ucs_status_t status;
+
+    set_am_handler(7);
+    sendbuf.pattern_fill(0x1234);
+
+    iov.buffer = sendbuf.ptr();
+    iov.length = length;
+    iov.memh   = sendbuf.memh();
+    iov.stride = 0;
+    iov.count  = 1;
+
+    status = uct_ep_am_zcopy(m_e1->ep(0), 7, &header, sizeof(header), &iov, 1,
+                             0, &comp);
+    ASSERT_UCS_STATUS_EQ(UCS_INPROGRESS, status);
+
+    wait_for_value(&comp.count, 0, true);
+    ASSERT_UCS_OK(comp.status);
+
+    short_progress_until_recv(1);
+    check_recv(0, header, std::string((char*)sendbuf.ptr(), length));
+}
+
+UCS_TEST_P(test_srd, get_zcopy)
+{
+    const size_t length   = 4096;
+    mapped_buffer sendbuf(length, 0, *m_e2);
+    mapped_buffer recvbuf(length, 0, *m_e1);
+    uct_completion_t comp = {comp_cb, 1, UCS_OK};
+    uct_iov_t iov;
+    ucs_status_t status;
+
+    check_caps_skip(UCT_IFACE_FLAG_GET_ZCOPY);
+
+    sendbuf.pattern_fill(0x5678);
+    recvbuf.memset(0);
+
+    iov.buffer = recvbuf.ptr();
+    iov.length = length;
+    iov.memh   = recvbuf.memh();
+    iov.stride = 0;
+    iov.count  = 1;
+
+    status = uct_ep_get_zcopy(m_e1->ep(0), &iov, 1, sendbuf.addr(),
+                              sendbuf.rkey(), &comp);
+    ASSERT_UCS_STATUS_EQ(UCS_INPROGRESS, status);
+
+    wait_for_value(&comp.count, 0, true);
+    ASSERT_UCS_OK(comp.status);
+    recvbuf.pattern_check(0x5678);
+}
+
+UCS_TEST_P(test_srd, ep_flush)
+{
+    char payload[] = "flush";
+    ucs_status_t status;
+
+    set_am_handler(3);
+
+    /* Nothing outstanding */
+    status = uct_ep_flush(m_e1->ep(0), 0, NULL);
+    ASSERT_UCS_OK(status);
+
+    for (uint64_t i = 0; i < 8; ++i) {
+        status = uct_ep_am_short(m_e1->ep(0), 3, i, payload, sizeof(payload));
+        ASSERT_UCS_OK(status);
+    }
+
+    status = uct_ep_flush(m_e1->ep(0), 0, NULL);
+    ASSERT_UCS_STATUS_EQ(UCS_INPROGRESS, status);
+
+    flush_ep(m_e1);
+    status = uct_ep_flush(m_e1->ep(0), 0, NULL);
+    ASSERT_UCS_OK(status);
+
+    short_progress_until_recv(8);
+}
+
+UCS_TEST_P(test_srd, pending)
+{
+    char payload[] = "fill";
+    const int max  = 100000;
+    pending_req req;
+    ucs_status_t status;
+    int sent;
+
+    set_am_handler(1);
+
+    /* Exhaust send resources without progress */
+    for (sent = 0; sent < max; ++sent) {
+        status = uct_ep_am_short(m_e1->ep(0), 1, sent, payload,
+                                 sizeof(payload));
+        if (status == UCS_ERR_NO_RESOURCE) {
+            break;
+        }
+        ASSERT_UCS_OK(status);
+    }
+    ASSERT_LT(sent, max);
+
+    req.uct.func = pending_cb;
+    req.test     = this;
+    req.count    = sent;
+    status       = uct_ep_pending_add(m_e1->ep(0), &req.uct, 0);
+    ASSERT_UCS_OK(status);
+
+    /* Flush must not complete while requests are pending */
+    status = uct_ep_flush(m_e1->ep(0), 0, NULL);
+    ASSERT_UCS_STATUS_EQ(UCS_ERR_NO_RESOURCE, status);
+
+    wait_for_value(&req.count, sent + 1, true);
+    flush_ep(m_e1);
+
+    short_progress_until_recv(sent + 1);
+    for (int i = 0; i < (int)m_recv.size(); ++i) {
+        EXPECT_EQ((uint64_t)i, m_recv[i].hdr);
+    }
+}
+
+UCS_TEST_P(test_srd, pending_purge)
+{
+    char payload[] = "fill";
+    pending_req req;
+    ucs_status_t status;
+
+    set_am_handler(1);
+
+    do {
+        status = uct_ep_am_short(m_e1->ep(0), 1, 0, payload, sizeof(payload));
+    } while (status == UCS_OK);
+    ASSERT_UCS_STATUS_EQ(UCS_ERR_NO_RESOURCE, status);
+
+    req.uct.func = pending_cb;
+    req.test     = this;
+    req.count    = 0;
+    status       = uct_ep_pending_add(m_e1->ep(0), &req.uct, 0);
+    ASSERT_UCS_OK(status);
+
+    uct_ep_pending_purge(m_e1->ep(0), NULL, NULL);
+    flush_ep(m_e1);
+    EXPECT_EQ(0, req.count);
+}
+
+UCS_TEST_P(test_srd, am_reorder)
+{
+    uct_srd_ep_t *ep = ucs_derived_of(m_e1->ep(0), uct_srd_ep_t);
+    char payload[]   = "reorder";
+    uct_srd_psn_t psn;
+    ucs_status_t status;
+
+    set_am_handler(9);
+
+    /* Emulate the network delivering the later packet first */
+    psn     = ep->psn;
+    ep->psn = psn + 1;
+    status  = uct_ep_am_short(m_e1->ep(0), 9, 1, payload, sizeof(payload));
+    ASSERT_UCS_OK(status);
+
+    short_progress_loop();
+    EXPECT_TRUE(m_recv.empty());
+
+    ep->psn = psn;
+    status  = uct_ep_am_short(m_e1->ep(0), 9, 0, payload, sizeof(payload));
+    ASSERT_UCS_OK(status);
+    ep->psn = psn + 2;
+
+    status = uct_ep_am_short(m_e1->ep(0), 9, 2, payload, sizeof(payload));
+    ASSERT_UCS_OK(status);
+
+    short_progress_until_recv(3);
+    for (uint64_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(i, m_recv[i].hdr);
+    }
+}
+
 UCT_INSTANTIATE_SRD_TEST_CASE(test_srd)
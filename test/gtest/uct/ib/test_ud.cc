@@ -95,6 +95,26 @@ public:
         return UCS_OK;
     }
 
+    static ucs_status_t count_put_tx(uct_ud_ep_t *ep, uct_ud_neth_t *neth)
+    {
+        if (neth->packet_type & UCT_UD_PACKET_FLAG_PUT) {
+            ucs_atomic_add32(&tx_count, 1);
+        }
+        return UCS_OK;
+    }
+
+    static ucs_status_t drop_put_psn(uct_ud_ep_t *ep, uct_ud_neth_t *neth)
+    {
+        if ((neth->packet_type & UCT_UD_PACKET_FLAG_PUT) &&
+            (neth->psn == drop_psn)) {
+            /* drop only the first transmission */
+            drop_psn = 0;
+            ucs_atomic_add32(&rx_drop_count, 1);
+            return UCS_ERR_BUSY;
+        }
+        return UCS_OK;
+    }
+
     static ucs_status_t drop_creq(uct_ud_iface_t *iface, uct_ud_neth_t *neth)
     {
         if ((neth->packet_type & UCT_UD_PACKET_FLAG_CTL) &&
@@ -171,6 +191,7 @@ public:
     static volatile uint32_t     tx_count;
     static volatile uct_ud_psn_t tx_ackreq_psn;
     static volatile uct_ud_psn_t tx_ack_psn;
+    static volatile uct_ud_psn_t drop_psn;
 };
 
 volatile uint32_t      test_ud::ack_req_tx_cnt = 0;
@@ -178,6 +199,7 @@ volatile uint32_t      test_ud::rx_ack_count   = 0;
 volatile uint32_t      test_ud::rx_drop_count  = 0;
 volatile uint32_t      test_ud::tx_count  = 0;
 volatile uct_ud_psn_t  test_ud::tx_ackreq_psn = 0;
+volatile uct_ud_psn_t  test_ud::drop_psn = 0;
 volatile uct_ud_psn_t  test_ud::tx_ack_psn = 0;
 
 UCS_TEST_SKIP_COND_P(test_ud, basic_tx,
@@ -672,6 +694,42 @@ UCS_TEST_SKIP_COND_P(test_ud, ca_resend,
     EXPECT_GE(ack_req_tx_cnt, 1u);
 }
 
+/* a single lost packet is resent once SACKs arrive, and the packets which
+ * were received after it are not resent */
+UCS_TEST_SKIP_COND_P(test_ud, sack_resend,
+                     (RUNNING_ON_VALGRIND ||
+                      !check_caps(UCT_IFACE_FLAG_AM_SHORT))) {
+    const unsigned num_sends = 8;
+    uct_ud_psn_t first_psn;
+    unsigned i;
+
+    disable_async(m_e1);
+    disable_async(m_e2);
+    connect();
+    set_tx_win(m_e1, UCT_UD_CA_MAX_WINDOW);
+
+    first_psn               = ep(m_e1)->tx.psn;
+    drop_psn                = first_psn + 1;
+    rx_drop_count           = 0;
+    tx_count                = 0;
+    ep(m_e1)->tx.tx_hook    = count_put_tx;
+    ep(m_e2, 0)->rx.rx_hook = drop_put_psn;
+
+    for (i = 0; i < num_sends; i++) {
+        EXPECT_UCS_OK(tx(m_e1));
+    }
+
+    validate_recv(ep(m_e2), first_psn + num_sends - 1);
+    flush();
+
+    EXPECT_EQ(1u, rx_drop_count);
+    /* only the dropped packet is sent twice */
+    EXPECT_EQ(num_sends + 1, tx_count);
+    EXPECT_EQ(first_psn + num_sends - 1, ep(m_e1)->tx.acked_psn);
+    ep(m_e1)->tx.tx_hook    = uct_ud_ep_null_hook;
+    ep(m_e2, 0)->rx.rx_hook = uct_ud_ep_null_hook;
+}
+
 UCS_TEST_P(test_ud, connect_iface_single_drop_creq) {
     /* single connect */
     iface(m_e2)->rx.hook = drop_creq;
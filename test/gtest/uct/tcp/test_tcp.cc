@@ -288,3 +288,337 @@ UCS_TEST_P(test_uct_tcp, check_addr_len)
 
 
 _UCT_INSTANTIATE_TEST_CASE(test_uct_tcp, tcp)
+
+
+class test_uct_tcp_io_uring : public test_uct_tcp {
+public:
+    void init() {
+        modify_config("TCP_IO_ENGINE", "auto");
+        test_uct_tcp::init();
+
+        if (m_tcp_iface->io_uring == NULL) {
+            UCS_TEST_SKIP_R("io_uring is not supported");
+        }
+    }
+
+    static ucs_status_t
+    am_handler(void *arg, void *data, size_t length, unsigned flags) {
+        (*static_cast<size_t*>(arg))++;
+        return UCS_OK;
+    }
+
+    static size_t pack_cb(void *dest, void *arg) {
+        size_t length = *static_cast<size_t*>(arg);
+
+        memset(dest, 0xab, length);
+        return length;
+    }
+
+    void test_send_recv(size_t length, size_t num_msgs) {
+        entity *sender = uct_test::create_entity(0);
+        m_entities.push_back(sender);
+
+        volatile size_t num_recvd = 0;
+        ucs_status_t status = uct_iface_set_am_handler(m_ent->iface(), 0,
+                                                       am_handler,
+                                                       (void*)&num_recvd, 0);
+        ASSERT_UCS_OK(status);
+
+        sender->connect(0, *m_ent, 0);
+
+        for (size_t i = 0; i < num_msgs; ++i) {
+            ssize_t packed_length;
+            do {
+                packed_length = uct_ep_am_bcopy(sender->ep(0), 0, pack_cb,
+                                                &length, 0);
+                progress();
+            } while (packed_length == UCS_ERR_NO_RESOURCE);
+            ASSERT_EQ(length, packed_length);
+        }
+
+        wait_for_value(&num_recvd, num_msgs, true);
+        EXPECT_EQ(num_msgs, num_recvd);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_io_uring, send_recv_small) {
+    test_send_recv(8, 10000 / ucs::test_time_multiplier());
+}
+
+UCS_TEST_P(test_uct_tcp_io_uring, send_recv_large) {
+    /* Large messages fill up the socket buffer, so the sender has to wait for
+     * write readiness reported through io_uring */
+    test_send_recv(m_tcp_iface->config.tx_seg_size - sizeof(uct_tcp_am_hdr_t),
+                   2000 / ucs::test_time_multiplier());
+}
+
+UCS_TEST_P(test_uct_tcp_io_uring, listener_flood_connect_and_close) {
+    const size_t max_conn =
+        ucs_min(static_cast<size_t>(max_connections()), 128lu) /
+        ucs::test_time_multiplier();
+    test_listener_flood(*m_ent, max_conn, 0);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_io_uring, tcp)
+
+
+class test_uct_tcp_zerocopy : public test_uct_tcp {
+public:
+    void init() {
+        modify_config("TCP_ZEROCOPY_THRESH", "1k");
+        test_uct_tcp::init();
+
+        if (m_tcp_iface->config.zerocopy_thresh == UCS_MEMUNITS_INF) {
+            UCS_TEST_SKIP_R("MSG_ZEROCOPY is not supported");
+        }
+
+        m_sender = uct_test::create_entity(0);
+        m_entities.push_back(m_sender);
+        m_sender->connect(0, *m_ent, 0);
+        m_num_recvd = 0;
+    }
+
+protected:
+    struct zcopy_comp {
+        uct_completion_t uct;
+        volatile bool    done;
+    };
+
+    static void completion_cb(uct_completion_t *self) {
+        zcopy_comp *comp = ucs_container_of(self, zcopy_comp, uct);
+
+        EXPECT_UCS_OK(self->status);
+        comp->done = true;
+    }
+
+    static ucs_status_t
+    am_handler(void *arg, void *data, size_t length, unsigned flags) {
+        test_uct_tcp_zerocopy *self = static_cast<test_uct_tcp_zerocopy*>(arg);
+
+        mem_buffer::pattern_check(data, length, self->m_num_recvd);
+        ++self->m_num_recvd;
+        return UCS_OK;
+    }
+
+    uct_tcp_ep_t *sender_ep() const {
+        return ucs_derived_of(m_sender->ep(0), uct_tcp_ep_t);
+    }
+
+    template <typename F>
+    void send_and_wait(F send_func) {
+        zcopy_comp comp;
+        ucs_status_t status;
+
+        comp.uct.func   = completion_cb;
+        comp.uct.count  = 1;
+        comp.uct.status = UCS_OK;
+        comp.done       = false;
+
+        do {
+            status = send_func(&comp.uct);
+            progress();
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        if (status == UCS_INPROGRESS) {
+            /* The user's buffer can be reused only after the kernel notifies
+             * that it was released */
+            wait_for_flag(&comp.done);
+            EXPECT_TRUE(comp.done);
+        } else {
+            ASSERT_UCS_OK(status);
+        }
+    }
+
+    void check_zerocopy_completed() {
+        uct_tcp_ep_t *ep = sender_ep();
+
+        flush();
+        EXPECT_NE(0u, ep->zerocopy.sn);
+        EXPECT_EQ(ep->zerocopy.sn, ep->zerocopy.done_sn);
+        EXPECT_TRUE(ucs_queue_is_empty(&ep->zerocopy.comp_q));
+    }
+
+    entity          *m_sender;
+    volatile size_t m_num_recvd;
+};
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_zerocopy, am_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY))
+{
+    const size_t length   = ucs_min(m_sender->iface_attr().cap.am.max_zcopy,
+                                    32 * UCS_KBYTE);
+    const size_t num_msgs = 200 / ucs::test_time_multiplier();
+    mapped_buffer sendbuf(length, 0, *m_sender);
+
+    ucs_status_t status = uct_iface_set_am_handler(m_ent->iface(), 0,
+                                                   am_handler, this, 0);
+    ASSERT_UCS_OK(status);
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        /* Overwrite the buffer only after the previous send is completed */
+        sendbuf.pattern_fill(i);
+        send_and_wait([&](uct_completion_t *comp) {
+            return uct_ep_am_zcopy(m_sender->ep(0), 0, NULL, 0, sendbuf.iov(),
+                                   1, 0, comp);
+        });
+    }
+
+    wait_for_value(&m_num_recvd, num_msgs, true);
+    EXPECT_EQ(num_msgs, m_num_recvd);
+    check_zerocopy_completed();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_zerocopy, put_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY))
+{
+    const size_t length   = 256 * UCS_KBYTE;
+    const size_t num_iter = 20 / ucs::test_time_multiplier();
+    mapped_buffer sendbuf(length, 0, *m_sender);
+    mapped_buffer recvbuf(length, 0, *m_ent);
+
+    for (size_t i = 0; i < num_iter; ++i) {
+        sendbuf.pattern_fill(i);
+        send_and_wait([&](uct_completion_t *comp) {
+            return uct_ep_put_zcopy(m_sender->ep(0), sendbuf.iov(), 1,
+                                    recvbuf.addr(), recvbuf.rkey(), comp);
+        });
+        recvbuf.pattern_check(i);
+    }
+
+    check_zerocopy_completed();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_zerocopy, put_zcopy_window,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY))
+{
+    const size_t num_puts   = 32;
+    const size_t put_length = 64 * UCS_KBYTE;
+    mapped_buffer sendbuf(num_puts * put_length, 0, *m_sender);
+    mapped_buffer recvbuf(num_puts * put_length, 0, *m_ent);
+    ucs_status_t status;
+
+    /* Post many operations without waiting for completions, so that service
+     * headers of the operations are reused while the kernel still references
+     * the zero-copied payload */
+    sendbuf.pattern_fill(1);
+    recvbuf.memset(0);
+    for (size_t i = 0; i < num_puts; ++i) {
+        uct_iov_t iov = *sendbuf.iov();
+
+        iov.buffer = UCS_PTR_BYTE_OFFSET(sendbuf.ptr(), i * put_length);
+        iov.length = put_length;
+        do {
+            status = uct_ep_put_zcopy(m_sender->ep(0), &iov, 1,
+                                      recvbuf.addr() + (i * put_length),
+                                      recvbuf.rkey(), NULL);
+            progress();
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_UCS_STATUS_EQ(UCS_INPROGRESS, status);
+    }
+
+    check_zerocopy_completed();
+    recvbuf.pattern_check(1);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_zerocopy, tcp)
+
+
+class test_uct_tcp_get : public test_uct_tcp {
+public:
+    void init() {
+        test_uct_tcp::init();
+
+        m_sender = uct_test::create_entity(0);
+        m_entities.push_back(m_sender);
+        m_sender->connect(0, *m_ent, 0);
+    }
+
+protected:
+    struct get_comp {
+        uct_completion_t uct;
+        volatile bool    done;
+    };
+
+    static void completion_cb(uct_completion_t *self) {
+        get_comp *comp = ucs_container_of(self, get_comp, uct);
+
+        EXPECT_UCS_OK(self->status);
+        comp->done = true;
+    }
+
+    template <typename F>
+    ucs_status_t post(F op_func) {
+        ucs_status_t status;
+
+        do {
+            status = op_func();
+            progress();
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        return status;
+    }
+
+    entity *m_sender;
+};
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_get, get_after_put,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY |
+                                 UCT_IFACE_FLAG_GET_ZCOPY))
+{
+    const size_t num_puts   = 8;
+    const size_t put_length = 16 * UCS_KBYTE;
+    const size_t length     = num_puts * put_length;
+    mapped_buffer sendbuf(length, 0, *m_sender);
+    mapped_buffer getbuf(length, 0, *m_sender);
+    mapped_buffer recvbuf(length, 0, *m_ent);
+    uct_iov_t iov[2];
+    get_comp comp;
+    ucs_status_t status;
+
+    sendbuf.pattern_fill(1);
+    recvbuf.memset(0);
+    getbuf.memset(0);
+
+    /* GET is posted without waiting for the preceding PUTs to complete, its
+     * reply has to contain the data written by them */
+    for (size_t i = 0; i < num_puts; ++i) {
+        iov[0]        = *sendbuf.iov();
+        iov[0].buffer = UCS_PTR_BYTE_OFFSET(sendbuf.ptr(), i * put_length);
+        iov[0].length = put_length;
+        status        = post([&]() {
+            return uct_ep_put_zcopy(m_sender->ep(0), iov, 1,
+                                    recvbuf.addr() + (i * put_length),
+                                    recvbuf.rkey(), NULL);
+        });
+        ASSERT_UCS_STATUS_EQ(UCS_INPROGRESS, status);
+    }
+
+    /* Scatter the payload to two IOVs to check a segmented receive */
+    iov[0]        = *getbuf.iov();
+    iov[0].length = length / 3;
+    iov[1]        = *getbuf.iov();
+    iov[1].buffer = UCS_PTR_BYTE_OFFSET(getbuf.ptr(), iov[0].length);
+    iov[1].length = length - iov[0].length;
+
+    comp.uct.func   = completion_cb;
+    comp.uct.count  = 1;
+    comp.uct.status = UCS_OK;
+    comp.done       = false;
+
+    status = post([&]() {
+        return uct_ep_get_zcopy(m_sender->ep(0), iov, 2, recvbuf.addr(),
+                                recvbuf.rkey(), &comp.uct);
+    });
+    ASSERT_UCS_STATUS_EQ(UCS_INPROGRESS, status);
+
+    wait_for_flag(&comp.done);
+    EXPECT_TRUE(comp.done);
+    getbuf.pattern_check(1);
+
+    /* The GET reply acknowledged the preceding PUT operations */
+    EXPECT_FALSE(ucs_derived_of(m_sender->ep(0), uct_tcp_ep_t)->flags &
+                 UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK);
+    flush();
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_get, tcp)
@@ -116,9 +116,9 @@ void uct_amo_test::validate_replies(const std::vector<uint64_t>& exp_replies) {
 }
 
 void uct_amo_test::wait_for_remote() {
-    for (unsigned i = 0; i < num_senders(); ++i) {
-        sender(i).flush();
-    }
+    /* Progress the receiver as well, since a transport may execute atomic
+     * operations in the target's progress (e.g TCP) */
+    flush();
 }
 
 void uct_amo_test::run_workers(send_func_t send, const mapped_buffer& recvbuf,
@@ -132,6 +132,9 @@ void uct_amo_test::run_workers(send_func_t send, const mapped_buffer& recvbuf,
     }
 
     for (unsigned i = 0; i < num_senders(); ++i) {
+        while (!m_workers.at(i).finished) {
+            receiver().progress();
+        }
         m_workers.at(i).join();
     }
 }
@@ -140,7 +143,7 @@ uct_amo_test::worker::worker(uct_amo_test* test, send_func_t send,
                              const mapped_buffer& recvbuf, const entity& entity,
                              uint64_t initial_value, bool advance) :
     test(test), value(initial_value), count(0), running(true),
-    m_send(send), m_advance(advance), m_recvbuf(recvbuf), m_entity(entity)
+    finished(false), m_send(send), m_advance(advance), m_recvbuf(recvbuf), m_entity(entity)
 
 {
     m_completions.resize(uct_amo_test::count());
@@ -192,6 +195,8 @@ void uct_amo_test::worker::run() {
             value = hash64(value);
         }
     }
+
+    finished = true;
 }
 
 void uct_amo_test::worker::join() {
@@ -6,6 +6,7 @@
 
 extern "C" {
 #include <uct/api/uct.h>
+#include <uct/api/v2/uct_v2.h>
 #include <uct/sm/mm/base/mm_md.h>
 #include <ucs/time/time.h>
 }
@@ -110,6 +111,16 @@ public:
         return UCS_OK;
     }
 
+    static ucs_status_t mm_am_batch_handler(void *arg, void *data,
+                                            size_t length, unsigned flags) {
+        std::vector<uint64_t> *recv_hdrs = (std::vector<uint64_t>*)arg;
+
+        EXPECT_EQ(2 * sizeof(uint64_t), length);
+        EXPECT_EQ(0xdeadbeef, ((uint64_t*)data)[1]);
+        recv_hdrs->push_back(*(uint64_t*)data);
+        return UCS_OK;
+    }
+
     bool check_md_caps(uint64_t flags) {
         FOR_EACH_ENTITY(iter) {
             if (!(ucs_test_all_flags((*iter)->md_attr().flags, flags))) {
@@ -218,6 +229,52 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, open_for_posix,
     free(recv_buffer);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, am_short_batch,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    const size_t num_msgs   = 1000;
+    const size_t batch_size = 13;
+    uint64_t payload        = 0xdeadbeef;
+    std::vector<uct_am_short_batch_entry_t> entries(num_msgs);
+    std::vector<uint64_t> recv_hdrs;
+    size_t posted;
+    ssize_t ret;
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        entries[i].header  = i;
+        entries[i].payload = &payload;
+        entries[i].length  = sizeof(payload);
+    }
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                             &recv_hdrs, 0);
+
+    posted = 0;
+    while (posted < num_msgs) {
+        ret = uct_ep_am_short_batch(m_e1->ep(0), 0, &entries[posted],
+                                    ucs_min(batch_size, num_msgs - posted));
+        if (ret > 0) {
+            posted += ret;
+        } else {
+            ASSERT_EQ(UCS_ERR_NO_RESOURCE, (ucs_status_t)ret);
+            progress();
+        }
+    }
+
+    ucs_time_t deadline = ucs_get_time() +
+                          ucs_time_from_sec(DEFAULT_TIMEOUT_SEC);
+    while ((recv_hdrs.size() < num_msgs) && (ucs_get_time() < deadline)) {
+        progress();
+    }
+
+    /* messages must arrive in order */
+    ASSERT_EQ(num_msgs, recv_hdrs.size());
+    for (size_t i = 0; i < num_msgs; ++i) {
+        EXPECT_EQ(i, recv_hdrs[i]);
+    }
+}
+
 UCS_TEST_SKIP_COND_P(test_uct_mm, alloc,
                      !check_md_caps(UCT_MD_FLAG_ALLOC)) {
 
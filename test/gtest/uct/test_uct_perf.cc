@@ -124,6 +124,13 @@ const test_perf::test_spec test_uct_perf::tests[] =
     ucs_offsetof(ucx_perf_result_t, msgrate.total_average), 1e-6, 0.8, 80.0,
     0 },
 
+  { "am short batch rate", "Mpps",
+    UCX_PERF_API_UCT, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_STREAM_UNI,
+    UCX_PERF_WAIT_MODE_POLL,
+    UCT_PERF_DATA_LAYOUT_SHORT_BATCH, 0, 1, { 8 }, 1, 2000000lu,
+    ucs_offsetof(ucx_perf_result_t, msgrate.total_average), 1e-6, 0.8, 80.0,
+    0 },
+
   { "am bcopy latency", "usec",
     UCX_PERF_API_UCT, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_PINGPONG,
     UCX_PERF_WAIT_MODE_POLL,
@@ -287,3 +294,63 @@ UCS_TEST_P(test_uct_loopback_cuda, envelope)
 }
 
 UCT_INSTANTIATE_CUDA_TEST_CASE(test_uct_loopback_cuda);
+
+
+class test_perf_histogram : public ucs::test {
+protected:
+    /* Record an even value through the rescaling merge path, from a
+     * histogram with twice the unit of @a hist */
+    static void record(ucx_perf_histogram_t *hist, uint64_t value)
+    {
+        ucx_perf_histogram_t *src = new ucx_perf_histogram_t;
+        double low, high;
+        unsigned i;
+
+        value /= 2;
+        ucx_perf_histogram_reset(src, hist->unit * 2);
+        for (i = 0; i < UCX_PERF_HIST_NUM_BUCKETS; ++i) {
+            ucx_perf_histogram_bucket_range(src, i, &low, &high);
+            if ((value * src->unit) < high) {
+                break;
+            }
+        }
+
+        ASSERT_LT(i, (unsigned)UCX_PERF_HIST_NUM_BUCKETS);
+        src->buckets[i] = 1;
+        src->count      = 1;
+        src->min        = value;
+        src->max        = value;
+        ucx_perf_histogram_merge(hist, src);
+        delete src;
+    }
+};
+
+UCS_TEST_F(test_perf_histogram, percentile) {
+    static const double max_error = 1.0 / UCS_BIT(UCX_PERF_HIST_SUB_BITS);
+    ucx_perf_histogram_t *hist    = new ucx_perf_histogram_t;
+    ucx_perf_histogram_t *total   = new ucx_perf_histogram_t;
+    uint64_t value;
+
+    ucx_perf_histogram_reset(hist, 1e-9);
+    for (value = 1; value <= 1000; ++value) {
+        record(hist, value * 1000);
+    }
+
+    EXPECT_EQ(1000u, hist->count);
+    EXPECT_NEAR(500e-6, ucx_perf_histogram_percentile(hist, 50),
+                500e-6 * max_error * 2);
+    EXPECT_NEAR(990e-6, ucx_perf_histogram_percentile(hist, 99),
+                990e-6 * max_error * 2);
+    EXPECT_DOUBLE_EQ(1000e-6, ucx_perf_histogram_percentile(hist, 100));
+
+    /* merging histograms with the same unit sums the counts */
+    ucx_perf_histogram_reset(total, hist->unit);
+    ucx_perf_histogram_merge(total, hist);
+    ucx_perf_histogram_merge(total, hist);
+    EXPECT_EQ(2000u, total->count);
+    EXPECT_DOUBLE_EQ(ucx_perf_histogram_percentile(hist, 90),
+                     ucx_perf_histogram_percentile(total, 90));
+
+    delete total;
+    delete hist;
+}